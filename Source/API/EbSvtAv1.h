@@ -76,6 +76,81 @@ typedef enum EbAv1PictureType {
     EB_AV1_INVALID_PICTURE       = 0xFF
 } EbAv1PictureType;
 
+/* Times at which a picture went through the encoder stages, in nanoseconds of
+ * CLOCK_MONOTONIC (QueryPerformanceCounter on Windows). A packet holding an
+ * undisplayed frame and the displayed one reports the displayed one. Stages not
+ * reached are 0. */
+typedef struct EbPictureTimestamps {
+    uint64_t resource_coordination; // taken from the input queue
+    uint64_t picture_decision; // analysis done, waiting for its mini-GOP
+    uint64_t enc_dec_start; // first superblock entering mode decision
+    uint64_t enc_dec_end; // last superblock encoded
+    uint64_t packetization; // entropy coded, waiting for the output order
+    uint64_t output; // packet queued for svt_av1_enc_get_packet() or handed to the packet writer
+} EbPictureTimestamps;
+
+// References of a picture: LAST_FRAME (1) to ALTREF_FRAME (7) of the AV1 specification
+#define SVT_AV1_ANALYSIS_REFS 7
+
+/* Mode decision of a coded block. Modes, partitions and references use the
+ * values of the AV1 specification: mode DC_PRED (0) to PAETH_PRED (12) for
+ * intra blocks, NEARESTMV (13) to NEW_NEWMV (24) for inter blocks; ref_frame
+ * 0 for intra, LAST_FRAME (1) to ALTREF_FRAME (7), -1 for none. */
+typedef struct SvtAv1BlockAnalysis {
+    uint16_t x; // luma position in the coded picture
+    uint16_t y;
+    uint8_t  width;
+    uint8_t  height;
+    uint8_t  mode;
+    uint8_t  uv_mode;
+    int8_t   ref_frame[2];
+    uint8_t  partition; // partition type of the node the block comes from
+    uint8_t  skip; // no residual coded
+    uint8_t  segment_id;
+    uint8_t  tx_depth;
+    int16_t  mv[2][2]; // x, y per reference in 1/8 luma sample
+} SvtAv1BlockAnalysis;
+
+/* Encoder analysis of a picture, attached to its packet when export_analysis is
+ * set. The arrays belong to the export, which is freed with the packet, or once
+ * the packet writer returns.
+ *
+ * Motion estimation runs on the source pictures, per 64x64 block in raster
+ * order. Each 64x64 block has 85 square blocks: the 64x64 one, then its 4
+ * 32x32, 16 16x16 and 64 8x8 blocks, each size in raster order. Each square
+ * block has a vector per searched reference; bit i of its me_ref_mask is set
+ * when the vector of reference i is valid, i.e. kept as a candidate for mode
+ * decision. */
+typedef struct SvtAv1AnalysisExport {
+    uint64_t picture_number; // display order
+    // Undisplayed (ALTREF) pictures coded in the same packet
+    struct SvtAv1AnalysisExport *next;
+    uint16_t                     width; // luma size of the coded picture
+    uint16_t                     height;
+    // Display order of the references, valid up to the reference count of each list:
+    // LAST_FRAME to GOLDEN_FRAME for list 0, BWDREF_FRAME to ALTREF_FRAME for list 1
+    uint64_t ref_picture[SVT_AV1_ANALYSIS_REFS];
+    uint8_t  ref_count[2];
+
+    // Motion estimation, no 64x64 block for intra pictures
+    uint16_t me_cols;
+    uint16_t me_rows;
+    uint8_t  me_ref_count;
+    int8_t   me_ref_frame[SVT_AV1_ANALYSIS_REFS]; // reference frame of each searched reference
+    int16_t *me_mv; // x, y pair in luma sample per reference per square block
+    uint8_t *me_ref_mask; // per square block
+
+    // Quantizer index of each superblock, in raster order
+    uint8_t  sb_size;
+    uint16_t sb_cols;
+    uint16_t sb_rows;
+    uint8_t *sb_qindex;
+
+    // Coded blocks, in raster order of their top left corner
+    uint32_t             block_count;
+    SvtAv1BlockAnalysis *blocks;
+} SvtAv1AnalysisExport;
+
 typedef struct EbBufferHeaderType {
     // EbBufferHeaderType size
     uint32_t size;
@@ -110,6 +185,12 @@ typedef struct EbBufferHeaderType {
     double cb_ssim;
 
     struct SvtMetadataArray *metadata;
+
+    // pipeline timestamps of the output packets
+    EbPictureTimestamps timestamps;
+
+    // encoder analysis of the output packets, NULL unless export_analysis is set
+    SvtAv1AnalysisExport *analysis;
 } EbBufferHeaderType;
 
 typedef struct EbComponentType {
@@ -264,6 +345,7 @@ typedef enum {
     ROI_MAP_EVENT, // ROI map data per picture
     RES_CHANGE_EVENT, // resolution change data per picture (KF only)
     RATE_CHANGE_EVENT, // Rate change data per picture (KF only)
+    MV_HINT_EVENT, // motion vector hints per picture (SvtAv1MotionHints)
     PRIVATE_DATA_TYPES // end of private data types
 } PrivDataType;
 typedef struct EbPrivDataNode {
@@ -304,6 +386,28 @@ typedef struct SvtAv1RateInfo {
     uint32_t target_bit_rate;
 } SvtAv1RateInfo;
 
+// How much motion estimation relies on the motion hints of a picture
+typedef enum SvtAv1MotionHintTrust {
+    // The hint is an extra search centre, used when its SAD beats the HME result
+    SVT_AV1_MV_HINT_SEED = 1,
+    // The hint replaces pre-HME and HME levels 0 and 1, HME level 2 refines around it
+    SVT_AV1_MV_HINT_REPLACE_HME = 2,
+} SvtAv1MotionHintTrust;
+/* Motion hints of a picture, e.g. the motion vectors of the decoded stream of a
+ * transcode. The field has cols x rows blocks of block_size x block_size luma
+ * samples, in raster order; mv holds an x, y pair per block in 1/8 luma sample.
+ * The vectors point to the past and are normalized to a distance of one picture:
+ * a vector to a reference n pictures before the current one is divided by n.
+ * An x of INT16_MIN marks a block without hint. The field is copied at
+ * svt_av1_enc_send_picture. */
+typedef struct SvtAv1MotionHints {
+    uint8_t  block_size; // 8, 16, 32 or 64
+    uint8_t  trust; // SvtAv1MotionHintTrust
+    uint16_t cols;
+    uint16_t rows;
+    int16_t *mv; // 2 * cols * rows values
+} SvtAv1MotionHints;
+
 /*!\brief Structure containing film grain synthesis parameters for a frame
      *
      * This structure contains input parameters for film grain synthesis
@@ -151,10 +151,131 @@ typedef enum SvtAv1IntraRefreshType {
 typedef enum {
     SVT_AV1_STREAM_INFO_START                = 1,
     SVT_AV1_STREAM_INFO_FIRST_PASS_STATS_OUT = SVT_AV1_STREAM_INFO_START,
+    /* Live counters of the pipeline stages, info is a SvtAv1PipelineStats */
+    SVT_AV1_STREAM_INFO_PIPELINE_STATS,
+    /* Live counters of the picture pools, info is a SvtAv1PoolStats */
+    SVT_AV1_STREAM_INFO_POOL_STATS,
+    /* Memory allocated by the encoder per category, info is a SvtAv1MemoryStats */
+    SVT_AV1_STREAM_INFO_MEMORY_STATS,
+    /* Plane layout of the frames sent with svt_av1_enc_send_picture_zero_copy(), info is a SvtAv1InputLayout */
+    SVT_AV1_STREAM_INFO_INPUT_LAYOUT,
 
     SVT_AV1_STREAM_INFO_END,
 } SVT_AV1_STREAM_INFO_ID;
 
+/* Stages of the encoder pipeline, in processing order */
+typedef enum SvtAv1PipelineStage {
+    SVT_AV1_STAGE_RESOURCE_COORDINATION,
+    SVT_AV1_STAGE_PICTURE_ANALYSIS,
+    SVT_AV1_STAGE_PICTURE_DECISION,
+    SVT_AV1_STAGE_MOTION_ESTIMATION,
+    SVT_AV1_STAGE_INITIAL_RATE_CONTROL,
+    SVT_AV1_STAGE_SOURCE_BASED_OPERATIONS,
+    SVT_AV1_STAGE_TPL,
+    SVT_AV1_STAGE_PICTURE_MANAGER,
+    SVT_AV1_STAGE_RATE_CONTROL,
+    SVT_AV1_STAGE_MODE_DECISION_CONFIG,
+    SVT_AV1_STAGE_ENC_DEC,
+    SVT_AV1_STAGE_DLF,
+    SVT_AV1_STAGE_CDEF,
+    SVT_AV1_STAGE_RESTORATION,
+    SVT_AV1_STAGE_ENTROPY_CODING,
+    SVT_AV1_STAGE_PACKETIZATION,
+    SVT_AV1_STAGE_COUNT
+} SvtAv1PipelineStage;
+
+typedef struct SvtAv1StageCounters {
+    uint32_t thread_count; /* threads of the stage */
+    uint32_t queue_depth; /* tasks waiting in the input queue of the stage */
+    uint32_t busy_threads; /* threads of the stage not waiting for a task */
+    uint64_t task_count; /* tasks processed since init */
+    uint64_t busy_time_us; /* time spent processing tasks since init, summed over the threads */
+} SvtAv1StageCounters;
+
+typedef struct SvtAv1PipelineStats {
+    SvtAv1StageCounters stage[SVT_AV1_STAGE_COUNT];
+    /* Input pictures sent to the encoder whose packet has not been output yet */
+    uint32_t frames_in_flight;
+} SvtAv1PipelineStats;
+
+/* Object pools bounding the number of pictures in the pipeline */
+typedef enum SvtAv1Pool {
+    SVT_AV1_POOL_INPUT, /* input pictures, svt_av1_enc_send_picture() blocks when exhausted */
+    SVT_AV1_POOL_PARENT_PCS, /* pictures in the lookahead and pipeline */
+    SVT_AV1_POOL_PCS, /* pictures past picture management */
+    SVT_AV1_POOL_ME, /* motion estimation results */
+    SVT_AV1_POOL_REFERENCE, /* reconstructed reference pictures */
+    SVT_AV1_POOL_PA_REFERENCE, /* source reference pictures of the lookahead */
+    SVT_AV1_POOL_OUTPUT, /* output packets */
+    SVT_AV1_POOL_COUNT
+} SvtAv1Pool;
+
+typedef struct SvtAv1PoolCounters {
+    uint32_t total_count; /* objects in the pool */
+    uint32_t allocated_count; /* objects constructed so far, below total_count when the pool grows on demand */
+    uint32_t in_use; /* objects currently taken from the pool */
+    uint64_t blocked_count; /* times a thread found the pool exhausted and had to wait */
+    uint64_t blocked_time_us; /* total time threads waited on the exhausted pool */
+} SvtAv1PoolCounters;
+
+typedef struct SvtAv1PoolStats {
+    SvtAv1PoolCounters pool[SVT_AV1_POOL_COUNT];
+} SvtAv1PoolStats;
+
+/* Subsystems the memory allocated by the encoder is charged to */
+typedef enum SvtAv1MemCategory {
+    SVT_AV1_MEM_OTHER, /* stage contexts, queues and tables not listed below */
+    SVT_AV1_MEM_PICTURE_BUFFERS, /* input, reference, PA reference and recon pictures */
+    SVT_AV1_MEM_PCS, /* sequence and picture control sets, motion estimation results */
+    SVT_AV1_MEM_MD, /* mode decision and encode-decode contexts */
+    SVT_AV1_MEM_TPL, /* TPL reference pictures, contexts and statistics */
+    SVT_AV1_MEM_TF, /* temporal filtering buffers and the hash tables of the hash based motion search */
+    SVT_AV1_MEM_BITSTREAM, /* entropy coder, bitstream and output packet buffers */
+    SVT_AV1_MEM_COUNT
+} SvtAv1MemCategory;
+
+typedef struct SvtAv1MemoryCounters {
+    uint64_t current; /* bytes currently allocated */
+    uint64_t peak; /* highest value of current since the handle was created */
+} SvtAv1MemoryCounters;
+
+typedef struct SvtAv1MemoryStats {
+    SvtAv1MemoryCounters category[SVT_AV1_MEM_COUNT];
+    SvtAv1MemoryCounters total; /* all categories, its peak is not the sum of the category peaks */
+} SvtAv1MemoryStats;
+
+/* Plane layout of the frames lent to the encoder. The pictures are padded in
+ * place, so each plane is allocated with margins around the visible samples.
+ * All values are in samples. */
+typedef struct SvtAv1InputLayout {
+    uint32_t luma_stride; /* y_stride of the lent frames */
+    uint32_t chroma_stride; /* cb_stride and cr_stride of the lent frames */
+    uint32_t luma_offset; /* from the start of the luma allocation to the first visible sample */
+    uint32_t chroma_offset; /* from the start of each chroma allocation to the first visible sample */
+    uint32_t luma_size; /* size of the luma allocation */
+    uint32_t chroma_size; /* size of each chroma allocation */
+} SvtAv1InputLayout;
+
+/* Hands a lent frame back to the application, opaque is the value given to
+ * svt_av1_enc_send_picture_zero_copy() */
+typedef void (*SvtAv1InputRelease)(void *opaque);
+
+/* Application sink of the output packets, see svt_av1_enc_set_packet_writer() */
+typedef struct SvtAv1PacketWriter {
+    /* Returns size bytes of application memory for the next packet, or NULL
+     * to have it written from encoder memory. Optional. */
+    uint8_t *(*get_buffer)(void *opaque, uint32_t size);
+    /* Hands over a packet. p_buffer is the memory returned by the previous
+     * get_buffer call, or encoder memory if it returned NULL. The packet and
+     * encoder memory are only valid during the call. */
+    void (*write)(void *opaque, const EbBufferHeaderType *packet);
+    void *opaque;
+} SvtAv1PacketWriter;
+
+/* Signals that a packet can be taken with svt_av1_enc_get_packet(), see
+ * svt_av1_enc_set_output_notify() */
+typedef void (*SvtAv1OutputNotify)(void *opaque);
+
 /*!\brief Generic fixed size buffer structure
  *
  * This structure is able to hold a reference to any fixed size buffer.
@@ -940,10 +1061,81 @@ typedef struct EbSvtAv1EncConfiguration {
      */
     bool avif;
 
+    /* @brief Thread scheduling mode of the pipeline stages
+     *  0: every stage runs on its own dedicated threads
+     *  1: stage threads share a scheduler that lets at most one thread per
+     *     available core run at a time; a thread gives its core back whenever it
+     *     waits on the pipeline, so idle cores move to the stages with backlog
+     *  Default is 0. */
+    uint8_t scheduler_mode;
+
+    /* @brief Placement of the picture and reference pools on NUMA systems
+     *  0: local, the pools are first touched from the cores the encoder threads
+     *     are pinned to (pin_threads / target_socket), so they land on that node
+     *  1: interleave, the pools are spread page by page over all NUMA nodes, for a
+     *     single instance spanning several sockets (Linux only)
+     *  Default is 0. */
+    uint8_t numa_policy;
+
+    /* @brief Rebalance the threads of the multi-threaded stages at run time
+     *  0: every stage keeps all of its threads
+     *  1: the queues feeding the stages are sampled every few milliseconds, and
+     *     a budget of one running thread per core is split between the stages in
+     *     proportion to their backlog; the other threads are parked
+     *  Default is 0. */
+    uint8_t stage_rebalance;
+
+    /* @brief Allocation of the large object pools (picture control sets, motion
+     *  estimation results, reference pictures)
+     *  0: every pool is fully allocated at init
+     *  1: every pool starts with one object and grows when it runs dry
+     *  2: same as 1, and the objects grown past the first one are freed again
+     *     when at least half of the pool is idle
+     *  Default is 0. */
+    uint8_t pool_growth;
+
+    /* @brief Real-time speed control, single pass only
+     *  0: the preset is fixed
+     *  1: the output frame rate is measured about once per second, and the preset
+     *     of the next mini-GOPs is stepped towards faster presets when the encoder
+     *     falls behind the configured frame rate, and back towards enc_mode when it
+     *     keeps up. enc_mode is the slowest preset used.
+     *  Default is 0. */
+    uint8_t speed_control;
+
+    /* @brief Fastest preset speed control may step to, -1 for the fastest
+     *  supported preset: M10, or M9 for 4k and higher resolutions in random
+     *  access. Values above it are mapped to it with a warning, values below
+     *  enc_mode keep the preset fixed.
+     *  Default is -1. */
+    int8_t speed_control_max_preset;
+
+    /* @brief Number of closed-GOP chunks encoded at the same time, random access only
+     *  0, 1: the input is encoded as a single stream
+     *  2-16: a new chunk starts at each key frame, forced or placed every
+     *     intra_period_length + 1 frames. The chunks are encoded as independent
+     *     streams, with their own rate control and the first pass stats of their
+     *     frames, on that many pipelines sharing the cores of the handle, and
+     *     their packets are output in order as a single stream. Each pipeline
+     *     keeps the pictures its chunk needs in flight, they split the other
+     *     picture buffers and stage threads of the level_of_parallelism.
+     *     Requires key frame intra refresh; not used in the first pass.
+     *  Default is 0. */
+    uint8_t parallel_chunks;
+
+    /* @brief Attach the encoder analysis of each picture to its output packet
+     *  (EbBufferHeaderType.analysis): motion estimation vectors, superblock
+     *  quantizer indexes and the mode decision of every coded block.
+     *  Default is 0. */
+    bool export_analysis;
+
     /*Add 128 Byte Padding to Struct to avoid changing the size of the public configuration struct*/
-    uint8_t padding[128];
+    uint8_t padding[128 - 8 * sizeof(uint8_t)];
 } EbSvtAv1EncConfiguration;
 
+/* Opaque handle of a thread pool shared by several encoder handles */
+typedef struct SvtAv1ThreadPool SvtAv1ThreadPool;
+
 /**
  * Returns a string containing "v$tag-$commit_count-g$hash${dirty:+-dirty}"
  * @param[out] SVT_AV1_CVS_VERSION
@@ -987,6 +1179,36 @@ EB_API EbErrorType svt_av1_enc_set_parameter(
 EB_API EbErrorType svt_av1_enc_parse_parameter(EbSvtAv1EncConfiguration *pComponentParameterStructure, const char *name,
                                                const char *value);
 
+/* OPTIONAL: Thread pool shared by several encoder handles.
+     *
+     * The stage threads of every handle attached to the pool run on the same
+     * set of core_count execution slots, so running several encoders in one
+     * process no longer oversubscribes the machine with one full thread set per
+     * handle. Free slots are handed to the attached handle currently holding
+     * the fewest of them, so a busy channel cannot starve the others.
+     *
+     * Parameter:
+     * @ **pool        Created pool.
+     * @ core_count    Number of stage threads allowed to run at once, 0 for the
+     *                 number of available processors. */
+EB_API EbErrorType svt_av1_enc_thread_pool_create(SvtAv1ThreadPool **pool, uint32_t core_count);
+
+/* OPTIONAL: Destroy a thread pool. Every attached handle must have been
+     * deconstructed with svt_av1_enc_deinit_handle() first.
+     *
+     * Parameter:
+     * @ *pool         Pool to destroy. */
+EB_API EbErrorType svt_av1_enc_thread_pool_destroy(SvtAv1ThreadPool *pool);
+
+/* OPTIONAL: Run the stage threads of an encoder on a shared thread pool.
+     * Must be called before svt_av1_enc_init(); the scheduler_mode setting is
+     * then implied.
+     *
+     * Parameter:
+     * @ *svt_enc_component  Encoder handler.
+     * @ *pool               Pool created with svt_av1_enc_thread_pool_create(). */
+EB_API EbErrorType svt_av1_enc_attach_thread_pool(EbComponentType *svt_enc_component, SvtAv1ThreadPool *pool);
+
 /* STEP 3: Initialize encoder and allocates memory to necessary buffers.
      *
      * Parameter:
@@ -1014,6 +1236,28 @@ EB_API EbErrorType svt_av1_enc_stream_header_release(EbBufferHeaderType *stream_
      * @ *p_buffer           Header pointer, picture buffer. */
 EB_API EbErrorType svt_av1_enc_send_picture(EbComponentType *svt_enc_component, EbBufferHeaderType *p_buffer);
 
+/* OPTIONAL: Send the picture without copying it.
+     *
+     * The planes of the EbSvtIOFormat in p_buffer->p_buffer are referenced by
+     * the encoder instead of being copied. They must follow the layout given by
+     * SVT_AV1_STREAM_INFO_INPUT_LAYOUT, with luma, cb and cr pointing at the
+     * first visible sample. The encoder pads and filters the planes in place, so
+     * the application must not access them until release is called, once the
+     * last stage reading the source picture is done, and at the latest by
+     * svt_av1_enc_reset() or svt_av1_enc_deinit(). release runs on an encoder
+     * thread and must not call into the encoder.
+     * Frames that cannot be referenced (strides not matching the layout, a
+     * resolution change, a short input, 10-bit input or a downsampled first
+     * pass) are copied, and released before the function returns.
+     *
+     * Parameter:
+     * @ *svt_enc_component  Encoder handler.
+     * @ *p_buffer           Header pointer, picture buffer.
+     * @ release             Called once with opaque when the planes are returned.
+     * @ *opaque             Application data passed to release. */
+EB_API EbErrorType svt_av1_enc_send_picture_zero_copy(EbComponentType *svt_enc_component, EbBufferHeaderType *p_buffer,
+                                                      SvtAv1InputRelease release, void *opaque);
+
 /**
  * @brief Step 5: Receive packet.
  * This function will become blocking if either pic_send_done is set to 1 or if we are in low-delay (pred-struct=1).
@@ -1033,6 +1277,36 @@ EB_API EbErrorType svt_av1_enc_get_packet(EbComponentType *svt_enc_component, Eb
      * @ **p_buffer          Header pointer that contains the output packet to be released. */
 EB_API void svt_av1_enc_release_out_buffer(EbBufferHeaderType **p_buffer);
 
+/* OPTIONAL: Write the output packets to application memory.
+     *
+     * Instead of being queued for svt_av1_enc_get_packet(), each packet is
+     * written once into the memory returned by writer->get_buffer and handed
+     * over with writer->write, in output order, from an encoder thread. The
+     * callbacks must not call into the encoder. The EOS packet is also
+     * returned by svt_av1_enc_get_packet(), without data, and is the only
+     * packet it returns, so the application can wait for it there.
+     * Must be called before svt_av1_enc_init().
+     *
+     * Parameter:
+     * @ *svt_enc_component  Encoder handler.
+     * @ *writer             Callbacks and their opaque pointer, copied. */
+EB_API EbErrorType svt_av1_enc_set_packet_writer(EbComponentType *svt_enc_component, const SvtAv1PacketWriter *writer);
+
+/* OPTIONAL: Be notified of the output packets instead of polling for them.
+     *
+     * notify is called from an encoder thread each time a packet is queued,
+     * so a following svt_av1_enc_get_packet() with pic_send_done set to 0
+     * returns it. The callback must not call into the encoder, it is meant to
+     * wake the application, e.g. by writing to an eventfd or a pipe watched by
+     * its event loop. Must be called before svt_av1_enc_init().
+     *
+     * Parameter:
+     * @ *svt_enc_component  Encoder handler.
+     * @ notify              Callback, NULL to disable the notifications.
+     * @ *opaque             Passed back to notify. */
+EB_API EbErrorType svt_av1_enc_set_output_notify(EbComponentType *svt_enc_component, SvtAv1OutputNotify notify,
+                                                 void *opaque);
+
 /* OPTIONAL: Fill buffer with reconstructed picture.
      *
      * Parameter:
@@ -1045,9 +1319,29 @@ EB_API EbErrorType svt_av1_get_recon(EbComponentType *svt_enc_component, EbBuffe
      * Parameter:
      * @ *svt_enc_component  Encoder handler.
      * @ *stream_info_id SVT_AV1_STREAM_INFO_ID.
-     * @ *info         output, the type depends on id */
+     * @ *info         output, the type depends on id
+     * The pipeline, pool and memory counters can be sampled from any thread
+     * between svt_av1_enc_init() and svt_av1_enc_deinit(). */
 EB_API EbErrorType svt_av1_enc_get_stream_info(EbComponentType *svt_enc_component, uint32_t stream_info_id, void *info);
 
+/* OPTIONAL: Start a new stream on an initialized encoder.
+     *
+     * Ends the current stream and prepares the handle for an independent
+     * stream with the configuration in effect at svt_av1_enc_init(): the
+     * next picture sent is encoded as the first picture of a new sequence,
+     * with fresh rate control and reference state. The pools and threads
+     * are kept, so this is much cheaper than a deinit / init cycle.
+     *
+     * If EOS was not sent yet, it is sent and the remaining packets are
+     * dropped. Every packet returned by svt_av1_enc_get_packet() must have
+     * been released, and no other call may be made on the handle until the
+     * reset returns. Rate and QP changes sent with the pictures are undone;
+     * resolution changes are kept.
+     *
+     * Parameter:
+     * @ *svt_enc_component  Encoder handler. */
+EB_API EbErrorType svt_av1_enc_reset(EbComponentType *svt_enc_component);
+
 /* STEP 6: Deinitialize encoder library.
      *
      * Parameter:
@@ -139,6 +139,13 @@
 #define THREAD_MGMNT "--lp"
 #define PIN_TOKEN "--pin"
 #define TARGET_SOCKET "--ss"
+#define SCHEDULER_MODE_TOKEN "--scheduler-mode"
+#define NUMA_POLICY_TOKEN "--numa-policy"
+#define STAGE_REBALANCE_TOKEN "--stage-rebalance"
+#define POOL_GROWTH_TOKEN "--pool-growth"
+#define SPEED_CONTROL_TOKEN "--speed-control"
+#define SPEED_CONTROL_MAX_PRESET_TOKEN "--speed-control-max-preset"
+#define PARALLEL_CHUNKS_TOKEN "--parallel-chunks"
 
 //double dash
 #define PRESET_TOKEN "--preset"
@@ -789,6 +796,41 @@ ConfigEntry config_entry_global_options[] = {
      "Specifies which socket to run on, assumes a max of two sockets. Refer to Appendix A.1 of the "
      "user guide, default is -1 [-1, 0, -1]",
      set_cfg_generic_token},
+    {SINGLE_INPUT,
+     SCHEDULER_MODE_TOKEN,
+     "Stage thread scheduling, default is 0 [0: dedicated threads per stage, 1: shared scheduler capping running "
+     "threads to the core count]",
+     set_cfg_generic_token},
+    {SINGLE_INPUT,
+     NUMA_POLICY_TOKEN,
+     "Placement of the encoder pools on NUMA systems, default is 0 [0: local to the cores selected with --pin / "
+     "--ss, 1: interleaved over all nodes]",
+     set_cfg_generic_token},
+    {SINGLE_INPUT,
+     STAGE_REBALANCE_TOKEN,
+     "Move threads between the pipeline stages at run time based on their backlog, default is 0 [0: fixed threads "
+     "per stage, 1: rebalanced]",
+     set_cfg_generic_token},
+    {SINGLE_INPUT,
+     POOL_GROWTH_TOKEN,
+     "Allocation of the picture and reference pools, default is 0 [0: preallocated, 1: grown on demand, 2: grown "
+     "and shrunk on demand]",
+     set_cfg_generic_token},
+    {SINGLE_INPUT,
+     SPEED_CONTROL_TOKEN,
+     "Step the preset per mini-GOP to keep up with the frame rate, --preset being the slowest one, default is 0 "
+     "[0: fixed preset, 1: speed control]",
+     set_cfg_generic_token},
+    {SINGLE_INPUT,
+     SPEED_CONTROL_MAX_PRESET_TOKEN,
+     "Fastest preset used by --speed-control, default is -1 [-1: fastest supported preset (10, or 9 for 4k and higher in "
+     "random access), 0-13]",
+     set_cfg_generic_token},
+    {SINGLE_INPUT,
+     PARALLEL_CHUNKS_TOKEN,
+     "Number of closed-GOP chunks, split at the key frames, encoded at the same time, default is 0 [0-1: single "
+     "stream, 2-16]",
+     set_cfg_generic_token},
     // Termination
     {SINGLE_INPUT, NULL, NULL, NULL}};
 
@@ -1253,6 +1295,13 @@ ConfigEntry config_entry[] = {
     {SINGLE_INPUT, THREAD_MGMNT, "LevelOfParallelism", set_cfg_generic_token},
     {SINGLE_INPUT, PIN_TOKEN, "PinnedExecution", set_cfg_generic_token},
     {SINGLE_INPUT, TARGET_SOCKET, "TargetSocket", set_cfg_generic_token},
+    {SINGLE_INPUT, SCHEDULER_MODE_TOKEN, "SchedulerMode", set_cfg_generic_token},
+    {SINGLE_INPUT, NUMA_POLICY_TOKEN, "NumaPolicy", set_cfg_generic_token},
+    {SINGLE_INPUT, STAGE_REBALANCE_TOKEN, "StageRebalance", set_cfg_generic_token},
+    {SINGLE_INPUT, POOL_GROWTH_TOKEN, "PoolGrowth", set_cfg_generic_token},
+    {SINGLE_INPUT, SPEED_CONTROL_TOKEN, "SpeedControl", set_cfg_generic_token},
+    {SINGLE_INPUT, SPEED_CONTROL_MAX_PRESET_TOKEN, "SpeedControlMaxPreset", set_cfg_generic_token},
+    {SINGLE_INPUT, PARALLEL_CHUNKS_TOKEN, "ParallelChunks", set_cfg_generic_token},
 
     // Rate Control Options
     {SINGLE_INPUT, RATE_CONTROL_ENABLE_TOKEN, "RateControlMode", set_cfg_generic_token},
@@ -96,6 +96,8 @@ typedef struct EncContext {
     EncPass    enc_pass;
     int32_t    passes;
     int32_t    total_frames;
+    // Thread pool shared by the channels when they use the shared scheduler
+    SvtAv1ThreadPool* thread_pool;
 } EncContext;
 
 //initilize memory mapped file handler
@@ -192,6 +194,19 @@ static EbErrorType enc_context_ctor(EncApp* enc_app, EncContext* enc_context, in
     if (enc_context->channels[0].app_cfg->config.target_socket != -1)
         assign_app_thread_group(enc_context->channels[0].app_cfg->config.target_socket);
 
+    // Run every channel on one thread pool instead of one full set of stage threads per channel
+    if (num_channels > 1 && enc_context->channels[0].app_cfg->config.scheduler_mode) {
+        return_error = svt_av1_enc_thread_pool_create(&enc_context->thread_pool, 0);
+        if (return_error != EB_ErrorNone)
+            return return_error;
+        for (uint32_t inst_cnt = 0; inst_cnt < num_channels; ++inst_cnt) {
+            EncChannel* c = enc_context->channels + inst_cnt;
+            if (c->return_error == EB_ErrorNone)
+                c->return_error = svt_av1_enc_attach_thread_pool(c->app_cfg->svt_encoder_handle,
+                                                                 enc_context->thread_pool);
+        }
+    }
+
     // Init the Encoder
     for (uint32_t inst_cnt = 0; inst_cnt < num_channels; ++inst_cnt) {
         EncChannel* c = enc_context->channels + inst_cnt;
@@ -251,6 +266,8 @@ static void enc_context_dctor(EncContext* enc_context) {
         deinit_memory_file_map(c->app_cfg);
         enc_channel_dctor(c, inst_cnt);
     }
+    if (enc_context->thread_pool)
+        svt_av1_enc_thread_pool_destroy(enc_context->thread_pool);
 
     for (uint32_t warning_id = 0; warning_id < MAX_NUM_TOKENS; warning_id++) free(enc_context->warning[warning_id]);
 }
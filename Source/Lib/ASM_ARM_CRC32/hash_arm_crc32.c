@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2025, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+ */
+
+#include <arm_acle.h>
+#include <arm_neon.h>
+#include <string.h>
+#include "aom_dsp_rtcd.h"
+#include "hash.h"
+
+uint32_t svt_av1_get_crc32c_value_arm_crc32(const uint8_t *p, size_t length) {
+    uint32_t crc = 0xFFFFFFFF;
+    for (; length >= 8; length -= 8, p += 8) {
+        uint64_t v;
+        memcpy(&v, p, sizeof(v));
+        crc = __crc32cd(crc, v);
+    }
+    if (length >= 4) {
+        uint32_t v;
+        memcpy(&v, p, sizeof(v));
+        crc = __crc32cw(crc, v);
+        length -= 4;
+        p += 4;
+    }
+    for (; length; length--) crc = __crc32cb(crc, *p++);
+    return crc ^ 0xFFFFFFFF;
+}
+
+void svt_av1_generate_block_2x2_hash_row_arm_crc32(const uint8_t *src, int stride, int width,
+                                                   CRC_CALCULATOR *crc_calculator, uint32_t *hash1, uint32_t *hash2,
+                                                   int8_t *row_same, int8_t *col_same) {
+    const uint8_t   *src1 = src + stride;
+    const uint8x16_t one  = vdupq_n_u8(1);
+    int              x    = 0;
+
+    // 16 positions at a time, the loads of the right neighbours end at src[width]
+    for (; x + 16 <= width; x += 16) {
+        const uint8x16_t a0 = vld1q_u8(src + x);
+        const uint8x16_t a1 = vld1q_u8(src + x + 1);
+        const uint8x16_t b0 = vld1q_u8(src1 + x);
+        const uint8x16_t b1 = vld1q_u8(src1 + x + 1);
+
+        const uint8x16_t row = vandq_u8(vceqq_u8(a0, a1), vceqq_u8(b0, b1));
+        const uint8x16_t col = vandq_u8(vceqq_u8(a0, b0), vceqq_u8(a1, b1));
+        vst1q_s8(row_same + x, vreinterpretq_s8_u8(vandq_u8(row, one)));
+        vst1q_s8(col_same + x, vreinterpretq_s8_u8(vandq_u8(col, one)));
+
+        // Each 32-bit word holds the 2x2 block in the order of the C version
+        const uint16x8_t a_lo = vreinterpretq_u16_u8(vzip1q_u8(a0, a1));
+        const uint16x8_t a_hi = vreinterpretq_u16_u8(vzip2q_u8(a0, a1));
+        const uint16x8_t b_lo = vreinterpretq_u16_u8(vzip1q_u8(b0, b1));
+        const uint16x8_t b_hi = vreinterpretq_u16_u8(vzip2q_u8(b0, b1));
+        uint32_t         blocks[16];
+        vst1q_u32(blocks + 0, vreinterpretq_u32_u16(vzip1q_u16(a_lo, b_lo)));
+        vst1q_u32(blocks + 4, vreinterpretq_u32_u16(vzip2q_u16(a_lo, b_lo)));
+        vst1q_u32(blocks + 8, vreinterpretq_u32_u16(vzip1q_u16(a_hi, b_hi)));
+        vst1q_u32(blocks + 12, vreinterpretq_u32_u16(vzip2q_u16(a_hi, b_hi)));
+
+        for (int i = 0; i < 16; i++) {
+            hash1[x + i] = svt_av1_get_crc_value(crc_calculator, (uint8_t *)&blocks[i], sizeof(blocks[i]));
+            hash2[x + i] = __crc32cw(0xFFFFFFFF, blocks[i]) ^ 0xFFFFFFFF;
+        }
+    }
+
+    if (x < width)
+        svt_av1_generate_block_2x2_hash_row_c(
+            src + x, stride, width - x, crc_calculator, hash1 + x, hash2 + x, row_same + x, col_same + x);
+}
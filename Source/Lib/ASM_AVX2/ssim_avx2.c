@@ -177,3 +177,71 @@ double svt_ssim_4x4_hbd_avx2(const uint16_t *s, uint32_t sp, const uint16_t *r,
     double   score    = similarity(sum_s, sum_r, sum_sq_s, sum_sq_r, sum_sxr, 16, 10);
     return score;
 }
+
+static INLINE __m256i load_u8_8x2_avx2(const uint8_t *p, int stride) {
+    return _mm256_cvtepu8_epi16(_mm_unpacklo_epi64(_mm_loadu_si64(p), _mm_loadu_si64(p + stride)));
+}
+
+static INLINE void ssim_parms_accumulate_avx2(const __m256i src, const __m256i rec, __m256i *sum_s, __m256i *sum_r,
+                                              __m256i *sum_sq_s, __m256i *sum_sq_r, __m256i *sum_sxr) {
+    const __m256i one = _mm256_set1_epi16(1);
+    *sum_s            = _mm256_add_epi32(*sum_s, _mm256_madd_epi16(src, one));
+    *sum_r            = _mm256_add_epi32(*sum_r, _mm256_madd_epi16(rec, one));
+    *sum_sq_s         = _mm256_add_epi32(*sum_sq_s, _mm256_madd_epi16(src, src));
+    *sum_sq_r         = _mm256_add_epi32(*sum_sq_r, _mm256_madd_epi16(rec, rec));
+    *sum_sxr          = _mm256_add_epi32(*sum_sxr, _mm256_madd_epi16(src, rec));
+}
+
+void svt_aom_ssim_parms_8x8_avx2(const uint8_t *s, int sp, const uint8_t *r, int rp, uint32_t *sum_s, uint32_t *sum_r,
+                                 uint32_t *sum_sq_s, uint32_t *sum_sq_r, uint32_t *sum_sxr) {
+    __m256i vec_sum_s    = _mm256_setzero_si256();
+    __m256i vec_sum_r    = _mm256_setzero_si256();
+    __m256i vec_sum_sq_s = _mm256_setzero_si256();
+    __m256i vec_sum_sq_r = _mm256_setzero_si256();
+    __m256i vec_sum_sxr  = _mm256_setzero_si256();
+    for (int i = 0; i < 8; i += 2) {
+        ssim_parms_accumulate_avx2(load_u8_8x2_avx2(s, sp),
+                                   load_u8_8x2_avx2(r, rp),
+                                   &vec_sum_s,
+                                   &vec_sum_r,
+                                   &vec_sum_sq_s,
+                                   &vec_sum_sq_r,
+                                   &vec_sum_sxr);
+        s += 2 * sp;
+        r += 2 * rp;
+    }
+
+    *sum_s += sum8(vec_sum_s);
+    *sum_r += sum8(vec_sum_r);
+    *sum_sq_s += sum8(vec_sum_sq_s);
+    *sum_sq_r += sum8(vec_sum_sq_r);
+    *sum_sxr += sum8(vec_sum_sxr);
+}
+
+void svt_aom_highbd_ssim_parms_8x8_avx2(const uint8_t *s, int sp, const uint8_t *sinc, int spinc, const uint16_t *r,
+                                        int rp, uint32_t *sum_s, uint32_t *sum_r, uint32_t *sum_sq_s,
+                                        uint32_t *sum_sq_r, uint32_t *sum_sxr) {
+    __m256i vec_sum_s    = _mm256_setzero_si256();
+    __m256i vec_sum_r    = _mm256_setzero_si256();
+    __m256i vec_sum_sq_s = _mm256_setzero_si256();
+    __m256i vec_sum_sq_r = _mm256_setzero_si256();
+    __m256i vec_sum_sxr  = _mm256_setzero_si256();
+    for (int i = 0; i < 8; i += 2) {
+        // the 2 lsb are kept in bits 6 and 7 of sinc
+        const __m256i vec_src = _mm256_add_epi16(_mm256_slli_epi16(load_u8_8x2_avx2(s, sp), 2),
+                                                 _mm256_srli_epi16(load_u8_8x2_avx2(sinc, spinc), 6));
+        const __m256i vec_rec = _mm256_setr_m128i(_mm_loadu_si128((const __m128i *)r),
+                                                  _mm_loadu_si128((const __m128i *)(r + rp)));
+        ssim_parms_accumulate_avx2(
+            vec_src, vec_rec, &vec_sum_s, &vec_sum_r, &vec_sum_sq_s, &vec_sum_sq_r, &vec_sum_sxr);
+        s += 2 * sp;
+        sinc += 2 * spinc;
+        r += 2 * rp;
+    }
+
+    *sum_s += sum8(vec_sum_s);
+    *sum_r += sum8(vec_sum_r);
+    *sum_sq_s += sum8(vec_sum_sq_s);
+    *sum_sq_r += sum8(vec_sum_sq_r);
+    *sum_sxr += sum8(vec_sum_sxr);
+}
@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2025, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+ */
+
+#include "definitions.h"
+
+#if EN_AVX512_SUPPORT
+
+#include <immintrin.h>
+
+// Load 4 rows of 8 pixels, widened to 16 bits
+static INLINE __m512i load_u8_8x4_avx512(const uint8_t *p, int stride) {
+    const __m128i lo = _mm_unpacklo_epi64(_mm_loadl_epi64((const __m128i *)p),
+                                          _mm_loadl_epi64((const __m128i *)(p + stride)));
+    const __m128i hi = _mm_unpacklo_epi64(_mm_loadl_epi64((const __m128i *)(p + 2 * stride)),
+                                          _mm_loadl_epi64((const __m128i *)(p + 3 * stride)));
+    return _mm512_cvtepu8_epi16(_mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1));
+}
+
+static INLINE __m512i load_u16_8x4_avx512(const uint16_t *p, int stride) {
+    __m512i v = _mm512_castsi128_si512(_mm_loadu_si128((const __m128i *)p));
+    v         = _mm512_inserti32x4(v, _mm_loadu_si128((const __m128i *)(p + stride)), 1);
+    v         = _mm512_inserti32x4(v, _mm_loadu_si128((const __m128i *)(p + 2 * stride)), 2);
+    return _mm512_inserti32x4(v, _mm_loadu_si128((const __m128i *)(p + 3 * stride)), 3);
+}
+
+static INLINE void ssim_parms_accumulate_avx512(const __m512i src, const __m512i rec, __m512i *sum_s, __m512i *sum_r,
+                                                __m512i *sum_sq_s, __m512i *sum_sq_r, __m512i *sum_sxr) {
+    const __m512i one = _mm512_set1_epi16(1);
+    *sum_s            = _mm512_add_epi32(*sum_s, _mm512_madd_epi16(src, one));
+    *sum_r            = _mm512_add_epi32(*sum_r, _mm512_madd_epi16(rec, one));
+    *sum_sq_s         = _mm512_add_epi32(*sum_sq_s, _mm512_madd_epi16(src, src));
+    *sum_sq_r         = _mm512_add_epi32(*sum_sq_r, _mm512_madd_epi16(rec, rec));
+    *sum_sxr          = _mm512_add_epi32(*sum_sxr, _mm512_madd_epi16(src, rec));
+}
+
+void svt_aom_ssim_parms_8x8_avx512(const uint8_t *s, int sp, const uint8_t *r, int rp, uint32_t *sum_s,
+                                   uint32_t *sum_r, uint32_t *sum_sq_s, uint32_t *sum_sq_r, uint32_t *sum_sxr) {
+    __m512i vec_sum_s    = _mm512_setzero_si512();
+    __m512i vec_sum_r    = _mm512_setzero_si512();
+    __m512i vec_sum_sq_s = _mm512_setzero_si512();
+    __m512i vec_sum_sq_r = _mm512_setzero_si512();
+    __m512i vec_sum_sxr  = _mm512_setzero_si512();
+    for (int i = 0; i < 8; i += 4) {
+        ssim_parms_accumulate_avx512(load_u8_8x4_avx512(s, sp),
+                                     load_u8_8x4_avx512(r, rp),
+                                     &vec_sum_s,
+                                     &vec_sum_r,
+                                     &vec_sum_sq_s,
+                                     &vec_sum_sq_r,
+                                     &vec_sum_sxr);
+        s += 4 * sp;
+        r += 4 * rp;
+    }
+
+    *sum_s += (uint32_t)_mm512_reduce_add_epi32(vec_sum_s);
+    *sum_r += (uint32_t)_mm512_reduce_add_epi32(vec_sum_r);
+    *sum_sq_s += (uint32_t)_mm512_reduce_add_epi32(vec_sum_sq_s);
+    *sum_sq_r += (uint32_t)_mm512_reduce_add_epi32(vec_sum_sq_r);
+    *sum_sxr += (uint32_t)_mm512_reduce_add_epi32(vec_sum_sxr);
+}
+
+void svt_aom_highbd_ssim_parms_8x8_avx512(const uint8_t *s, int sp, const uint8_t *sinc, int spinc,
+                                          const uint16_t *r, int rp, uint32_t *sum_s, uint32_t *sum_r,
+                                          uint32_t *sum_sq_s, uint32_t *sum_sq_r, uint32_t *sum_sxr) {
+    __m512i vec_sum_s    = _mm512_setzero_si512();
+    __m512i vec_sum_r    = _mm512_setzero_si512();
+    __m512i vec_sum_sq_s = _mm512_setzero_si512();
+    __m512i vec_sum_sq_r = _mm512_setzero_si512();
+    __m512i vec_sum_sxr  = _mm512_setzero_si512();
+    for (int i = 0; i < 8; i += 4) {
+        // the 2 lsb are kept in bits 6 and 7 of sinc
+        const __m512i vec_src = _mm512_add_epi16(_mm512_slli_epi16(load_u8_8x4_avx512(s, sp), 2),
+                                                 _mm512_srli_epi16(load_u8_8x4_avx512(sinc, spinc), 6));
+        ssim_parms_accumulate_avx512(vec_src,
+                                     load_u16_8x4_avx512(r, rp),
+                                     &vec_sum_s,
+                                     &vec_sum_r,
+                                     &vec_sum_sq_s,
+                                     &vec_sum_sq_r,
+                                     &vec_sum_sxr);
+        s += 4 * sp;
+        sinc += 4 * spinc;
+        r += 4 * rp;
+    }
+
+    *sum_s += (uint32_t)_mm512_reduce_add_epi32(vec_sum_s);
+    *sum_r += (uint32_t)_mm512_reduce_add_epi32(vec_sum_r);
+    *sum_sq_s += (uint32_t)_mm512_reduce_add_epi32(vec_sum_sq_s);
+    *sum_sq_r += (uint32_t)_mm512_reduce_add_epi32(vec_sum_sq_r);
+    *sum_sxr += (uint32_t)_mm512_reduce_add_epi32(vec_sum_sxr);
+}
+
+#endif // EN_AVX512_SUPPORT
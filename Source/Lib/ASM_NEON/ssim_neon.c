@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2025, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+ */
+
+#include <arm_neon.h>
+
+#include "definitions.h"
+
+static inline void ssim_parms_accumulate_neon(const uint16x8_t src, const uint16x8_t rec, uint32x4_t *sum_s,
+                                              uint32x4_t *sum_r, uint32x4_t *sum_sq_s, uint32x4_t *sum_sq_r,
+                                              uint32x4_t *sum_sxr) {
+    *sum_s    = vpadalq_u16(*sum_s, src);
+    *sum_r    = vpadalq_u16(*sum_r, rec);
+    *sum_sq_s = vmlal_u16(*sum_sq_s, vget_low_u16(src), vget_low_u16(src));
+    *sum_sq_s = vmlal_u16(*sum_sq_s, vget_high_u16(src), vget_high_u16(src));
+    *sum_sq_r = vmlal_u16(*sum_sq_r, vget_low_u16(rec), vget_low_u16(rec));
+    *sum_sq_r = vmlal_u16(*sum_sq_r, vget_high_u16(rec), vget_high_u16(rec));
+    *sum_sxr  = vmlal_u16(*sum_sxr, vget_low_u16(src), vget_low_u16(rec));
+    *sum_sxr  = vmlal_u16(*sum_sxr, vget_high_u16(src), vget_high_u16(rec));
+}
+
+void svt_aom_ssim_parms_8x8_neon(const uint8_t *s, int sp, const uint8_t *r, int rp, uint32_t *sum_s, uint32_t *sum_r,
+                                 uint32_t *sum_sq_s, uint32_t *sum_sq_r, uint32_t *sum_sxr) {
+    uint32x4_t vec_sum_s    = vdupq_n_u32(0);
+    uint32x4_t vec_sum_r    = vdupq_n_u32(0);
+    uint32x4_t vec_sum_sq_s = vdupq_n_u32(0);
+    uint32x4_t vec_sum_sq_r = vdupq_n_u32(0);
+    uint32x4_t vec_sum_sxr  = vdupq_n_u32(0);
+    for (int i = 0; i < 8; i++) {
+        ssim_parms_accumulate_neon(vmovl_u8(vld1_u8(s)),
+                                   vmovl_u8(vld1_u8(r)),
+                                   &vec_sum_s,
+                                   &vec_sum_r,
+                                   &vec_sum_sq_s,
+                                   &vec_sum_sq_r,
+                                   &vec_sum_sxr);
+        s += sp;
+        r += rp;
+    }
+
+    *sum_s += vaddvq_u32(vec_sum_s);
+    *sum_r += vaddvq_u32(vec_sum_r);
+    *sum_sq_s += vaddvq_u32(vec_sum_sq_s);
+    *sum_sq_r += vaddvq_u32(vec_sum_sq_r);
+    *sum_sxr += vaddvq_u32(vec_sum_sxr);
+}
+
+void svt_aom_highbd_ssim_parms_8x8_neon(const uint8_t *s, int sp, const uint8_t *sinc, int spinc, const uint16_t *r,
+                                        int rp, uint32_t *sum_s, uint32_t *sum_r, uint32_t *sum_sq_s,
+                                        uint32_t *sum_sq_r, uint32_t *sum_sxr) {
+    uint32x4_t vec_sum_s    = vdupq_n_u32(0);
+    uint32x4_t vec_sum_r    = vdupq_n_u32(0);
+    uint32x4_t vec_sum_sq_s = vdupq_n_u32(0);
+    uint32x4_t vec_sum_sq_r = vdupq_n_u32(0);
+    uint32x4_t vec_sum_sxr  = vdupq_n_u32(0);
+    for (int i = 0; i < 8; i++) {
+        // the 2 lsb are kept in bits 6 and 7 of sinc
+        const uint16x8_t src = vaddw_u8(vshll_n_u8(vld1_u8(s), 2), vshr_n_u8(vld1_u8(sinc), 6));
+        ssim_parms_accumulate_neon(
+            src, vld1q_u16(r), &vec_sum_s, &vec_sum_r, &vec_sum_sq_s, &vec_sum_sq_r, &vec_sum_sxr);
+        s += sp;
+        sinc += spinc;
+        r += rp;
+    }
+
+    *sum_s += vaddvq_u32(vec_sum_s);
+    *sum_r += vaddvq_u32(vec_sum_r);
+    *sum_sq_s += vaddvq_u32(vec_sum_sq_s);
+    *sum_sq_r += vaddvq_u32(vec_sum_sq_r);
+    *sum_sxr += vaddvq_u32(vec_sum_sxr);
+}
@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2025, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+ */
+
+#include <nmmintrin.h>
+#include <string.h>
+#include "aom_dsp_rtcd.h"
+#include "hash.h"
+
+uint32_t svt_av1_get_crc32c_value_sse4_2(const uint8_t *p, size_t length) {
+    uint64_t crc = 0xFFFFFFFF;
+    for (; length >= 8; length -= 8, p += 8) {
+        uint64_t v;
+        memcpy(&v, p, sizeof(v));
+        crc = _mm_crc32_u64(crc, v);
+    }
+    uint32_t crc32 = (uint32_t)crc;
+    if (length >= 4) {
+        uint32_t v;
+        memcpy(&v, p, sizeof(v));
+        crc32 = _mm_crc32_u32(crc32, v);
+        length -= 4;
+        p += 4;
+    }
+    for (; length; length--) crc32 = _mm_crc32_u8(crc32, *p++);
+    return crc32 ^ 0xFFFFFFFF;
+}
+
+void svt_av1_generate_block_2x2_hash_row_sse4_2(const uint8_t *src, int stride, int width,
+                                                CRC_CALCULATOR *crc_calculator, uint32_t *hash1, uint32_t *hash2,
+                                                int8_t *row_same, int8_t *col_same) {
+    const uint8_t *src1 = src + stride;
+    const __m128i  one  = _mm_set1_epi8(1);
+    int            x    = 0;
+
+    // 16 positions at a time, the loads of the right neighbours end at src[width]
+    for (; x + 16 <= width; x += 16) {
+        const __m128i a0 = _mm_loadu_si128((const __m128i *)(src + x));
+        const __m128i a1 = _mm_loadu_si128((const __m128i *)(src + x + 1));
+        const __m128i b0 = _mm_loadu_si128((const __m128i *)(src1 + x));
+        const __m128i b1 = _mm_loadu_si128((const __m128i *)(src1 + x + 1));
+
+        const __m128i row = _mm_and_si128(_mm_cmpeq_epi8(a0, a1), _mm_cmpeq_epi8(b0, b1));
+        const __m128i col = _mm_and_si128(_mm_cmpeq_epi8(a0, b0), _mm_cmpeq_epi8(a1, b1));
+        _mm_storeu_si128((__m128i *)(row_same + x), _mm_and_si128(row, one));
+        _mm_storeu_si128((__m128i *)(col_same + x), _mm_and_si128(col, one));
+
+        // Each 32-bit word holds the 2x2 block in the order of the C version
+        const __m128i a_lo = _mm_unpacklo_epi8(a0, a1);
+        const __m128i a_hi = _mm_unpackhi_epi8(a0, a1);
+        const __m128i b_lo = _mm_unpacklo_epi8(b0, b1);
+        const __m128i b_hi = _mm_unpackhi_epi8(b0, b1);
+        uint32_t      blocks[16];
+        _mm_storeu_si128((__m128i *)(blocks + 0), _mm_unpacklo_epi16(a_lo, b_lo));
+        _mm_storeu_si128((__m128i *)(blocks + 4), _mm_unpackhi_epi16(a_lo, b_lo));
+        _mm_storeu_si128((__m128i *)(blocks + 8), _mm_unpacklo_epi16(a_hi, b_hi));
+        _mm_storeu_si128((__m128i *)(blocks + 12), _mm_unpackhi_epi16(a_hi, b_hi));
+
+        for (int i = 0; i < 16; i++) {
+            hash1[x + i] = svt_av1_get_crc_value(crc_calculator, (uint8_t *)&blocks[i], sizeof(blocks[i]));
+            hash2[x + i] = _mm_crc32_u32(0xFFFFFFFF, blocks[i]) ^ 0xFFFFFFFF;
+        }
+    }
+
+    if (x < width)
+        svt_av1_generate_block_2x2_hash_row_c(
+            src + x, stride, width - x, crc_calculator, hash1 + x, hash2 + x, row_same + x, col_same + x);
+}
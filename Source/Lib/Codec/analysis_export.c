@@ -0,0 +1,186 @@
+/*
+* Copyright (c) 2025, Alliance for Open Media. All rights reserved
+*
+* This source code is subject to the terms of the BSD 2 Clause License and
+* the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+* was not distributed with this source code in the LICENSE file, you can
+* obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+* Media Patent License 1.0 was not distributed with this source code in the
+* PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+*/
+
+#include <inttypes.h>
+#include <string.h>
+
+#include "analysis_export.h"
+#include "sequence_control_set.h"
+#include "me_sb_results.h"
+#include "mode_decision.h"
+#include "svt_malloc.h"
+#include "svt_log.h"
+
+void svt_aom_free_analysis_export(SvtAv1AnalysisExport **analysis) {
+    while (*analysis) {
+        SvtAv1AnalysisExport *next = (*analysis)->next;
+        EB_FREE(*analysis);
+        *analysis = next;
+    }
+}
+
+// Whether the block of the mi unit starts at it; AV1 blocks are aligned on their size
+static bool is_block_origin(const BlockModeInfoEnc *block_mi, int32_t mi_row, int32_t mi_col) {
+    return !(mi_row & (mi_size_high[block_mi->bsize] - 1)) && !(mi_col & (mi_size_wide[block_mi->bsize] - 1));
+}
+
+static uint32_t count_blocks(const PictureControlSet *pcs, int32_t mi_rows, int32_t mi_cols) {
+    uint32_t count = 0;
+    for (int32_t mi_row = 0; mi_row < mi_rows; mi_row++)
+        for (int32_t mi_col = 0; mi_col < mi_cols; mi_col++)
+            count += is_block_origin(&pcs->mi_grid_base[mi_row * pcs->mi_stride + mi_col]->mbmi.block_mi,
+                                     mi_row,
+                                     mi_col);
+    return count;
+}
+
+static void export_blocks(const PictureControlSet *pcs, int32_t mi_rows, int32_t mi_cols,
+                          SvtAv1BlockAnalysis *blocks) {
+    for (int32_t mi_row = 0; mi_row < mi_rows; mi_row++) {
+        for (int32_t mi_col = 0; mi_col < mi_cols; mi_col++) {
+            const BlockModeInfoEnc *block_mi = &pcs->mi_grid_base[mi_row * pcs->mi_stride + mi_col]->mbmi.block_mi;
+            if (!is_block_origin(block_mi, mi_row, mi_col))
+                continue;
+            SvtAv1BlockAnalysis *block = blocks++;
+            block->x                   = (uint16_t)(mi_col << MI_SIZE_LOG2);
+            block->y                   = (uint16_t)(mi_row << MI_SIZE_LOG2);
+            block->width               = block_size_wide[block_mi->bsize];
+            block->height              = block_size_high[block_mi->bsize];
+            block->mode                = (uint8_t)block_mi->mode;
+            block->uv_mode             = (uint8_t)block_mi->uv_mode;
+            block->partition           = (uint8_t)block_mi->partition;
+            block->skip                = block_mi->skip;
+            block->segment_id          = block_mi->segment_id;
+            block->tx_depth            = block_mi->tx_depth;
+            for (int i = 0; i < 2; i++) {
+                const bool inter    = block_mi->ref_frame[i] > INTRA_FRAME;
+                block->ref_frame[i] = block_mi->ref_frame[i];
+                block->mv[i][0]     = inter ? block_mi->mv[i].as_mv.col : 0;
+                block->mv[i][1]     = inter ? block_mi->mv[i].as_mv.row : 0;
+            }
+        }
+    }
+}
+
+// Copies the vectors of the references in me_slot (indexes in the ME results),
+// keeping the ones of the unipred candidates of each square block
+static void export_me(const PictureParentControlSet *ppcs, const uint8_t *me_slot, SvtAv1AnalysisExport *analysis) {
+    const MotionEstimationData *me_data   = ppcs->pa_me_data;
+    const uint32_t              b64_count = analysis->me_cols * analysis->me_rows;
+    const uint8_t               ref_count = analysis->me_ref_count;
+    int16_t                    *mv        = analysis->me_mv;
+    uint8_t                    *ref_mask  = analysis->me_ref_mask;
+    for (uint32_t b64 = 0; b64 < b64_count; b64++) {
+        const MeSbResults *me_results = me_data->me_results[b64];
+        for (uint32_t pu = 0; pu < SQUARE_PU_COUNT; pu++, mv += 2 * ref_count) {
+            // Same square blocks as in construct_me_candidate_array()
+            const bool use_me_pu = ppcs->enable_me_16x16 ? ppcs->enable_me_8x8 || pu < MAX_SB64_PU_COUNT_NO_8X8
+                                                         : pu < MAX_SB64_PU_COUNT_WO_16X16;
+            uint8_t mask = 0;
+            if (use_me_pu) {
+                const MeCandidate *cand = &me_results->me_candidate_array[pu * me_data->max_cand];
+                for (uint32_t c = 0; c < me_results->total_me_candidate_index[pu]; c++) {
+                    if (cand[c].direction == BI_PRED)
+                        continue;
+                    const uint8_t slot = cand[c].direction ? me_data->max_l0 + cand[c].ref_idx_l1
+                                                           : cand[c].ref_idx_l0;
+                    for (uint8_t r = 0; r < ref_count; r++)
+                        if (me_slot[r] == slot)
+                            mask |= 1 << r;
+                }
+            }
+            for (uint8_t r = 0; r < ref_count; r++) {
+                const MvCandidate me_mv = me_results->me_mv_array[pu * me_data->max_refs + me_slot[r]];
+                const bool        valid = (mask >> r) & 1;
+                mv[2 * r]               = valid ? me_mv.x_mv : 0;
+                mv[2 * r + 1]           = valid ? me_mv.y_mv : 0;
+            }
+            *ref_mask++ = mask;
+        }
+    }
+}
+
+void svt_aom_build_analysis_export(PictureControlSet *pcs) {
+    PictureParentControlSet *ppcs = pcs->ppcs;
+    if (!pcs->scs->static_config.export_analysis)
+        return;
+    svt_aom_free_analysis_export(&ppcs->analysis);
+
+    // References, then the ones motion estimation searched: list 0 ones followed by list 1 ones
+    uint64_t ref_picture[SVT_AV1_ANALYSIS_REFS] = {0};
+    uint8_t  ref_count[2]                       = {0};
+    int8_t   me_ref_frame[SVT_AV1_ANALYSIS_REFS];
+    uint8_t  me_slot[SVT_AV1_ANALYSIS_REFS];
+    uint8_t  me_ref_count = 0;
+    uint16_t me_cols = 0, me_rows = 0;
+    if (ppcs->slice_type != I_SLICE) {
+        const MotionEstimationData *me_data = ppcs->pa_me_data;
+        ref_count[REF_LIST_0]               = ppcs->ref_list0_count;
+        ref_count[REF_LIST_1]               = ppcs->ref_list1_count;
+        for (uint8_t list = REF_LIST_0; list <= REF_LIST_1; list++) {
+            const uint8_t me_count = list == REF_LIST_0
+                ? MIN(ppcs->ref_list0_count_try, me_data->max_l0)
+                : MIN(ppcs->ref_list1_count_try, me_data->max_refs - me_data->max_l0);
+            for (uint8_t i = 0; i < ref_count[list]; i++) {
+                const MvReferenceFrame ref_frame = svt_get_ref_frame_type(list, i);
+                ref_picture[ref_frame - LAST_FRAME] = ppcs->ref_pic_poc_array[list][i];
+                if (i < me_count) {
+                    me_ref_frame[me_ref_count] = ref_frame;
+                    me_slot[me_ref_count++]    = (list ? me_data->max_l0 : 0) + i;
+                }
+            }
+        }
+        me_cols = (ppcs->aligned_width + BLOCK_SIZE_64 - 1) / BLOCK_SIZE_64;
+        me_rows = (ppcs->aligned_height + BLOCK_SIZE_64 - 1) / BLOCK_SIZE_64;
+        if (!me_ref_count || me_cols * me_rows > me_data->b64_total_count)
+            me_cols = me_rows = me_ref_count = 0;
+    }
+
+    const int32_t  mi_rows     = ppcs->av1_cm->mi_rows;
+    const int32_t  mi_cols     = ppcs->av1_cm->mi_cols;
+    const uint32_t block_count = count_blocks(pcs, mi_rows, mi_cols);
+    const uint32_t me_blocks   = me_cols * me_rows * SQUARE_PU_COUNT;
+    const uint32_t sb_count    = ppcs->picture_sb_width * ppcs->picture_sb_height;
+
+    // A single allocation, ordered by alignment
+    SvtAv1AnalysisExport *analysis;
+    EB_NO_THROW_MALLOC(analysis,
+                       sizeof(*analysis) + sizeof(*analysis->blocks) * block_count +
+                           sizeof(*analysis->me_mv) * 2 * me_blocks * me_ref_count + me_blocks + sb_count);
+    if (!analysis) {
+        SVT_ERROR("failed to allocate the analysis export of picture %" PRIu64 "\n", ppcs->picture_number);
+        return;
+    }
+    memset(analysis, 0, sizeof(*analysis));
+    analysis->picture_number = ppcs->picture_number;
+    analysis->width          = ppcs->frame_width;
+    analysis->height         = ppcs->frame_height;
+    memcpy(analysis->ref_picture, ref_picture, sizeof(ref_picture));
+    memcpy(analysis->ref_count, ref_count, sizeof(ref_count));
+    analysis->blocks       = (SvtAv1BlockAnalysis *)(analysis + 1);
+    analysis->me_mv        = (int16_t *)(analysis->blocks + block_count);
+    analysis->me_ref_mask  = (uint8_t *)(analysis->me_mv + 2 * me_blocks * me_ref_count);
+    analysis->sb_qindex    = analysis->me_ref_mask + me_blocks;
+    analysis->block_count  = block_count;
+    analysis->me_cols      = me_cols;
+    analysis->me_rows      = me_rows;
+    analysis->me_ref_count = me_ref_count;
+    memcpy(analysis->me_ref_frame, me_ref_frame, me_ref_count);
+    analysis->sb_size = (uint8_t)pcs->scs->sb_size;
+    analysis->sb_cols = ppcs->picture_sb_width;
+    analysis->sb_rows = ppcs->picture_sb_height;
+
+    export_blocks(pcs, mi_rows, mi_cols, analysis->blocks);
+    if (me_blocks)
+        export_me(ppcs, me_slot, analysis);
+    for (uint32_t sb = 0; sb < sb_count; sb++) analysis->sb_qindex[sb] = pcs->sb_ptr_array[sb]->qindex;
+    ppcs->analysis = analysis;
+}
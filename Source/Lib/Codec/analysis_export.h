@@ -0,0 +1,40 @@
+/*
+* Copyright (c) 2025, Alliance for Open Media. All rights reserved
+*
+* This source code is subject to the terms of the BSD 2 Clause License and
+* the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+* was not distributed with this source code in the LICENSE file, you can
+* obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+* Media Patent License 1.0 was not distributed with this source code in the
+* PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+*/
+
+#ifndef EbAnalysisExport_h
+#define EbAnalysisExport_h
+
+#include "EbSvtAv1.h"
+#include "pcs.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**************************************
+ * Analysis export
+ *
+ * Copy of the motion estimation results, the superblock quantizer indexes and
+ * the mode decision of a picture, built when export_analysis is set once the
+ * picture is encoded and before its motion estimation data is released. The
+ * export waits on the parent picture until packetization attaches it to the
+ * output packet of the picture; the application gets it with the packet.
+ **************************************/
+
+/* Builds the export of an encoded picture into pcs->ppcs->analysis. */
+extern void svt_aom_build_analysis_export(PictureControlSet *pcs);
+/* Frees an export and the ones chained after it. */
+extern void svt_aom_free_analysis_export(SvtAv1AnalysisExport **analysis);
+
+#ifdef __cplusplus
+}
+#endif
+#endif // EbAnalysisExport_h
@@ -13,6 +13,7 @@
 
 #define AOM_RTCD_C
 #include "aom_dsp_rtcd.h"
+#include "rtcd_profile.h"
 #include "compute_sad_c.h"
 #include "pic_analysis_process.h"
 #include "temporal_filtering.h"
@@ -48,6 +49,13 @@
     SET_FUNCTIONS_AVX512(ptr, avx512)
 #elif defined ARCH_AARCH64
 
+#if HAVE_ARM_CRC32
+#define SET_FUNCTIONS_ARM_CRC32(ptr, arm_crc32)                                                   \
+    if (((uintptr_t)NULL != (uintptr_t)arm_crc32) && (flags & HAS_ARM_CRC32)) ptr = arm_crc32;
+#else
+#define SET_FUNCTIONS_ARM_CRC32(ptr, arm_crc32)
+#endif // HAVE_ARM_CRC32
+
 #if HAVE_NEON_DOTPROD
 #define SET_FUNCTIONS_NEON_DOTPROD(ptr, neon_dotprod)                                             \
     if (((uintptr_t)NULL != (uintptr_t)neon_dotprod) && (flags & HAS_NEON_DOTPROD)) ptr = neon_dotprod;
@@ -62,8 +70,9 @@
 #define SET_FUNCTIONS_SVE(ptr, sve)
 #endif // HAVE_SVE
 
-#define SET_FUNCTIONS_AARCH64(ptr, c, neon, neon_dotprod, sve)                                    \
+#define SET_FUNCTIONS_AARCH64(ptr, c, neon, arm_crc32, neon_dotprod, sve)                         \
     if (((uintptr_t)NULL != (uintptr_t)neon)   && (flags & HAS_NEON))   ptr = neon;               \
+    SET_FUNCTIONS_ARM_CRC32(ptr, arm_crc32)                                                       \
     SET_FUNCTIONS_NEON_DOTPROD(ptr, neon_dotprod)                                                 \
     SET_FUNCTIONS_SVE(ptr, sve)
 #endif
@@ -82,6 +91,7 @@
         }                                                                                         \
         ptr = c;                                                                                  \
         SET_FUNCTIONS_X86(ptr, c, mmx, sse, sse2, sse3, ssse3, sse4_1, sse4_2, avx, avx2, avx512) \
+        RTCD_PROFILE_REGISTER(ptr, c);                                                            \
     } while (0)
 #else
 #define SET_FUNCTIONS(ptr, c, mmx, sse, sse2, sse3, ssse3, sse4_1, sse4_2, avx, avx2, avx512)     \
@@ -96,11 +106,12 @@
         }                                                                                         \
         ptr = c;                                                                                  \
         SET_FUNCTIONS_X86(ptr, c, mmx, sse, sse2, sse3, ssse3, sse4_1, sse4_2, avx, avx2, avx512) \
+        RTCD_PROFILE_REGISTER(ptr, c);                                                            \
     } while (0)
 #endif
 #elif defined ARCH_AARCH64
 #if EXCLUDE_HASH
-#define SET_FUNCTIONS(ptr, c, neon, neon_dotprod, sve)                                            \
+#define SET_FUNCTIONS(ptr, c, neon, arm_crc32, neon_dotprod, sve)                                 \
     do {                                                                                          \
         if (check_pointer_was_set && ptr != 0) {                                                  \
             printf("Error: %s:%i: Pointer \"%s\" is set before!\n", __FILE__, 0, #ptr);           \
@@ -111,10 +122,11 @@
             assert(0);                                                                            \
         }                                                                                         \
         ptr = c;                                                                                  \
-        SET_FUNCTIONS_AARCH64(ptr, c, neon, neon_dotprod, sve)                                    \
+        SET_FUNCTIONS_AARCH64(ptr, c, neon, arm_crc32, neon_dotprod, sve)                         \
+        RTCD_PROFILE_REGISTER(ptr, c);                                                            \
     } while (0)
 #else
-#define SET_FUNCTIONS(ptr, c, neon, neon_dotprod, sve)                                            \
+#define SET_FUNCTIONS(ptr, c, neon, arm_crc32, neon_dotprod, sve)                                 \
     do {                                                                                          \
         if (check_pointer_was_set && ptr != 0) {                                                  \
             printf("Error: %s:%i: Pointer \"%s\" is set before!\n", __FILE__, __LINE__, #ptr);    \
@@ -125,7 +137,8 @@
             assert(0);                                                                            \
         }                                                                                         \
         ptr = c;                                                                                  \
-        SET_FUNCTIONS_AARCH64(ptr, c, neon, neon_dotprod, sve)                                    \
+        SET_FUNCTIONS_AARCH64(ptr, c, neon, arm_crc32, neon_dotprod, sve)                         \
+        RTCD_PROFILE_REGISTER(ptr, c);                                                            \
     } while (0)
 #endif
 #else
@@ -141,6 +154,7 @@
             assert(0);                                                                            \
         }                                                                                         \
         ptr = c;                                                                                  \
+        RTCD_PROFILE_REGISTER(ptr, c);                                                            \
     } while (0)
 #else
 #define SET_FUNCTIONS(ptr, c)                                                                     \
@@ -154,6 +168,7 @@
             assert(0);                                                                            \
         }                                                                                         \
         ptr = c;                                                                                  \
+        RTCD_PROFILE_REGISTER(ptr, c);                                                            \
     } while (0)
 #endif
 #endif
@@ -169,17 +184,19 @@
     #define SET_SSSE3(ptr, c, ssse3)                                      SET_FUNCTIONS(ptr, c, 0, 0, 0, 0, ssse3, 0, 0, 0, 0, 0)
     #define SET_SSSE3_AVX2(ptr, c, ssse3, avx2)                           SET_FUNCTIONS(ptr, c, 0, 0, 0, 0, ssse3, 0, 0, 0, avx2, 0)
     #define SET_SSE41(ptr, c, sse4_1)                                     SET_FUNCTIONS(ptr, c, 0, 0, 0, 0, 0, sse4_1, 0, 0, 0, 0)
+    #define SET_SSE42(ptr, c, sse4_2)                                     SET_FUNCTIONS(ptr, c, 0, 0, 0, 0, 0, 0, sse4_2, 0, 0, 0)
     #define SET_SSE41_AVX2(ptr, c, sse4_1, avx2)                          SET_FUNCTIONS(ptr, c, 0, 0, 0, 0, 0, sse4_1, 0, 0, avx2, 0)
     #define SET_SSE41_AVX2_AVX512(ptr, c, sse4_1, avx2, avx512)           SET_FUNCTIONS(ptr, c, 0, 0, 0, 0, 0, sse4_1, 0, 0, avx2, avx512)
     #define SET_AVX2(ptr, c, avx2)                                        SET_FUNCTIONS(ptr, c, 0, 0, 0, 0, 0, 0, 0, 0, avx2, 0)
     #define SET_AVX2_AVX512(ptr, c, avx2, avx512)                         SET_FUNCTIONS(ptr, c, 0, 0, 0, 0, 0, 0, 0, 0, avx2, avx512)
     #define SET_SSE2_AVX2_AVX512(ptr, c, sse2, avx2, avx512)              SET_FUNCTIONS(ptr, c, 0, 0, sse2, 0, 0, 0, 0, 0, avx2, avx512)
 #elif defined ARCH_AARCH64
-    #define SET_ONLY_C(ptr, c)                                            SET_FUNCTIONS(ptr, c, 0, 0, 0)
-    #define SET_NEON(ptr, c, neon)                                        SET_FUNCTIONS(ptr, c, neon, 0, 0)
-    #define SET_NEON_NEON_DOTPROD(ptr, c, neon, neon_dotprod)             SET_FUNCTIONS(ptr, c, neon, neon_dotprod, 0)
-    #define SET_NEON_NEON_DOTPROD_SVE(ptr, c, neon, neon_dotprod, sve)    SET_FUNCTIONS(ptr, c, neon, neon_dotprod, sve)
-    #define SET_NEON_SVE(ptr, c, neon, sve)                               SET_FUNCTIONS(ptr, c, neon, 0, sve)
+    #define SET_ONLY_C(ptr, c)                                            SET_FUNCTIONS(ptr, c, 0, 0, 0, 0)
+    #define SET_NEON(ptr, c, neon)                                        SET_FUNCTIONS(ptr, c, neon, 0, 0, 0)
+    #define SET_ARM_CRC32(ptr, c, arm_crc32)                              SET_FUNCTIONS(ptr, c, 0, arm_crc32, 0, 0)
+    #define SET_NEON_NEON_DOTPROD(ptr, c, neon, neon_dotprod)             SET_FUNCTIONS(ptr, c, neon, 0, neon_dotprod, 0)
+    #define SET_NEON_NEON_DOTPROD_SVE(ptr, c, neon, neon_dotprod, sve)    SET_FUNCTIONS(ptr, c, neon, 0, neon_dotprod, sve)
+    #define SET_NEON_SVE(ptr, c, neon, sve)                               SET_FUNCTIONS(ptr, c, neon, 0, 0, sve)
 
 #else
     #define SET_ONLY_C(ptr, c)                                      SET_FUNCTIONS(ptr, c)
@@ -548,6 +565,10 @@ void svt_aom_setup_rtcd_internal(EbCpuFlags flags) {
     SET_AVX2(svt_ssim_4x4, svt_ssim_4x4_c, svt_ssim_4x4_avx2);
     SET_AVX2(svt_ssim_8x8_hbd, svt_ssim_8x8_hbd_c, svt_ssim_8x8_hbd_avx2);
     SET_AVX2(svt_ssim_4x4_hbd, svt_ssim_4x4_hbd_c, svt_ssim_4x4_hbd_avx2);
+    SET_AVX2_AVX512(svt_aom_ssim_parms_8x8, svt_aom_ssim_parms_8x8_c, svt_aom_ssim_parms_8x8_avx2, svt_aom_ssim_parms_8x8_avx512);
+    SET_AVX2_AVX512(svt_aom_highbd_ssim_parms_8x8, svt_aom_highbd_ssim_parms_8x8_c, svt_aom_highbd_ssim_parms_8x8_avx2, svt_aom_highbd_ssim_parms_8x8_avx512);
+    SET_SSE42(svt_av1_get_crc32c_value, svt_av1_get_crc32c_value_c, svt_av1_get_crc32c_value_sse4_2);
+    SET_SSE42(svt_av1_generate_block_2x2_hash_row, svt_av1_generate_block_2x2_hash_row_c, svt_av1_generate_block_2x2_hash_row_sse4_2);
 #elif defined ARCH_AARCH64
     SET_NEON(hadamard_path, hadamard_path_c, hadamard_path_neon);
     SET_NEON_NEON_DOTPROD(svt_aom_sse, svt_aom_sse_c, svt_aom_sse_neon, svt_aom_sse_neon_dotprod);
@@ -899,6 +920,10 @@ void svt_aom_setup_rtcd_internal(EbCpuFlags flags) {
     SET_ONLY_C(svt_ssim_4x4, svt_ssim_4x4_c);
     SET_ONLY_C(svt_ssim_8x8_hbd, svt_ssim_8x8_hbd_c);
     SET_ONLY_C(svt_ssim_4x4_hbd, svt_ssim_4x4_hbd_c);
+    SET_NEON(svt_aom_ssim_parms_8x8, svt_aom_ssim_parms_8x8_c, svt_aom_ssim_parms_8x8_neon);
+    SET_NEON(svt_aom_highbd_ssim_parms_8x8, svt_aom_highbd_ssim_parms_8x8_c, svt_aom_highbd_ssim_parms_8x8_neon);
+    SET_ARM_CRC32(svt_av1_get_crc32c_value, svt_av1_get_crc32c_value_c, svt_av1_get_crc32c_value_arm_crc32);
+    SET_ARM_CRC32(svt_av1_generate_block_2x2_hash_row, svt_av1_generate_block_2x2_hash_row_c, svt_av1_generate_block_2x2_hash_row_arm_crc32);
 #else
     SET_ONLY_C(hadamard_path, hadamard_path_c);
     SET_ONLY_C(svt_aom_sse, svt_aom_sse_c);
@@ -1248,6 +1273,10 @@ void svt_aom_setup_rtcd_internal(EbCpuFlags flags) {
     SET_ONLY_C(svt_ssim_4x4, svt_ssim_4x4_c);
     SET_ONLY_C(svt_ssim_8x8_hbd, svt_ssim_8x8_hbd_c);
     SET_ONLY_C(svt_ssim_4x4_hbd, svt_ssim_4x4_hbd_c);
+    SET_ONLY_C(svt_aom_ssim_parms_8x8, svt_aom_ssim_parms_8x8_c);
+    SET_ONLY_C(svt_aom_highbd_ssim_parms_8x8, svt_aom_highbd_ssim_parms_8x8_c);
+    SET_ONLY_C(svt_av1_get_crc32c_value, svt_av1_get_crc32c_value_c);
+    SET_ONLY_C(svt_av1_generate_block_2x2_hash_row, svt_av1_generate_block_2x2_hash_row_c);
 #endif
 
     if(0 == flags)
@@ -911,6 +911,14 @@ extern "C" {
     double svt_ssim_8x8_hbd_c(const uint16_t* s, uint32_t sp, const uint16_t* r, uint32_t rp);
     RTCD_EXTERN double (*svt_ssim_4x4_hbd)(const uint16_t* s, uint32_t sp, const uint16_t* r, uint32_t rp);
     double svt_ssim_4x4_hbd_c(const uint16_t* s, uint32_t sp, const uint16_t* r, uint32_t rp);
+    RTCD_EXTERN void (*svt_aom_ssim_parms_8x8)(const uint8_t *s, int sp, const uint8_t *r, int rp, uint32_t *sum_s, uint32_t *sum_r, uint32_t *sum_sq_s, uint32_t *sum_sq_r, uint32_t *sum_sxr);
+    void svt_aom_ssim_parms_8x8_c(const uint8_t *s, int sp, const uint8_t *r, int rp, uint32_t *sum_s, uint32_t *sum_r, uint32_t *sum_sq_s, uint32_t *sum_sq_r, uint32_t *sum_sxr);
+    RTCD_EXTERN void (*svt_aom_highbd_ssim_parms_8x8)(const uint8_t *s, int sp, const uint8_t *sinc, int spinc, const uint16_t *r, int rp, uint32_t *sum_s, uint32_t *sum_r, uint32_t *sum_sq_s, uint32_t *sum_sq_r, uint32_t *sum_sxr);
+    void svt_aom_highbd_ssim_parms_8x8_c(const uint8_t *s, int sp, const uint8_t *sinc, int spinc, const uint16_t *r, int rp, uint32_t *sum_s, uint32_t *sum_r, uint32_t *sum_sq_s, uint32_t *sum_sq_r, uint32_t *sum_sxr);
+    RTCD_EXTERN uint32_t (*svt_av1_get_crc32c_value)(const uint8_t *p, size_t length);
+    uint32_t svt_av1_get_crc32c_value_c(const uint8_t *p, size_t length);
+    RTCD_EXTERN void (*svt_av1_generate_block_2x2_hash_row)(const uint8_t *src, int stride, int width, CRC_CALCULATOR *crc_calculator, uint32_t *hash1, uint32_t *hash2, int8_t *row_same, int8_t *col_same);
+    void svt_av1_generate_block_2x2_hash_row_c(const uint8_t *src, int stride, int width, CRC_CALCULATOR *crc_calculator, uint32_t *hash1, uint32_t *hash2, int8_t *row_same, int8_t *col_same);
 
 #ifdef ARCH_AARCH64
     void svt_av1_calc_indices_dim1_neon(const int* data, const int* centroids, uint8_t* indices, int n, int k);
@@ -1359,6 +1367,12 @@ extern "C" {
     double svt_av1_compute_cross_correlation_sve(unsigned char *im1, int stride1, int x1, int y1, unsigned char *im2, int stride2, int x2, int y2, uint8_t match_sz);
 
     void svt_av1_calc_target_weighted_pred_left_neon(uint8_t is16bit, MacroBlockD *xd, int rel_mi_row, uint8_t nb_mi_height, MbModeInfo *nb_mi, void *fun_ctxt, const int num_planes);
+    void svt_aom_ssim_parms_8x8_neon(const uint8_t *s, int sp, const uint8_t *r, int rp, uint32_t *sum_s, uint32_t *sum_r, uint32_t *sum_sq_s, uint32_t *sum_sq_r, uint32_t *sum_sxr);
+    void svt_aom_highbd_ssim_parms_8x8_neon(const uint8_t *s, int sp, const uint8_t *sinc, int spinc, const uint16_t *r, int rp, uint32_t *sum_s, uint32_t *sum_r, uint32_t *sum_sq_s, uint32_t *sum_sq_r, uint32_t *sum_sxr);
+#if HAVE_ARM_CRC32
+    uint32_t svt_av1_get_crc32c_value_arm_crc32(const uint8_t *p, size_t length);
+    void svt_av1_generate_block_2x2_hash_row_arm_crc32(const uint8_t *src, int stride, int width, CRC_CALCULATOR *crc_calculator, uint32_t *hash1, uint32_t *hash2, int8_t *row_same, int8_t *col_same);
+#endif // HAVE_ARM_CRC32
 #endif
 
 #ifdef ARCH_X86_64
@@ -2197,6 +2211,12 @@ extern "C" {
     double svt_ssim_4x4_avx2(const uint8_t* s, uint32_t sp, const uint8_t* r, uint32_t rp);
     double svt_ssim_8x8_hbd_avx2(const uint16_t* s, uint32_t sp, const uint16_t* r, uint32_t rp);
     double svt_ssim_4x4_hbd_avx2(const uint16_t* s, uint32_t sp, const uint16_t* r, uint32_t rp);
+    void svt_aom_ssim_parms_8x8_avx2(const uint8_t *s, int sp, const uint8_t *r, int rp, uint32_t *sum_s, uint32_t *sum_r, uint32_t *sum_sq_s, uint32_t *sum_sq_r, uint32_t *sum_sxr);
+    void svt_aom_ssim_parms_8x8_avx512(const uint8_t *s, int sp, const uint8_t *r, int rp, uint32_t *sum_s, uint32_t *sum_r, uint32_t *sum_sq_s, uint32_t *sum_sq_r, uint32_t *sum_sxr);
+    void svt_aom_highbd_ssim_parms_8x8_avx2(const uint8_t *s, int sp, const uint8_t *sinc, int spinc, const uint16_t *r, int rp, uint32_t *sum_s, uint32_t *sum_r, uint32_t *sum_sq_s, uint32_t *sum_sq_r, uint32_t *sum_sxr);
+    void svt_aom_highbd_ssim_parms_8x8_avx512(const uint8_t *s, int sp, const uint8_t *sinc, int spinc, const uint16_t *r, int rp, uint32_t *sum_s, uint32_t *sum_r, uint32_t *sum_sq_s, uint32_t *sum_sq_r, uint32_t *sum_sxr);
+    uint32_t svt_av1_get_crc32c_value_sse4_2(const uint8_t *p, size_t length);
+    void svt_av1_generate_block_2x2_hash_row_sse4_2(const uint8_t *src, int stride, int width, CRC_CALCULATOR *crc_calculator, uint32_t *hash1, uint32_t *hash2, int8_t *row_same, int8_t *col_same);
 #endif
 
     /* Moved to aom_dsp_rtcd.c file:
@@ -32,8 +32,10 @@ static void output_bitstream_unit_dctor(EbPtr p) {
 EbErrorType svt_aom_output_bitstream_unit_ctor(OutputBitstreamUnit *bitstream_ptr, uint32_t buffer_size) {
     bitstream_ptr->dctor = output_bitstream_unit_dctor;
     if (buffer_size) {
-        bitstream_ptr->size = buffer_size;
+        bitstream_ptr->size                  = buffer_size;
+        const SvtAv1MemCategory mem_category = svt_mem_set_category(SVT_AV1_MEM_BITSTREAM);
         EB_MALLOC_ARRAY(bitstream_ptr->buffer_begin_av1, bitstream_ptr->size);
+        svt_mem_set_category(mem_category);
         bitstream_ptr->buffer_av1 = bitstream_ptr->buffer_begin_av1;
     } else {
         bitstream_ptr->size             = 0;
@@ -19,12 +19,14 @@
 #include "svt_threads.h"
 #include "reference_object.h"
 #include "enc_cdef.h"
+#include "deblocking_filter.h"
 #include "enc_dec_process.h"
 #include "pic_buffer_desc.h"
 #include "sequence_control_set.h"
 #include "utility.h"
 #include "pcs.h"
 #include "resize.h"
+#include "svt_trace.h"
 
 void svt_aom_copy_sb8_16(uint16_t *dst, int32_t dstride, const uint8_t *src, int32_t src_voffset, int32_t src_hoffset,
                          int32_t sstride, int32_t vsize, int32_t hsize, bool is_16bit);
@@ -426,6 +428,13 @@ void *svt_aom_cdef_kernel(void *input_ptr) {
 
         dlf_results                   = (DlfResults *)dlf_results_wrapper->object_ptr;
         pcs                           = (PictureControlSet *)dlf_results->pcs_wrapper->object_ptr;
+        if (dlf_results->task_type == DLF_TASK_LF_JOBS) {
+            SVT_TRACE_TASK("DLF", pcs->picture_number, -1);
+            svt_av1_loop_filter_run_jobs(pcs, dlf_results->lf_pass);
+            svt_release_object(dlf_results_wrapper);
+            continue;
+        }
+        SVT_TRACE_TASK("CDEF", pcs->picture_number, (int32_t)dlf_results->segment_index);
         PictureParentControlSet *ppcs = pcs->ppcs;
         scs                           = pcs->scs;
 
@@ -20,6 +20,7 @@
 
 #define RTCD_C
 #include "common_dsp_rtcd.h"
+#include "rtcd_profile.h"
 #include "pic_operators.h"
 #include "pack_unpack_c.h"
 #include "utility.h"
@@ -359,6 +360,7 @@ EbCpuFlags svt_aom_get_cpu_flags_to_use() {
         }                                                                                         \
         ptr = c;                                                                                  \
         SET_FUNCTIONS_X86(ptr, c, mmx, sse, sse2, sse3, ssse3, sse4_1, sse4_2, avx, avx2, avx512) \
+        RTCD_PROFILE_REGISTER(ptr, c);                                                            \
     } while (0)
 #else
 #define SET_FUNCTIONS(ptr, c, mmx, sse, sse2, sse3, ssse3, sse4_1, sse4_2, avx, avx2, avx512)     \
@@ -373,6 +375,7 @@ EbCpuFlags svt_aom_get_cpu_flags_to_use() {
         }                                                                                         \
         ptr = c;                                                                                  \
         SET_FUNCTIONS_X86(ptr, c, mmx, sse, sse2, sse3, ssse3, sse4_1, sse4_2, avx, avx2, avx512) \
+        RTCD_PROFILE_REGISTER(ptr, c);                                                            \
     } while (0)
 #endif
 #elif defined ARCH_AARCH64
@@ -389,6 +392,7 @@ EbCpuFlags svt_aom_get_cpu_flags_to_use() {
         }                                                                                         \
         ptr = c;                                                                                  \
         SET_FUNCTIONS_AARCH64(ptr, c, neon, neon_dotprod, neon_i8mm, sve, sve2)                         \
+        RTCD_PROFILE_REGISTER(ptr, c);                                                                  \
     } while (0)
 #else
 #define SET_FUNCTIONS(ptr, c, neon, neon_dotprod, neon_i8mm, sve, sve2)                                      \
@@ -403,6 +407,7 @@ EbCpuFlags svt_aom_get_cpu_flags_to_use() {
         }                                                                                         \
         ptr = c;                                                                                  \
         SET_FUNCTIONS_AARCH64(ptr, c, neon, neon_dotprod, neon_i8mm, sve, sve2)                              \
+        RTCD_PROFILE_REGISTER(ptr, c);                                                                       \
     } while (0)
 #endif
 #else
@@ -418,6 +423,7 @@ EbCpuFlags svt_aom_get_cpu_flags_to_use() {
             assert(0);                                                                            \
         }                                                                                         \
         ptr = c;                                                                                  \
+        RTCD_PROFILE_REGISTER(ptr, c);                                                            \
     } while (0)
 #else
 #define SET_FUNCTIONS(ptr, c)                                                                     \
@@ -431,6 +437,7 @@ EbCpuFlags svt_aom_get_cpu_flags_to_use() {
             assert(0);                                                                            \
         }                                                                                         \
         ptr = c;                                                                                  \
+        RTCD_PROFILE_REGISTER(ptr, c);                                                            \
     } while (0)
 #endif
 #endif
@@ -20,6 +20,8 @@
 #include "sequence_control_set.h"
 #include "reference_object.h"
 #include "common_utils.h"
+#include "enc_dec_results.h"
+#include "svt_threads.h"
 //#include "svt_log.h"
 #define DLF_MAX_LVL 4
 const int32_t  inter_frame_multiplier[INPUT_SIZE_COUNT]      = {6017, 6017, 6017, 12034, 12034, 12034, 12034};
@@ -540,18 +542,8 @@ void svt_av1_filter_block_plane_horz(const PictureControlSet *const pcs, const i
         }
     }
 }
-/*************************************************************************************************
-* svt_aom_loop_filter_sb
-* Loop over all superblocks in the picture and filter each superblock
-*************************************************************************************************/
-void svt_aom_loop_filter_sb(EbPictureBufferDesc *frame_buffer, //reconpicture,
-                            //Yv12BufferConfig *frame_buffer,
-                            PictureControlSet *pcs, int32_t mi_row, int32_t mi_col, int32_t plane_start,
-                            int32_t plane_end, uint8_t last_col) {
-    FrameHeader            *frm_hdr = &pcs->ppcs->frm_hdr;
-    struct MacroblockdPlane pd[3];
-    int32_t                 plane;
-
+static void init_lf_planes(struct MacroblockdPlane pd[3], const EbPictureBufferDesc *frame_buffer,
+                           const PictureControlSet *pcs) {
     pd[0].subsampling_x = 0;
     pd[0].subsampling_y = 0;
     pd[0].plane_type    = PLANE_TYPE_Y;
@@ -567,6 +559,20 @@ void svt_aom_loop_filter_sb(EbPictureBufferDesc *frame_buffer, //reconpicture,
 
     if (pcs->ppcs->scs->is_16bit_pipeline)
         pd[0].is_16bit = pd[1].is_16bit = pd[2].is_16bit = true;
+}
+/*************************************************************************************************
+* svt_aom_loop_filter_sb
+* Loop over all superblocks in the picture and filter each superblock
+*************************************************************************************************/
+void svt_aom_loop_filter_sb(EbPictureBufferDesc *frame_buffer, //reconpicture,
+                            //Yv12BufferConfig *frame_buffer,
+                            PictureControlSet *pcs, int32_t mi_row, int32_t mi_col, int32_t plane_start,
+                            int32_t plane_end, uint8_t last_col) {
+    FrameHeader            *frm_hdr = &pcs->ppcs->frm_hdr;
+    struct MacroblockdPlane pd[3];
+    int32_t                 plane;
+
+    init_lf_planes(pd, frame_buffer, pcs);
 
     for (plane = plane_start; plane < plane_end; plane++) {
         if (plane == 0 && !(frm_hdr->loop_filter_params.filter_level[0]) &&
@@ -617,39 +623,149 @@ void svt_aom_loop_filter_sb(EbPictureBufferDesc *frame_buffer, //reconpicture,
         }
     }
 }
+static uint64_t picture_sse_band(PictureControlSet *pcs, EbPictureBufferDesc *recon_ptr, int32_t plane,
+                                 uint32_t x_start, uint32_t x_end);
+static void     copy_band(EbPictureBufferDesc *src, EbPictureBufferDesc *dst, PictureControlSet *pcs, int32_t plane,
+                          uint32_t x_start, uint32_t x_end);
+
+/*************************************************************************************************
+* lf_run_job
+* Filter the vertical edges of an SB row, or the horizontal edges of an SB column. A vertical
+* edge only changes the samples of its row and a horizontal edge those of its column, so once
+* all the rows are done the columns can be filtered in any order, giving the SB order result.
+*************************************************************************************************/
+static void lf_run_job(PictureControlSet *pcs, DlfJobs *jobs, uint32_t job) {
+    SequenceControlSet *scs              = pcs->scs;
+    FrameHeader        *frm_hdr          = &pcs->ppcs->frm_hdr;
+    const uint8_t       sb_size_log2     = (uint8_t)svt_log2f(scs->sb_size);
+    const uint32_t      pic_width_in_sb  = (pcs->ppcs->aligned_width + scs->sb_size - 1) / scs->sb_size;
+    const uint32_t      pic_height_in_sb = (pcs->ppcs->aligned_height + scs->sb_size - 1) / scs->sb_size;
+    const uint32_t      sb_count         = jobs->horz ? pic_height_in_sb : pic_width_in_sb;
+    struct MacroblockdPlane pd[3];
+
+    init_lf_planes(pd, jobs->frame_buffer, pcs);
+    for (int32_t plane = jobs->plane_start; plane < jobs->plane_end; plane++) {
+        if (plane == 0 && !(frm_hdr->loop_filter_params.filter_level[0]) &&
+            !(frm_hdr->loop_filter_params.filter_level[1]))
+            break;
+        else if (plane == 1 && !(frm_hdr->loop_filter_params.filter_level_u))
+            continue;
+        else if (plane == 2 && !(frm_hdr->loop_filter_params.filter_level_v))
+            continue;
+
+        for (uint32_t i = 0; i < sb_count; i++) {
+            const int32_t mi_row = (int32_t)((jobs->horz ? i : job) << sb_size_log2) >> 2;
+            const int32_t mi_col = (int32_t)((jobs->horz ? job : i) << sb_size_log2) >> 2;
+            svt_av1_setup_dst_planes(
+                pcs, pd, scs->seq_header.sb_size, jobs->frame_buffer, mi_row, mi_col, plane, plane + 1);
+            if (jobs->horz)
+                svt_av1_filter_block_plane_horz(pcs, plane, &pd[plane], mi_row, mi_col);
+            else
+                svt_av1_filter_block_plane_vert(pcs, plane, &pd[plane], mi_row, mi_col);
+        }
+    }
+    if (jobs->horz && jobs->sse_plane >= 0) {
+        const uint32_t ss_x    = jobs->sse_plane ? scs->subsampling_x : 0;
+        const uint32_t x_start = (job << sb_size_log2) >> ss_x;
+        const uint32_t x_end   = ((job + 1) << sb_size_log2) >> ss_x;
+        svt_atomic_fetch_add_u64(&jobs->sse,
+                                 picture_sse_band(pcs, jobs->frame_buffer, jobs->sse_plane, x_start, x_end));
+        if (jobs->restore_buffer)
+            copy_band(jobs->restore_buffer, jobs->frame_buffer, pcs, jobs->sse_plane, x_start, x_end);
+    }
+}
+
+static void lf_take_jobs(PictureControlSet *pcs, DlfJobs *jobs) {
+    int32_t job;
+    while ((job = svt_atomic_fetch_add_i32(&jobs->next_job, 1)) < (int32_t)jobs->job_count)
+        lf_run_job(pcs, jobs, (uint32_t)job);
+}
+
+/*************************************************************************************************
+* svt_av1_loop_filter_run_jobs
+* Help with the jobs of deblocking pass lf_pass, if it is still running and has jobs left
+*************************************************************************************************/
+void svt_av1_loop_filter_run_jobs(PictureControlSet *pcs, uint32_t lf_pass) {
+    DlfJobs *jobs = &pcs->dlf_jobs;
+
+    svt_block_on_mutex(jobs->mutex);
+    const bool join = lf_pass == jobs->pass && jobs->next_job < (int32_t)jobs->job_count;
+    if (join)
+        jobs->active_helpers++;
+    svt_release_mutex(jobs->mutex);
+    if (!join)
+        return;
+
+    lf_take_jobs(pcs, jobs);
+
+    svt_block_on_mutex(jobs->mutex);
+    const bool last_helper = --jobs->active_helpers == 0 && jobs->waiting;
+    if (last_helper)
+        jobs->waiting = false;
+    svt_release_mutex(jobs->mutex);
+    if (last_helper)
+        svt_post_semaphore(jobs->done_semaphore);
+}
+
+/*************************************************************************************************
+* loop_filter_pass
+* Run a deblocking pass over the frame, with the help of the CDEF processes when a helper fifo is
+* set. Only the helpers which joined the pass are waited for, the ones dequeued after it is over
+* return at once. Returns the sse of sse_plane after the pass.
+*************************************************************************************************/
+static uint64_t loop_filter_pass(PictureControlSet *pcs, EbPictureBufferDesc *frame_buffer, int32_t plane_start,
+                                 int32_t plane_end, bool horz, int32_t sse_plane,
+                                 EbPictureBufferDesc *restore_buffer) {
+    SequenceControlSet *scs  = pcs->scs;
+    DlfJobs            *jobs = &pcs->dlf_jobs;
+
+    svt_block_on_mutex(jobs->mutex);
+    jobs->frame_buffer   = frame_buffer;
+    jobs->plane_start    = plane_start;
+    jobs->plane_end      = plane_end;
+    jobs->horz           = horz;
+    jobs->sse_plane      = sse_plane;
+    jobs->restore_buffer = restore_buffer;
+    jobs->sse            = 0;
+    jobs->job_count      = horz ? (pcs->ppcs->aligned_width + scs->sb_size - 1) / scs->sb_size
+                                : (pcs->ppcs->aligned_height + scs->sb_size - 1) / scs->sb_size;
+    jobs->next_job       = 0;
+    svt_release_mutex(jobs->mutex);
+
+    const uint32_t helper_count = jobs->helper_fifo ? AOMMIN(jobs->helper_max, jobs->job_count - 1) : 0;
+    for (uint32_t i = 0; i < helper_count; i++) {
+        EbObjectWrapper *dlf_results_wrapper;
+        svt_get_empty_object(jobs->helper_fifo, &dlf_results_wrapper);
+        DlfResults *dlf_results    = (DlfResults *)dlf_results_wrapper->object_ptr;
+        dlf_results->pcs_wrapper   = jobs->pcs_wrapper;
+        dlf_results->segment_index = 0;
+        dlf_results->task_type     = DLF_TASK_LF_JOBS;
+        dlf_results->lf_pass       = jobs->pass;
+        svt_post_full_object(dlf_results_wrapper);
+    }
+    lf_take_jobs(pcs, jobs);
+
+    // All the jobs are taken: close the pass and wait for the helpers still filtering
+    svt_block_on_mutex(jobs->mutex);
+    jobs->pass++;
+    const bool wait = jobs->active_helpers > 0;
+    jobs->waiting   = wait;
+    svt_release_mutex(jobs->mutex);
+    if (wait)
+        svt_block_on_semaphore(jobs->done_semaphore);
+    return jobs->sse;
+}
+
 /*************************************************************************************************
 * svt_av1_loop_filter_frame
 * Apply loop filtering to the frame based on the selected loop filter parameters
 *************************************************************************************************/
 void svt_av1_loop_filter_frame(EbPictureBufferDesc *frame_buffer, PictureControlSet *pcs, int32_t plane_start,
                                int32_t plane_end) {
-    SequenceControlSet *scs = pcs->scs;
-    //SuperBlock                     *sb_ptr;
-    //uint16_t                                   sb_index;
-    uint8_t  sb_size_log2 = (uint8_t)svt_log2f(scs->sb_size);
-    uint32_t x_sb_index;
-    uint32_t y_sb_index;
-    uint32_t sb_origin_x;
-    uint32_t sb_origin_y;
-    bool     end_of_row_flag;
-
-    uint32_t pic_width_in_sb      = (pcs->ppcs->aligned_width + scs->sb_size - 1) / scs->sb_size;
-    uint32_t picture_height_in_sb = (pcs->ppcs->aligned_height + scs->sb_size - 1) / scs->sb_size;
-
     svt_av1_loop_filter_frame_init(&pcs->ppcs->frm_hdr, &pcs->ppcs->lf_info, plane_start, plane_end);
 
-    for (y_sb_index = 0; y_sb_index < picture_height_in_sb; ++y_sb_index) {
-        for (x_sb_index = 0; x_sb_index < pic_width_in_sb; ++x_sb_index) {
-            //sb_index        = (uint16_t)(y_sb_index * pic_width_in_sb + x_sb_index);
-            //sb_ptr          = pcs->sb_ptr_array[sb_index];
-            sb_origin_x     = x_sb_index << sb_size_log2;
-            sb_origin_y     = y_sb_index << sb_size_log2;
-            end_of_row_flag = (x_sb_index == pic_width_in_sb - 1) ? true : false;
-
-            svt_aom_loop_filter_sb(
-                frame_buffer, pcs, sb_origin_y >> 2, sb_origin_x >> 2, plane_start, plane_end, end_of_row_flag);
-        }
-    }
+    loop_filter_pass(pcs, frame_buffer, plane_start, plane_end, false, -1, NULL);
+    loop_filter_pass(pcs, frame_buffer, plane_start, plane_end, true, -1, NULL);
 }
 
 void svt_copy_buffer(EbPictureBufferDesc *srcBuffer, EbPictureBufferDesc *dstBuffer, PictureControlSet *pcs,
@@ -713,9 +829,41 @@ void svt_copy_buffer(EbPictureBufferDesc *srcBuffer, EbPictureBufferDesc *dstBuf
         }
     }
 }
-uint64_t picture_sse_calculations(PictureControlSet *pcs, EbPictureBufferDesc *recon_ptr, int32_t plane) {
+/*************************************************************************************************
+* copy_band
+* Copy the columns [x_start, x_end) of a plane, over the area svt_copy_buffer() copies
+*************************************************************************************************/
+static void copy_band(EbPictureBufferDesc *src, EbPictureBufferDesc *dst, PictureControlSet *pcs, int32_t plane,
+                      uint32_t x_start, uint32_t x_end) {
+    const bool     is_16bit = pcs->ppcs->scs->is_16bit_pipeline;
+    const uint32_t ss       = plane ? 1 : 0;
+    const uint32_t width    = ALIGN_POWER_OF_TWO(src->width, 3) >> ss;
+    const uint32_t height   = ALIGN_POWER_OF_TWO(src->height, 3) >> ss;
+    if (x_start >= width)
+        return;
+    x_end = AOMMIN(x_end, width);
+
+    uint8_t       *dst_buf = plane == 0 ? dst->buffer_y : plane == 1 ? dst->buffer_cb : dst->buffer_cr;
+    const uint8_t *src_buf = plane == 0 ? src->buffer_y : plane == 1 ? src->buffer_cb : src->buffer_cr;
+    const uint32_t stride  = plane == 0 ? src->stride_y : plane == 1 ? src->stride_cb : src->stride_cr;
+    const uint32_t offset  = ((src->org_x >> ss) + x_start + (src->org_y >> ss) * stride) << is_16bit;
+
+    for (uint32_t row = 0; row < height; row++)
+        svt_memcpy(dst_buf + offset + (row * stride << is_16bit),
+                   src_buf + offset + (row * stride << is_16bit),
+                   (x_end - x_start) << is_16bit);
+}
+
+/*************************************************************************************************
+* picture_sse_band
+* Compute the sse of the columns [x_start, x_end) of a plane
+*************************************************************************************************/
+static uint64_t picture_sse_band(PictureControlSet *pcs, EbPictureBufferDesc *recon_ptr, int32_t plane,
+                                 uint32_t x_start, uint32_t x_end) {
     SequenceControlSet *scs      = pcs->ppcs->scs;
     bool                is_16bit = scs->is_16bit_pipeline;
+    const uint32_t      ss_x     = plane ? scs->subsampling_x : 0;
+    const uint32_t      ss_y     = plane ? scs->subsampling_y : 0;
 
     // svt_spatial_full_distortion_kernel note:
     // intrinsic optimization require width and height in 4 pixel aligned.
@@ -723,113 +871,49 @@ uint64_t picture_sse_calculations(PictureControlSet *pcs, EbPictureBufferDesc *r
     // here uses aligned_width and aligned_height to avoid wrong sse results.
     // if encoding in non-scaled frame, aligned_width and aligned_height equals
     // frame width and height, it has no effect to original resolution
-    const uint16_t input_align_width  = pcs->ppcs->aligned_width;
-    const uint16_t input_align_height = pcs->ppcs->aligned_height;
-    const uint32_t ss_x               = scs->subsampling_x;
-    const uint32_t ss_y               = scs->subsampling_y;
+    EbPictureBufferDesc *input_pic = is_16bit ? pcs->input_frame16bit
+                                              : (EbPictureBufferDesc *)pcs->ppcs->enhanced_pic;
+    const uint32_t       width  = is_16bit ? (uint32_t)(input_pic->width + ss_x) >> ss_x
+                                               : (uint32_t)pcs->ppcs->aligned_width >> ss_x;
+    const uint32_t       height = is_16bit ? (uint32_t)(input_pic->height + ss_y) >> ss_y
+                                               : (uint32_t)pcs->ppcs->aligned_height >> ss_y;
+    if (x_start >= width)
+        return 0;
+    x_end = AOMMIN(x_end, width);
 
     uint8_t *input_buffer;
     uint8_t *recon_coeff_buffer;
-
-    if (!is_16bit) {
-        EbPictureBufferDesc *input_pic = (EbPictureBufferDesc *)pcs->ppcs->enhanced_pic;
-
-        if (plane == 0) {
-            recon_coeff_buffer = (uint8_t *)&(
-                (recon_ptr->buffer_y)[recon_ptr->org_x + recon_ptr->org_y * recon_ptr->stride_y]);
-            input_buffer = (uint8_t *)&(
-                (input_pic->buffer_y)[input_pic->org_x + input_pic->org_y * input_pic->stride_y]);
-
-            return svt_spatial_full_distortion_kernel(input_buffer,
-                                                      0,
-                                                      input_pic->stride_y,
-                                                      recon_coeff_buffer,
-                                                      0,
-                                                      recon_ptr->stride_y,
-                                                      input_align_width,
-                                                      input_align_height);
-        } else if (plane == 1) {
-            recon_coeff_buffer = (uint8_t *)&(
-                (recon_ptr->buffer_cb)[recon_ptr->org_x / 2 + recon_ptr->org_y / 2 * recon_ptr->stride_cb]);
-            input_buffer = (uint8_t *)&(
-                (input_pic->buffer_cb)[input_pic->org_x / 2 + input_pic->org_y / 2 * input_pic->stride_cb]);
-
-            return svt_spatial_full_distortion_kernel(input_buffer,
-                                                      0,
-                                                      input_pic->stride_cb,
-                                                      recon_coeff_buffer,
-                                                      0,
-                                                      recon_ptr->stride_cb,
-                                                      input_align_width >> ss_x,
-                                                      input_align_height >> ss_y);
-        } else if (plane == 2) {
-            recon_coeff_buffer = (uint8_t *)&(
-                (recon_ptr->buffer_cr)[recon_ptr->org_x / 2 + recon_ptr->org_y / 2 * recon_ptr->stride_cr]);
-            input_buffer = (uint8_t *)&(
-                (input_pic->buffer_cr)[input_pic->org_x / 2 + input_pic->org_y / 2 * input_pic->stride_cr]);
-
-            return svt_spatial_full_distortion_kernel(input_buffer,
-                                                      0,
-                                                      input_pic->stride_cr,
-                                                      recon_coeff_buffer,
-                                                      0,
-                                                      recon_ptr->stride_cr,
-                                                      input_align_width >> ss_x,
-                                                      input_align_height >> ss_y);
-        }
-        return 0;
+    uint32_t input_stride;
+    uint32_t recon_stride;
+    if (plane == 0) {
+        input_stride       = input_pic->stride_y;
+        recon_stride       = recon_ptr->stride_y;
+        input_buffer       = input_pic->buffer_y;
+        recon_coeff_buffer = recon_ptr->buffer_y;
+    } else if (plane == 1) {
+        input_stride       = input_pic->stride_cb;
+        recon_stride       = recon_ptr->stride_cb;
+        input_buffer       = input_pic->buffer_cb;
+        recon_coeff_buffer = recon_ptr->buffer_cb;
     } else {
-        EbPictureBufferDesc *input_pic = (EbPictureBufferDesc *)pcs->input_frame16bit;
-
-        if (plane == 0) {
-            recon_coeff_buffer = (uint8_t *)&(
-                (recon_ptr->buffer_y)[(recon_ptr->org_x + recon_ptr->org_y * recon_ptr->stride_y) << is_16bit]);
-            input_buffer = (uint8_t *)&(
-                (input_pic->buffer_y)[(input_pic->org_x + input_pic->org_y * input_pic->stride_y) << is_16bit]);
-
-            return svt_full_distortion_kernel16_bits(input_buffer,
-                                                     0,
-                                                     input_pic->stride_y,
-                                                     recon_coeff_buffer,
-                                                     0,
-                                                     recon_ptr->stride_y,
-                                                     input_pic->width,
-                                                     input_pic->height);
-        } else if (plane == 1) {
-            recon_coeff_buffer = (uint8_t *)&(
-                (recon_ptr
-                     ->buffer_cb)[(recon_ptr->org_x / 2 + recon_ptr->org_y / 2 * recon_ptr->stride_cb) << is_16bit]);
-            input_buffer = (uint8_t *)&(
-                (input_pic
-                     ->buffer_cb)[(input_pic->org_x / 2 + input_pic->org_y / 2 * input_pic->stride_cb) << is_16bit]);
-
-            return svt_full_distortion_kernel16_bits(input_buffer,
-                                                     0,
-                                                     input_pic->stride_cb,
-                                                     recon_coeff_buffer,
-                                                     0,
-                                                     recon_ptr->stride_cb,
-                                                     (input_pic->width + ss_x) >> ss_x,
-                                                     (input_pic->height + ss_y) >> ss_y);
-        } else if (plane == 2) {
-            recon_coeff_buffer = (uint8_t *)&(
-                (recon_ptr
-                     ->buffer_cr)[(recon_ptr->org_x / 2 + recon_ptr->org_y / 2 * recon_ptr->stride_cr) << is_16bit]);
-            input_buffer = (uint8_t *)&(
-                (input_pic
-                     ->buffer_cr)[(input_pic->org_x / 2 + input_pic->org_y / 2 * input_pic->stride_cr) << is_16bit]);
-
-            return svt_full_distortion_kernel16_bits(input_buffer,
-                                                     0,
-                                                     input_pic->stride_cr,
-                                                     recon_coeff_buffer,
-                                                     0,
-                                                     recon_ptr->stride_cr,
-                                                     (input_pic->width + ss_x) >> ss_x,
-                                                     (input_pic->height + ss_y) >> ss_y);
-        }
-        return 0;
+        input_stride       = input_pic->stride_cr;
+        recon_stride       = recon_ptr->stride_cr;
+        input_buffer       = input_pic->buffer_cr;
+        recon_coeff_buffer = recon_ptr->buffer_cr;
     }
+    const uint32_t ss = plane ? 1 : 0;
+    input_buffer += ((input_pic->org_x >> ss) + x_start + (input_pic->org_y >> ss) * input_stride) << is_16bit;
+    recon_coeff_buffer += ((recon_ptr->org_x >> ss) + x_start + (recon_ptr->org_y >> ss) * recon_stride) << is_16bit;
+
+    if (!is_16bit)
+        return svt_spatial_full_distortion_kernel(
+            input_buffer, 0, input_stride, recon_coeff_buffer, 0, recon_stride, x_end - x_start, height);
+    return svt_full_distortion_kernel16_bits(
+        input_buffer, 0, input_stride, recon_coeff_buffer, 0, recon_stride, x_end - x_start, height);
+}
+
+uint64_t picture_sse_calculations(PictureControlSet *pcs, EbPictureBufferDesc *recon_ptr, int32_t plane) {
+    return picture_sse_band(pcs, recon_ptr, plane, 0, UINT32_MAX);
 }
 /*************************************************************************************************
 * try_filter_frame
@@ -867,14 +951,19 @@ static int64_t try_filter_frame(
     case 2: frm_hdr->loop_filter_params.filter_level_v = filter_level[0]; break;
     }
 
-    svt_av1_loop_filter_frame(recon_buffer, pcs, plane, plane + 1);
-
-    filt_err = picture_sse_calculations(pcs, recon_buffer, plane);
-
-    // Re-instate the unfiltered frame; if both filters are off, no need to copy as there was no change to the pic
-    if (filter_level[0] || filter_level[1])
-        svt_copy_buffer(
-            temp_lf_recon_buffer /*cpi->last_frame_uf*/, recon_buffer /*cm->frame_to_show*/, pcs, (uint8_t)plane);
+    svt_av1_loop_filter_frame_init(frm_hdr, &pcs->ppcs->lf_info, plane, plane + 1);
+    loop_filter_pass(pcs, recon_buffer, plane, plane + 1, false, -1, NULL);
+
+    // The horizontal pass computes the filtering sse of each SB column once it is filtered, then
+    // re-instates the unfiltered column; if both filters are off, no need to copy as there was no
+    // change to the pic
+    filt_err = loop_filter_pass(pcs,
+                                recon_buffer,
+                                plane,
+                                plane + 1,
+                                true,
+                                plane,
+                                filter_level[0] || filter_level[1] ? temp_lf_recon_buffer : NULL);
 
     return filt_err;
 }
@@ -50,6 +50,7 @@ void svt_av1_loop_filter_frame(
         PictureControlSet *pcs,
         /*MacroBlockD *xd,*/ int32_t plane_start, int32_t plane_end/*,
         int32_t partial_frame*/);
+void     svt_av1_loop_filter_run_jobs(PictureControlSet *pcs, uint32_t lf_pass);
 uint64_t picture_sse_calculations(PictureControlSet *pcs, EbPictureBufferDesc *recon_ptr, int32_t plane);
 
 EbErrorType svt_av1_pick_filter_level(EbPictureBufferDesc *srcBuffer, // source input
@@ -2037,11 +2037,9 @@ static const EbWarpedMotionParams default_warp_params = {
 
 #define MAX_BITS_PER_FRAME            8000000
 
-#define SC_FRAMES_TO_IGNORE     1000 // The speed control algorith starts after SC_FRAMES_TO_IGNORE number frames.
-#define SC_FRAMES_INTERVAL_SPEED      60 // The speed control Interval To Check the speed
-#define SC_FRAMES_INTERVAL_T1         60 // The speed control Interval Threshold1
-#define SC_FRAMES_INTERVAL_T2        180 // The speed control Interval Threshold2
-#define SC_FRAMES_INTERVAL_T3        120 // The speed control Interval Threshold3
+#define SC_KEEP_UP_PCT          95 // The speed control keeps up when the output rate reaches SC_KEEP_UP_PCT % of the frame rate
+#define SC_PROBE_WAIT_MIN        2 // The speed control checks to keep up before trying a slower preset
+#define SC_PROBE_WAIT_MAX       32 // The speed control max checks to keep up, after slower presets failed
 
 #define LAST_BWD_FRAME     8
 #define LAST_ALT_FRAME    16
@@ -2136,7 +2134,6 @@ typedef uint8_t EbModeType;
 #define INTRA_MODE 2
 
 #define INVALID_MODE 0xFFu
-#define SPEED_CONTROL_INIT_MOD ENC_M5;
 typedef enum ATTRIBUTE_PACKED {
     REF_LIST_0 = 0,
     REF_LIST_1 = 1,
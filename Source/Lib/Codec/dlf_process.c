@@ -20,6 +20,7 @@
 #include "sequence_control_set.h"
 #include "pcs.h"
 #include "aom_dsp_rtcd.h"
+#include "svt_trace.h"
 void svt_aom_get_recon_pic(PictureControlSet *pcs, EbPictureBufferDesc **recon_ptr, bool is_highbd);
 void svt_av1_loop_restoration_save_boundary_lines(const Yv12BufferConfig *frame, Av1Common *cm, int32_t after_cdef);
 void svt_convert_pic_8bit_to_16bit(EbPictureBufferDesc *src_8bit, EbPictureBufferDesc *dst_16bit, uint16_t ss_x,
@@ -74,6 +75,7 @@ void *svt_aom_dlf_kernel(void *input_ptr) {
 
         enc_dec_results               = (EncDecResults *)enc_dec_results_wrapper->object_ptr;
         pcs                           = (PictureControlSet *)enc_dec_results->pcs_wrapper->object_ptr;
+        SVT_TRACE_TASK("DLF", pcs->picture_number, -1);
         PictureParentControlSet *ppcs = pcs->ppcs;
         scs                           = pcs->scs;
 
@@ -107,6 +109,10 @@ void *svt_aom_dlf_kernel(void *input_ptr) {
             EbPictureBufferDesc *recon_buffer;
             svt_aom_get_recon_pic(pcs, &recon_buffer, is_16bit);
             svt_av1_loop_filter_init(pcs);
+            // The CDEF processes help with the deblocking jobs of the picture
+            pcs->dlf_jobs.helper_fifo = context_ptr->dlf_output_fifo_ptr;
+            pcs->dlf_jobs.pcs_wrapper = enc_dec_results->pcs_wrapper;
+            pcs->dlf_jobs.helper_max  = scs->cdef_process_init_count > 1 ? scs->cdef_process_init_count : 0;
             svt_av1_pick_filter_level((EbPictureBufferDesc *)pcs->ppcs->enhanced_pic, pcs, LPF_PICK_FROM_FULL_IMAGE);
             if (pcs->zero_filt_sse == -1 &&
                 (frm_hdr->loop_filter_params.filter_level[0] || frm_hdr->loop_filter_params.filter_level[1])) {
@@ -128,6 +134,7 @@ void *svt_aom_dlf_kernel(void *input_ptr) {
                     !(frm_hdr->loop_filter_params.filter_level[0] || frm_hdr->loop_filter_params.filter_level[1])
                 ? 0
                 : (int32_t)(1000 - ((1000 * pcs->best_filt_sse) / pcs->zero_filt_sse));
+            pcs->dlf_jobs.helper_fifo = NULL;
         }
 
         //pre-cdef prep
@@ -172,6 +179,7 @@ void *svt_aom_dlf_kernel(void *input_ptr) {
             dlf_results                = (struct DlfResults *)dlf_results_wrapper->object_ptr;
             dlf_results->pcs_wrapper   = enc_dec_results->pcs_wrapper;
             dlf_results->segment_index = segment_index;
+            dlf_results->task_type     = DLF_TASK_CDEF_SEGMENT;
             // Post DLF Results
             svt_post_full_object(dlf_results_wrapper);
         }
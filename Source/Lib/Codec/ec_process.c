@@ -20,7 +20,9 @@
 #include "cabac_context_model.h"
 #include "svt_log.h"
 #include "common_dsp_rtcd.h"
+#include "svt_trace.h"
 void svt_av1_reset_loop_restoration(PictureControlSet *piCSetPtr, uint16_t tile_idx);
+void svt_aom_ssim_run_jobs(PictureControlSet *pcs);
 
 static void rest_context_dctor(EbPtr p) {
     EbThreadContext      *thread_ctx = (EbThreadContext *)p;
@@ -223,6 +225,13 @@ void *svt_aom_entropy_coding_kernel(void *input_ptr) {
 
         RestResults        *rest_results = (RestResults *)rest_results_wrapper->object_ptr;
         PictureControlSet  *pcs          = (PictureControlSet *)rest_results->pcs_wrapper->object_ptr;
+        if (rest_results->task_type == REST_TASK_SSIM_JOBS) {
+            SVT_TRACE_TASK("SSIM", pcs->picture_number, -1);
+            svt_aom_ssim_run_jobs(pcs);
+            svt_release_object(rest_results_wrapper);
+            continue;
+        }
+        SVT_TRACE_TASK("EntropyCoding", pcs->picture_number, (int32_t)rest_results->tile_index);
         SequenceControlSet *scs          = pcs->scs;
         // SB Constants
 
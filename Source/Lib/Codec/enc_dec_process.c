@@ -20,12 +20,16 @@
 #include "utility.h"
 //To fix warning C4013: 'svt_convert_16bit_to_8bit' undefined; assuming extern returning int
 #include "common_dsp_rtcd.h"
+#include "aom_dsp_rtcd.h"
 #include "rd_cost.h"
 #include "pd_process.h"
 #include "firstpass.h"
 #include "pic_analysis_process.h"
 #include "resize.h"
 #include "enc_mode_config.h"
+#include "svt_time.h"
+#include "svt_trace.h"
+#include "analysis_export.h"
 
 void svt_aom_get_recon_pic(PictureControlSet *pcs, EbPictureBufferDesc **recon_ptr, bool is_highbd);
 void copy_mv_rate(PictureControlSet *pcs, MdRateEstimationContext *dst_rate);
@@ -668,8 +672,8 @@ void svt_aom_recon_output(PictureControlSet *pcs, SequenceControlSet *scs) {
 // Calculate Frame SSIM
 /************************************/
 
-static void svt_aom_ssim_parms_8x8_c(const uint8_t *s, int sp, const uint8_t *r, int rp, uint32_t *sum_s,
-                                     uint32_t *sum_r, uint32_t *sum_sq_s, uint32_t *sum_sq_r, uint32_t *sum_sxr) {
+void svt_aom_ssim_parms_8x8_c(const uint8_t *s, int sp, const uint8_t *r, int rp, uint32_t *sum_s, uint32_t *sum_r,
+                              uint32_t *sum_sq_s, uint32_t *sum_sq_r, uint32_t *sum_sxr) {
     int i, j;
     for (i = 0; i < 8; i++, s += sp, r += rp) {
         for (j = 0; j < 8; j++) {
@@ -682,9 +686,9 @@ static void svt_aom_ssim_parms_8x8_c(const uint8_t *s, int sp, const uint8_t *r,
     }
 }
 
-static void svt_aom_highbd_ssim_parms_8x8_c(const uint8_t *s, int sp, const uint8_t *sinc, int spinc, const uint16_t *r,
-                                            int rp, uint32_t *sum_s, uint32_t *sum_r, uint32_t *sum_sq_s,
-                                            uint32_t *sum_sq_r, uint32_t *sum_sxr) {
+void svt_aom_highbd_ssim_parms_8x8_c(const uint8_t *s, int sp, const uint8_t *sinc, int spinc, const uint16_t *r, int rp,
+                                     uint32_t *sum_s, uint32_t *sum_r, uint32_t *sum_sq_s, uint32_t *sum_sq_r,
+                                     uint32_t *sum_sxr) {
     int      i, j;
     uint32_t ss;
     for (i = 0; i < 8; i++, s += sp, sinc += spinc, r += rp) {
@@ -736,14 +740,14 @@ double similarity(uint32_t sum_s, uint32_t sum_r, uint32_t sum_sq_s, uint32_t su
 
 static double ssim_8x8(const uint8_t *s, int sp, const uint8_t *r, int rp) {
     uint32_t sum_s = 0, sum_r = 0, sum_sq_s = 0, sum_sq_r = 0, sum_sxr = 0;
-    svt_aom_ssim_parms_8x8_c(s, sp, r, rp, &sum_s, &sum_r, &sum_sq_s, &sum_sq_r, &sum_sxr);
+    svt_aom_ssim_parms_8x8(s, sp, r, rp, &sum_s, &sum_r, &sum_sq_s, &sum_sq_r, &sum_sxr);
     return similarity(sum_s, sum_r, sum_sq_s, sum_sq_r, sum_sxr, 64, 8);
 }
 
 static double highbd_ssim_8x8(const uint8_t *s, int sp, const uint8_t *sinc, int spinc, const uint16_t *r, int rp,
                               uint32_t bd, uint32_t shift) {
     uint32_t sum_s = 0, sum_r = 0, sum_sq_s = 0, sum_sq_r = 0, sum_sxr = 0;
-    svt_aom_highbd_ssim_parms_8x8_c(s, sp, sinc, spinc, r, rp, &sum_s, &sum_r, &sum_sq_s, &sum_sq_r, &sum_sxr);
+    svt_aom_highbd_ssim_parms_8x8(s, sp, sinc, spinc, r, rp, &sum_s, &sum_r, &sum_sq_s, &sum_sq_r, &sum_sxr);
     return similarity(sum_s >> shift,
                       sum_r >> shift,
                       sum_sq_s >> (2 * shift),
@@ -756,27 +760,30 @@ static double highbd_ssim_8x8(const uint8_t *s, int sp, const uint8_t *sinc, int
 // We are using a 8x8 moving window with starting location of each 8x8 window
 // on the 4x4 pixel grid. Such arrangement allows the windows to overlap
 // block boundaries to penalize blocking artifacts.
-static double aom_ssim2(const uint8_t *img1, int stride_img1, const uint8_t *img2, int stride_img2, int width,
-                        int height) {
-    int    i, j;
-    int    samples    = 0;
-    double ssim_total = 0;
-
-    // region too small to compute meaningful SSIM score
-    if (width <= 8 || height <= 8)
-        return NAN;
+// Stores the SSIM of the windows starting on the rows [row_start, row_end) to window_ssim, in raster order.
+static void ssim2_rows(const uint8_t *img1, int stride_img1, const uint8_t *img2, int stride_img2, int width,
+                       int row_start, int row_end, double *window_ssim) {
+    img1 += row_start * stride_img1;
+    img2 += row_start * stride_img2;
+    // sample point start with each 4x4 location
+    for (int i = row_start; i < row_end; i += 4, img1 += stride_img1 * 4, img2 += stride_img2 * 4) {
+        for (int j = 0; j <= width - 8; j += 4) *window_ssim++ = ssim_8x8(img1 + j, stride_img1, img2 + j, stride_img2);
+    }
+}
 
+static void highbd_ssim2_rows(const uint8_t *img1, int stride_img1, const uint8_t *img1inc, int stride_img1inc,
+                              const uint16_t *img2, int stride_img2, int width, int row_start, int row_end,
+                              uint32_t bd, uint32_t shift, double *window_ssim) {
+    img1 += row_start * stride_img1;
+    img1inc += row_start * stride_img1inc;
+    img2 += row_start * stride_img2;
     // sample point start with each 4x4 location
-    for (i = 0; i <= height - 8; i += 4, img1 += stride_img1 * 4, img2 += stride_img2 * 4) {
-        for (j = 0; j <= width - 8; j += 4) {
-            double v = ssim_8x8(img1 + j, stride_img1, img2 + j, stride_img2);
-            ssim_total += v;
-            samples++;
-        }
+    for (int i = row_start; i < row_end;
+         i += 4, img1 += stride_img1 * 4, img1inc += stride_img1inc * 4, img2 += stride_img2 * 4) {
+        for (int j = 0; j <= width - 8; j += 4)
+            *window_ssim++ = highbd_ssim_8x8(
+                (img1 + j), stride_img1, (img1inc + j), stride_img1inc, (img2 + j), stride_img2, bd, shift);
     }
-    assert(samples > 0);
-    ssim_total /= samples;
-    return ssim_total;
 }
 
 static double aom_highbd_ssim2(const uint8_t *img1, int stride_img1, const uint8_t *img1inc, int stride_img1inc,
@@ -805,6 +812,130 @@ static double aom_highbd_ssim2(const uint8_t *img1, int stride_img1, const uint8
     return ssim_total;
 }
 
+static void ssim_plane_init(SsimPlane *plane, const uint8_t *input, int32_t input_stride, const uint8_t *input_bit_inc,
+                            int32_t input_bit_inc_stride, const uint8_t *recon, int32_t recon_stride, int32_t width,
+                            int32_t height) {
+    plane->input                = input;
+    plane->input_stride         = input_stride;
+    plane->input_bit_inc        = input_bit_inc;
+    plane->input_bit_inc_stride = input_bit_inc_stride;
+    plane->recon                = recon;
+    plane->recon_stride         = recon_stride;
+    plane->width                = width;
+    plane->height               = height;
+    // region too small to compute meaningful SSIM score
+    if (width <= 8 || height <= 8) {
+        plane->band_height = 0;
+        plane->job_count   = 0;
+        return;
+    }
+    const int32_t window_rows = (height - 8) / 4 + 1;
+    plane->window_cols        = (width - 8) / 4 + 1;
+    plane->window_count       = window_rows * plane->window_cols;
+    plane->band_height        = (window_rows + SSIM_JOBS_PER_PLANE - 1) / SSIM_JOBS_PER_PLANE;
+    plane->job_count          = (window_rows + plane->band_height - 1) / plane->band_height;
+}
+
+static void ssim_run_job(SsimJobs *jobs, uint32_t job) {
+    int32_t p = 0;
+    while (job >= jobs->plane[p].job_count) job -= jobs->plane[p++].job_count;
+
+    const SsimPlane *plane     = &jobs->plane[p];
+    const int32_t    row_start = (int32_t)job * plane->band_height * 4;
+    const int32_t    row_end   = AOMMIN(row_start + plane->band_height * 4, plane->height - 7);
+    double *const    window_ssim = jobs->window_ssim[p] + job * plane->band_height * plane->window_cols;
+    // both input and output are 10 bit (bitdepth - input_bd)
+    if (jobs->highbd)
+        highbd_ssim2_rows(plane->input,
+                          plane->input_stride,
+                          plane->input_bit_inc,
+                          plane->input_bit_inc_stride,
+                          (const uint16_t *)plane->recon,
+                          plane->recon_stride,
+                          plane->width,
+                          row_start,
+                          row_end,
+                          10,
+                          0,
+                          window_ssim);
+    else
+        ssim2_rows(plane->input,
+                   plane->input_stride,
+                   plane->recon,
+                   plane->recon_stride,
+                   plane->width,
+                   row_start,
+                   row_end,
+                   window_ssim);
+}
+
+/******************************************************
+ * svt_aom_ssim_run_jobs
+ * Take the jobs of the frame SSIM until none is left
+ ******************************************************/
+void svt_aom_ssim_run_jobs(PictureControlSet *pcs) {
+    SsimJobs *jobs = &pcs->ssim_jobs;
+    int32_t   job;
+    while ((job = svt_atomic_fetch_add_i32(&jobs->next_job, 1)) < (int32_t)jobs->job_count)
+        ssim_run_job(jobs, (uint32_t)job);
+
+    svt_block_on_mutex(jobs->mutex);
+    const bool last_task = ++jobs->tasks_done == jobs->task_count;
+    svt_release_mutex(jobs->mutex);
+    if (last_task)
+        svt_post_semaphore(jobs->done_semaphore);
+}
+
+/******************************************************
+ * ssim_run
+ * Compute the SSIM of the planes set in pcs->ssim_jobs, with the help of the
+ * EntropyCoding processes when a helper fifo is set. The window scores are
+ * added in raster order once all the jobs are done, as aom_ssim2 adds them, so
+ * the result does not depend on the jobs.
+ ******************************************************/
+static EbErrorType ssim_run(PictureControlSet *pcs, double *luma_ssim, double *cb_ssim, double *cr_ssim) {
+    SsimJobs *jobs = &pcs->ssim_jobs;
+
+    EB_MALLOC_ARRAY(jobs->window_ssim[0],
+                    jobs->plane[0].window_count + jobs->plane[1].window_count + jobs->plane[2].window_count);
+    jobs->window_ssim[1] = jobs->window_ssim[0] + jobs->plane[0].window_count;
+    jobs->window_ssim[2] = jobs->window_ssim[1] + jobs->plane[1].window_count;
+
+    jobs->job_count  = jobs->plane[0].job_count + jobs->plane[1].job_count + jobs->plane[2].job_count;
+    jobs->next_job   = 0;
+    jobs->tasks_done = 0;
+
+    const uint32_t helper_count = jobs->helper_fifo && jobs->job_count
+        ? AOMMIN(jobs->helper_max, jobs->job_count - 1)
+        : 0;
+    jobs->task_count = helper_count + 1;
+    for (uint32_t i = 0; i < helper_count; i++) {
+        EbObjectWrapper *rest_results_wrapper;
+        svt_get_empty_object(jobs->helper_fifo, &rest_results_wrapper);
+        RestResults *rest_results = (RestResults *)rest_results_wrapper->object_ptr;
+        rest_results->pcs_wrapper = jobs->pcs_wrapper;
+        rest_results->tile_index  = 0;
+        rest_results->task_type   = REST_TASK_SSIM_JOBS;
+        svt_post_full_object(rest_results_wrapper);
+    }
+    svt_aom_ssim_run_jobs(pcs);
+    svt_block_on_semaphore(jobs->done_semaphore);
+
+    double *ssim[MAX_MB_PLANE] = {luma_ssim, cb_ssim, cr_ssim};
+    for (int32_t p = 0; p < MAX_MB_PLANE; p++) {
+        const SsimPlane *plane = &jobs->plane[p];
+        if (!plane->job_count) {
+            *ssim[p] = NAN;
+            continue;
+        }
+        double ssim_total = 0;
+        for (int32_t i = 0; i < plane->window_count; i++) ssim_total += jobs->window_ssim[p][i];
+        *ssim[p] = ssim_total / plane->window_count;
+    }
+    EB_FREE_ARRAY(jobs->window_ssim[0]);
+    return EB_ErrorNone;
+}
+
 void free_temporal_filtering_buffer(PictureControlSet *pcs, SequenceControlSet *scs) {
     // save_source_picture_ptr will be allocated only if do_tf is true in svt_av1_init_temporal_filtering().
     if (!pcs->ppcs->do_tf) {
@@ -825,6 +956,7 @@ void free_temporal_filtering_buffer(PictureControlSet *pcs, SequenceControlSet *
 
 EbErrorType svt_aom_ssim_calculations(PictureControlSet *pcs, SequenceControlSet *scs, bool free_memory) {
     bool is_16bit = (scs->static_config.encoder_bit_depth > EB_EIGHT_BIT);
+    EbErrorType return_error = EB_ErrorNone;
 
     const uint32_t ss_x = scs->subsampling_x;
     const uint32_t ss_y = scs->subsampling_y;
@@ -876,34 +1008,48 @@ EbErrorType svt_aom_ssim_calculations(PictureControlSet *pcs, SequenceControlSet
             buffer_cr = input_pic->buffer_cr;
         }
 
+        SsimJobs *jobs = &pcs->ssim_jobs;
+        jobs->highbd   = false;
+
         recon_coeff_buffer = &((recon_ptr->buffer_y)[recon_ptr->org_x + recon_ptr->org_y * recon_ptr->stride_y]);
         input_buffer       = &(buffer_y[input_pic->org_x + input_pic->org_y * input_pic->stride_y]);
-        luma_ssim          = aom_ssim2(input_buffer,
-                              input_pic->stride_y,
-                              recon_coeff_buffer,
-                              recon_ptr->stride_y,
-                              scs->max_input_luma_width,
-                              scs->max_input_luma_height);
+        ssim_plane_init(&jobs->plane[0],
+                        input_buffer,
+                        input_pic->stride_y,
+                        NULL,
+                        0,
+                        recon_coeff_buffer,
+                        recon_ptr->stride_y,
+                        scs->max_input_luma_width,
+                        scs->max_input_luma_height);
 
         recon_coeff_buffer = &(
             (recon_ptr->buffer_cb)[recon_ptr->org_x / 2 + recon_ptr->org_y / 2 * recon_ptr->stride_cb]);
         input_buffer = &(buffer_cb[input_pic->org_x / 2 + input_pic->org_y / 2 * input_pic->stride_cb]);
-        cb_ssim      = aom_ssim2(input_buffer,
-                            input_pic->stride_cb,
-                            recon_coeff_buffer,
-                            recon_ptr->stride_cb,
-                            scs->chroma_width,
-                            scs->chroma_height);
+        ssim_plane_init(&jobs->plane[1],
+                        input_buffer,
+                        input_pic->stride_cb,
+                        NULL,
+                        0,
+                        recon_coeff_buffer,
+                        recon_ptr->stride_cb,
+                        scs->chroma_width,
+                        scs->chroma_height);
 
         recon_coeff_buffer = &(
             (recon_ptr->buffer_cr)[recon_ptr->org_x / 2 + recon_ptr->org_y / 2 * recon_ptr->stride_cr]);
         input_buffer = &(buffer_cr[input_pic->org_x / 2 + input_pic->org_y / 2 * input_pic->stride_cr]);
-        cr_ssim      = aom_ssim2(input_buffer,
-                            input_pic->stride_cr,
-                            recon_coeff_buffer,
-                            recon_ptr->stride_cr,
-                            scs->chroma_width,
-                            scs->chroma_height);
+        ssim_plane_init(&jobs->plane[2],
+                        input_buffer,
+                        input_pic->stride_cr,
+                        NULL,
+                        0,
+                        recon_coeff_buffer,
+                        recon_ptr->stride_cr,
+                        scs->chroma_width,
+                        scs->chroma_height);
+
+        return_error = ssim_run(pcs, &luma_ssim, &cb_ssim, &cr_ssim);
 
         pcs->ppcs->luma_ssim = luma_ssim;
         pcs->ppcs->cb_ssim   = cb_ssim;
@@ -1041,7 +1187,6 @@ EbErrorType svt_aom_ssim_calculations(PictureControlSet *pcs, SequenceControlSet
             EbByte buffer_y, buffer_bit_inc_y;
             EbByte buffer_cb, buffer_bit_inc_cb;
             EbByte buffer_cr, buffer_bit_inc_cr;
-            int    bd, shift;
 
             if (pcs->ppcs->do_tf == true) {
                 assert(pcs->ppcs->save_source_picture_width == input_pic->width &&
@@ -1088,22 +1233,21 @@ EbErrorType svt_aom_ssim_calculations(PictureControlSet *pcs, SequenceControlSet
                 buffer_bit_inc_cr = uncompressed_pics[2];
             }
 
-            bd    = 10;
-            shift = 0; // both input and output are 10 bit (bitdepth - input_bd)
+            SsimJobs *jobs = &pcs->ssim_jobs;
+            jobs->highbd   = true;
 
             input_buffer                = &((buffer_y)[input_pic->org_x + input_pic->org_y * input_pic->stride_y]);
             EbByte input_buffer_bit_inc = &(
                 (buffer_bit_inc_y)[input_pic->org_x + input_pic->org_y * input_pic->stride_bit_inc_y]);
-            luma_ssim = aom_highbd_ssim2(input_buffer,
-                                         input_pic->stride_y,
-                                         input_buffer_bit_inc,
-                                         input_pic->stride_bit_inc_y,
-                                         recon_coeff_buffer,
-                                         recon_ptr->stride_y,
-                                         scs->max_input_luma_width,
-                                         scs->max_input_luma_height,
-                                         bd,
-                                         shift);
+            ssim_plane_init(&jobs->plane[0],
+                            input_buffer,
+                            input_pic->stride_y,
+                            input_buffer_bit_inc,
+                            input_pic->stride_bit_inc_y,
+                            (uint8_t *)recon_coeff_buffer,
+                            recon_ptr->stride_y,
+                            scs->max_input_luma_width,
+                            scs->max_input_luma_height);
 
             recon_coeff_buffer   = (uint16_t *)(&(
                 (recon_ptr->buffer_cb)[(recon_ptr->org_x << is_16bit) / 2 +
@@ -1111,16 +1255,15 @@ EbErrorType svt_aom_ssim_calculations(PictureControlSet *pcs, SequenceControlSet
             input_buffer         = &((buffer_cb)[input_pic->org_x / 2 + input_pic->org_y / 2 * input_pic->stride_cb]);
             input_buffer_bit_inc = &(
                 (buffer_bit_inc_cb)[input_pic->org_x / 2 + input_pic->org_y / 2 * input_pic->stride_bit_inc_cb]);
-            cb_ssim = aom_highbd_ssim2(input_buffer,
-                                       input_pic->stride_cb,
-                                       input_buffer_bit_inc,
-                                       input_pic->stride_bit_inc_cb,
-                                       recon_coeff_buffer,
-                                       recon_ptr->stride_cb,
-                                       scs->chroma_width,
-                                       scs->chroma_height,
-                                       bd,
-                                       shift);
+            ssim_plane_init(&jobs->plane[1],
+                            input_buffer,
+                            input_pic->stride_cb,
+                            input_buffer_bit_inc,
+                            input_pic->stride_bit_inc_cb,
+                            (uint8_t *)recon_coeff_buffer,
+                            recon_ptr->stride_cb,
+                            scs->chroma_width,
+                            scs->chroma_height);
 
             recon_coeff_buffer   = (uint16_t *)(&(
                 (recon_ptr->buffer_cr)[(recon_ptr->org_x << is_16bit) / 2 +
@@ -1128,16 +1271,17 @@ EbErrorType svt_aom_ssim_calculations(PictureControlSet *pcs, SequenceControlSet
             input_buffer         = &((buffer_cr)[input_pic->org_x / 2 + input_pic->org_y / 2 * input_pic->stride_cr]);
             input_buffer_bit_inc = &(
                 (buffer_bit_inc_cr)[input_pic->org_x / 2 + input_pic->org_y / 2 * input_pic->stride_bit_inc_cr]);
-            cr_ssim = aom_highbd_ssim2(input_buffer,
-                                       input_pic->stride_cr,
-                                       input_buffer_bit_inc,
-                                       input_pic->stride_bit_inc_cr,
-                                       recon_coeff_buffer,
-                                       recon_ptr->stride_cr,
-                                       scs->chroma_width,
-                                       scs->chroma_height,
-                                       bd,
-                                       shift);
+            ssim_plane_init(&jobs->plane[2],
+                            input_buffer,
+                            input_pic->stride_cr,
+                            input_buffer_bit_inc,
+                            input_pic->stride_bit_inc_cr,
+                            (uint8_t *)recon_coeff_buffer,
+                            recon_ptr->stride_cr,
+                            scs->chroma_width,
+                            scs->chroma_height);
+
+            return_error = ssim_run(pcs, &luma_ssim, &cb_ssim, &cr_ssim);
 
             pcs->ppcs->luma_ssim = luma_ssim;
             pcs->ppcs->cb_ssim   = cb_ssim;
@@ -1159,7 +1303,7 @@ EbErrorType svt_aom_ssim_calculations(PictureControlSet *pcs, SequenceControlSet
         }
     }
     EB_DELETE(upscaled_recon);
-    return EB_ErrorNone;
+    return return_error;
 }
 
 EbErrorType psnr_calculations(PictureControlSet *pcs, SequenceControlSet *scs, bool free_memory) {
@@ -3176,6 +3320,7 @@ void *svt_aom_mode_decision_kernel(void *input_ptr) {
 
         EncDecTasks                    *enc_dec_tasks = (EncDecTasks *)enc_dec_tasks_wrapper->object_ptr;
         PictureControlSet              *pcs           = (PictureControlSet *)enc_dec_tasks->pcs_wrapper->object_ptr;
+        SVT_TRACE_TASK("EncDec", pcs->picture_number, -1);
         SequenceControlSet             *scs           = pcs->scs;
         ModeDecisionContext            *md_ctx        = ed_ctx->md_ctx;
         struct PictureParentControlSet *ppcs          = pcs->ppcs;
@@ -3252,6 +3397,10 @@ void *svt_aom_mode_decision_kernel(void *input_ptr) {
             // Segment-loop
             while (assign_enc_dec_segments(
                        segments_ptr, &segment_index, enc_dec_tasks, ed_ctx->enc_dec_feedback_fifo_ptr) == true) {
+                uint64_t seg_start = SVT_TRACE_NOW();
+                // The first segment of the first tile group is always coded first
+                if (segment_index == 0 && ed_ctx->tile_group_index == 0 && !ppcs->timestamps.enc_dec_start)
+                    ppcs->timestamps.enc_dec_start = svt_av1_get_time_ns();
                 x_sb_start_index = segments_ptr->x_start_array[segment_index];
                 y_sb_start_index = segments_ptr->y_start_array[segment_index];
                 sb_start_index   = y_sb_start_index * tile_group_width_in_sb + x_sb_start_index;
@@ -3505,6 +3654,7 @@ void *svt_aom_mode_decision_kernel(void *input_ptr) {
                     }
                     x_sb_start_index = (x_sb_start_index > 0) ? x_sb_start_index - 1 : 0;
                 }
+                SVT_TRACE_SPAN("EncDec segment", seg_start, pcs->picture_number, segment_index);
             }
 
             svt_block_on_mutex(pcs->intra_mutex);
@@ -3588,10 +3738,12 @@ void *svt_aom_mode_decision_kernel(void *input_ptr) {
                     pcs->ppcs->av1x->rdmult =
                         ed_ctx->pic_full_lambda[(ed_ctx->bit_depth == EB_TEN_BIT) ? EB_10_BIT_MD : EB_8_BIT_MD];
                     if (pcs->ppcs->superres_total_recode_loop == 0) {
+                        svt_aom_build_analysis_export(pcs);
                         svt_release_object(pcs->ppcs->me_data_wrapper);
                         pcs->ppcs->me_data_wrapper = (EbObjectWrapper *)NULL;
                         pcs->ppcs->pa_me_data      = NULL;
                     }
+                    ppcs->timestamps.enc_dec_end = svt_av1_get_time_ns();
                     // Get Empty EncDec Results
                     svt_get_empty_object(ed_ctx->enc_dec_output_fifo_ptr, &enc_dec_results_wrapper);
                     enc_dec_results              = (EncDecResults *)enc_dec_results_wrapper->object_ptr;
@@ -26,10 +26,17 @@ typedef struct EncDecResults {
     EbObjectWrapper *pcs_wrapper;
 } EncDecResults;
 
+typedef enum DlfTaskType {
+    DLF_TASK_CDEF_SEGMENT, // search and apply cdef on segment_index
+    DLF_TASK_LF_JOBS, // help the DLF process with the jobs of pcs->dlf_jobs
+} DlfTaskType;
+
 typedef struct DlfResults {
     EbDctor          dctor;
     EbObjectWrapper *pcs_wrapper;
     uint32_t         segment_index;
+    DlfTaskType      task_type;
+    uint32_t         lf_pass; // DLF_TASK_LF_JOBS: pass of pcs->dlf_jobs the task was posted for
 } DlfResults;
 
 typedef struct CdefResults {
@@ -38,10 +45,16 @@ typedef struct CdefResults {
     uint32_t         segment_index;
 } CdefResults;
 
+typedef enum RestTaskType {
+    REST_TASK_TILE, // entropy code tile_index
+    REST_TASK_SSIM_JOBS, // help the Rest process with the jobs of pcs->ssim_jobs
+} RestTaskType;
+
 typedef struct RestResults {
     EbDctor          dctor;
     EbObjectWrapper *pcs_wrapper;
     uint16_t         tile_index;
+    RestTaskType     task_type;
 } RestResults;
 
 typedef struct EncDecResultsInitData {
@@ -508,6 +508,24 @@ static void svt_aom_set_me_sr_adjustment_ctrls(MeContext *me_ctx, uint8_t sr_adj
         }
     }
 }
+static void set_hash_me_ctrls(MeContext *me_ctx, uint8_t level) {
+    HashMeCtrls *hash_me_ctrls = &me_ctx->hash_me_ctrls;
+
+    switch (level) {
+    case 0: hash_me_ctrls->enabled = 0; break;
+    case 1:
+        hash_me_ctrls->enabled        = 1;
+        hash_me_ctrls->min_block_size = 16;
+        hash_me_ctrls->max_candidates = 256;
+        break;
+    case 2:
+        hash_me_ctrls->enabled        = 1;
+        hash_me_ctrls->min_block_size = 32;
+        hash_me_ctrls->max_candidates = 64;
+        break;
+    default: assert(0); break;
+    }
+}
 static void svt_aom_set_me_8x8_var_ctrls(MeContext *me_ctx, uint8_t level) {
     Me8x8VarCtrls *me_8x8_var_ctrls = &me_ctx->me_8x8_var_ctrls;
 
@@ -776,6 +794,12 @@ void svt_aom_sig_deriv_me(SequenceControlSet *scs, PictureParentControlSet *pcs,
 
     uint8_t me_8x8_var_lvl = 2;
     svt_aom_set_me_8x8_var_ctrls(me_ctx, me_8x8_var_lvl);
+
+    // Hash based ME (0-2): exact matches are common in screen content, and may be out of the ME search area
+    uint8_t hash_me_lvl = 0;
+    if (sc_class1 && !pcs->frame_superres_enabled && !pcs->frame_resize_enabled)
+        hash_me_lvl = enc_mode <= ENC_M7 ? 1 : 2;
+    set_hash_me_ctrls(me_ctx, hash_me_lvl);
     if (enc_mode <= ENC_M6)
         me_ctx->prune_me_candidates_th = 0;
     else
@@ -845,6 +869,7 @@ void svt_aom_sig_deriv_me_tf(PictureParentControlSet *pcs, MeContext *me_ctx) {
     svt_aom_set_mv_based_sa_ctrls(me_ctx, 0);
 
     svt_aom_set_me_8x8_var_ctrls(me_ctx, 0);
+    set_hash_me_ctrls(me_ctx, 0);
     me_ctx->me_early_exit_th            = pcs->tf_ctrls.hme_me_level <= 1 ? 0 : BLOCK_SIZE_64 * BLOCK_SIZE_64 * 4;
     me_ctx->me_safe_limit_zz_th         = 0;
     me_ctx->reduce_hme_l0_sr_th_min     = 0;
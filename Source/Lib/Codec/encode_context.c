@@ -10,6 +10,7 @@
 */
 
 #include <stdlib.h>
+#include <string.h>
 
 #include "encode_context.h"
 #include "EbSvtAv1ErrorCodes.h"
@@ -74,6 +75,7 @@ static void encode_context_dctor(EbPtr p) {
 #endif
     EB_DELETE_PTR_ARRAY(obj->initial_rate_control_reorder_queue, INITIAL_RATE_CONTROL_REORDER_QUEUE_MAX_DEPTH);
     EB_DELETE_PTR_ARRAY(obj->packetization_reorder_queue, PACKETIZATION_REORDER_QUEUE_MAX_DEPTH);
+    for (uint32_t i = 0; i < obj->packet_buffer_cache_count; i++) EB_FREE(obj->packet_buffer_cache[i]);
     EB_FREE(obj->stats_out.stat);
     destroy_stats_buffer(&obj->stats_buf_context, obj->frame_stats_buffer);
     EB_DELETE_PTR_ARRAY(obj->rc.coded_frames_stat_queue, CODED_FRAMES_STAT_QUEUE_MAX_DEPTH);
@@ -142,7 +144,6 @@ EbErrorType svt_aom_encode_context_ctor(EncodeContext *enc_ctx, EbPtr object_ini
     enc_ctx->terminating_picture_number = ~0u;
 
     EB_CREATE_MUTEX(enc_ctx->sc_buffer_mutex);
-    enc_ctx->enc_mode         = SPEED_CONTROL_INIT_MOD;
     enc_ctx->recode_tolerance = 25;
     enc_ctx->rc_cfg.min_cr    = 0;
     EB_CREATE_MUTEX(enc_ctx->stat_file_mutex);
@@ -185,3 +186,52 @@ EbErrorType svt_aom_encode_context_ctor(EncodeContext *enc_ctx, EbPtr object_ini
     enc_ctx->roi_map_evt = NULL;
     return EB_ErrorNone;
 }
+
+/**************************************
+ * svt_aom_encode_context_reset
+ *   Brings the per-stream state back to its state after construction.
+ *   The fifos, callbacks, prediction structures and reference list set
+ *   up by the encoder handle at init are kept.
+ **************************************/
+EbErrorType svt_aom_encode_context_reset(EncodeContext *enc_ctx) {
+    EbCallback               *app_callback_ptr               = enc_ctx->app_callback_ptr;
+    EbFifo                   *overlay_fifo_ptr               = enc_ctx->overlay_input_picture_pool_fifo_ptr;
+    EbFifo                   *stream_output_fifo_ptr         = enc_ctx->stream_output_fifo_ptr;
+    EbFifo                   *recon_output_fifo_ptr          = enc_ctx->recon_output_fifo_ptr;
+    EbFifo                   *ref_fifo_ptr                   = enc_ctx->reference_picture_pool_fifo_ptr;
+    EbFifo                   *pa_ref_fifo_ptr                = enc_ctx->pa_reference_picture_pool_fifo_ptr;
+    EbFifo                   *tpl_ref_fifo_ptr               = enc_ctx->tpl_reference_picture_pool_fifo_ptr;
+    PredictionStructureGroup *prediction_structure_group_ptr = enc_ctx->prediction_structure_group_ptr;
+    ReferenceQueueEntry     **ref_pic_list                   = enc_ctx->ref_pic_list;
+    const uint32_t            ref_pic_list_length            = enc_ctx->ref_pic_list_length;
+    const RecodeLoopType      recode_loop                    = enc_ctx->recode_loop;
+    const SvtAv1PacketWriter  packet_writer                  = enc_ctx->packet_writer;
+    const SvtAv1OutputNotify  output_notify                  = enc_ctx->output_notify;
+    void                     *output_notify_opaque           = enc_ctx->output_notify_opaque;
+
+    // Owned by the context but built at init, detach them from the dctor
+    enc_ctx->prediction_structure_group_ptr = NULL;
+    enc_ctx->ref_pic_list                   = NULL;
+    enc_ctx->dctor(enc_ctx);
+    memset(enc_ctx, 0, sizeof(*enc_ctx));
+
+    enc_ctx->app_callback_ptr                    = app_callback_ptr;
+    enc_ctx->overlay_input_picture_pool_fifo_ptr = overlay_fifo_ptr;
+    enc_ctx->stream_output_fifo_ptr              = stream_output_fifo_ptr;
+    enc_ctx->recon_output_fifo_ptr               = recon_output_fifo_ptr;
+    enc_ctx->reference_picture_pool_fifo_ptr     = ref_fifo_ptr;
+    enc_ctx->pa_reference_picture_pool_fifo_ptr  = pa_ref_fifo_ptr;
+    enc_ctx->tpl_reference_picture_pool_fifo_ptr = tpl_ref_fifo_ptr;
+    enc_ctx->prediction_structure_group_ptr      = prediction_structure_group_ptr;
+    enc_ctx->ref_pic_list                        = ref_pic_list;
+    enc_ctx->ref_pic_list_length                 = ref_pic_list_length;
+    enc_ctx->recode_loop                         = recode_loop;
+    enc_ctx->packet_writer                       = packet_writer;
+    enc_ctx->output_notify                       = output_notify;
+    enc_ctx->output_notify_opaque                = output_notify_opaque;
+    for (uint32_t i = 0; i < ref_pic_list_length; i++) {
+        memset(ref_pic_list[i], 0, sizeof(*ref_pic_list[i]));
+        svt_aom_reference_queue_entry_ctor(ref_pic_list[i]);
+    }
+    return svt_aom_encode_context_ctor(enc_ctx, NULL);
+}
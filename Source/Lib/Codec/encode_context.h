@@ -40,6 +40,7 @@
 #define PICTURE_MANAGER_REORDER_QUEUE_MAX_DEPTH 2048
 #define HIGH_LEVEL_RATE_CONTROL_HISTOGRAM_QUEUE_MAX_DEPTH 2048
 #define PACKETIZATION_REORDER_QUEUE_MAX_DEPTH 2048
+#define PACKET_BUFFER_CACHE_SIZE 32
 #define TPL_PADX 32
 #define TPL_PADY 32
 // RC Groups: They should be a power of 2, so we can replace % by &.
@@ -140,6 +141,16 @@ typedef struct EncodeContext {
     // Packetization Reorder Queue
     PacketizationReorderEntry **packetization_reorder_queue;
     uint32_t                    packetization_reorder_queue_head_index;
+    // Application packet writer, set when the packets are written to its
+    // memory instead of being queued. The staging buffers of the frames are
+    // then kept by the packetization process for the next frames.
+    SvtAv1PacketWriter packet_writer;
+    uint8_t           *packet_buffer_cache[PACKET_BUFFER_CACHE_SIZE];
+    uint32_t           packet_buffer_cache_size[PACKET_BUFFER_CACHE_SIZE];
+    uint32_t           packet_buffer_cache_count;
+    // Called each time a packet is queued for svt_av1_enc_get_packet()
+    SvtAv1OutputNotify output_notify;
+    void              *output_notify_opaque;
 
     // GOP Counters
     uint32_t intra_period_position; // Current position in intra period
@@ -157,7 +168,6 @@ typedef struct EncodeContext {
     PredictionStructureGroup *prediction_structure_group_ptr;
 
     // Speed Control
-    int64_t  sc_buffer;
     int64_t  sc_frame_in;
     int64_t  sc_frame_out;
     EbHandle sc_buffer_mutex;
@@ -214,4 +224,5 @@ typedef struct EncodeContextInitData {
  * Extern Function Declarations
  **************************************/
 extern EbErrorType svt_aom_encode_context_ctor(EncodeContext *enc_ctx, EbPtr object_init_data_ptr);
+extern EbErrorType svt_aom_encode_context_reset(EncodeContext *enc_ctx);
 #endif // EbEncodeContext_h
@@ -12,23 +12,10 @@
 #include "hash.h"
 #include "hash_motion.h"
 #include "pcs.h"
+#include "aom_dsp_rtcd.h"
 
 void             svt_aom_free(void *memblk);
-static const int crc_bits        = 16;
-static const int block_size_bits = 3;
-
-static void hash_table_clear_all(HashTable *p_hash_table) {
-    if (p_hash_table->p_lookup_table == NULL)
-        return;
-    int max_addr = 1 << (crc_bits + block_size_bits);
-    for (int i = 0; i < max_addr; i++) {
-        if (p_hash_table->p_lookup_table[i] != NULL) {
-            svt_aom_vector_destroy(p_hash_table->p_lookup_table[i]);
-            free(p_hash_table->p_lookup_table[i]);
-            p_hash_table->p_lookup_table[i] = NULL;
-        }
-    }
-}
+static const int crc_bits = 16;
 
 static void get_pixels_in_1d_char_array_by_block_2x2(uint8_t *y_src, int stride, uint8_t *p_pixels_in1D) {
     uint8_t *p_pel = y_src;
@@ -88,50 +75,50 @@ static int hash_block_size_to_index(int block_size) {
 }
 
 void svt_av1_hash_table_destroy(HashTable *p_hash_table) {
-    hash_table_clear_all(p_hash_table);
-    EB_FREE_ARRAY(p_hash_table->p_lookup_table);
-    p_hash_table->p_lookup_table = NULL;
-}
-
-EbErrorType svt_aom_rtime_alloc_svt_av1_hash_table_create(HashTable *p_hash_table) {
-    EbErrorType err_code = EB_ErrorNone;
-    ;
-
-    if (p_hash_table->p_lookup_table != NULL) {
-        hash_table_clear_all(p_hash_table);
-        return err_code;
+    for (int i = 0; i < HASH_BLOCK_SIZE_COUNT; i++) {
+        EB_FREE_ARRAY(p_hash_table->offsets[i]);
+        EB_FREE_ARRAY(p_hash_table->entries[i]);
     }
-    const int max_addr = 1 << (crc_bits + block_size_bits);
-    //p_hash_table->p_lookup_table = (Vector **)malloc(sizeof(p_hash_table->p_lookup_table[0]) * max_addr);
-    EB_CALLOC_ARRAY(p_hash_table->p_lookup_table, max_addr);
-
-    return err_code;
 }
 
-static void hash_table_add_to_table(HashTable *p_hash_table, uint32_t hash_value, BlockHash *curr_block_hash) {
-    if (p_hash_table->p_lookup_table[hash_value] == NULL) {
-        p_hash_table->p_lookup_table[hash_value] = malloc(sizeof(p_hash_table->p_lookup_table[0][0]));
-        svt_aom_vector_setup(p_hash_table->p_lookup_table[hash_value], 10, sizeof(curr_block_hash[0]));
-        svt_aom_vector_push_back(p_hash_table->p_lookup_table[hash_value], curr_block_hash);
-    } else {
-        svt_aom_vector_push_back(p_hash_table->p_lookup_table[hash_value], curr_block_hash);
-    }
+EbErrorType svt_aom_rtime_alloc_svt_av1_hash_table_create(HashTable *p_hash_table) {
+    // The blocks are allocated when added
+    svt_av1_hash_table_destroy(p_hash_table);
+    return EB_ErrorNone;
 }
 
 int32_t svt_av1_hash_table_count(const HashTable *p_hash_table, uint32_t hash_value) {
-    if (p_hash_table->p_lookup_table[hash_value] == NULL) {
+    const uint32_t  size_idx = hash_value >> crc_bits;
+    const uint32_t *offsets  = size_idx < HASH_BLOCK_SIZE_COUNT ? p_hash_table->offsets[size_idx] : NULL;
+    if (offsets == NULL)
         return 0;
-    } else
-        return (int32_t)(p_hash_table->p_lookup_table[hash_value]->size);
+    const uint32_t value = hash_value & ((1 << crc_bits) - 1);
+    return (int32_t)(offsets[value + 1] - offsets[value]);
 }
 
 Iterator svt_av1_hash_get_first_iterator(HashTable *p_hash_table, uint32_t hash_value) {
     assert(svt_av1_hash_table_count(p_hash_table, hash_value) > 0);
-    return svt_aom_vector_begin(p_hash_table->p_lookup_table[hash_value]);
+    const uint32_t size_idx = hash_value >> crc_bits;
+    const uint32_t value    = hash_value & ((1 << crc_bits) - 1);
+    Iterator iterator = {&p_hash_table->entries[size_idx][p_hash_table->offsets[size_idx][value]], sizeof(BlockHash)};
+    return iterator;
+}
+
+void svt_av1_generate_block_2x2_hash_row_c(const uint8_t *src, int stride, int width, CRC_CALCULATOR *crc_calculator,
+                                           uint32_t *hash1, uint32_t *hash2, int8_t *row_same, int8_t *col_same) {
+    uint8_t p[4];
+    for (int x_pos = 0; x_pos < width; x_pos++) {
+        get_pixels_in_1d_char_array_by_block_2x2((uint8_t *)src + x_pos, stride, p);
+        row_same[x_pos] = is_block_2x2_row_same_value(p);
+        col_same[x_pos] = is_block_2x2_col_same_value(p);
+
+        hash1[x_pos] = svt_av1_get_crc_value(crc_calculator, p, sizeof(p));
+        hash2[x_pos] = svt_av1_get_crc32c_value(p, sizeof(p));
+    }
 }
 
 void svt_av1_generate_block_2x2_hash_value(const Yv12BufferConfig *picture, uint32_t *pic_block_hash[2],
-                                           int8_t *pic_block_same_info[3], PictureControlSet *pcs) {
+                                           int8_t *pic_block_same_info[3], CRC_CALCULATOR *crc_calculator) {
     const int width  = 2;
     const int height = 2;
     const int x_end  = picture->y_crop_width - width + 1;
@@ -148,36 +135,31 @@ void svt_av1_generate_block_2x2_hash_value(const Yv12BufferConfig *picture, uint
                 pic_block_same_info[0][pos] = is_block16_2x2_row_same_value(p);
                 pic_block_same_info[1][pos] = is_block16_2x2_col_same_value(p);
 
-                pic_block_hash[0][pos] = svt_av1_get_crc_value(
-                    &pcs->crc_calculator1, (uint8_t *)p, length * sizeof(p[0]));
-                pic_block_hash[1][pos] = svt_av1_get_crc_value(
-                    &pcs->crc_calculator2, (uint8_t *)p, length * sizeof(p[0]));
+                pic_block_hash[0][pos] = svt_av1_get_crc_value(crc_calculator, (uint8_t *)p, length * sizeof(p[0]));
+                pic_block_hash[1][pos] = svt_av1_get_crc32c_value((uint8_t *)p, length * sizeof(p[0]));
                 pos++;
             }
             pos += width - 1;
         }
     } else {
-        uint8_t p[4];
-        int     pos = 0;
+        int pos = 0;
         for (int y_pos = 0; y_pos < y_end; y_pos++) {
-            for (int x_pos = 0; x_pos < x_end; x_pos++) {
-                get_pixels_in_1d_char_array_by_block_2x2(
-                    picture->y_buffer + y_pos * picture->y_stride + x_pos, picture->y_stride, p);
-                pic_block_same_info[0][pos] = is_block_2x2_row_same_value(p);
-                pic_block_same_info[1][pos] = is_block_2x2_col_same_value(p);
-
-                pic_block_hash[0][pos] = svt_av1_get_crc_value(&pcs->crc_calculator1, p, length * sizeof(p[0]));
-                pic_block_hash[1][pos] = svt_av1_get_crc_value(&pcs->crc_calculator2, p, length * sizeof(p[0]));
-                pos++;
-            }
-            pos += width - 1;
+            svt_av1_generate_block_2x2_hash_row(picture->y_buffer + y_pos * picture->y_stride,
+                                                picture->y_stride,
+                                                x_end,
+                                                crc_calculator,
+                                                pic_block_hash[0] + pos,
+                                                pic_block_hash[1] + pos,
+                                                pic_block_same_info[0] + pos,
+                                                pic_block_same_info[1] + pos);
+            pos += x_end + width - 1;
         }
     }
 }
 
 void svt_av1_generate_block_hash_value(const Yv12BufferConfig *picture, int block_size, uint32_t *src_pic_block_hash[2],
                                        uint32_t *dst_pic_block_hash[2], int8_t *src_pic_block_same_info[3],
-                                       int8_t *dst_pic_block_same_info[3], PictureControlSet *pcs) {
+                                       int8_t *dst_pic_block_same_info[3], CRC_CALCULATOR *crc_calculator) {
     const int pic_width = picture->y_crop_width;
     const int x_end     = picture->y_crop_width - block_size + 1;
     const int y_end     = picture->y_crop_height - block_size + 1;
@@ -195,13 +177,13 @@ void svt_av1_generate_block_hash_value(const Yv12BufferConfig *picture, int bloc
             p[1]                       = src_pic_block_hash[0][pos + src_size];
             p[2]                       = src_pic_block_hash[0][pos + src_size * pic_width];
             p[3]                       = src_pic_block_hash[0][pos + src_size * pic_width + src_size];
-            dst_pic_block_hash[0][pos] = svt_av1_get_crc_value(&pcs->crc_calculator1, (uint8_t *)p, length);
+            dst_pic_block_hash[0][pos] = svt_av1_get_crc_value(crc_calculator, (uint8_t *)p, length);
 
             p[0]                       = src_pic_block_hash[1][pos];
             p[1]                       = src_pic_block_hash[1][pos + src_size];
             p[2]                       = src_pic_block_hash[1][pos + src_size * pic_width];
             p[3]                       = src_pic_block_hash[1][pos + src_size * pic_width + src_size];
-            dst_pic_block_hash[1][pos] = svt_av1_get_crc_value(&pcs->crc_calculator2, (uint8_t *)p, length);
+            dst_pic_block_hash[1][pos] = svt_av1_get_crc32c_value((uint8_t *)p, length);
 
             dst_pic_block_same_info[0][pos] = src_pic_block_same_info[0][pos] &&
                 src_pic_block_same_info[0][pos + quad_size] && src_pic_block_same_info[0][pos + src_size] &&
@@ -234,36 +216,68 @@ void svt_av1_generate_block_hash_value(const Yv12BufferConfig *picture, int bloc
     }
 }
 
-void svt_aom_rtime_alloc_svt_av1_add_to_hash_map_by_row_with_precal_data(HashTable *p_hash_table, uint32_t *pic_hash[2],
-                                                                         int8_t *pic_is_same, int pic_width,
-                                                                         int pic_height, int block_size) {
+EbErrorType svt_aom_rtime_alloc_svt_av1_add_to_hash_map_by_row_with_precal_data(HashTable *p_hash_table,
+                                                                                uint32_t *pic_hash[2],
+                                                                                int8_t *pic_is_same, int pic_width,
+                                                                                int pic_height, int block_size) {
     const int x_end = pic_width - block_size + 1;
     const int y_end = pic_height - block_size + 1;
 
     const int8_t   *src_is_added = pic_is_same;
     const uint32_t *src_hash[2]  = {pic_hash[0], pic_hash[1]};
 
-    int add_value = hash_block_size_to_index(block_size);
-    assert(add_value >= 0);
-    add_value <<= crc_bits;
+    const int size_idx = hash_block_size_to_index(block_size);
+    assert(size_idx >= 0);
     const int crc_mask = (1 << crc_bits) - 1;
 
+    // Replaces the blocks of this size added before
+    EB_FREE_ARRAY(p_hash_table->offsets[size_idx]);
+    EB_FREE_ARRAY(p_hash_table->entries[size_idx]);
+
+    // Count the blocks of each hash value, so they are stored in one array with the ones of a value together
+    uint32_t *offsets;
+    EB_CALLOC_ARRAY(offsets, (1 << crc_bits) + 1);
+    uint32_t count = 0;
     for (int x_pos = 0; x_pos < x_end; x_pos++) {
         for (int y_pos = 0; y_pos < y_end; y_pos++) {
             const int pos = y_pos * pic_width + x_pos;
             // valid data
             if (src_is_added[pos]) {
-                BlockHash curr_block_hash;
-                curr_block_hash.x = x_pos;
-                curr_block_hash.y = y_pos;
-
-                const uint32_t hash_value1  = (src_hash[0][pos] & crc_mask) + add_value;
-                curr_block_hash.hash_value2 = src_hash[1][pos];
-
-                hash_table_add_to_table(p_hash_table, hash_value1, &curr_block_hash);
+                offsets[(src_hash[0][pos] & crc_mask) + 1]++;
+                count++;
             }
         }
     }
+    for (int value = 0; value < crc_mask + 1; value++) offsets[value + 1] += offsets[value];
+
+    BlockHash *entries = NULL;
+    if (count) {
+        EB_NO_THROW_MALLOC(entries, sizeof(*entries) * count);
+        if (!entries) {
+            EB_FREE_ARRAY(offsets);
+            return EB_ErrorInsufficientResources;
+        }
+    }
+    // offsets[v] is the first entry of the value v, used as its next entry: the blocks keep the order of the scan,
+    // which the searches rely on for ties
+    for (int x_pos = 0; x_pos < x_end; x_pos++) {
+        for (int y_pos = 0; y_pos < y_end; y_pos++) {
+            const int pos = y_pos * pic_width + x_pos;
+            if (src_is_added[pos]) {
+                BlockHash *curr_block_hash   = &entries[offsets[src_hash[0][pos] & crc_mask]++];
+                curr_block_hash->x           = x_pos;
+                curr_block_hash->y           = y_pos;
+                curr_block_hash->hash_value2 = src_hash[1][pos];
+            }
+        }
+    }
+    // offsets[v] is now the first entry of the value v + 1
+    memmove(offsets + 1, offsets, sizeof(*offsets) * (crc_mask + 1));
+    offsets[0] = 0;
+
+    p_hash_table->offsets[size_idx] = offsets;
+    p_hash_table->entries[size_idx] = entries;
+    return EB_ErrorNone;
 }
 
 void svt_av1_get_block_hash_value(uint8_t *y_src, int stride, int block_size, uint32_t *hash_value1,
@@ -287,8 +301,8 @@ void svt_av1_get_block_hash_value(uint8_t *y_src, int stride, int block_size, ui
                 assert(pos < AOM_BUFFER_SIZE_FOR_BLOCK_HASH);
                 x->hash_value_buffer[0][0][pos] = svt_av1_get_crc_value(
                     &x->crc_calculator1, (uint8_t *)pixel_to_hash, sizeof(pixel_to_hash));
-                x->hash_value_buffer[1][0][pos] = svt_av1_get_crc_value(
-                    &x->crc_calculator2, (uint8_t *)pixel_to_hash, sizeof(pixel_to_hash));
+                x->hash_value_buffer[1][0][pos] = svt_av1_get_crc32c_value((uint8_t *)pixel_to_hash,
+                                                                           sizeof(pixel_to_hash));
             }
         }
     } else {
@@ -300,8 +314,7 @@ void svt_av1_get_block_hash_value(uint8_t *y_src, int stride, int block_size, ui
                 assert(pos < AOM_BUFFER_SIZE_FOR_BLOCK_HASH);
                 x->hash_value_buffer[0][0][pos] = svt_av1_get_crc_value(
                     &x->crc_calculator1, pixel_to_hash, sizeof(pixel_to_hash));
-                x->hash_value_buffer[1][0][pos] = svt_av1_get_crc_value(
-                    &x->crc_calculator2, pixel_to_hash, sizeof(pixel_to_hash));
+                x->hash_value_buffer[1][0][pos] = svt_av1_get_crc32c_value(pixel_to_hash, sizeof(pixel_to_hash));
             }
         }
     }
@@ -336,8 +349,8 @@ void svt_av1_get_block_hash_value(uint8_t *y_src, int stride, int block_size, ui
                 to_hash[1] = x->hash_value_buffer[1][src_idx][src_pos + 1];
                 to_hash[2] = x->hash_value_buffer[1][src_idx][src_pos + src_sub_block_in_width];
                 to_hash[3] = x->hash_value_buffer[1][src_idx][src_pos + src_sub_block_in_width + 1];
-                x->hash_value_buffer[1][dst_idx][dst_pos] = svt_av1_get_crc_value(
-                    &x->crc_calculator2, (uint8_t *)to_hash, sizeof(to_hash));
+                x->hash_value_buffer[1][dst_idx][dst_pos] = svt_av1_get_crc32c_value((uint8_t *)to_hash,
+                                                                                     sizeof(to_hash));
                 dst_pos++;
             }
         }
@@ -349,3 +362,97 @@ void svt_av1_get_block_hash_value(uint8_t *y_src, int stride, int block_size, ui
     *hash_value1 = (x->hash_value_buffer[0][dst_idx][0] & crc_mask) + add_value;
     *hash_value2 = x->hash_value_buffer[1][dst_idx][0];
 }
+
+EbErrorType svt_av1_build_hash_table(HashTable *p_hash_table, const Yv12BufferConfig *picture,
+                                     CRC_CALCULATOR *crc_calculator, int min_block_size, int max_block_size) {
+    const int pic_width  = picture->y_crop_width;
+    const int pic_height = picture->y_crop_height;
+
+    uint32_t *block_hash_values[2][2] = {{NULL}};
+    int8_t   *is_block_same[2][3]     = {{NULL}};
+    EbErrorType err_code              = svt_aom_rtime_alloc_svt_av1_hash_table_create(p_hash_table);
+    for (int k = 0; k < 2 && err_code == EB_ErrorNone; k++) {
+        for (int j = 0; j < 2; j++) {
+            EB_NO_THROW_MALLOC(block_hash_values[k][j], sizeof(uint32_t) * pic_width * pic_height);
+            if (!block_hash_values[k][j])
+                err_code = EB_ErrorInsufficientResources;
+        }
+        for (int j = 0; j < 3; j++) {
+            EB_NO_THROW_MALLOC(is_block_same[k][j], sizeof(int8_t) * pic_width * pic_height);
+            if (!is_block_same[k][j])
+                err_code = EB_ErrorInsufficientResources;
+        }
+    }
+    if (err_code == EB_ErrorNone) {
+        svt_av1_generate_block_2x2_hash_value(picture, block_hash_values[0], is_block_same[0], crc_calculator);
+        int src_idx = 0;
+        for (int size = 4; size <= max_block_size; size <<= 1, src_idx = !src_idx) {
+            const int dst_idx = !src_idx;
+            svt_av1_generate_block_hash_value(picture,
+                                              size,
+                                              block_hash_values[src_idx],
+                                              block_hash_values[dst_idx],
+                                              is_block_same[src_idx],
+                                              is_block_same[dst_idx],
+                                              crc_calculator);
+            if (size >= min_block_size && err_code == EB_ErrorNone)
+                err_code = svt_aom_rtime_alloc_svt_av1_add_to_hash_map_by_row_with_precal_data(
+                    p_hash_table, block_hash_values[dst_idx], is_block_same[dst_idx][2], pic_width, pic_height, size);
+        }
+    }
+    for (int k = 0; k < 2; k++) {
+        for (int j = 0; j < 2; j++) EB_FREE(block_hash_values[k][j]);
+        for (int j = 0; j < 3; j++) EB_FREE(is_block_same[k][j]);
+    }
+    return err_code;
+}
+
+void svt_av1_get_b64_block_hash_values(const uint8_t *y_src, int stride, CRC_CALCULATOR *crc_calculator,
+                                       uint32_t hash_value1[3][16], uint32_t hash_value2[3][16]) {
+    const int crc_mask = (1 << crc_bits) - 1;
+    // [first hash/second hash][two buffers used ping-pong], 2x2 hash values of the 64x64 block at most
+    uint32_t buf[2][2][32 * 32];
+    uint32_t to_hash[4];
+    uint8_t  pixel_to_hash[4];
+
+    for (int y_pos = 0; y_pos < 32; y_pos++) {
+        for (int x_pos = 0; x_pos < 32; x_pos++) {
+            get_pixels_in_1d_char_array_by_block_2x2((uint8_t *)y_src + 2 * y_pos * stride + 2 * x_pos,
+                                                     stride,
+                                                     pixel_to_hash);
+            buf[0][0][y_pos * 32 + x_pos] = svt_av1_get_crc_value(
+                crc_calculator, pixel_to_hash, sizeof(pixel_to_hash));
+            buf[1][0][y_pos * 32 + x_pos] = svt_av1_get_crc32c_value(pixel_to_hash, sizeof(pixel_to_hash));
+        }
+    }
+
+    // 4x4 to 64x64 hash values, each from the four blocks of half its size, as in the hash table
+    int src_idx = 0;
+    for (int size = 4, src_width = 32; size <= 64; size <<= 1, src_width >>= 1, src_idx = !src_idx) {
+        const int dst_idx   = !src_idx;
+        const int dst_width = src_width >> 1;
+        for (int y_pos = 0; y_pos < dst_width; y_pos++) {
+            for (int x_pos = 0; x_pos < dst_width; x_pos++) {
+                const int src_pos = (y_pos << 1) * src_width + (x_pos << 1);
+                const int dst_pos = y_pos * dst_width + x_pos;
+                for (int k = 0; k < 2; k++) {
+                    to_hash[0] = buf[k][src_idx][src_pos];
+                    to_hash[1] = buf[k][src_idx][src_pos + 1];
+                    to_hash[2] = buf[k][src_idx][src_pos + src_width];
+                    to_hash[3] = buf[k][src_idx][src_pos + src_width + 1];
+                    buf[k][dst_idx][dst_pos] = k ? svt_av1_get_crc32c_value((uint8_t *)to_hash, sizeof(to_hash))
+                                                 : svt_av1_get_crc_value(
+                                                       crc_calculator, (uint8_t *)to_hash, sizeof(to_hash));
+                }
+            }
+        }
+        if (size >= 16) {
+            const int level     = size == 16 ? 0 : size == 32 ? 1 : 2;
+            const int add_value = hash_block_size_to_index(size) << crc_bits;
+            for (int pos = 0; pos < dst_width * dst_width; pos++) {
+                hash_value1[level][pos] = (buf[0][dst_idx][pos] & crc_mask) + add_value;
+                hash_value2[level][pos] = buf[1][dst_idx][pos];
+            }
+        }
+    }
+}
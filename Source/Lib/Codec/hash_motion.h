@@ -30,22 +30,36 @@ typedef struct _block_hash {
     uint32_t hash_value2;
 } BlockHash;
 
+// Block sizes of the hash table, 4x4 to 128x128
+#define HASH_BLOCK_SIZE_COUNT 6
+// The blocks of each size by hash value: those of the value v are entries[offsets[v]] to
+// entries[offsets[v + 1] - 1], in the order they were added. NULL for the sizes not added
 typedef struct HashTable {
-    Vector **p_lookup_table;
+    uint32_t  *offsets[HASH_BLOCK_SIZE_COUNT];
+    BlockHash *entries[HASH_BLOCK_SIZE_COUNT];
 } HashTable;
 void        svt_av1_hash_table_destroy(HashTable *p_hash_table);
 EbErrorType svt_aom_rtime_alloc_svt_av1_hash_table_create(HashTable *p_hash_table);
 int32_t     svt_av1_hash_table_count(const HashTable *p_hash_table, uint32_t hash_value);
 Iterator    svt_av1_hash_get_first_iterator(HashTable *p_hash_table, uint32_t hash_value);
 void        svt_av1_generate_block_2x2_hash_value(const Yv12BufferConfig *picture, uint32_t *pic_block_hash[2],
-                                                  int8_t *pic_block_same_info[3], struct PictureControlSet *pcs);
+                                                  int8_t *pic_block_same_info[3], CRC_CALCULATOR *crc_calculator);
 
 void svt_av1_generate_block_hash_value(const Yv12BufferConfig *picture, int block_size, uint32_t *src_pic_block_hash[2],
                                        uint32_t *dst_pic_block_hash[2], int8_t *src_pic_block_same_info[3],
-                                       int8_t *dst_pic_block_same_info[3], struct PictureControlSet *pcs);
-void svt_aom_rtime_alloc_svt_av1_add_to_hash_map_by_row_with_precal_data(HashTable *p_hash_table, uint32_t *pic_hash[2],
-                                                                         int8_t *pic_is_same, int pic_width,
-                                                                         int pic_height, int block_size);
+                                       int8_t *dst_pic_block_same_info[3], CRC_CALCULATOR *crc_calculator);
+// Adds the blocks of block_size flagged in pic_is_same, replacing the ones of that size added before
+EbErrorType svt_aom_rtime_alloc_svt_av1_add_to_hash_map_by_row_with_precal_data(HashTable *p_hash_table,
+                                                                                uint32_t *pic_hash[2],
+                                                                                int8_t *pic_is_same, int pic_width,
+                                                                                int pic_height, int block_size);
+// Builds the hash table of the min_block_size to max_block_size blocks of picture, (re)creating p_hash_table
+EbErrorType svt_av1_build_hash_table(HashTable *p_hash_table, const Yv12BufferConfig *picture,
+                                     CRC_CALCULATOR *crc_calculator, int min_block_size, int max_block_size);
+// Hash values, as keyed in the hash table, of the aligned 16x16, 32x32 and 64x64 blocks of the 64x64 block at
+// y_src: hash_value1[i][j] / hash_value2[i][j] for the size 16 << i and the raster index j
+void svt_av1_get_b64_block_hash_values(const uint8_t *y_src, int stride, CRC_CALCULATOR *crc_calculator,
+                                       uint32_t hash_value1[3][16], uint32_t hash_value2[3][16]);
 
 // check whether the block starts from (x_start, y_start) with the size of
 // BlockSize x BlockSize has the same color in all rows
@@ -24,6 +24,7 @@
 #include "svt_log.h"
 #include "pd_process.h"
 #include "firstpass.h"
+#include "svt_trace.h"
 /**************************************
  * Context
  **************************************/
@@ -672,6 +673,7 @@ void *svt_aom_initial_rate_control_kernel(void *input_ptr) {
 
         MotionEstimationResults *in_results_ptr = (MotionEstimationResults *)in_results_wrapper_ptr->object_ptr;
         PictureParentControlSet *pcs            = (PictureParentControlSet *)in_results_ptr->pcs_wrapper->object_ptr;
+        SVT_TRACE_TASK("InitialRateControl", pcs->picture_number, -1);
 
         // Set the segment counter
         pcs->me_segments_completion_count++;
@@ -679,6 +681,8 @@ void *svt_aom_initial_rate_control_kernel(void *input_ptr) {
         // If the picture is complete, proceed
         if (pcs->me_segments_completion_count == pcs->me_segments_total_count) {
             SequenceControlSet *scs = pcs->scs;
+            // The hash based ME of the picture is done
+            svt_aom_release_pa_reference_hash_tables(pcs);
 
             pcs->norm_me_dist = 0;
             if (pcs->slice_type != I_SLICE) {
@@ -30,6 +30,7 @@
 #include "enc_mode_config.h"
 #include "global_me.h"
 #include "aom_dsp_rtcd.h"
+#include "svt_trace.h"
 #define MAX_MESH_SPEED 5 // Max speed setting for mesh motion method
 static MeshPattern good_quality_mesh_patterns[MAX_MESH_SPEED + 1][MAX_MESH_STEP] = {
     {{64, 8}, {28, 4}, {15, 1}, {7, 1}},
@@ -527,7 +528,6 @@ static void av1_setup_motion_field(Av1Common *cm, PictureControlSet *pcs) {
         motion_field_projection(cm, pcs, LAST2_FRAME, 2);
 }
 EbErrorType svt_av1_hash_table_create(HashTable *p_hash_table);
-void       *rtime_alloc_block_hash_block_is_same(size_t size) { return malloc(size); }
 int32_t     svt_aom_noise_log1p_fp16(int32_t noise_level_fp16);
 /* Determine the frame complexity level (stored under pcs->coeff_lvl) based
 on the ME distortion and QP. */
@@ -631,6 +631,7 @@ void *svt_aom_mode_decision_configuration_kernel(void *input_ptr) {
 
         RateControlResults *rc_results = (RateControlResults *)rc_results_wrapper->object_ptr;
         PictureControlSet  *pcs        = (PictureControlSet *)rc_results->pcs_wrapper->object_ptr;
+        SVT_TRACE_TASK("ModeDecisionConfig", pcs->picture_number, -1);
         SequenceControlSet *scs        = pcs->scs;
         pcs->min_me_clpx               = 0;
         pcs->max_me_clpx               = 0;
@@ -754,52 +755,17 @@ void *svt_aom_mode_decision_configuration_kernel(void *input_ptr) {
 
             {
                 // add to hash table
-                const int pic_width  = pcs->ppcs->aligned_width;
-                const int pic_height = pcs->ppcs->aligned_height;
-
-                uint32_t *block_hash_values[2][2];
-                int8_t   *is_block_same[2][3];
-                int       k, j;
-
-                for (k = 0; k < 2; k++) {
-                    for (j = 0; j < 2; j++)
-                        block_hash_values[k][j] = rtime_alloc_block_hash_block_is_same(sizeof(uint32_t) * pic_width *
-                                                                                       pic_height);
-                    for (j = 0; j < 3; j++)
-                        is_block_same[k][j] = rtime_alloc_block_hash_block_is_same(sizeof(int8_t) * pic_width *
-                                                                                   pic_height);
-                }
-                svt_aom_rtime_alloc_svt_av1_hash_table_create(&pcs->hash_table);
                 Yv12BufferConfig cpi_source;
                 svt_aom_link_eb_to_aom_buffer_desc_8bit(pcs->ppcs->enhanced_pic, &cpi_source);
 
+                // The second hash is the CRC32C of svt_av1_get_crc32c_value()
                 svt_av1_crc_calculator_init(&pcs->crc_calculator1, 24, 0x5D6DCB);
-                svt_av1_crc_calculator_init(&pcs->crc_calculator2, 24, 0x864CFB);
-
-                svt_av1_generate_block_2x2_hash_value(&cpi_source, block_hash_values[0], is_block_same[0], pcs);
-                uint8_t       src_idx     = 0;
-                const uint8_t max_sb_size = pcs->ppcs->intraBC_ctrls.max_block_size_hash;
-                for (int size = 4; size <= max_sb_size; size <<= 1, src_idx = !src_idx) {
-                    const uint8_t dst_idx = !src_idx;
-                    svt_av1_generate_block_hash_value(&cpi_source,
-                                                      size,
-                                                      block_hash_values[src_idx],
-                                                      block_hash_values[dst_idx],
-                                                      is_block_same[src_idx],
-                                                      is_block_same[dst_idx],
-                                                      pcs);
-                    if (size != 4 || pcs->ppcs->intraBC_ctrls.hash_4x4_blocks)
-                        svt_aom_rtime_alloc_svt_av1_add_to_hash_map_by_row_with_precal_data(&pcs->hash_table,
-                                                                                            block_hash_values[dst_idx],
-                                                                                            is_block_same[dst_idx][2],
-                                                                                            pic_width,
-                                                                                            pic_height,
-                                                                                            size);
-                }
-                for (k = 0; k < 2; k++) {
-                    for (j = 0; j < 2; j++) free(block_hash_values[k][j]);
-                    for (j = 0; j < 3; j++) free(is_block_same[k][j]);
-                }
+
+                svt_av1_build_hash_table(&pcs->hash_table,
+                                         &cpi_source,
+                                         &pcs->crc_calculator1,
+                                         pcs->ppcs->intraBC_ctrls.hash_4x4_blocks ? 4 : 8,
+                                         pcs->ppcs->intraBC_ctrls.max_block_size_hash);
             }
 
             svt_av1_init3smotion_compensation(&pcs->ss_cfg, pcs->ppcs->enhanced_pic->stride_y);
@@ -32,6 +32,8 @@ EbErrorType svt_aom_me_context_ctor(MeContext *object_ptr) {
     object_ptr->num_of_list_to_search       = 1;
     object_ptr->num_of_ref_pic_to_search[0] = 0;
     object_ptr->num_of_ref_pic_to_search[1] = 0;
+    // Same hash functions as the hash tables of the references
+    svt_av1_crc_calculator_init(&object_ptr->crc_calculator, 24, 0x5D6DCB);
 
     return EB_ErrorNone;
 }
@@ -317,6 +317,18 @@ typedef struct Me8x8VarCtrls {
     // If ME 8x8 SAD variance is above me_sr_mult2_th, multiply the search area width/height by 2
     uint32_t me_sr_mult2_th;
 } Me8x8VarCtrls;
+/* HashMeCtrls control the hash based ME of screen content: the aligned blocks of the 64x64 block are looked up
+* in the hash tables of the references, and the exact matches are used as ME results. When every block of the
+* 64x64 block matches in at least one reference, HME and the full-pel search are skipped.
+*/
+typedef struct HashMeCtrls {
+    // If true, search the exact matches of the blocks in the hash tables of the references
+    uint8_t enabled;
+    // Smallest block size looked up (16, 32 or 64); the hash tables hold the 16x16 to 64x64 blocks
+    uint8_t min_block_size;
+    // Maximum number of entries of the hash table checked per lookup, bounds the lookups of flat blocks
+    uint16_t max_candidates;
+} HashMeCtrls;
 #define SEARCH_REGION_COUNT 2
 typedef struct SearchArea {
     uint16_t width; // search area width
@@ -413,6 +425,10 @@ typedef struct MeContext {
     MeHmeRefPruneCtrls me_hme_prune_ctrls;
     MeSrCtrls          me_sr_adjustment_ctrls;
     Me8x8VarCtrls      me_8x8_var_ctrls;
+    HashMeCtrls        hash_me_ctrls;
+    CRC_CALCULATOR     crc_calculator;
+    // Hash tables of the references, NULL when not available
+    struct HashTable  *hash_me_table[MAX_NUM_OF_REF_PIC_LIST][REF_LIST_MAX_DEPTH];
     uint8_t            max_hme_sr_area_multipler;
     MvBasedSearchAdj   mv_based_sa_adj;
     // ME
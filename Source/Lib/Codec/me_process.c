@@ -34,6 +34,7 @@
 #include "firstpass.h"
 #include "initial_rc_process.h"
 #include "enc_mode_config.h"
+#include "svt_trace.h"
 
 /* --32x32-
 |00||01|
@@ -107,6 +108,7 @@ void *svt_aom_motion_estimation_kernel(void *input_ptr) {
                                                      in_results_wrapper_ptr->object_ptr;
         PictureParentControlSet *pcs = (PictureParentControlSet *)
                                                in_results_ptr->pcs_wrapper->object_ptr;
+        SVT_TRACE_TASK("MotionEstimation", pcs->picture_number, (int32_t)in_results_ptr->segment_index);
         SequenceControlSet *scs = pcs->scs;
         if (in_results_ptr->task_type == TASK_TFME)
             me_context_ptr->me_ctx->me_type = ME_MCTF;
@@ -170,6 +172,9 @@ void *svt_aom_motion_estimation_kernel(void *input_ptr) {
                                                      &quarter_picture_ptr,
                                                      &sixteenth_picture_ptr);
 
+                    // Hash the references once for the hash based ME
+                    svt_aom_hash_me_setup(pcs, me_context_ptr->me_ctx);
+
                     // 64x64 Block Loop
                     for (uint32_t y_b64_index = y_b64_start_index; y_b64_index < y_b64_end_index; ++y_b64_index) {
                         for (uint32_t x_b64_index = x_b64_start_index; x_b64_index < x_b64_end_index; ++x_b64_index) {
@@ -319,8 +324,10 @@ void *svt_aom_motion_estimation_kernel(void *input_ptr) {
                     pcs->temp_filt_pcs_list);
             // temporal filtering start
             me_context_ptr->me_ctx->me_type = ME_MCTF;
+            const SvtAv1MemCategory mem_category = svt_mem_set_category(SVT_AV1_MEM_TF);
             svt_av1_init_temporal_filtering(
                 pcs->temp_filt_pcs_list, pcs, me_context_ptr, in_results_ptr->segment_index);
+            svt_mem_set_category(mem_category);
 
             // Release the Input Results
             svt_release_object(in_results_wrapper_ptr);
@@ -1664,28 +1664,33 @@ static void prehme_core(MeContext *me_ctx, int16_t org_x, int16_t org_y, uint32_
     prehme_data->valid = 1;
     return;
 }
-static uint32_t get_zz_sad(EbPictureBufferDesc *ref_pic_ptr, MeContext *me_ctx, uint32_t sb_origin_x,
-                    uint32_t sb_origin_y, uint32_t sb_width, uint32_t sb_height)
+// Full-pel SAD of the 64x64 block at (mv_x, mv_y), computed on every other line
+static uint32_t get_mv_sad(EbPictureBufferDesc *ref_pic_ptr, MeContext *me_ctx, uint32_t sb_origin_x,
+                           uint32_t sb_origin_y, uint32_t sb_width, uint32_t sb_height, int16_t mv_x, int16_t mv_y)
 
 {
-    uint32_t search_region_index, zero_mv_sad;
-    int16_t  org_x      = (int16_t)sb_origin_x;
-    int16_t  org_y      = (int16_t)sb_origin_y;
+    uint32_t search_region_index, mv_sad;
+    int16_t  org_x      = (int16_t)sb_origin_x + mv_x;
+    int16_t  org_y      = (int16_t)sb_origin_y + mv_y;
     uint32_t subsample_sad = 1;
 
     search_region_index = (int16_t)ref_pic_ptr->org_x + org_x +
         ((int16_t)ref_pic_ptr->org_y + org_y) * ref_pic_ptr->stride_y;
 
-    zero_mv_sad = svt_nxm_sad_kernel(me_ctx->b64_src_ptr,
-                                     me_ctx->b64_src_stride << subsample_sad,
-                                     &(ref_pic_ptr->buffer_y[search_region_index]),
-                                     ref_pic_ptr->stride_y << subsample_sad,
-                                     sb_height >> subsample_sad,
-                                     sb_width);
+    mv_sad = svt_nxm_sad_kernel(me_ctx->b64_src_ptr,
+                                me_ctx->b64_src_stride << subsample_sad,
+                                &(ref_pic_ptr->buffer_y[search_region_index]),
+                                ref_pic_ptr->stride_y << subsample_sad,
+                                sb_height >> subsample_sad,
+                                sb_width);
 
-    zero_mv_sad = zero_mv_sad << subsample_sad;
+    mv_sad = mv_sad << subsample_sad;
 
-    return zero_mv_sad;
+    return mv_sad;
+}
+static uint32_t get_zz_sad(EbPictureBufferDesc *ref_pic_ptr, MeContext *me_ctx, uint32_t sb_origin_x,
+                    uint32_t sb_origin_y, uint32_t sb_width, uint32_t sb_height) {
+    return get_mv_sad(ref_pic_ptr, me_ctx, sb_origin_x, sb_origin_y, sb_width, sb_height, 0, 0);
 }
 // Determine if pre-HME for the current picture and search region should be skipped.
 // Return 1 if can early exit (i.e. skip pre-hme for current frame and search region)
@@ -2434,6 +2439,165 @@ static void init_zz_sad(PictureParentControlSet *pcs, MeContext *me_ctx, uint32_
     }
 
 
+}
+/*******************************************
+ * Motion hints
+ *******************************************/
+static void insert_sorted_mv(int16_t *sorted, uint32_t count, int16_t mv) {
+    uint32_t i = count;
+    for (; i > 0 && sorted[i - 1] > mv; i--) sorted[i] = sorted[i - 1];
+    sorted[i] = mv;
+}
+// Median hint of the blocks of the field covering the 64x64 block, false when none of them has a hint
+static bool get_b64_motion_hint(const SvtAv1MotionHints *hints, uint32_t org_x, uint32_t org_y,
+                                uint32_t block_width, uint32_t block_height, int16_t *hint_x, int16_t *hint_y) {
+    const uint32_t bs      = hints->block_size;
+    const uint32_t col_end = MIN(hints->cols, (org_x + block_width + bs - 1) / bs);
+    const uint32_t row_end = MIN(hints->rows, (org_y + block_height + bs - 1) / bs);
+    // At most (64 / 8) * (64 / 8) blocks of the field
+    int16_t  sorted_x[64], sorted_y[64];
+    uint32_t count = 0;
+    for (uint32_t row = org_y / bs; row < row_end; row++) {
+        for (uint32_t col = org_x / bs; col < col_end; col++) {
+            const int16_t *mv = &hints->mv[2 * (row * hints->cols + col)];
+            if (mv[0] == INT16_MIN)
+                continue;
+            insert_sorted_mv(sorted_x, count, mv[0]);
+            insert_sorted_mv(sorted_y, count, mv[1]);
+            count++;
+        }
+    }
+    if (!count)
+        return false;
+    *hint_x = sorted_x[count >> 1];
+    *hint_y = sorted_y[count >> 1];
+    return true;
+}
+// Clips a full-pel search centre to the search bounds of HME level 2
+static void clip_search_centre(EbPictureBufferDesc *ref_pic, uint32_t org_x, uint32_t org_y, int32_t x, int32_t y,
+                               int16_t *sc_x, int16_t *sc_y) {
+    const int32_t pad = BLOCK_SIZE_64 - 1;
+    *sc_x = (int16_t)CLIP3(-pad - (int32_t)org_x, (int32_t)ref_pic->width - 1 - (int32_t)org_x, x);
+    *sc_y = (int16_t)CLIP3(-pad - (int32_t)org_y, (int32_t)ref_pic->height - 1 - (int32_t)org_y, y);
+}
+// Full-pel search centre of a reference for the hint, scaled by the signed distance to the reference
+static void get_ref_motion_hint(PictureParentControlSet *pcs, MeContext *me_ctx, uint8_t list_index,
+                                uint8_t ref_pic_index, EbPictureBufferDesc *ref_pic, uint32_t org_x, uint32_t org_y,
+                                int16_t hint_x, int16_t hint_y, int16_t *sc_x, int16_t *sc_y) {
+    const int32_t dist = (int32_t)((int64_t)pcs->picture_number -
+                                   (int64_t)me_ctx->me_ds_ref_array[list_index][ref_pic_index].picture_number);
+    clip_search_centre(ref_pic,
+                       org_x,
+                       org_y,
+                       ROUND_POWER_OF_TWO_SIGNED(hint_x * dist, 3),
+                       ROUND_POWER_OF_TWO_SIGNED(hint_y * dist, 3),
+                       sc_x,
+                       sc_y);
+}
+// Replaces pre-HME and HME levels 0 and 1 with the hint of the 64x64 block; HME level 2, when enabled,
+// refines around it. Returns false when the block has no hint.
+static bool hint_hme_b64(PictureParentControlSet *pcs, uint32_t org_x, uint32_t org_y, MeContext *me_ctx,
+                         EbPictureBufferDesc *input_ptr) {
+    int16_t hint_x, hint_y;
+    if (!get_b64_motion_hint(
+            pcs->mv_hints, org_x, org_y, me_ctx->b64_width, me_ctx->b64_height, &hint_x, &hint_y))
+        return false;
+    // A single search region, centred on the hint
+    const uint16_t num_hme_sa_w = me_ctx->num_hme_sa_w;
+    const uint16_t num_hme_sa_h = me_ctx->num_hme_sa_h;
+    me_ctx->num_hme_sa_w        = 1;
+    me_ctx->num_hme_sa_h        = 1;
+    for (int list_index = REF_LIST_0; list_index < me_ctx->num_of_list_to_search; ++list_index) {
+        for (uint8_t ref_pic_index = 0; ref_pic_index < me_ctx->num_of_ref_pic_to_search[list_index];
+             ++ref_pic_index) {
+            if (me_ctx->temporal_layer_index == 0 && list_index != 0)
+                continue;
+            uint16_t             dist    = 0;
+            EbPictureBufferDesc *ref_pic = get_me_reference(
+                pcs, me_ctx, list_index, ref_pic_index, 2, &dist, input_ptr->width, input_ptr->height);
+            int16_t sc_x, sc_y;
+            get_ref_motion_hint(
+                pcs, me_ctx, list_index, ref_pic_index, ref_pic, org_x, org_y, hint_x, hint_y, &sc_x, &sc_y);
+            // Still fall back to the zero motion vector, e.g. for static or noisy areas
+            uint64_t sad = get_mv_sad(
+                ref_pic, me_ctx, org_x, org_y, me_ctx->b64_width, me_ctx->b64_height, sc_x, sc_y);
+            if (sc_x || sc_y) {
+                const uint64_t zz_sad = get_zz_sad(
+                    ref_pic, me_ctx, org_x, org_y, me_ctx->b64_width, me_ctx->b64_height);
+                if (zz_sad <= sad) {
+                    sc_x = sc_y = 0;
+                    sad         = zz_sad;
+                }
+            }
+            if (me_ctx->enable_hme_level2_flag) {
+                me_ctx->x_hme_level1_search_center[list_index][ref_pic_index][0][0] = sc_x;
+                me_ctx->y_hme_level1_search_center[list_index][ref_pic_index][0][0] = sc_y;
+                // Never skip the level 2 refinement of a hint
+                me_ctx->hme_level1_sad[list_index][ref_pic_index][0][0] = (uint64_t)~0;
+                continue;
+            }
+            // Scale the SAD to the resolution of the level it replaces, as the ME thresholds do
+            if (me_ctx->enable_hme_level1_flag) {
+                me_ctx->x_hme_level1_search_center[list_index][ref_pic_index][0][0] = sc_x;
+                me_ctx->y_hme_level1_search_center[list_index][ref_pic_index][0][0] = sc_y;
+                me_ctx->hme_level1_sad[list_index][ref_pic_index][0][0]             = sad >> 2;
+            } else {
+                me_ctx->x_hme_level0_search_center[list_index][ref_pic_index][0][0] = sc_x;
+                me_ctx->y_hme_level0_search_center[list_index][ref_pic_index][0][0] = sc_y;
+                me_ctx->hme_level0_sad[list_index][ref_pic_index][0][0]             = sad >> 4;
+            }
+        }
+    }
+    if (me_ctx->enable_hme_level2_flag)
+        hme_level2_b64(pcs, org_x, org_y, me_ctx, input_ptr);
+    set_final_seach_centre_sb(pcs, me_ctx);
+    me_ctx->num_hme_sa_w = num_hme_sa_w;
+    me_ctx->num_hme_sa_h = num_hme_sa_h;
+    return true;
+}
+// Uses the hint of the 64x64 block as search centre of the references where its SAD is clearly lower than
+// the one of the HME search centre; a hint only slightly better is usually noise and costs the HME centre
+static void seed_motion_hint_b64(PictureParentControlSet *pcs, uint32_t org_x, uint32_t org_y, MeContext *me_ctx,
+                                 EbPictureBufferDesc *input_ptr) {
+    int16_t hint_x, hint_y;
+    if (!get_b64_motion_hint(
+            pcs->mv_hints, org_x, org_y, me_ctx->b64_width, me_ctx->b64_height, &hint_x, &hint_y))
+        return;
+    uint64_t best_cost = (uint64_t)~0;
+    for (int list_index = REF_LIST_0; list_index < me_ctx->num_of_list_to_search; ++list_index) {
+        for (uint8_t ref_pic_index = 0; ref_pic_index < me_ctx->num_of_ref_pic_to_search[list_index];
+             ++ref_pic_index) {
+            if (me_ctx->temporal_layer_index == 0 && list_index != 0)
+                continue;
+            SearchResults       *res     = &me_ctx->search_results[list_index][ref_pic_index];
+            uint16_t             dist    = 0;
+            EbPictureBufferDesc *ref_pic = get_me_reference(
+                pcs, me_ctx, list_index, ref_pic_index, 2, &dist, input_ptr->width, input_ptr->height);
+            int16_t sc_x, sc_y;
+            get_ref_motion_hint(
+                pcs, me_ctx, list_index, ref_pic_index, ref_pic, org_x, org_y, hint_x, hint_y, &sc_x, &sc_y);
+            if (sc_x != res->hme_sc_x || sc_y != res->hme_sc_y) {
+                // Both SADs are taken at full resolution; the HME one may come from a lower level
+                int16_t hme_x, hme_y;
+                clip_search_centre(ref_pic, org_x, org_y, res->hme_sc_x, res->hme_sc_y, &hme_x, &hme_y);
+                const uint32_t hme_sad  = get_mv_sad(
+                    ref_pic, me_ctx, org_x, org_y, me_ctx->b64_width, me_ctx->b64_height, hme_x, hme_y);
+                const uint32_t hint_sad = get_mv_sad(
+                    ref_pic, me_ctx, org_x, org_y, me_ctx->b64_width, me_ctx->b64_height, sc_x, sc_y);
+                if (hint_sad < hme_sad - (hme_sad >> 3)) {
+                    // Keep the SAD in the units of the HME level that produced the centre
+                    res->hme_sad  = res->hme_sad * hint_sad / hme_sad;
+                    res->hme_sc_x = sc_x;
+                    res->hme_sc_y = sc_y;
+                }
+            }
+            if (res->hme_sad < best_cost) {
+                best_cost             = res->hme_sad;
+                me_ctx->best_list_idx = list_index;
+                me_ctx->best_ref_idx  = ref_pic_index;
+            }
+        }
+    }
 }
 /*******************************************
  * performs hierarchical ME for a 64x64 block for every ref frame
@@ -2444,6 +2608,13 @@ static void hme_b64(PictureParentControlSet *pcs, uint32_t org_x, uint32_t org_y
     if (me_ctx->me_early_exit_th || me_ctx->me_safe_limit_zz_th  )
         init_zz_sad(pcs, me_ctx, org_x, org_y);
 
+    // Motion hints of the application only apply to the open loop ME of the picture
+    const SvtAv1MotionHints *mv_hints = me_ctx->me_type == ME_OPEN_LOOP ? pcs->mv_hints : NULL;
+    if (mv_hints && mv_hints->trust == SVT_AV1_MV_HINT_REPLACE_HME && me_ctx->enable_hme_flag &&
+        (me_ctx->enable_hme_level0_flag || me_ctx->enable_hme_level1_flag || me_ctx->enable_hme_level2_flag) &&
+        hint_hme_b64(pcs, org_x, org_y, me_ctx, input_ptr))
+        return;
+
     if (me_ctx->prehme_ctrl.enable) {
         // perform pre-HME
         prehme_b64(pcs, org_x, org_y, me_ctx, input_ptr);
@@ -2466,6 +2637,9 @@ static void hme_b64(PictureParentControlSet *pcs, uint32_t org_x, uint32_t org_y
     // Set final MV centre
     set_final_seach_centre_sb(pcs, me_ctx);
 
+    if (mv_hints)
+        seed_motion_hint_b64(pcs, org_x, org_y, me_ctx, input_ptr);
+
     if (me_ctx->me_type == ME_MCTF) {
         if (ABS(me_ctx->search_results[0][0].hme_sc_x) > ABS(me_ctx->search_results[0][0].hme_sc_y))
             me_ctx->tf_tot_horz_blks++;
@@ -3068,6 +3242,279 @@ static INLINE void init_me_hme_data(MeContext *me_ctx) {
     memset(me_ctx->performed_phme,0,
         sizeof(uint8_t)*MAX_NUM_OF_REF_PIC_LIST*REF_LIST_MAX_DEPTH*SEARCH_REGION_COUNT);
 }
+/*******************************************
+ * Hash based ME
+ *******************************************/
+// Exact matches of the 64x64, 32x32 and 16x16 blocks of the 64x64 block in a reference, by ME PU index
+typedef struct HashMeHits {
+    bool     hit[ME_TIER_ZERO_PU_8x8_0];
+    uint32_t mv[ME_TIER_ZERO_PU_8x8_0];
+    // Number of the 16x16 blocks covered by the matches
+    uint8_t covered_16x16;
+} HashMeHits;
+
+void svt_aom_hash_me_setup(PictureParentControlSet *pcs, MeContext *me_ctx) {
+    memset(me_ctx->hash_me_table, 0, sizeof(me_ctx->hash_me_table));
+    if (!me_ctx->hash_me_ctrls.enabled || pcs->frame_superres_enabled || pcs->frame_resize_enabled)
+        return;
+    const uint8_t num_of_list_to_search = pcs->slice_type == P_SLICE ? 1 : 2;
+    for (uint8_t list_index = REF_LIST_0; list_index < num_of_list_to_search; list_index++) {
+        const uint8_t num_of_ref = list_index == REF_LIST_0 ? pcs->ref_list0_count_try : pcs->ref_list1_count_try;
+        for (uint8_t ref_pic_index = 0; ref_pic_index < num_of_ref; ref_pic_index++) {
+            EbPaReferenceObject *ref_obj =
+                (EbPaReferenceObject *)pcs->ref_pa_pic_ptr_array[list_index][ref_pic_index]->object_ptr;
+            // Built once per reference, by the first segment searching it
+            svt_block_on_mutex(ref_obj->hash_table_mutex);
+            if (ref_obj->hash_table_picture_number != ref_obj->picture_number) {
+                EbPictureBufferDesc *ref_pic = ref_obj->input_padded_pic;
+                Yv12BufferConfig     picture;
+                memset(&picture, 0, sizeof(picture));
+                picture.y_buffer      = ref_pic->buffer_y + ref_pic->org_x + ref_pic->org_y * ref_pic->stride_y;
+                picture.y_stride      = ref_pic->stride_y;
+                picture.y_crop_width  = ref_pic->width;
+                picture.y_crop_height = ref_pic->height;
+                const SvtAv1MemCategory mem_category = svt_mem_set_category(SVT_AV1_MEM_TF);
+                if (svt_av1_build_hash_table(
+                        &ref_obj->hash_table, &picture, &me_ctx->crc_calculator, 16, BLOCK_SIZE_64) == EB_ErrorNone)
+                    ref_obj->hash_table_picture_number = ref_obj->picture_number;
+                svt_mem_set_category(mem_category);
+            }
+            if (ref_obj->hash_table_picture_number == ref_obj->picture_number)
+                me_ctx->hash_me_table[list_index][ref_pic_index] = &ref_obj->hash_table;
+            svt_release_mutex(ref_obj->hash_table_mutex);
+        }
+    }
+}
+// Full-pel SAD of the block at (x, y) of the 64x64 block
+static uint32_t hash_me_block_sad(MeContext *me_ctx, EbPictureBufferDesc *ref_pic, uint32_t org_x, uint32_t org_y,
+                                  uint32_t x, uint32_t y, uint32_t block_size, int32_t mv_x, int32_t mv_y) {
+    const int32_t ref_x = (int32_t)(org_x + x) + mv_x;
+    const int32_t ref_y = (int32_t)(org_y + y) + mv_y;
+    return svt_nxm_sad_kernel(me_ctx->b64_src_ptr + y * me_ctx->b64_src_stride + x,
+                              me_ctx->b64_src_stride,
+                              ref_pic->buffer_y + (ref_pic->org_y + ref_y) * ref_pic->stride_y + ref_pic->org_x +
+                                  ref_x,
+                              ref_pic->stride_y,
+                              block_size,
+                              block_size);
+}
+// Looks up the block at (x, y) of the 64x64 block in the hash table of the reference; returns false when it has
+// no exact match, else the match of the shortest motion vector
+static bool hash_me_lookup(MeContext *me_ctx, HashTable *table, EbPictureBufferDesc *ref_pic, uint32_t org_x,
+                           uint32_t org_y, uint32_t x, uint32_t y, uint32_t block_size, uint32_t hash_value1,
+                           uint32_t hash_value2, uint32_t *best_mv) {
+    // The co-located block first: static areas are the most common matches, and flat blocks are only in the
+    // table at aligned positions
+    if (hash_me_block_sad(me_ctx, ref_pic, org_x, org_y, x, y, block_size, 0, 0) == 0) {
+        *best_mv = 0;
+        return true;
+    }
+    const int32_t count = MIN(svt_av1_hash_table_count(table, hash_value1), me_ctx->hash_me_ctrls.max_candidates);
+    if (!count)
+        return false;
+    const int32_t pos_x    = (int32_t)(org_x + x);
+    const int32_t pos_y    = (int32_t)(org_y + y);
+    int32_t       best_x   = 0;
+    int32_t       best_y   = 0;
+    int32_t       best_len = INT32_MAX;
+    Iterator      iterator = svt_av1_hash_get_first_iterator(table, hash_value1);
+    for (int32_t i = 0; i < count; i++, svt_aom_iterator_increment(&iterator)) {
+        const BlockHash *ref_block_hash = (const BlockHash *)svt_aom_iterator_get(&iterator);
+        if (ref_block_hash->hash_value2 != hash_value2)
+            continue;
+        const int32_t mv_x = ref_block_hash->x - pos_x;
+        const int32_t mv_y = ref_block_hash->y - pos_y;
+        // Within the range of the AV1 motion vectors, in 1/8 sample
+        if (ABS(mv_x) >= (MV_UPP >> 3) || ABS(mv_y) >= (MV_UPP >> 3))
+            continue;
+        if (ABS(mv_x) + ABS(mv_y) < best_len) {
+            best_len = ABS(mv_x) + ABS(mv_y);
+            best_x   = mv_x;
+            best_y   = mv_y;
+        }
+    }
+    // The hash values may still collide
+    if (best_len == INT32_MAX || hash_me_block_sad(me_ctx, ref_pic, org_x, org_y, x, y, block_size, best_x, best_y))
+        return false;
+    *best_mv = ((uint32_t)best_y << 16) | (uint16_t)best_x;
+    return true;
+}
+// Marks the ME PU and the 32x32 and 16x16 blocks in it as matched by mv
+static void hash_me_set_hit(HashMeHits *hits, uint32_t pu_index, uint32_t mv) {
+    hits->hit[pu_index] = true;
+    hits->mv[pu_index]  = mv;
+    if (pu_index == ME_TIER_ZERO_PU_64x64) {
+        for (uint32_t i = ME_TIER_ZERO_PU_32x32_0; i < ME_TIER_ZERO_PU_8x8_0; i++) {
+            hits->hit[i] = true;
+            hits->mv[i]  = mv;
+        }
+        hits->covered_16x16 = 16;
+    } else if (pu_index < ME_TIER_ZERO_PU_16x16_0) {
+        const uint32_t first_16x16 = ME_TIER_ZERO_PU_16x16_0 + 4 * (pu_index - ME_TIER_ZERO_PU_32x32_0);
+        for (uint32_t i = first_16x16; i < first_16x16 + 4; i++) {
+            hits->hit[i] = true;
+            hits->mv[i]  = mv;
+        }
+        hits->covered_16x16 += 4;
+    } else
+        hits->covered_16x16++;
+}
+/* Looks up the 64x64 block, then the 32x32 blocks it has no match for, then their 16x16 blocks, in the hash
+ * tables of the references. Returns true when every block of the 64x64 block matches in at least one
+ * reference: the matches are then the ME results, and the references without full matches are not searched. */
+static bool hash_me_b64(PictureParentControlSet *pcs, MeContext *me_ctx, uint32_t org_x, uint32_t org_y,
+                        EbPictureBufferDesc *input_ptr, HashMeHits hits[MAX_NUM_OF_REF_PIC_LIST][REF_LIST_MAX_DEPTH]) {
+    const uint32_t min_block_size = me_ctx->hash_me_ctrls.min_block_size;
+    uint32_t       hash_value1[3][16], hash_value2[3][16];
+    bool           hashed    = false;
+    bool           full_hit  = false;
+    // Only the blocks inside the picture are looked up
+    const uint32_t num_16x16 = (me_ctx->b64_width >> 4) * (me_ctx->b64_height >> 4);
+    for (int list_index = REF_LIST_0; list_index < me_ctx->num_of_list_to_search; ++list_index) {
+        for (uint8_t ref_pic_index = 0; ref_pic_index < me_ctx->num_of_ref_pic_to_search[list_index];
+             ++ref_pic_index) {
+            HashMeHits *ref_hits = &hits[list_index][ref_pic_index];
+            memset(ref_hits, 0, sizeof(*ref_hits));
+            HashTable *table = me_ctx->hash_me_table[list_index][ref_pic_index];
+            if (!table || !num_16x16)
+                continue;
+            if (!hashed) {
+                svt_av1_get_b64_block_hash_values(
+                    me_ctx->b64_src_ptr, me_ctx->b64_src_stride, &me_ctx->crc_calculator, hash_value1, hash_value2);
+                hashed = true;
+            }
+            uint16_t             dist    = 0;
+            EbPictureBufferDesc *ref_pic = get_me_reference(
+                pcs, me_ctx, list_index, ref_pic_index, 2, &dist, input_ptr->width, input_ptr->height);
+            uint32_t mv;
+            if (num_16x16 == 16 &&
+                hash_me_lookup(
+                    me_ctx, table, ref_pic, org_x, org_y, 0, 0, 64, hash_value1[2][0], hash_value2[2][0], &mv)) {
+                hash_me_set_hit(ref_hits, ME_TIER_ZERO_PU_64x64, mv);
+            } else {
+                for (uint32_t q = 0; q < 4 && min_block_size <= 32; q++) {
+                    const uint32_t x32 = (q & 1) << 5;
+                    const uint32_t y32 = (q >> 1) << 5;
+                    if (x32 + 32 <= me_ctx->b64_width && y32 + 32 <= me_ctx->b64_height &&
+                        hash_me_lookup(me_ctx,
+                                       table,
+                                       ref_pic,
+                                       org_x,
+                                       org_y,
+                                       x32,
+                                       y32,
+                                       32,
+                                       hash_value1[1][q],
+                                       hash_value2[1][q],
+                                       &mv)) {
+                        hash_me_set_hit(ref_hits, ME_TIER_ZERO_PU_32x32_0 + q, mv);
+                        continue;
+                    }
+                    for (uint32_t k = 0; k < 4 && min_block_size <= 16; k++) {
+                        const uint32_t x16 = x32 + ((k & 1) << 4);
+                        const uint32_t y16 = y32 + ((k >> 1) << 4);
+                        const uint32_t idx = (y16 >> 4) * 4 + (x16 >> 4);
+                        if (x16 + 16 <= me_ctx->b64_width && y16 + 16 <= me_ctx->b64_height &&
+                            hash_me_lookup(me_ctx,
+                                           table,
+                                           ref_pic,
+                                           org_x,
+                                           org_y,
+                                           x16,
+                                           y16,
+                                           16,
+                                           hash_value1[0][idx],
+                                           hash_value2[0][idx],
+                                           &mv))
+                            hash_me_set_hit(ref_hits, ME_TIER_ZERO_PU_16x16_0 + 4 * q + k, mv);
+                    }
+                }
+            }
+            if (num_16x16 == 16 && ref_hits->covered_16x16 == 16)
+                full_hit = true;
+        }
+    }
+    if (!full_hit)
+        return false;
+
+    for (int list_index = REF_LIST_0; list_index < me_ctx->num_of_list_to_search; ++list_index) {
+        for (uint8_t ref_pic_index = 0; ref_pic_index < me_ctx->num_of_ref_pic_to_search[list_index];
+             ++ref_pic_index) {
+            const HashMeHits *ref_hits = &hits[list_index][ref_pic_index];
+            SearchResults    *res      = &me_ctx->search_results[list_index][ref_pic_index];
+            if (ref_hits->covered_16x16 != 16) {
+                res->do_ref = 0;
+                continue;
+            }
+            uint32_t *best_sad = me_ctx->p_sb_best_sad[list_index][ref_pic_index];
+            uint32_t *best_mv  = me_ctx->p_sb_best_mv[list_index][ref_pic_index];
+            for (uint32_t pu_index = ME_TIER_ZERO_PU_16x16_0; pu_index < SQUARE_PU_COUNT; pu_index++) {
+                best_sad[pu_index] = 0;
+                // The 8x8 blocks take the motion vector of their 16x16 block
+                best_mv[pu_index] = ref_hits->mv[pu_index < ME_TIER_ZERO_PU_8x8_0
+                                                     ? pu_index
+                                                     : ME_TIER_ZERO_PU_16x16_0 + ((pu_index - ME_TIER_ZERO_PU_8x8_0) >> 2)];
+            }
+            // The 64x64 and 32x32 blocks matched by their sub-blocks take the motion vector of the top left one
+            uint16_t             dist    = 0;
+            EbPictureBufferDesc *ref_pic = get_me_reference(
+                pcs, me_ctx, list_index, ref_pic_index, 2, &dist, input_ptr->width, input_ptr->height);
+            for (uint32_t pu_index = ME_TIER_ZERO_PU_64x64; pu_index < ME_TIER_ZERO_PU_16x16_0; pu_index++) {
+                const uint32_t q = pu_index - ME_TIER_ZERO_PU_32x32_0;
+                if (ref_hits->hit[pu_index]) {
+                    best_sad[pu_index] = 0;
+                    best_mv[pu_index]  = ref_hits->mv[pu_index];
+                } else if (pu_index == ME_TIER_ZERO_PU_64x64) {
+                    best_mv[pu_index]  = ref_hits->mv[ME_TIER_ZERO_PU_16x16_0];
+                    best_sad[pu_index] = hash_me_block_sad(
+                        me_ctx, ref_pic, org_x, org_y, 0, 0, 64, _MVXT(best_mv[pu_index]), _MVYT(best_mv[pu_index]));
+                } else {
+                    best_mv[pu_index]  = ref_hits->mv[ME_TIER_ZERO_PU_16x16_0 + 4 * q];
+                    best_sad[pu_index] = hash_me_block_sad(me_ctx,
+                                                           ref_pic,
+                                                           org_x,
+                                                           org_y,
+                                                           (q & 1) << 5,
+                                                           (q >> 1) << 5,
+                                                           32,
+                                                           _MVXT(best_mv[pu_index]),
+                                                           _MVYT(best_mv[pu_index]));
+                }
+            }
+            res->hme_sad  = 0;
+            res->hme_sc_x = _MVXT(best_mv[ME_TIER_ZERO_PU_64x64]);
+            res->hme_sc_y = _MVYT(best_mv[ME_TIER_ZERO_PU_64x64]);
+        }
+    }
+    return true;
+}
+// Replaces the searched motion vectors of the blocks matched in the hash tables, e.g. when the match is out of the
+// search area
+static void hash_me_inject_b64(MeContext *me_ctx, HashMeHits hits[MAX_NUM_OF_REF_PIC_LIST][REF_LIST_MAX_DEPTH]) {
+    for (int list_index = REF_LIST_0; list_index < me_ctx->num_of_list_to_search; ++list_index) {
+        for (uint8_t ref_pic_index = 0; ref_pic_index < me_ctx->num_of_ref_pic_to_search[list_index];
+             ++ref_pic_index) {
+            const HashMeHits *ref_hits = &hits[list_index][ref_pic_index];
+            if (!ref_hits->covered_16x16 || !me_ctx->search_results[list_index][ref_pic_index].do_ref)
+                continue;
+            uint32_t *best_sad = me_ctx->p_sb_best_sad[list_index][ref_pic_index];
+            uint32_t *best_mv  = me_ctx->p_sb_best_mv[list_index][ref_pic_index];
+            for (uint32_t pu_index = 0; pu_index < ME_TIER_ZERO_PU_8x8_0; pu_index++) {
+                if (!ref_hits->hit[pu_index])
+                    continue;
+                best_sad[pu_index] = 0;
+                best_mv[pu_index]  = ref_hits->mv[pu_index];
+                if (pu_index >= ME_TIER_ZERO_PU_16x16_0) {
+                    const uint32_t first_8x8 = ME_TIER_ZERO_PU_8x8_0 + 4 * (pu_index - ME_TIER_ZERO_PU_16x16_0);
+                    for (uint32_t i = first_8x8; i < first_8x8 + 4; i++) {
+                        best_sad[i] = 0;
+                        best_mv[i]  = ref_hits->mv[pu_index];
+                    }
+                }
+            }
+        }
+    }
+}
 /*******************************************
 * motion_estimation
 *   performs ME on 64x64 blocks
@@ -3103,20 +3550,29 @@ EbErrorType svt_aom_motion_estimation_b64(
     uint8_t prune_ref = me_ctx->enable_hme_flag && me_ctx->me_type != ME_MCTF;
     // Initialize ME/HME buffers
     init_me_hme_data(me_ctx);
-    // HME: Perform Hierachical Motion Estimation for all refrence frames for the current 64x64 block.
-    hme_b64(pcs, b64_origin_x, b64_origin_y, me_ctx, input_ptr);
+    // Hash based ME: HME and the full-pel search are skipped when the whole 64x64 block has exact matches
+    HashMeHits hash_me_hits[MAX_NUM_OF_REF_PIC_LIST][REF_LIST_MAX_DEPTH];
+    const bool hash_me      = me_ctx->hash_me_ctrls.enabled && me_ctx->me_type == ME_OPEN_LOOP;
+    const bool hash_me_skip = hash_me && hash_me_b64(pcs, me_ctx, b64_origin_x, b64_origin_y, input_ptr, hash_me_hits);
+    if (!hash_me_skip) {
+        // HME: Perform Hierachical Motion Estimation for all refrence frames for the current 64x64 block.
+        hme_b64(pcs, b64_origin_x, b64_origin_y, me_ctx, input_ptr);
+
+        if (me_ctx->me_type == ME_MCTF &&
+            me_ctx->search_results[0][0].hme_sad < me_ctx->tf_me_exit_th) {
+            me_ctx->tf_use_pred_64x64_only_th = (uint8_t)~0;
+            return return_error;
+        }
+        // prune the refrence frames based on the HME outputs.
+        if (prune_ref) {
+            hme_prune_ref_and_adjust_sr(me_ctx);
+        }
+        // Full pel: Perform the Integer Motion Estimation on the allowed refrence frames.
+        integer_search_b64(pcs, me_ctx, b64_origin_x, b64_origin_y, input_ptr);
 
-    if (me_ctx->me_type == ME_MCTF &&
-        me_ctx->search_results[0][0].hme_sad < me_ctx->tf_me_exit_th) {
-        me_ctx->tf_use_pred_64x64_only_th = (uint8_t)~0;
-        return return_error;
-    }
-    // prune the refrence frames based on the HME outputs.
-    if (prune_ref) {
-        hme_prune_ref_and_adjust_sr(me_ctx);
+        if (hash_me)
+            hash_me_inject_b64(me_ctx, hash_me_hits);
     }
-    // Full pel: Perform the Integer Motion Estimation on the allowed refrence frames.
-    integer_search_b64(pcs, me_ctx, b64_origin_x, b64_origin_y, input_ptr);
 
     // prune the refrence frames
     if (prune_ref && me_ctx->me_hme_prune_ctrls.enable_me_hme_ref_pruning) {
@@ -36,6 +36,11 @@ extern "C" {
         MeContext                 *me_ctx,
         EbPictureBufferDesc       *input_ptr);
 
+    // Sets the hash tables of the references for the hash based ME, building the ones not built yet
+    extern void svt_aom_hash_me_setup(
+        PictureParentControlSet *pcs,
+        MeContext               *me_ctx);
+
     extern void svt_aom_downsample_2d_c(
         uint8_t                   *input_samples,
         uint32_t                   input_stride,
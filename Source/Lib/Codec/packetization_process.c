@@ -9,6 +9,7 @@
 * PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
 */
 #include <stdlib.h>
+#include <string.h>
 
 #include "enc_handle.h"
 #include "packetization_process.h"
@@ -26,6 +27,8 @@
 #include "restoration.h" // RDCOST_DBL
 #include "rc_process.h"
 #include "enc_mode_config.h"
+#include "svt_trace.h"
+#include "analysis_export.h"
 
 #define RDCOST_DBL_WITH_NATIVE_BD_DIST(RM, R, D, BD) RDCOST_DBL((RM), (R), (double)((D) >> (2 * (BD - 8))))
 
@@ -306,25 +309,127 @@ static void collect_frames_info(PacketizationContext *context_ptr, const EncodeC
 
 #define TD_SIZE 2
 
+/* Wrapper function to capture the return of EB_MALLOC. With a packet writer,
+ * the smallest cached staging buffer large enough is reused. */
+static inline EbErrorType malloc_p_buffer(EncodeContext *enc_ctx, EbBufferHeaderType *output_stream_ptr) {
+    uint32_t best = enc_ctx->packet_buffer_cache_count;
+    for (uint32_t i = 0; i < enc_ctx->packet_buffer_cache_count; i++) {
+        if (enc_ctx->packet_buffer_cache_size[i] >= output_stream_ptr->n_alloc_len &&
+            (best == enc_ctx->packet_buffer_cache_count ||
+             enc_ctx->packet_buffer_cache_size[i] < enc_ctx->packet_buffer_cache_size[best]))
+            best = i;
+    }
+    if (best < enc_ctx->packet_buffer_cache_count) {
+        const uint32_t last                     = --enc_ctx->packet_buffer_cache_count;
+        output_stream_ptr->p_buffer             = enc_ctx->packet_buffer_cache[best];
+        output_stream_ptr->n_alloc_len          = enc_ctx->packet_buffer_cache_size[best];
+        enc_ctx->packet_buffer_cache[best]      = enc_ctx->packet_buffer_cache[last];
+        enc_ctx->packet_buffer_cache_size[best] = enc_ctx->packet_buffer_cache_size[last];
+        return EB_ErrorNone;
+    }
+    const SvtAv1MemCategory mem_category = svt_mem_set_category(SVT_AV1_MEM_BITSTREAM);
+    EB_MALLOC(output_stream_ptr->p_buffer, output_stream_ptr->n_alloc_len);
+    svt_mem_set_category(mem_category);
+    return EB_ErrorNone;
+}
+
+/* Frees the staging buffer of a frame, or caches it when the packets go to a
+ * packet writer, keeping the largest buffers when the cache is full */
+static void free_p_buffer(EncodeContext *enc_ctx, EbBufferHeaderType *output_stream_ptr) {
+    if (enc_ctx->packet_writer.write && output_stream_ptr->p_buffer) {
+        uint32_t i = enc_ctx->packet_buffer_cache_count;
+        if (i == PACKET_BUFFER_CACHE_SIZE) {
+            i = 0;
+            for (uint32_t j = 1; j < PACKET_BUFFER_CACHE_SIZE; j++)
+                if (enc_ctx->packet_buffer_cache_size[j] < enc_ctx->packet_buffer_cache_size[i])
+                    i = j;
+            if (enc_ctx->packet_buffer_cache_size[i] >= output_stream_ptr->n_alloc_len) {
+                EB_FREE(output_stream_ptr->p_buffer);
+                return;
+            }
+            EB_FREE(enc_ctx->packet_buffer_cache[i]);
+        } else
+            enc_ctx->packet_buffer_cache_count++;
+        enc_ctx->packet_buffer_cache[i]      = output_stream_ptr->p_buffer;
+        enc_ctx->packet_buffer_cache_size[i] = output_stream_ptr->n_alloc_len;
+        output_stream_ptr->p_buffer          = NULL;
+        return;
+    }
+    EB_FREE(output_stream_ptr->p_buffer);
+}
+
+// Application memory for a packet of size bytes, NULL without a packet writer
+static uint8_t *get_writer_buffer(EncodeContext *enc_ctx, uint32_t size) {
+    const SvtAv1PacketWriter *writer = &enc_ctx->packet_writer;
+    return writer->get_buffer ? writer->get_buffer(writer->opaque, size) : NULL;
+}
+
+/*
+ * svt_aom_post_packet
+ *   Outputs a packet whose n_filled_len bytes are in data. The packet is
+ *   queued for svt_av1_enc_get_packet(), and the application notified, or
+ *   handed to the packet writer and released, except for the EOS which is
+ *   also queued, without data.
+ */
+void svt_aom_post_packet(EncodeContext *enc_ctx, EbObjectWrapper *wrapper, uint8_t *data) {
+    EbBufferHeaderType       *packet = (EbBufferHeaderType *)wrapper->object_ptr;
+    const SvtAv1PacketWriter *writer = &enc_ctx->packet_writer;
+    if (data)
+        packet->timestamps.output = svt_av1_get_time_ns();
+    else
+        memset(&packet->timestamps, 0, sizeof(packet->timestamps));
+    if (writer->write) {
+        EbBufferHeaderType written = *packet;
+        written.p_buffer           = data;
+        written.n_filled_len       = data ? packet->n_filled_len : 0;
+        written.n_alloc_len        = written.n_filled_len;
+        written.wrapper_ptr        = NULL;
+        writer->write(writer->opaque, &written);
+        free_p_buffer(enc_ctx, packet);
+        svt_aom_free_analysis_export(&packet->analysis);
+        if (!(packet->flags & EB_BUFFERFLAG_EOS)) {
+            svt_release_object(wrapper);
+            return;
+        }
+        packet->n_filled_len = 0;
+    }
+    svt_post_full_object(wrapper);
+    if (enc_ctx->output_notify)
+        enc_ctx->output_notify(enc_ctx->output_notify_opaque);
+}
+
+// Moves the analysis of a frame not output on its own after the ones of the packet holding it
+static void chain_analysis(EbBufferHeaderType *packet, EbBufferHeaderType *frame) {
+    SvtAv1AnalysisExport **tail = &packet->analysis;
+    while (*tail) tail = &(*tail)->next;
+    *tail           = frame->analysis;
+    frame->analysis = NULL;
+}
+
 // a tu start with a td, + 0 more not displable frame, + 1 display frame
-static EbErrorType encode_tu(EncodeContext *enc_ctx, int frames, uint32_t total_bytes,
-                             EbBufferHeaderType *output_stream_ptr) {
+// returns the buffer holding the tu, the packet writer memory if there is one
+static uint8_t *encode_tu(EncodeContext *enc_ctx, int frames, uint32_t total_bytes,
+                          EbBufferHeaderType *output_stream_ptr) {
     total_bytes += TD_SIZE;
-    if (total_bytes > output_stream_ptr->n_alloc_len) {
-        uint8_t *pbuff;
-        EB_MALLOC(pbuff, total_bytes);
-        if (!pbuff) {
-            SVT_ERROR("failed to allocate more memory in encode_tu");
-            return EB_ErrorInsufficientResources;
+    uint8_t *tu_buffer = get_writer_buffer(enc_ctx, total_bytes);
+    if (!tu_buffer) {
+        if (total_bytes > output_stream_ptr->n_alloc_len) {
+            uint8_t *pbuff;
+            EB_NO_THROW_MALLOC(pbuff, total_bytes);
+            if (!pbuff) {
+                SVT_ERROR("failed to allocate more memory in encode_tu");
+                return NULL;
+            }
+            EB_MEMCPY(pbuff,
+                      output_stream_ptr->p_buffer,
+                      output_stream_ptr->n_alloc_len > total_bytes ? total_bytes : output_stream_ptr->n_alloc_len);
+            EB_FREE(output_stream_ptr->p_buffer);
+            output_stream_ptr->p_buffer    = pbuff;
+            output_stream_ptr->n_alloc_len = total_bytes;
         }
-        EB_MEMCPY(pbuff,
-                  output_stream_ptr->p_buffer,
-                  output_stream_ptr->n_alloc_len > total_bytes ? total_bytes : output_stream_ptr->n_alloc_len);
-        EB_FREE(output_stream_ptr->p_buffer);
-        output_stream_ptr->p_buffer    = pbuff;
-        output_stream_ptr->n_alloc_len = total_bytes;
+        tu_buffer = output_stream_ptr->p_buffer;
     }
-    uint8_t *dst = output_stream_ptr->p_buffer + total_bytes;
+    uint8_t *dst = tu_buffer + total_bytes;
     // we use last frame's output_stream_ptr to hold entire tu, so we need copy backward.
     for (int i = frames - 1; i >= 0; i--) {
         PacketizationReorderEntry *queue_entry_ptr = get_reorder_queue_entry(enc_ctx, i);
@@ -339,7 +444,8 @@ static EbErrorType encode_tu(EncodeContext *enc_ctx, int frames, uint32_t total_
         if (i != frames - 1 && !queue_entry_ptr->is_alt_ref)
             push_undisplayed_frame(enc_ctx, wrapper);
         else if (queue_entry_ptr->is_alt_ref) {
-            EB_FREE(src_stream_ptr->p_buffer);
+            chain_analysis(output_stream_ptr, src_stream_ptr);
+            free_p_buffer(enc_ctx, src_stream_ptr);
             svt_release_object(wrapper);
         }
     }
@@ -349,7 +455,7 @@ static EbErrorType encode_tu(EncodeContext *enc_ctx, int frames, uint32_t total_
     svt_aom_encode_td_av1(dst);
     output_stream_ptr->n_filled_len = total_bytes;
     output_stream_ptr->flags |= EB_BUFFERFLAG_HAS_TD;
-    return EB_ErrorNone;
+    return tu_buffer;
 }
 
 static EbErrorType copy_data_from_bitstream(EncodeContext *enc_ctx, Bitstream *bitstream_ptr,
@@ -368,16 +474,26 @@ static EbErrorType copy_data_from_bitstream(EncodeContext *enc_ctx, Bitstream *b
     return return_error;
 }
 
-static void encode_show_existing(EncodeContext *enc_ctx, PacketizationReorderEntry *queue_entry_ptr,
-                                 EbBufferHeaderType *output_stream_ptr) {
-    uint8_t *dst = output_stream_ptr->p_buffer;
+// returns the buffer holding the frame, the packet writer memory if there is one
+static uint8_t *encode_show_existing(EncodeContext *enc_ctx, PacketizationReorderEntry *queue_entry_ptr,
+                                     EbBufferHeaderType *output_stream_ptr) {
+    const uint32_t size = TD_SIZE + svt_aom_bitstream_get_bytes_count(queue_entry_ptr->bitstream_ptr);
+    uint8_t       *dst  = get_writer_buffer(enc_ctx, size);
+
+    output_stream_ptr->flags |= (EB_BUFFERFLAG_SHOW_EXT | EB_BUFFERFLAG_HAS_TD);
+    if (dst) {
+        svt_aom_encode_td_av1(dst);
+        svt_aom_bitstream_copy(queue_entry_ptr->bitstream_ptr, dst + TD_SIZE, size - TD_SIZE);
+        output_stream_ptr->n_filled_len = size;
+        return dst;
+    }
+    dst = output_stream_ptr->p_buffer;
 
     svt_aom_encode_td_av1(dst);
     output_stream_ptr->n_filled_len = TD_SIZE;
 
     copy_data_from_bitstream(enc_ctx, queue_entry_ptr->bitstream_ptr, output_stream_ptr);
-
-    output_stream_ptr->flags |= (EB_BUFFERFLAG_SHOW_EXT | EB_BUFFERFLAG_HAS_TD);
+    return dst;
 }
 
 static void release_frames(EncodeContext *enc_ctx, int frames) {
@@ -446,11 +562,6 @@ inline static void set_eos_flag(EbBufferHeaderType *output_stream_ptr) {
     output_stream_ptr->flags |= EB_BUFFERFLAG_EOS;
 }
 
-/* Wrapper function to capture the return of EB_MALLOC */
-static inline EbErrorType malloc_p_buffer(EbBufferHeaderType *output_stream_ptr) {
-    EB_MALLOC(output_stream_ptr->p_buffer, output_stream_ptr->n_alloc_len);
-    return EB_ErrorNone;
-}
 void update_firstpass_stats(PictureParentControlSet *pcs, const int frame_number, const double ts_duration,
                             StatStruct *stat_struct);
 void svt_av1_end_first_pass(PictureParentControlSet *pcs);
@@ -488,12 +599,14 @@ void *svt_aom_packetization_kernel(void *input_ptr) {
         EntropyCodingResults *entropy_coding_results_ptr = (EntropyCodingResults *)
                                                                entropy_coding_results_wrapper_ptr->object_ptr;
         PictureControlSet       *pcs      = (PictureControlSet *)entropy_coding_results_ptr->pcs_wrapper->object_ptr;
+        SVT_TRACE_TASK("Packetization", pcs->picture_number, -1);
         SequenceControlSet      *scs      = pcs->scs;
         EncodeContext           *enc_ctx  = scs->enc_ctx;
         FrameHeader             *frm_hdr  = &pcs->ppcs->frm_hdr;
         Av1Common *const         cm       = pcs->ppcs->av1_cm;
         uint16_t                 tile_cnt = cm->tiles_info.tile_rows * cm->tiles_info.tile_cols;
         PictureParentControlSet *ppcs     = (PictureParentControlSet *)pcs->ppcs;
+        ppcs->timestamps.packetization    = svt_av1_get_time_ns();
 
         if (ppcs->superres_total_recode_loop > 0 && ppcs->superres_recode_loop < ppcs->superres_total_recode_loop) {
             // Reset the Bitstream before writing to it
@@ -630,6 +743,7 @@ void *svt_aom_packetization_kernel(void *input_ptr) {
             // Release pa me ptr. For non-superres-recode, it's released in svt_aom_mode_decision_kernel
             assert(pcs->ppcs->me_data_wrapper != NULL);
             assert(pcs->ppcs->pa_me_data != NULL);
+            svt_aom_build_analysis_export(pcs);
             svt_release_object(pcs->ppcs->me_data_wrapper);
             pcs->ppcs->me_data_wrapper = NULL;
             pcs->ppcs->pa_me_data      = NULL;
@@ -731,6 +845,9 @@ void *svt_aom_packetization_kernel(void *input_ptr) {
         output_stream_ptr->temporal_layer_index = pcs->ppcs->temporal_layer_index;
         output_stream_ptr->qp                   = pcs->ppcs->picture_qp;
         output_stream_ptr->avg_qp               = pcs->ppcs->avg_qp;
+        output_stream_ptr->timestamps           = pcs->ppcs->timestamps;
+        output_stream_ptr->analysis             = pcs->ppcs->analysis;
+        pcs->ppcs->analysis                     = NULL;
         if (scs->static_config.stat_report) {
             output_stream_ptr->luma_sse  = pcs->ppcs->luma_sse;
             output_stream_ptr->cr_sse    = pcs->ppcs->cr_sse;
@@ -809,7 +926,7 @@ void *svt_aom_packetization_kernel(void *input_ptr) {
 
         output_stream_ptr->n_alloc_len = (uint32_t)(svt_aom_bitstream_get_bytes_count(pcs->bitstream_ptr) + TD_SIZE +
                                                     metadata_sz);
-        malloc_p_buffer(output_stream_ptr);
+        malloc_p_buffer(enc_ctx, output_stream_ptr);
 
         assert(output_stream_ptr->p_buffer != NULL && "bit-stream memory allocation failure");
 
@@ -888,7 +1005,7 @@ void *svt_aom_packetization_kernel(void *input_ptr) {
             pcs->ppcs->data_ll_head_ptr = app_data_ll_head_temp_ptr;
         }
 
-        if (scs->speed_control_flag) {
+        if (scs->speed_control_flag && !pcs->ppcs->is_overlay) {
             // update speed control variables
             svt_block_on_mutex(enc_ctx->sc_buffer_mutex);
             enc_ctx->sc_frame_out++;
@@ -930,20 +1047,21 @@ void *svt_aom_packetization_kernel(void *input_ptr) {
             bool eos = output_stream_ptr->flags & EB_BUFFERFLAG_EOS;
 #endif
 #if OPT_LD_LATENCY2
-            encode_tu(enc_ctx, frames, total_bytes, output_stream_ptr);
+            uint8_t *tu_buffer = encode_tu(enc_ctx, frames, total_bytes, output_stream_ptr);
 
             if (eos && queue_entry_ptr->has_show_existing)
                 clear_eos_flag(output_stream_ptr);
 
-            svt_post_full_object(output_stream_wrapper_ptr);
+            svt_aom_post_packet(enc_ctx, output_stream_wrapper_ptr, tu_buffer);
             if (queue_entry_ptr->has_show_existing) {
                 EbObjectWrapper *existed = pop_undisplayed_frame(enc_ctx);
                 if (existed) {
                     EbBufferHeaderType *existed_output_stream_ptr = (EbBufferHeaderType *)existed->object_ptr;
-                    encode_show_existing(enc_ctx, queue_entry_ptr, existed_output_stream_ptr);
+                    uint8_t            *existed_buffer            = encode_show_existing(
+                        enc_ctx, queue_entry_ptr, existed_output_stream_ptr);
                     if (eos)
                         set_eos_flag(existed_output_stream_ptr);
-                    svt_post_full_object(existed);
+                    svt_aom_post_packet(enc_ctx, existed, existed_buffer);
                 }
             }
 
@@ -955,20 +1073,21 @@ void *svt_aom_packetization_kernel(void *input_ptr) {
             release_frames(enc_ctx, frames);
 
 #else
-            encode_tu(enc_ctx, frames, total_bytes, output_stream_ptr);
+            uint8_t *tu_buffer = encode_tu(enc_ctx, frames, total_bytes, output_stream_ptr);
 
             if (eos && queue_entry_ptr->has_show_existing)
                 clear_eos_flag(output_stream_ptr);
 
-            svt_post_full_object(output_stream_wrapper_ptr);
+            svt_aom_post_packet(enc_ctx, output_stream_wrapper_ptr, tu_buffer);
             if (queue_entry_ptr->has_show_existing) {
                 EbObjectWrapper *existed = pop_undisplayed_frame(enc_ctx);
                 if (existed) {
                     EbBufferHeaderType *existed_output_stream_ptr = (EbBufferHeaderType *)existed->object_ptr;
-                    encode_show_existing(enc_ctx, queue_entry_ptr, existed_output_stream_ptr);
+                    uint8_t            *existed_buffer            = encode_show_existing(
+                        enc_ctx, queue_entry_ptr, existed_output_stream_ptr);
                     if (eos)
                         set_eos_flag(existed_output_stream_ptr);
-                    svt_post_full_object(existed);
+                    svt_aom_post_packet(enc_ctx, existed, existed_buffer);
                 }
             }
             release_frames(enc_ctx, frames);
@@ -982,8 +1101,9 @@ void *svt_aom_packetization_kernel(void *input_ptr) {
 
             tmp_out_str->flags        = EB_BUFFERFLAG_EOS;
             tmp_out_str->n_filled_len = 0;
+            tmp_out_str->analysis     = NULL;
 
-            svt_post_full_object(tmp_out_str_wrp);
+            svt_aom_post_packet(enc_ctx, tmp_out_str_wrp, NULL);
             release_references_eos(scs);
 
             // Print a suggestion if a single picture is detected without using --avif 1
@@ -24,6 +24,8 @@ EbErrorType svt_aom_packetization_context_ctor(EbThreadContext *thread_ctx, cons
                                                int rate_control_index, int demux_index, int me_port_index);
 
 extern void *svt_aom_packetization_kernel(void *input_ptr);
+// Outputs a packet whose bytes are in data, to the output queue or the packet writer
+extern void svt_aom_post_packet(EncodeContext *enc_ctx, EbObjectWrapper *wrapper, uint8_t *data);
 #if OPT_LD_LATENCY2
 // Release the pd_dpb and ref_pic_list at the end of the sequence
 extern void release_references_eos(SequenceControlSet *scs);
@@ -209,6 +209,10 @@ static void picture_control_set_dctor(EbPtr p) {
     EB_FREE_ARRAY(obj->md_rate_est_ctx);
     EB_DESTROY_MUTEX(obj->entropy_coding_pic_mutex);
     EB_DESTROY_MUTEX(obj->intra_mutex);
+    EB_DESTROY_MUTEX(obj->dlf_jobs.mutex);
+    EB_DESTROY_SEMAPHORE(obj->dlf_jobs.done_semaphore);
+    EB_DESTROY_MUTEX(obj->ssim_jobs.mutex);
+    EB_DESTROY_SEMAPHORE(obj->ssim_jobs.done_semaphore);
     EB_DESTROY_MUTEX(obj->cdef_search_mutex);
     EB_DESTROY_MUTEX(obj->rest_search_mutex);
 }
@@ -475,7 +479,7 @@ static EbErrorType picture_control_set_ctor(PictureControlSet *object_ptr, EbPtr
 
     object_ptr->dctor = picture_control_set_dctor;
 
-    object_ptr->hash_table.p_lookup_table = NULL;
+    memset(&object_ptr->hash_table, 0, sizeof(object_ptr->hash_table));
 
     // Init Picture Init data
     uint16_t padding = init_data_ptr->sb_size + 32;
@@ -1033,6 +1037,11 @@ static EbErrorType picture_control_set_ctor(PictureControlSet *object_ptr, EbPtr
 
     EB_CREATE_MUTEX(object_ptr->intra_mutex);
 
+    EB_CREATE_MUTEX(object_ptr->dlf_jobs.mutex);
+    EB_CREATE_SEMAPHORE(object_ptr->dlf_jobs.done_semaphore, 0, 1);
+    EB_CREATE_MUTEX(object_ptr->ssim_jobs.mutex);
+    EB_CREATE_SEMAPHORE(object_ptr->ssim_jobs.done_semaphore, 0, 1);
+
     EB_CREATE_MUTEX(object_ptr->cdef_search_mutex);
 
     //object_ptr->mse_seg[0] = (uint64_t(*)[64])svt_aom_malloc(sizeof(**object_ptr->mse_seg) *  picture_sb_width * picture_sb_height);
@@ -1444,6 +1453,7 @@ static EbErrorType me_ctor(MotionEstimationData *object_ptr, EbPtr object_init_d
     }
 
     if (init_data_ptr->enable_tpl_la) {
+        const SvtAv1MemCategory mem_category         = svt_mem_set_category(SVT_AV1_MEM_TPL);
         const uint16_t picture_width_in_mb           = (uint16_t)((init_data_ptr->picture_width + 15) / 16);
         const uint16_t picture_height_in_mb          = (uint16_t)((init_data_ptr->picture_height + 15) / 16);
         uint16_t       adaptive_picture_width_in_mb  = (uint16_t)((init_data_ptr->picture_width + 15) / 16);
@@ -1477,6 +1487,7 @@ static EbErrorType me_ctor(MotionEstimationData *object_ptr, EbPtr object_init_d
                         adaptive_picture_width_in_mb * adaptive_picture_height_in_mb);
         EB_MALLOC_ARRAY(object_ptr->tpl_sb_rdmult_scaling_factors,
                         adaptive_picture_width_in_mb * adaptive_picture_height_in_mb);
+        svt_mem_set_category(mem_category);
     } else {
         object_ptr->ois_mb_results                = NULL;
         object_ptr->tpl_stats                     = NULL;
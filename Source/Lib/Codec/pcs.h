@@ -221,6 +221,72 @@ typedef struct PicVqCtrls {
     uint8_t detect_high_freq_lvl;
 } PicVqCtrls;
 
+/*
+ Frame-level deblocking pass split in SB row (vertical edges) or SB column
+ (horizontal edges) jobs, taken by the DLF process and the CDEF processes it
+ asks for help
+*/
+typedef struct DlfJobs {
+    EbFifo              *helper_fifo; // where the helper tasks are posted, NULL to run the jobs alone
+    EbObjectWrapper     *pcs_wrapper;
+    uint32_t             helper_max;
+    EbPictureBufferDesc *frame_buffer;
+    int32_t              plane_start;
+    int32_t              plane_end;
+    bool                 horz; // the jobs filter the horizontal edges of SB columns
+    // Horizontal jobs only: the sse of sse_plane is summed over the columns,
+    // which are then copied back from restore_buffer when it is set
+    int32_t              sse_plane;
+    EbPictureBufferDesc *restore_buffer;
+    volatile uint64_t    sse;
+    uint32_t             job_count;
+    volatile int32_t     next_job;
+    // Pass generation, incremented when all the jobs of a pass are taken so the helper
+    // tasks dequeued later do nothing. Never reset, as those may outlive the picture.
+    uint32_t             pass;
+    uint32_t             active_helpers; // helpers which joined the current pass and are not done
+    bool                 waiting; // the DLF process waits for the active helpers
+    EbHandle             mutex;
+    EbHandle             done_semaphore;
+} DlfJobs;
+
+#define SSIM_JOBS_PER_PLANE 16
+typedef struct SsimPlane {
+    const uint8_t *input; // 8 msb of the source when highbd
+    int32_t        input_stride;
+    const uint8_t *input_bit_inc; // highbd only: 2 lsb of the source, in bits 6 and 7
+    int32_t        input_bit_inc_stride;
+    const uint8_t *recon;
+    int32_t        recon_stride;
+    int32_t        width;
+    int32_t        height;
+    int32_t        window_cols;
+    int32_t        window_count;
+    int32_t        band_height; // in rows of 8x8 windows
+    uint32_t       job_count;
+} SsimPlane;
+
+/*
+ Frame SSIM of the stat report split in bands of 8x8 window rows, taken by the
+ Rest process and the EntropyCoding processes it asks for help. Each job stores
+ the SSIM of the windows of its band, which are added in raster order after the
+ jobs so the frame SSIM is the one of the serial loop.
+*/
+typedef struct SsimJobs {
+    EbFifo          *helper_fifo; // where the helper tasks are posted, NULL to run the jobs alone
+    EbObjectWrapper *pcs_wrapper;
+    uint32_t         helper_max;
+    bool             highbd;
+    SsimPlane        plane[MAX_MB_PLANE];
+    double          *window_ssim[MAX_MB_PLANE]; // per plane, in raster order
+    uint32_t         job_count;
+    volatile int32_t next_job;
+    uint32_t         task_count;
+    uint32_t         tasks_done;
+    EbHandle         mutex;
+    EbHandle         done_semaphore;
+} SsimJobs;
+
 typedef struct PictureControlSet {
     /*!< Pointer to the dtor of the struct*/
     EbDctor                    dctor;
@@ -257,6 +323,8 @@ typedef struct PictureControlSet {
     uint32_t          intra_coded_area;
     uint64_t          skip_coded_area;
     uint64_t          hp_coded_area;
+    DlfJobs           dlf_jobs;
+    SsimJobs          ssim_jobs;
     uint32_t          tot_seg_searched_cdef;
     EbHandle          cdef_search_mutex;
 
@@ -397,7 +465,6 @@ typedef struct PictureControlSet {
     SearchSiteConfig ss_cfg; // CHKN this might be a seq based
     HashTable        hash_table;
     CRC_CALCULATOR   crc_calculator1;
-    CRC_CALCULATOR   crc_calculator2;
 
     FRAME_CONTEXT                  *ec_ctx_array;
     FRAME_CONTEXT                   md_frame_context;
@@ -820,6 +887,8 @@ typedef struct PictureParentControlSet {
     bool     is_highest_layer;
     // status of PA reference 0: Not release; 1: Released
     uint8_t reference_released;
+    // The picture holds the hash tables of its PA references until its ME is done
+    bool hash_table_held;
     uint8_t ref_list0_count;
     uint8_t ref_list1_count;
     // The number of references to try (in ME / MD) in list0.Should be <= ref_list0_count.
@@ -838,6 +907,9 @@ typedef struct PictureParentControlSet {
     uint64_t                                last_idr_picture;
     uint64_t                                start_time_seconds;
     uint64_t                                start_time_u_seconds;
+    EbPictureTimestamps                     timestamps;
+    // Encoder analysis, from the end of the encoding to the output packet
+    SvtAv1AnalysisExport                   *analysis;
     uint64_t                                luma_sse;
     uint64_t                                cr_sse;
     uint64_t                                cb_sse;
@@ -1171,6 +1243,8 @@ typedef struct PictureParentControlSet {
     uint32_t         dpb_order_hint[REF_FRAMES]; // spec 6.8.2. ref_order_hint[]
     DGDetectorSeg   *dg_detector; // dg detector segments control struct
     SvtAv1RoiMapEvt *roi_map_evt;
+    // Motion hints of the picture, owned by its private data list; NULL when not used
+    const SvtAv1MotionHints *mv_hints;
     uint32_t         filt_to_unfilt_diff;
     // Absolute histogram deviation of the frame to the central TF frame (i.e. sum of absolute deviation of all bins)
     uint32_t tf_ahd_error_to_central;
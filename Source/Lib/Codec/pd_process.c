@@ -37,6 +37,8 @@
 #include "aom_dsp_rtcd.h"
 
 #include "pic_operators.h"
+#include "svt_time.h"
+#include "svt_trace.h"
 /************************************************
  * Defines
  ************************************************/
@@ -3393,11 +3395,13 @@ static void mctf_frame(
             pcs,
             pd_ctx);
     if (pcs->tf_ctrls.enabled) {
+        const SvtAv1MemCategory mem_category = svt_mem_set_category(SVT_AV1_MEM_TF);
         derive_tf_window_params(
             scs,
             scs->enc_ctx,
             pcs,
             pd_ctx);
+        svt_mem_set_category(mem_category);
         pcs->temp_filt_prep_done = 0;
         pcs->tf_tot_horz_blks = pcs->tf_tot_vert_blks = 0;
 
@@ -4193,6 +4197,8 @@ static void assign_and_release_pa_refs(EncodeContext* enc_ctx, PictureParentCont
                 svt_release_mutex(enc_ctx->pd_dpb_mutex);
 #endif
             }
+            // Keep the hash tables of the references for the hash based ME of the picture
+            svt_aom_hold_pa_reference_hash_tables(pcs);
         }
 
         uint8_t released_pics_idx = 0;
@@ -4548,6 +4554,9 @@ void* svt_aom_picture_decision_kernel(void *input_ptr) {
 
         in_results_ptr = (PictureAnalysisResults*)in_results_wrapper_ptr->object_ptr;
         pcs = (PictureParentControlSet*)in_results_ptr->pcs_wrapper->object_ptr;
+        SVT_TRACE_TASK("PictureDecision", pcs->picture_number, -1);
+        if (!pcs->timestamps.picture_decision)
+            pcs->timestamps.picture_decision = svt_av1_get_time_ns();
         scs = pcs->scs;
         enc_ctx = (EncodeContext*)scs->enc_ctx;
 
@@ -29,6 +29,7 @@
 #include "pic_operators.h"
 #include "resize.h"
 #include "av1me.h"
+#include "svt_trace.h"
 
 #define VARIANCE_PRECISION 16
 
@@ -2109,6 +2110,7 @@ void *svt_aom_picture_analysis_kernel(void *input_ptr) {
 
         in_results_ptr = (ResourceCoordinationResults *)in_results_wrapper_ptr->object_ptr;
         pcs            = (PictureParentControlSet *)in_results_ptr->pcs_wrapper->object_ptr;
+        SVT_TRACE_TASK("PictureAnalysis", pcs->picture_number, -1);
         scs            = pcs->scs;
 
         // Mariana : save enhanced picture ptr, move this from here
@@ -25,6 +25,7 @@
 #include "EbSvtAv1ErrorCodes.h"
 #include "entropy_coding.h"
 #include "svt_log.h"
+#include "svt_trace.h"
 
 // Token buffer is only used for palette tokens.
 static INLINE unsigned int get_token_alloc(int mb_rows, int mb_cols, int sb_size_log2, const int num_planes) {
@@ -344,6 +345,7 @@ void *svt_aom_picture_manager_kernel(void *input_ptr) {
         case EB_PIC_SUPERRES_INPUT: {
             pcs = (PictureParentControlSet *)input_pic_demux->pcs_wrapper->object_ptr;
             scs = pcs->scs;
+            SVT_TRACE_TASK("PictureManager", pcs->picture_number, -1);
 
             assert(scs->static_config.superres_mode == SUPERRES_QTHRESH ||
                    scs->static_config.superres_mode == SUPERRES_AUTO);
@@ -368,6 +370,7 @@ void *svt_aom_picture_manager_kernel(void *input_ptr) {
 
             pcs     = (PictureParentControlSet *)input_pic_demux->pcs_wrapper->object_ptr;
             scs     = pcs->scs;
+            SVT_TRACE_TASK("PictureManager", pcs->picture_number, -1);
             enc_ctx = scs->enc_ctx;
 
             // SVT_LOG("\nPicture Manager Process @ %d \n ", pcs->picture_number);
@@ -426,6 +429,7 @@ void *svt_aom_picture_manager_kernel(void *input_ptr) {
             break;
 
         case EB_PIC_REFERENCE:
+            SVT_TRACE_TASK("PictureManager", input_pic_demux->picture_number, -1);
             scs     = input_pic_demux->scs;
             enc_ctx = scs->enc_ctx;
             // Find the Reference in the Reference List
@@ -453,6 +457,7 @@ void *svt_aom_picture_manager_kernel(void *input_ptr) {
 #endif
             break;
         case EB_PIC_FEEDBACK:
+            SVT_TRACE_TASK("PictureManager", input_pic_demux->picture_number, -1);
             scs     = input_pic_demux->scs;
             enc_ctx = scs->enc_ctx;
 
@@ -39,6 +39,7 @@
 #include "resize.h"
 #include "src_ops_process.h"
 #include "enc_mode_config.h"
+#include "svt_trace.h"
 
 // Specifies the weights of the ref frame in calculating qindex of non base layer frames
 static const int non_base_qindex_weight_ref[EB_MAX_TEMPORAL_LAYERS] = {100, 100, 100, 100, 100, 100};
@@ -3167,6 +3168,7 @@ void *svt_aom_rate_control_kernel(void *input_ptr) {
             // intentionally reuse code in RC_INPUT
         case RC_INPUT:
             pcs = (PictureControlSet *)rc_tasks->pcs_wrapper->object_ptr;
+            SVT_TRACE_TASK("RateControl", pcs->picture_number, -1);
             scs = pcs->scs;
             // Get r0
             if (pcs->ppcs->r0_based_qps_qpm) {
@@ -3541,6 +3543,7 @@ void *svt_aom_rate_control_kernel(void *input_ptr) {
         case RC_PACKETIZATION_FEEDBACK_RESULT:
 
             ppcs = (PictureParentControlSet *)rc_tasks->pcs_wrapper->object_ptr;
+            SVT_TRACE_TASK("RateControl", ppcs->picture_number, -1);
             scs  = ppcs->scs;
             // Prevent double counting fames with overlay to so we don't
             // increase processed_frame_number twice per frame
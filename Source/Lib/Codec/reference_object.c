@@ -231,6 +231,8 @@ static void svt_pa_reference_object_dctor(EbPtr p) {
             EB_DESTROY_MUTEX(obj->resize_mutex[sr_denom_idx][resize_denom_idx]);
         }
     }
+    svt_av1_hash_table_destroy(&obj->hash_table);
+    EB_DESTROY_MUTEX(obj->hash_table_mutex);
 }
 
 static void svt_tpl_reference_object_dctor(EbPtr p) {
@@ -333,6 +335,10 @@ EbErrorType svt_pa_reference_object_ctor(EbPaReferenceObject *pa_ref_obj_, EbPtr
             EB_CREATE_MUTEX(pa_ref_obj_->resize_mutex[sr_down_idx][resize_down_idx]);
         }
     }
+    memset(&pa_ref_obj_->hash_table, 0, sizeof(pa_ref_obj_->hash_table));
+    pa_ref_obj_->hash_table_picture_number = (uint64_t)~0;
+    pa_ref_obj_->hash_table_users          = 0;
+    EB_CREATE_MUTEX(pa_ref_obj_->hash_table_mutex);
 
     return EB_ErrorNone;
 }
@@ -441,3 +447,51 @@ void svt_aom_release_pa_reference_objects(SequenceControlSet *scs, PictureParent
     pcs->reference_released = 1;
     return;
 }
+
+/************************************************
+* Hold / Release Pa Reference Hash Tables
+** The hash tables of the hash based ME are only
+** kept while a picture may still search them
+************************************************/
+void svt_aom_hold_pa_reference_hash_tables(PictureParentControlSet *pcs) {
+    if (pcs->slice_type == I_SLICE)
+        return;
+    const uint32_t num_of_list_to_search = (pcs->slice_type == P_SLICE) ? 1 : 2;
+    for (uint32_t list_index = REF_LIST_0; list_index < num_of_list_to_search; ++list_index) {
+        const uint8_t num_of_ref_pic = (list_index == REF_LIST_0) ? pcs->ref_list0_count : pcs->ref_list1_count;
+        for (uint32_t ref_pic_index = 0; ref_pic_index < num_of_ref_pic; ++ref_pic_index) {
+            if (pcs->ref_pa_pic_ptr_array[list_index][ref_pic_index] == NULL)
+                continue;
+            EbPaReferenceObject *ref_obj =
+                (EbPaReferenceObject *)pcs->ref_pa_pic_ptr_array[list_index][ref_pic_index]->object_ptr;
+            svt_block_on_mutex(ref_obj->hash_table_mutex);
+            ref_obj->hash_table_users++;
+            svt_release_mutex(ref_obj->hash_table_mutex);
+        }
+    }
+    pcs->hash_table_held = true;
+}
+
+void svt_aom_release_pa_reference_hash_tables(PictureParentControlSet *pcs) {
+    if (!pcs->hash_table_held)
+        return;
+    const uint32_t num_of_list_to_search = (pcs->slice_type == P_SLICE) ? 1 : 2;
+    for (uint32_t list_index = REF_LIST_0; list_index < num_of_list_to_search; ++list_index) {
+        const uint8_t num_of_ref_pic = (list_index == REF_LIST_0) ? pcs->ref_list0_count : pcs->ref_list1_count;
+        for (uint32_t ref_pic_index = 0; ref_pic_index < num_of_ref_pic; ++ref_pic_index) {
+            if (pcs->ref_pa_pic_ptr_array[list_index][ref_pic_index] == NULL)
+                continue;
+            EbPaReferenceObject *ref_obj =
+                (EbPaReferenceObject *)pcs->ref_pa_pic_ptr_array[list_index][ref_pic_index]->object_ptr;
+            svt_block_on_mutex(ref_obj->hash_table_mutex);
+            assert(ref_obj->hash_table_users > 0);
+            // Rebuilt if a picture given the object later searches it
+            if (--ref_obj->hash_table_users == 0) {
+                svt_av1_hash_table_destroy(&ref_obj->hash_table);
+                ref_obj->hash_table_picture_number = (uint64_t)~0;
+            }
+            svt_release_mutex(ref_obj->hash_table_mutex);
+        }
+    }
+    pcs->hash_table_held = false;
+}
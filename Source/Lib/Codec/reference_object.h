@@ -17,6 +17,7 @@
 #include "cabac_context_model.h"
 #include "coding_unit.h"
 #include "sequence_control_set.h"
+#include "hash_motion.h"
 
 typedef struct EbReferenceObject {
     EbDctor              dctor;
@@ -83,6 +84,14 @@ typedef struct EbPaReferenceObject {
     uint64_t picture_number;
     uint64_t avg_luma;
     uint8_t  dummy_obj;
+    // Hash table of the blocks of input_padded_pic for the hash based ME, built when first searched as a
+    // reference; valid when hash_table_picture_number is picture_number
+    HashTable hash_table;
+    uint64_t  hash_table_picture_number;
+    // Pictures given the object as a reference that are not done with their ME; the hash table is freed when it
+    // drops to zero
+    uint32_t hash_table_users;
+    EbHandle hash_table_mutex;
 } EbPaReferenceObject;
 
 typedef struct EbPaReferenceObjectDescInitData {
@@ -109,6 +118,8 @@ extern EbErrorType svt_reference_object_reset(EbReferenceObject *obj, SequenceCo
 extern EbErrorType svt_pa_reference_object_creator(EbPtr *object_dbl_ptr, EbPtr object_init_data_ptr);
 extern EbErrorType svt_tpl_reference_object_creator(EbPtr *object_dbl_ptr, EbPtr object_init_data_ptr);
 void               svt_aom_release_pa_reference_objects(SequenceControlSet *scs, PictureParentControlSet *pcs);
+void               svt_aom_hold_pa_reference_hash_tables(PictureParentControlSet *pcs);
+void               svt_aom_release_pa_reference_hash_tables(PictureParentControlSet *pcs);
 extern EbErrorType svt_pa_reference_param_update(EbPaReferenceObject *pa_ref_obj_, SequenceControlSet *scs);
 extern EbErrorType svt_tpl_reference_param_update(EbTplReferenceObject *tpl_ref_obj, SequenceControlSet *scs);
 extern EbErrorType svt_reference_param_update(EbReferenceObject *ref_object, SequenceControlSet *scs);
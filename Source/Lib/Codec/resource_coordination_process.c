@@ -29,6 +29,7 @@
 #include "resize.h"
 #include "metadata_handle.h"
 #include "enc_mode_config.h"
+#include "svt_trace.h"
 
 typedef struct ResourceCoordinationContext {
     EbFifo                        *input_cmd_fifo_ptr;
@@ -46,26 +47,15 @@ typedef struct ResourceCoordinationContext {
     // Picture Number Array
     uint64_t *picture_number_array;
 
-    uint64_t average_enc_mod;
-    uint8_t  prev_enc_mod;
-    int8_t   prev_enc_mode_delta;
-    uint8_t  prev_change_cond;
-
-    int64_t previous_mode_change_buffer;
-    int64_t previous_mode_change_frame_in;
-    int64_t previous_buffer_check1;
-    int64_t previous_frame_in_check1;
-    int64_t previous_frame_in_check2;
-    int64_t previous_frame_in_check3;
-
-    uint64_t cur_speed; // speed x 1000
-    uint64_t prevs_time_seconds;
-    uint64_t prevs_timeu_seconds;
-    int64_t  prev_frame_out;
-
-    uint64_t first_in_pic_arrived_time_seconds;
-    uint64_t first_in_pic_arrived_timeu_seconds;
-    bool     start_flag;
+    // Speed control
+    uint64_t sc_check_time_seconds; // time of the last speed check
+    uint64_t sc_check_time_useconds;
+    int64_t  sc_check_frame_in; // input and output frames at the last speed check
+    int64_t  sc_check_frame_out;
+    int64_t  sc_change_frame_in; // first input frame using the current preset
+    int8_t   sc_prev_delta; // last preset step
+    uint32_t sc_keep_up_count; // checks keeping up since the last preset step
+    uint32_t sc_probe_wait; // checks to keep up before trying a slower preset
 
     // Sequence Parameter Change Flags
     bool seq_param_change;
@@ -121,24 +111,14 @@ EbErrorType svt_aom_resource_coordination_context_ctor(EbThreadContext *thread_c
 
     EB_CALLOC_ARRAY(context_ptr->picture_number_array, context_ptr->encode_instances_total_count);
 
-    context_ptr->average_enc_mod                    = 0;
-    context_ptr->prev_enc_mod                       = 0;
-    context_ptr->prev_enc_mode_delta                = 0;
-    context_ptr->cur_speed                          = 0; // speed x 1000
-    context_ptr->previous_mode_change_buffer        = 0;
-    context_ptr->first_in_pic_arrived_time_seconds  = 0;
-    context_ptr->first_in_pic_arrived_timeu_seconds = 0;
-    context_ptr->previous_frame_in_check1           = 0;
-    context_ptr->previous_frame_in_check2           = 0;
-    context_ptr->previous_frame_in_check3           = 0;
-    context_ptr->previous_mode_change_frame_in      = 0;
-    context_ptr->prevs_time_seconds                 = 0;
-    context_ptr->prevs_timeu_seconds                = 0;
-    context_ptr->prev_frame_out                     = 0;
-    context_ptr->start_flag                         = false;
-
-    context_ptr->previous_buffer_check1 = 0;
-    context_ptr->prev_change_cond       = 0;
+    context_ptr->sc_check_time_seconds  = 0;
+    context_ptr->sc_check_time_useconds = 0;
+    context_ptr->sc_check_frame_in      = 0;
+    context_ptr->sc_check_frame_out     = 0;
+    context_ptr->sc_change_frame_in     = 0;
+    context_ptr->sc_prev_delta          = 0;
+    context_ptr->sc_keep_up_count       = 0;
+    context_ptr->sc_probe_wait          = SC_PROBE_WAIT_MIN;
 
     context_ptr->seq_param_change = 0;
     context_ptr->video_res_change = 0;
@@ -146,160 +126,87 @@ EbErrorType svt_aom_resource_coordination_context_ctor(EbThreadContext *thread_c
 }
 
 //******************************************************************************//
-// Modify the Enc mode based on the buffer Status
-// Inputs: TargetSpeed, Status of the SCbuffer
-// Output: EncMod
+// Modify the Enc mode based on the output rate
+// Inputs: frame rate, input and output frame counts, wall-clock time
+// Output: EncMode, stepped between the configured preset and the fastest allowed one
 //******************************************************************************//
-void speed_buffer_control(ResourceCoordinationContext *context_ptr, PictureParentControlSet *pcs,
-                          SequenceControlSet *scs) {
-    uint64_t curs_time_seconds  = 0;
-    uint64_t curs_time_useconds = 0;
-    double   overall_duration   = 0.0;
-    double   inst_duration      = 0.0;
-    int8_t   encoder_mode_delta = 0;
-    int64_t  input_frames_count = 0;
-    int8_t   change_cond        = 0;
-    int64_t  target_fps         = (60 >> 16);
-
-    int64_t buffer_threshold_1 = SC_FRAMES_INTERVAL_T1;
-    int64_t buffer_threshold_2 = SC_FRAMES_INTERVAL_T2;
-    int64_t buffer_threshold_3 = MIN(target_fps * 3, SC_FRAMES_INTERVAL_T3);
-    svt_block_on_mutex(scs->enc_ctx->sc_buffer_mutex);
-
-    if (scs->enc_ctx->sc_frame_in == 0)
-        svt_av1_get_time(&context_ptr->first_in_pic_arrived_time_seconds,
-                         &context_ptr->first_in_pic_arrived_timeu_seconds);
-    else if (scs->enc_ctx->sc_frame_in == SC_FRAMES_TO_IGNORE)
-        context_ptr->start_flag = true;
-    // Compute duration since the start of the encode and since the previous checkpoint
-    svt_av1_get_time(&curs_time_seconds, &curs_time_useconds);
-
-    overall_duration = svt_av1_compute_overall_elapsed_time_ms(context_ptr->first_in_pic_arrived_time_seconds,
-                                                               context_ptr->first_in_pic_arrived_timeu_seconds,
-                                                               curs_time_seconds,
-                                                               curs_time_useconds);
-
-    inst_duration = svt_av1_compute_overall_elapsed_time_ms(
-        context_ptr->prevs_time_seconds, context_ptr->prevs_timeu_seconds, curs_time_seconds, curs_time_useconds);
-
-    input_frames_count      = (int64_t)overall_duration * (60 >> 16) / 1000;
-    scs->enc_ctx->sc_buffer = input_frames_count - scs->enc_ctx->sc_frame_in;
-
-    encoder_mode_delta = 0;
-
-    // Check every bufferTsshold1 for the changes (previous_frame_in_check1 variable)
-    if ((scs->enc_ctx->sc_frame_in > context_ptr->previous_frame_in_check1 + buffer_threshold_1 &&
-         scs->enc_ctx->sc_frame_in >= SC_FRAMES_TO_IGNORE)) {
-        // Go to a slower mode based on the fullness and changes of the buffer
-        if (scs->enc_ctx->sc_buffer < target_fps &&
-            (context_ptr->prev_enc_mode_delta > -1 ||
-             (context_ptr->prev_enc_mode_delta < 0 &&
-              scs->enc_ctx->sc_frame_in > context_ptr->previous_mode_change_frame_in + target_fps * 2))) {
-            if (context_ptr->previous_buffer_check1 > scs->enc_ctx->sc_buffer + buffer_threshold_1) {
-                encoder_mode_delta += -1;
-                change_cond = 2;
-            } else if (context_ptr->previous_mode_change_buffer > buffer_threshold_1 + scs->enc_ctx->sc_buffer &&
-                       scs->enc_ctx->sc_buffer < buffer_threshold_1) {
-                encoder_mode_delta += -1;
-                change_cond = 4;
-            }
-        }
-
-        // Go to a faster mode based on the fullness and changes of the buffer
-        if (scs->enc_ctx->sc_buffer > buffer_threshold_1 + context_ptr->previous_buffer_check1) {
-            encoder_mode_delta += +1;
-            change_cond = 1;
-        } else if (scs->enc_ctx->sc_buffer > buffer_threshold_1 + context_ptr->previous_mode_change_buffer) {
-            encoder_mode_delta += +1;
-            change_cond = 3;
-        }
-
-        // Update the encode mode based on the fullness of the buffer
-        // If previous ChangeCond was the same, double the threshold2
-        if (scs->enc_ctx->sc_buffer > buffer_threshold_3 &&
-            (context_ptr->prev_change_cond != 7 ||
-             scs->enc_ctx->sc_frame_in > context_ptr->previous_mode_change_frame_in + buffer_threshold_2 * 2) &&
-            scs->enc_ctx->sc_buffer > context_ptr->previous_mode_change_buffer) {
-            encoder_mode_delta += 1;
-            change_cond = 7;
-        }
-        encoder_mode_delta     = CLIP3(-1, 1, encoder_mode_delta);
-        scs->enc_ctx->enc_mode = (EncMode)CLIP3(1, MAX_ENC_PRESET, (int8_t)scs->enc_ctx->enc_mode + encoder_mode_delta);
-
-        // Update previous stats
-        context_ptr->previous_frame_in_check1 = scs->enc_ctx->sc_frame_in;
-        context_ptr->previous_buffer_check1   = scs->enc_ctx->sc_buffer;
+static void speed_buffer_control(ResourceCoordinationContext *context_ptr, PictureParentControlSet *pcs,
+                                 SequenceControlSet *scs) {
+    EncodeContext *enc_ctx = scs->enc_ctx;
+    svt_block_on_mutex(enc_ctx->sc_buffer_mutex);
 
-        if (encoder_mode_delta) {
-            context_ptr->previous_mode_change_buffer   = scs->enc_ctx->sc_buffer;
-            context_ptr->previous_mode_change_frame_in = scs->enc_ctx->sc_frame_in;
-            context_ptr->prev_enc_mode_delta           = encoder_mode_delta;
-        }
+    // The overlay is coded with the preset of its ALT_REF
+    if (pcs->is_overlay) {
+        pcs->enc_mode = enc_ctx->enc_mode;
+        svt_release_mutex(enc_ctx->sc_buffer_mutex);
+        return;
     }
-
-    // Check every buffer_threshold_2 for the changes (previous_frame_in_check2 variable)
-    if ((scs->enc_ctx->sc_frame_in > context_ptr->previous_frame_in_check2 + buffer_threshold_2 &&
-         scs->enc_ctx->sc_frame_in >= SC_FRAMES_TO_IGNORE)) {
-        encoder_mode_delta = 0;
-
-        // if no change in the encoder mode and buffer is low enough and level is not increasing,
-        // switch to a slower encoder mode If previous ChangeCond was the same, double the
-        // threshold2
-        if (scs->enc_ctx->sc_frame_in > context_ptr->previous_mode_change_frame_in + buffer_threshold_2 &&
-            (context_ptr->prev_change_cond != 8 ||
-             scs->enc_ctx->sc_frame_in > context_ptr->previous_mode_change_frame_in + buffer_threshold_2 * 2) &&
-            ((scs->enc_ctx->sc_buffer - context_ptr->previous_mode_change_buffer < (target_fps / 3)) ||
-             context_ptr->previous_mode_change_buffer == 0) &&
-            scs->enc_ctx->sc_buffer < buffer_threshold_3) {
-            encoder_mode_delta = -1;
-            change_cond        = 8;
-        }
-
-        encoder_mode_delta     = CLIP3(-1, 1, encoder_mode_delta);
-        scs->enc_ctx->enc_mode = (EncMode)CLIP3(1, MAX_ENC_PRESET, (int8_t)scs->enc_ctx->enc_mode + encoder_mode_delta);
-
-        // Update previous stats
-        context_ptr->previous_frame_in_check2 = scs->enc_ctx->sc_frame_in;
-
-        if (encoder_mode_delta) {
-            context_ptr->previous_mode_change_buffer   = scs->enc_ctx->sc_buffer;
-            context_ptr->previous_mode_change_frame_in = scs->enc_ctx->sc_frame_in;
-            context_ptr->prev_enc_mode_delta           = encoder_mode_delta;
-        }
+    if (enc_ctx->sc_frame_in == 0) {
+        enc_ctx->enc_mode = scs->static_config.enc_mode;
+        svt_av1_get_time(&context_ptr->sc_check_time_seconds, &context_ptr->sc_check_time_useconds);
     }
-    // Check every SC_FRAMES_INTERVAL_SPEED frames for the speed calculation
-    // (previous_frame_in_check3 variable)
-    if (context_ptr->start_flag ||
-        (scs->enc_ctx->sc_frame_in > context_ptr->previous_frame_in_check3 + SC_FRAMES_INTERVAL_SPEED &&
-         scs->enc_ctx->sc_frame_in >= SC_FRAMES_TO_IGNORE)) {
-        if (context_ptr->start_flag)
-            context_ptr->cur_speed = (uint64_t)(scs->enc_ctx->sc_frame_out - 0) * 1000 / (uint64_t)(overall_duration);
-        else {
-            if (inst_duration != 0)
-                context_ptr->cur_speed = (uint64_t)(scs->enc_ctx->sc_frame_out - context_ptr->prev_frame_out) * 1000 /
-                    (uint64_t)(inst_duration);
+    const int64_t mg_size = (int64_t)1 << scs->static_config.hierarchical_levels;
+    const double  fps     = (double)scs->static_config.frame_rate_numerator /
+        scs->static_config.frame_rate_denominator;
+
+    // Check the speed at the start of a mini-GOP, once about a second of input entered since the previous check
+    if (enc_ctx->sc_frame_in > 0 && (enc_ctx->sc_frame_in - 1) % mg_size == 0 &&
+        enc_ctx->sc_frame_in - context_ptr->sc_check_frame_in >= (int64_t)fps) {
+        uint64_t cur_seconds, cur_useconds;
+        svt_av1_get_time(&cur_seconds, &cur_useconds);
+        const int64_t frame_out = enc_ctx->sc_frame_out;
+
+        // Only measure windows fully output with the current preset, which starts after the pipeline delay
+        if (context_ptr->sc_check_frame_out > context_ptr->sc_change_frame_in) {
+            const double elapsed_ms = svt_av1_compute_overall_elapsed_time_ms(
+                context_ptr->sc_check_time_seconds, context_ptr->sc_check_time_useconds, cur_seconds, cur_useconds);
+            const double out_fps = elapsed_ms > 0
+                ? (double)(frame_out - context_ptr->sc_check_frame_out) * 1000 / elapsed_ms
+                : fps;
+            // Pictures in flight piling up mean the input arrives faster than the output
+            const int64_t backlog_growth = (enc_ctx->sc_frame_in - frame_out) -
+                (context_ptr->sc_check_frame_in - context_ptr->sc_check_frame_out);
+            const bool keep_up = out_fps * 100 >= fps * SC_KEEP_UP_PCT && backlog_growth <= mg_size;
+
+            int8_t encoder_mode_delta = 0;
+            if (!keep_up) {
+                // A slower preset falling behind right away is tried less often
+                if (context_ptr->sc_prev_delta < 0 && context_ptr->sc_keep_up_count == 0)
+                    context_ptr->sc_probe_wait = MIN(context_ptr->sc_probe_wait * 2, SC_PROBE_WAIT_MAX);
+                context_ptr->sc_keep_up_count = 0;
+                // Step twice when the output is less than half the frame rate
+                encoder_mode_delta = out_fps * 2 < fps ? 2 : 1;
+                encoder_mode_delta = (int8_t)MIN(encoder_mode_delta,
+                                                 scs->speed_control_max_preset - enc_ctx->enc_mode);
+            } else {
+                if (context_ptr->sc_keep_up_count < context_ptr->sc_probe_wait)
+                    context_ptr->sc_keep_up_count++;
+                if (context_ptr->sc_keep_up_count >= context_ptr->sc_probe_wait &&
+                    enc_ctx->enc_mode > scs->static_config.enc_mode) {
+                    // The previous slower preset kept up, try the next one sooner
+                    if (context_ptr->sc_prev_delta < 0)
+                        context_ptr->sc_probe_wait = MAX(context_ptr->sc_probe_wait / 2, SC_PROBE_WAIT_MIN);
+                    encoder_mode_delta = -1;
+                }
+            }
+            if (encoder_mode_delta) {
+                enc_ctx->enc_mode               = (EncMode)(enc_ctx->enc_mode + encoder_mode_delta);
+                context_ptr->sc_prev_delta      = encoder_mode_delta;
+                context_ptr->sc_keep_up_count   = 0;
+                context_ptr->sc_change_frame_in = enc_ctx->sc_frame_in;
+            }
         }
-        context_ptr->start_flag = false;
-
         // Update previous stats
-        context_ptr->previous_frame_in_check3 = scs->enc_ctx->sc_frame_in;
-        context_ptr->prevs_time_seconds       = curs_time_seconds;
-        context_ptr->prevs_timeu_seconds      = curs_time_useconds;
-        context_ptr->prev_frame_out           = scs->enc_ctx->sc_frame_out;
-    } else if (scs->enc_ctx->sc_frame_in < SC_FRAMES_TO_IGNORE && (overall_duration != 0))
-        context_ptr->cur_speed = (uint64_t)(scs->enc_ctx->sc_frame_out - 0) * 1000 / (uint64_t)(overall_duration);
-    if (change_cond)
-        context_ptr->prev_change_cond = change_cond;
-    scs->enc_ctx->sc_frame_in++;
-    if (scs->enc_ctx->sc_frame_in >= SC_FRAMES_TO_IGNORE)
-        context_ptr->average_enc_mod += scs->enc_ctx->enc_mode;
-    else
-        context_ptr->average_enc_mod = 0;
+        context_ptr->sc_check_time_seconds  = cur_seconds;
+        context_ptr->sc_check_time_useconds = cur_useconds;
+        context_ptr->sc_check_frame_in      = enc_ctx->sc_frame_in;
+        context_ptr->sc_check_frame_out     = frame_out;
+    }
+    enc_ctx->sc_frame_in++;
     // Set the encoder level
-    pcs->enc_mode = scs->enc_ctx->enc_mode;
+    pcs->enc_mode = enc_ctx->enc_mode;
 
-    svt_release_mutex(scs->enc_ctx->sc_buffer_mutex);
-    context_ptr->prev_enc_mod = scs->enc_ctx->enc_mode;
+    svt_release_mutex(enc_ctx->sc_buffer_mutex);
 }
 // Film grain (assigning the random-seed)
 static void assign_film_grain_random_seed(PictureParentControlSet *pcs) {
@@ -430,6 +337,7 @@ static EbErrorType reset_pcs_av1(PictureParentControlSet *pcs) {
 
     SequenceControlSet *scs           = pcs->scs;
     pcs->me_segments_completion_count = 0;
+    pcs->hash_table_held              = false;
     pcs->me_segments_column_count     = (uint8_t)(scs->me_segment_column_count_array[0]);
     pcs->me_segments_row_count        = (uint8_t)(scs->me_segment_row_count_array[0]);
 
@@ -739,6 +647,7 @@ static void update_rate_info(ResourceCoordinationContext *ctx, EbBufferHeaderTyp
 static void update_frame_event(PictureParentControlSet *pcs, uint64_t pic_num) {
     SequenceControlSet *scs  = pcs->scs;
     EbPrivDataNode     *node = (EbPrivDataNode *)pcs->input_ptr->p_app_private;
+    pcs->mv_hints            = NULL;
     while (node) {
         if (node->node_type == REF_FRAME_SCALING_EVENT) {
             // update resize denominator by input event
@@ -752,6 +661,12 @@ static void update_frame_event(PictureParentControlSet *pcs, uint64_t pic_num) {
             svt_aom_assert_err(node->size == sizeof(SvtAv1RoiMapEvt *) && node->data,
                                "invalide private data of type ROI_MAP_EVENT");
             scs->enc_ctx->roi_map_evt = (SvtAv1RoiMapEvt *)node->data;
+        } else if (node->node_type == MV_HINT_EVENT) {
+            // The field is in the units of the input picture, it is not used when ME runs on scaled pictures
+            const SvtAv1MotionHints *hints = (const SvtAv1MotionHints *)node->data;
+            if (hints->mv && scs->static_config.resize_mode == RESIZE_NONE &&
+                scs->static_config.superres_mode == SUPERRES_NONE)
+                pcs->mv_hints = hints;
         }
         node = node->next;
     }
@@ -783,7 +698,7 @@ static void set_eos_terminating_signals(PictureParentControlSet *pcs) {
         tmp_out_str->flags        = EB_BUFFERFLAG_EOS;
         tmp_out_str->n_filled_len = 0;
 
-        svt_post_full_object(tmp_out_str_wrp);
+        svt_aom_post_packet(enc_ctx, tmp_out_str_wrp, NULL);
         release_references_eos(scs);
     }
 
@@ -1029,6 +944,8 @@ void *svt_aom_resource_coordination_kernel(void *input_ptr) {
             pcs->superres_total_recode_loop = 0;
             pcs->superres_recode_loop       = 0;
             svt_av1_get_time(&pcs->start_time_seconds, &pcs->start_time_u_seconds);
+            memset(&pcs->timestamps, 0, sizeof(pcs->timestamps));
+            pcs->timestamps.resource_coordination = svt_av1_get_time_ns();
             pcs->seq_param_changed = (context_ptr->seq_param_change) ? true : false;
             // set the scs wrapper to be released after the picture is done
             pcs->scs_wrapper = context_ptr->scs_active_array[instance_index];
@@ -1093,6 +1010,7 @@ void *svt_aom_resource_coordination_kernel(void *input_ptr) {
                 pcs->picture_number = context_ptr->picture_number_array[instance_index]++;
             else
                 pcs->picture_number = context_ptr->picture_number_array[instance_index];
+            SVT_TRACE_TASK("ResourceCoordination", pcs->picture_number, -1);
             if (scs->passes == 2 && !end_of_sequence_flag && scs->static_config.pass == ENC_SECOND_PASS &&
                 scs->static_config.rate_control_mode) {
                 pcs->stat_struct = (scs->twopass.stats_buf_ctx->stats_in_start + pcs->picture_number)->stat_struct;
@@ -22,6 +22,7 @@
 #include "resource_coordination_process.h"
 #include "resize.h"
 #include "enc_mode_config.h"
+#include "svt_trace.h"
 
 /**************************************
  * Rest Context
@@ -548,6 +549,7 @@ void *svt_aom_rest_kernel(void *input_ptr) {
 
         cdef_results                  = (CdefResults *)cdef_results_wrapper->object_ptr;
         pcs                           = (PictureControlSet *)cdef_results->pcs_wrapper->object_ptr;
+        SVT_TRACE_TASK("Restoration", pcs->picture_number, (int32_t)cdef_results->segment_index);
         PictureParentControlSet *ppcs = pcs->ppcs;
         scs                           = pcs->scs;
         FrameHeader *frm_hdr          = &pcs->ppcs->frm_hdr;
@@ -719,7 +721,14 @@ void *svt_aom_rest_kernel(void *input_ptr) {
                                        "Couldn't allocate memory for uncompressed 10bit buffers for PSNR "
                                        "calculations");
                 }
+                // The EntropyCoding processes help with the SSIM jobs of the picture
+                pcs->ssim_jobs.helper_fifo = context_ptr->rest_output_fifo_ptr;
+                pcs->ssim_jobs.pcs_wrapper = cdef_results->pcs_wrapper;
+                pcs->ssim_jobs.helper_max  = scs->entropy_coding_process_init_count > 1
+                     ? scs->entropy_coding_process_init_count
+                     : 0;
                 return_error = svt_aom_ssim_calculations(pcs, scs, true /* free memory here */);
+                pcs->ssim_jobs.helper_fifo = NULL;
                 if (return_error != EB_ErrorNone) {
                     svt_aom_assert_err(0,
                                        "Couldn't allocate memory for uncompressed 10bit buffers for SSIM "
@@ -757,6 +766,7 @@ void *svt_aom_rest_kernel(void *input_ptr) {
                     rest_results              = (struct RestResults *)rest_results_wrapper->object_ptr;
                     rest_results->pcs_wrapper = cdef_results->pcs_wrapper;
                     rest_results->tile_index  = tile_idx;
+                    rest_results->task_type   = REST_TASK_TILE;
                     // Post Rest Results
                     svt_post_full_object(rest_results_wrapper);
                 }
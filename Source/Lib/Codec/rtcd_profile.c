@@ -0,0 +1,245 @@
+/*
+* Copyright (c) 2025, Alliance for Open Media. All rights reserved
+*
+* This source code is subject to the terms of the BSD 2 Clause License and
+* the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+* was not distributed with this source code in the LICENSE file, you can
+* obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+* Media Patent License 1.0 was not distributed with this source code in the
+* PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+*/
+
+#include "rtcd_profile.h"
+
+#if RTCD_PROFILE
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#include "svt_threads.h"
+#define LOG_TAG "SvtRtcdProfile"
+#include "svt_log.h"
+
+// Up to 2048 registered functions, in a 4096 slot open addressing table
+#define RTCD_PROFILE_MAX_ENTRIES 2048
+#define RTCD_PROFILE_SLOTS 4096
+
+// Everything here runs from the hooks or before the hooks can reach it
+#define NO_INSTRUMENT __attribute__((no_instrument_function))
+
+typedef struct RtcdProfileEntry {
+    const char *name;
+    void (*fn)(void);
+    bool is_c;
+} RtcdProfileEntry;
+
+// Counters of one thread; blocks are never freed as their threads may still call kernels
+typedef struct RtcdProfileThread {
+    struct RtcdProfileThread *next;
+    uint32_t                  depth; // registered kernels being executed
+    uint32_t                  sampled_depth; // depth of the timed call, 0 when none
+    uint32_t                  sampled_idx;
+    uint32_t                  tick;
+    uint64_t                  sample_start;
+    uint64_t                  calls[RTCD_PROFILE_MAX_ENTRIES];
+    uint64_t                  samples[RTCD_PROFILE_MAX_ENTRIES];
+    uint64_t                  cycles[RTCD_PROFILE_MAX_ENTRIES];
+} RtcdProfileThread;
+
+static RtcdProfileEntry   g_entries[RTCD_PROFILE_MAX_ENTRIES];
+static uint32_t           g_entry_count;
+static uint32_t           g_slots[RTCD_PROFILE_SLOTS]; // entry index + 1, 0 when free
+static RtcdProfileThread *g_threads;
+static uint32_t           g_ref_count;
+static bool               g_lock;
+
+static EB_THREAD_LOCAL RtcdProfileThread *profile_thread;
+
+// The hooks may not call instrumented functions, so the few updates of the
+// registry and the reference count take a spin lock instead of an svt mutex
+static NO_INSTRUMENT void profile_lock(void) {
+    while (__atomic_test_and_set(&g_lock, __ATOMIC_ACQUIRE))
+        ;
+}
+static NO_INSTRUMENT void profile_unlock(void) { __atomic_clear(&g_lock, __ATOMIC_RELEASE); }
+
+static NO_INSTRUMENT uint64_t read_cycles(void) {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#elif defined(__aarch64__)
+    uint64_t ticks;
+    __asm__ volatile("mrs %0, cntvct_el0" : "=r"(ticks));
+    return ticks;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+#endif
+}
+
+static NO_INSTRUMENT uint32_t slot_of(void (*fn)(void)) {
+    uintptr_t h = (uintptr_t)fn;
+    h ^= h >> 17;
+    h *= 0x9E3779B1u;
+    return (uint32_t)(h >> 7) & (RTCD_PROFILE_SLOTS - 1);
+}
+
+/* Returns the entry of fn, or -1 when fn is not a registered kernel */
+static NO_INSTRUMENT int32_t lookup(void *fn) {
+    for (uint32_t slot = slot_of((void (*)(void))fn);; slot = (slot + 1) & (RTCD_PROFILE_SLOTS - 1)) {
+        const uint32_t idx = __atomic_load_n(&g_slots[slot], __ATOMIC_ACQUIRE);
+        if (!idx)
+            return -1;
+        if ((void *)g_entries[idx - 1].fn == fn)
+            return (int32_t)idx - 1;
+    }
+}
+
+void NO_INSTRUMENT svt_rtcd_profile_register(const char *name, void (*fn)(void), bool is_c) {
+    profile_lock();
+    uint32_t slot = slot_of(fn);
+    for (; g_slots[slot]; slot = (slot + 1) & (RTCD_PROFILE_SLOTS - 1))
+        if (g_entries[g_slots[slot] - 1].fn == fn)
+            break;
+    // The same function may serve several pointers: the first name is kept
+    if (!g_slots[slot] && g_entry_count < RTCD_PROFILE_MAX_ENTRIES) {
+        RtcdProfileEntry *entry = &g_entries[g_entry_count++];
+        entry->name             = name;
+        entry->fn               = fn;
+        entry->is_c             = is_c;
+        __atomic_store_n(&g_slots[slot], g_entry_count, __ATOMIC_RELEASE);
+    }
+    profile_unlock();
+}
+
+/* Returns the block of the calling thread, registering it on first use */
+static NO_INSTRUMENT RtcdProfileThread *get_thread(void) {
+    if (profile_thread)
+        return profile_thread;
+    RtcdProfileThread *t = (RtcdProfileThread *)calloc(1, sizeof(*t));
+    if (!t)
+        return NULL;
+    t->next = __atomic_load_n(&g_threads, __ATOMIC_RELAXED);
+    while (!__atomic_compare_exchange_n(&g_threads, &t->next, t, true, __ATOMIC_RELEASE, __ATOMIC_RELAXED))
+        ;
+    profile_thread = t;
+    return t;
+}
+
+NO_INSTRUMENT void __cyg_profile_func_enter(void *fn, void *call_site);
+NO_INSTRUMENT void __cyg_profile_func_exit(void *fn, void *call_site);
+
+void __cyg_profile_func_enter(void *fn, void *call_site) {
+    (void)call_site;
+    const int32_t idx = lookup(fn);
+    if (idx < 0)
+        return;
+    RtcdProfileThread *t = get_thread();
+    if (!t)
+        return;
+    t->calls[idx]++;
+    t->depth++;
+    if (!t->sampled_depth && ++t->tick >= RTCD_PROFILE_SAMPLE_PERIOD) {
+        t->tick          = 0;
+        t->sampled_depth = t->depth;
+        t->sampled_idx   = (uint32_t)idx;
+        t->sample_start  = read_cycles();
+    }
+}
+
+void __cyg_profile_func_exit(void *fn, void *call_site) {
+    (void)call_site;
+    RtcdProfileThread *t = profile_thread;
+    if (!t || !t->depth || lookup(fn) < 0)
+        return;
+    if (t->sampled_depth == t->depth) {
+        t->cycles[t->sampled_idx] += read_cycles() - t->sample_start;
+        t->samples[t->sampled_idx]++;
+        t->sampled_depth = 0;
+    }
+    t->depth--;
+}
+
+typedef struct RtcdProfileTotal {
+    uint32_t idx;
+    uint64_t calls;
+    uint64_t samples;
+    uint64_t cycles; // estimated for all the calls
+} RtcdProfileTotal;
+
+static NO_INSTRUMENT int compare_totals(const void *a, const void *b) {
+    const RtcdProfileTotal *ta = (const RtcdProfileTotal *)a;
+    const RtcdProfileTotal *tb = (const RtcdProfileTotal *)b;
+    if (ta->cycles != tb->cycles)
+        return ta->cycles < tb->cycles ? 1 : -1;
+    return ta->calls < tb->calls ? 1 : ta->calls > tb->calls ? -1 : 0;
+}
+
+/* Logs the kernels ranked by estimated cycles, and clears the counters */
+static NO_INSTRUMENT void profile_report(void) {
+    RtcdProfileTotal *totals = (RtcdProfileTotal *)calloc(g_entry_count ? g_entry_count : 1, sizeof(*totals));
+    if (!totals)
+        return;
+    uint64_t total_cycles = 0, total_calls = 0;
+    for (uint32_t i = 0; i < g_entry_count; i++) {
+        RtcdProfileTotal *total = &totals[i];
+        total->idx              = i;
+        for (RtcdProfileThread *t = g_threads; t; t = t->next) {
+            total->calls += t->calls[i];
+            total->samples += t->samples[i];
+            total->cycles += t->cycles[i];
+        }
+        if (total->samples)
+            total->cycles = (uint64_t)((double)total->cycles * total->calls / total->samples);
+        total_cycles += total->cycles;
+        total_calls += total->calls;
+    }
+    qsort(totals, g_entry_count, sizeof(*totals), compare_totals);
+
+    SVT_INFO("RTCD kernel profile: %llu calls, %.1f Mcycles estimated from 1 call in %d\n",
+             (unsigned long long)total_calls,
+             total_cycles / 1e6,
+             RTCD_PROFILE_SAMPLE_PERIOD);
+    SVT_INFO("%6s %12s %14s %10s %4s  %s\n", "share", "Mcycles", "calls", "cyc/call", "impl", "kernel");
+    for (uint32_t i = 0; i < g_entry_count && totals[i].calls; i++) {
+        const RtcdProfileTotal *total = &totals[i];
+        const RtcdProfileEntry *entry = &g_entries[total->idx];
+        SVT_INFO("%5.1f%% %12.2f %14llu %10.0f %4s  %s\n",
+                 total_cycles ? 100.0 * total->cycles / total_cycles : 0.0,
+                 total->cycles / 1e6,
+                 (unsigned long long)total->calls,
+                 (double)total->cycles / total->calls,
+                 entry->is_c ? "c" : "simd",
+                 entry->name);
+    }
+    free(totals);
+
+    for (RtcdProfileThread *t = g_threads; t; t = t->next) {
+        memset(t->calls, 0, sizeof(t->calls));
+        memset(t->samples, 0, sizeof(t->samples));
+        memset(t->cycles, 0, sizeof(t->cycles));
+    }
+}
+
+/**************************************
+ * svt_rtcd_profile_init
+ **************************************/
+void NO_INSTRUMENT svt_rtcd_profile_init(void) {
+    profile_lock();
+    g_ref_count++;
+    profile_unlock();
+}
+
+/**************************************
+ * svt_rtcd_profile_deinit
+ **************************************/
+void NO_INSTRUMENT svt_rtcd_profile_deinit(void) {
+    profile_lock();
+    if (g_ref_count && --g_ref_count == 0)
+        profile_report();
+    profile_unlock();
+}
+#endif // RTCD_PROFILE
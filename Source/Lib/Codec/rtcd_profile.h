@@ -0,0 +1,65 @@
+/*
+* Copyright (c) 2025, Alliance for Open Media. All rights reserved
+*
+* This source code is subject to the terms of the BSD 2 Clause License and
+* the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+* was not distributed with this source code in the LICENSE file, you can
+* obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+* Media Patent License 1.0 was not distributed with this source code in the
+* PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+*/
+
+#ifndef EbRtcdProfile_h
+#define EbRtcdProfile_h
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef RTCD_PROFILE
+#define RTCD_PROFILE 0
+#endif
+
+/**************************************
+ * RTCD kernel profiling
+ *
+ * Opt-in build (SVT_AV1_RTCD_PROFILE), compiling the library with
+ * -finstrument-functions. The RTCD setup registers the function each pointer
+ * is set to; the entry and exit hooks of the instrumentation count the calls
+ * of the registered functions and time one call out of
+ * RTCD_PROFILE_SAMPLE_PERIOD per thread with the cycle counter. Each thread
+ * counts in its own block without locking. When the last encoder handle is
+ * deinitialized the kernels are logged ranked by their estimated cycles
+ * (sampled cycles scaled by calls / samples), and the counters restart.
+ *
+ * Cycles are inclusive of the registered kernels a kernel calls. Assembly
+ * kernels are not instrumented, so they are not counted. With GCC the inline
+ * functions are instrumented too, which adds the cost of their hooks to the C
+ * kernels; Clang instruments after inlining.
+ **************************************/
+#define RTCD_PROFILE_SAMPLE_PERIOD 64
+
+#if RTCD_PROFILE
+/* Registers fn as the function of the RTCD pointer name; is_c tells it is the C version */
+extern void svt_rtcd_profile_register(const char *name, void (*fn)(void), bool is_c);
+
+/* Reference counted like svt_trace_init(); the last svt_rtcd_profile_deinit()
+ * logs the report. All the profiled threads must have exited by then. */
+extern void svt_rtcd_profile_init(void);
+extern void svt_rtcd_profile_deinit(void);
+
+#define RTCD_PROFILE_REGISTER(ptr, c) \
+    svt_rtcd_profile_register(#ptr, (void (*)(void))(ptr), (uintptr_t)(ptr) == (uintptr_t)(c))
+#else
+#define RTCD_PROFILE_REGISTER(ptr, c)
+#define svt_rtcd_profile_init()
+#define svt_rtcd_profile_deinit()
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+#endif // EbRtcdProfile_h
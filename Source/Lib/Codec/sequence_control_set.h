@@ -176,6 +176,8 @@ typedef struct SequenceControlSet {
     uint32_t tf_segment_row_count;
     // level of parallelism determined based on the core count
     uint32_t lp;
+    // number of logical processors available to the encoder (after pinning / socket selection)
+    uint32_t core_count;
 
     /*!< Picture, reference, recon and input output buffer count */
     uint32_t picture_control_set_pool_init_count;
@@ -281,11 +283,13 @@ typedef struct SequenceControlSet {
     int max_heirachical_level;
     /* Flag to enable the Speed Control functionality to achieve the real-time
     * encoding speed defined by dynamically changing the encoding preset to meet
-    * the average speed defined in injectorFrameRate. When this parameter is set
-    * to 1 it forces -inj to be 1 -inj-frm-rt to be set to the -fps.
+    * the frame rate. The preset is stepped per mini-GOP between
+    * static_config.enc_mode and speed_control_max_preset.
     *
     * Default is 0. */
     int speed_control_flag;
+    // Fastest preset used by the Speed Control
+    EncMode speed_control_max_preset;
     /* TPL
     *
     * 0: OFF, 1: ON. */
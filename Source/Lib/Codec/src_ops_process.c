@@ -34,6 +34,7 @@
 #include "av1me.h"
 #include "enc_inter_prediction.h"
 #include "resize.h"
+#include "svt_trace.h"
 /**************************************
  * Context
  **************************************/
@@ -1972,6 +1973,7 @@ void *svt_aom_tpl_disp_kernel(void *input_ptr) {
         in_results_ptr = (TplDispResults *)in_results_wrapper_ptr->object_ptr;
 
         PictureParentControlSet *pcs = in_results_ptr->pcs;
+        SVT_TRACE_TASK("TPL", pcs->picture_number, -1);
 
         SequenceControlSet *scs = (SequenceControlSet *)pcs->scs;
 
@@ -1997,6 +1999,7 @@ void *svt_aom_tpl_disp_kernel(void *input_ptr) {
             while (assign_tpl_segments(
                        segments_ptr, &segment_index, in_results_ptr, frame_idx, context_ptr->tpl_disp_fb_fifo_ptr) ==
                    true) {
+                uint64_t seg_start = SVT_TRACE_NOW();
                 uint32_t x_sb_start_index;
                 uint32_t y_sb_start_index;
                 uint32_t sb_start_index;
@@ -2053,6 +2056,7 @@ void *svt_aom_tpl_disp_kernel(void *input_ptr) {
 
                     x_sb_start_index = (x_sb_start_index > 0) ? x_sb_start_index - 1 : 0;
                 }
+                SVT_TRACE_SPAN("TPL segment", seg_start, pcs->picture_number, segment_index);
             }
 
             svt_block_on_mutex(pcs->tpl_disp_mutex);
@@ -2221,6 +2225,7 @@ void *svt_aom_source_based_operations_kernel(void *input_ptr) {
 
         InitialRateControlResults *in_results_ptr = (InitialRateControlResults *)in_results_wrapper_ptr->object_ptr;
         PictureParentControlSet   *pcs            = (PictureParentControlSet *)in_results_ptr->pcs_wrapper->object_ptr;
+        SVT_TRACE_TASK("SourceBasedOperations", pcs->picture_number, -1);
         SequenceControlSet        *scs            = pcs->scs;
         if (in_results_ptr->superres_recode) {
             sbo_send_picture_out(context_ptr, pcs, true);
@@ -0,0 +1,125 @@
+/*
+* Copyright (c) 2025, Alliance for Open Media. All rights reserved
+*
+* This source code is subject to the terms of the BSD 2 Clause License and
+* the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+* was not distributed with this source code in the LICENSE file, you can
+* obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+* Media Patent License 1.0 was not distributed with this source code in the
+* PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+*/
+
+#include <stdlib.h>
+
+#include "stage_balancer.h"
+#include "svt_threads.h"
+
+// Sampling period of the stage queues
+#define STAGE_BALANCER_PERIOD_MS 4
+
+/**************************************
+ * stage_balancer_update
+ *   Every stage keeps at least one thread; the rest of the budget is handed
+ *   out one thread at a time to the stage with the highest demand per
+ *   thread. A stage without demand counts as one unit of demand, so idle
+ *   stages end up with an even split.
+ **************************************/
+static void stage_balancer_update(EbStageBalancer *balancer) {
+    uint32_t limit[STAGE_BALANCER_MAX_STAGES];
+    uint32_t budget = balancer->thread_budget - balancer->stage_count;
+
+    for (uint32_t i = 0; i < balancer->stage_count; i++) {
+        EbStageBalancerStage *stage = &balancer->stage_array[i];
+        uint32_t              queued, busy;
+        svt_system_resource_get_consumer_load(stage->resource_ptr, &queued, &busy);
+        stage->demand = (3 * stage->demand + ((queued + busy) << 8) + 2) >> 2;
+        limit[i]      = 1;
+    }
+    while (budget) {
+        int32_t best = -1;
+        for (uint32_t i = 0; i < balancer->stage_count; i++) {
+            if (limit[i] >= balancer->stage_array[i].process_count)
+                continue;
+            if (best < 0 ||
+                (uint64_t)(balancer->stage_array[i].demand + 256) * limit[best] >
+                    (uint64_t)(balancer->stage_array[best].demand + 256) * limit[i])
+                best = (int32_t)i;
+        }
+        if (best < 0)
+            break;
+        limit[best]++;
+        budget--;
+    }
+    for (uint32_t i = 0; i < balancer->stage_count; i++) {
+        EbStageBalancerStage *stage = &balancer->stage_array[i];
+        if (stage->limit != limit[i]) {
+            stage->limit = limit[i];
+            svt_system_resource_set_consumer_limit(stage->resource_ptr, limit[i]);
+        }
+    }
+}
+
+static void *stage_balancer_kernel(void *input_ptr) {
+    EbStageBalancer *balancer = (EbStageBalancer *)input_ptr;
+    while (!svt_atomic_load_u32(&balancer->quit_signal)) {
+        stage_balancer_update(balancer);
+        svt_sleep_ms(STAGE_BALANCER_PERIOD_MS);
+    }
+    return NULL;
+}
+
+static void svt_stage_balancer_dctor(EbPtr p) {
+    EbStageBalancer *obj = (EbStageBalancer *)p;
+    svt_atomic_store_u32(&obj->quit_signal, 1);
+    EB_DESTROY_THREAD(obj->thread_handle);
+}
+
+/**************************************
+ * svt_stage_balancer_ctor
+ **************************************/
+EbErrorType svt_stage_balancer_ctor(EbStageBalancer *balancer, uint32_t thread_budget) {
+    balancer->dctor         = svt_stage_balancer_dctor;
+    balancer->thread_budget = thread_budget;
+    return EB_ErrorNone;
+}
+
+/**************************************
+ * svt_stage_balancer_add_stage
+ **************************************/
+void svt_stage_balancer_add_stage(EbStageBalancer *balancer, const EbSystemResource *resource_ptr,
+                                  uint32_t process_count) {
+    if (process_count <= 1 || balancer->stage_count == STAGE_BALANCER_MAX_STAGES)
+        return;
+    EbStageBalancerStage *stage = &balancer->stage_array[balancer->stage_count++];
+    stage->resource_ptr         = resource_ptr;
+    stage->process_count        = process_count;
+    stage->limit                = process_count;
+    stage->demand               = 0;
+}
+
+/**************************************
+ * svt_stage_balancer_start
+ **************************************/
+EbErrorType svt_stage_balancer_start(EbStageBalancer *balancer) {
+    if (balancer->stage_count == 0)
+        return EB_ErrorNone;
+    uint32_t total_count = 0;
+    for (uint32_t i = 0; i < balancer->stage_count; i++) total_count += balancer->stage_array[i].process_count;
+    // Each stage keeps at least one thread, and the budget cannot exceed the available threads
+    balancer->thread_budget = AOMMIN(AOMMAX(balancer->thread_budget, balancer->stage_count), total_count);
+
+    balancer->thread_handle = svt_create_thread(stage_balancer_kernel, balancer);
+    EB_ADD_MEM(balancer->thread_handle, 1, EB_THREAD);
+    return EB_ErrorNone;
+}
+
+/**************************************
+ * svt_stage_balancer_reset
+ **************************************/
+void svt_stage_balancer_reset(EbStageBalancer *balancer) {
+    for (uint32_t i = 0; i < balancer->stage_count; i++) {
+        EbStageBalancerStage *stage = &balancer->stage_array[i];
+        stage->limit                = stage->process_count;
+        stage->demand               = 0;
+    }
+}
@@ -0,0 +1,74 @@
+/*
+* Copyright (c) 2025, Alliance for Open Media. All rights reserved
+*
+* This source code is subject to the terms of the BSD 2 Clause License and
+* the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+* was not distributed with this source code in the LICENSE file, you can
+* obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+* Media Patent License 1.0 was not distributed with this source code in the
+* PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+*/
+
+#ifndef EbStageBalancer_h
+#define EbStageBalancer_h
+
+#include "definitions.h"
+#include "object.h"
+#include "sys_resource_manager.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define STAGE_BALANCER_MAX_STAGES 16
+
+/**************************************
+ * Stage balancer
+ *
+ * The number of threads of each multi-threaded stage is fixed at init, but
+ * which stage is the bottleneck depends on the content and moves at run time.
+ * The balancer samples the occupancy of the input queue of each registered
+ * stage every few milliseconds, and splits a budget of running threads
+ * between the stages in proportion to their demand (queued objects plus busy
+ * threads). The threads above the share of a stage are parked between two
+ * objects, see svt_system_resource_set_consumer_limit().
+ **************************************/
+typedef struct EbStageBalancerStage {
+    // Input queue of the stage
+    const EbSystemResource *resource_ptr;
+    // Threads of the stage
+    uint32_t process_count;
+    // Threads currently allowed to run
+    uint32_t limit;
+    // Smoothed demand, in Q8
+    uint32_t demand;
+} EbStageBalancerStage;
+
+typedef struct EbStageBalancer {
+    EbDctor              dctor;
+    EbStageBalancerStage stage_array[STAGE_BALANCER_MAX_STAGES];
+    uint32_t             stage_count;
+    // Running threads shared by the registered stages
+    uint32_t          thread_budget;
+    EbHandle          thread_handle;
+    volatile uint32_t quit_signal;
+} EbStageBalancer;
+
+extern EbErrorType svt_stage_balancer_ctor(EbStageBalancer *balancer, uint32_t thread_budget);
+
+/* Registers the stage consuming the full queue of resource_ptr with
+ * process_count threads. Stages with a single thread are ignored. */
+extern void svt_stage_balancer_add_stage(EbStageBalancer *balancer, const EbSystemResource *resource_ptr,
+                                         uint32_t process_count);
+
+/* Starts sampling the registered stages. Deleting the balancer stops it. */
+extern EbErrorType svt_stage_balancer_start(EbStageBalancer *balancer);
+
+/* Forgets the demand and limits of the stages, after their queues were reset
+ * with every thread running. */
+extern void svt_stage_balancer_reset(EbStageBalancer *balancer);
+
+#ifdef __cplusplus
+}
+#endif
+#endif // EbStageBalancer_h
@@ -0,0 +1,86 @@
+/*
+* Copyright (c) 2025, Alliance for Open Media. All rights reserved
+*
+* This source code is subject to the terms of the BSD 2 Clause License and
+* the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+* was not distributed with this source code in the LICENSE file, you can
+* obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+* Media Patent License 1.0 was not distributed with this source code in the
+* PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+*/
+
+#include <stdlib.h>
+
+#include "stage_gate.h"
+#include "svt_threads.h"
+
+static void svt_stage_gate_dctor(EbPtr p) {
+    EbStageGate *obj = (EbStageGate *)p;
+    EB_DESTROY_SEMAPHORE(obj->parked_semaphore);
+    EB_DESTROY_SEMAPHORE(obj->resume_semaphore);
+    EB_FREE_ARRAY(obj->task_array);
+}
+
+/**************************************
+ * svt_stage_gate_ctor
+ **************************************/
+EbErrorType svt_stage_gate_ctor(EbStageGate *gate, uint32_t task_total_count) {
+    gate->dctor            = svt_stage_gate_dctor;
+    gate->task_total_count = task_total_count;
+    gate->mem_scope        = svt_mem_get_scope();
+    EB_CALLOC_ARRAY(gate->task_array, task_total_count);
+    EB_CREATE_SEMAPHORE(gate->parked_semaphore, 0, task_total_count);
+    EB_CREATE_SEMAPHORE(gate->resume_semaphore, 0, task_total_count);
+    return EB_ErrorNone;
+}
+
+/**************************************
+ * svt_stage_gate_add_task
+ **************************************/
+EbStageGateTask *svt_stage_gate_add_task(EbStageGate *gate, EbThreadFunction thread_function, void *thread_context) {
+    if (gate->task_count >= gate->task_total_count)
+        return NULL;
+    EbStageGateTask *task = &gate->task_array[gate->task_count++];
+    task->gate            = gate;
+    task->thread_function = thread_function;
+    task->thread_context  = thread_context;
+    return task;
+}
+
+/**************************************
+ * svt_stage_gate_thread_entry
+ *   Runs a stage kernel until it returns without a restart pending.
+ **************************************/
+void *svt_stage_gate_thread_entry(void *task_ptr) {
+    EbStageGateTask *task = (EbStageGateTask *)task_ptr;
+    EbStageGate     *gate = task->gate;
+    svt_mem_set_scope(gate->mem_scope);
+    for (;;) {
+        void *ret = task->thread_function(task->thread_context);
+        if (!svt_atomic_load_u32(&gate->restart_signal))
+            return ret;
+        svt_post_semaphore(gate->parked_semaphore);
+        svt_block_on_semaphore(gate->resume_semaphore);
+    }
+}
+
+/**************************************
+ * svt_stage_gate_close
+ **************************************/
+void svt_stage_gate_close(EbStageGate *gate) { svt_atomic_store_u32(&gate->restart_signal, 1); }
+
+/**************************************
+ * svt_stage_gate_wait_parked
+ **************************************/
+void svt_stage_gate_wait_parked(EbStageGate *gate) {
+    for (uint32_t i = 0; i < gate->task_count; i++) svt_block_on_semaphore(gate->parked_semaphore);
+}
+
+/**************************************
+ * svt_stage_gate_open
+ **************************************/
+void svt_stage_gate_open(EbStageGate *gate) {
+    // Cleared before the threads wake up, so a kernel returning later exits for good
+    svt_atomic_store_u32(&gate->restart_signal, 0);
+    for (uint32_t i = 0; i < gate->task_count; i++) svt_post_semaphore(gate->resume_semaphore);
+}
@@ -0,0 +1,86 @@
+/*
+* Copyright (c) 2025, Alliance for Open Media. All rights reserved
+*
+* This source code is subject to the terms of the BSD 2 Clause License and
+* the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+* was not distributed with this source code in the LICENSE file, you can
+* obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+* Media Patent License 1.0 was not distributed with this source code in the
+* PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+*/
+
+#ifndef EbStageGate_h
+#define EbStageGate_h
+
+#include "definitions.h"
+#include "object.h"
+#include "svt_scheduler.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**************************************
+ * Stage gate
+ *
+ * The kernels keep their per-stream state in locals of their loop, and only
+ * leave the loop when their input queue is shut down. To start a new stream
+ * on the same threads, the gate runs each kernel from a wrapper: when a
+ * restart is pending and the kernel returns, the thread parks at the gate
+ * instead of exiting, and enters the kernel again once the gate is opened.
+ **************************************/
+typedef struct EbStageGateTask {
+    struct EbStageGate *gate;
+    EbThreadFunction    thread_function;
+    void               *thread_context;
+} EbStageGateTask;
+
+typedef struct EbStageGate {
+    EbDctor          dctor;
+    EbStageGateTask *task_array;
+    uint32_t         task_count;
+    uint32_t         task_total_count;
+    // Set while the kernels are being stopped for a restart
+    volatile uint32_t restart_signal;
+    // Posted by every thread parking at the gate
+    EbHandle parked_semaphore;
+    // Posted once per parked thread to open the gate
+    EbHandle resume_semaphore;
+    // Memory scope of the creator, the stage threads allocate in it
+    EbMemScope mem_scope;
+} EbStageGate;
+
+extern EbErrorType svt_stage_gate_ctor(EbStageGate *gate, uint32_t task_total_count);
+
+/* Registers a stage thread with the gate, returns the context to pass to
+ * svt_stage_gate_thread_entry() or NULL when all task slots are taken. */
+extern EbStageGateTask *svt_stage_gate_add_task(EbStageGate *gate, EbThreadFunction thread_function,
+                                                void *thread_context);
+extern void            *svt_stage_gate_thread_entry(void *task_ptr);
+
+/* Makes the kernels park at the gate when they return. The caller then shuts
+ * down their input queues and waits with svt_stage_gate_wait_parked(). */
+extern void svt_stage_gate_close(EbStageGate *gate);
+extern void svt_stage_gate_wait_parked(EbStageGate *gate);
+/* Lets the parked threads enter their kernel again. */
+extern void svt_stage_gate_open(EbStageGate *gate);
+
+#define EB_CREATE_GATED_THREAD(gate, channel, pointer, thread_function, thread_context)                    \
+    do {                                                                                                   \
+        EbStageGateTask *gate_task = svt_stage_gate_add_task(gate, thread_function, thread_context);       \
+        if (gate_task == NULL)                                                                             \
+            return EB_ErrorInsufficientResources;                                                          \
+        EB_CREATE_SCHEDULED_THREAD(channel, pointer, svt_stage_gate_thread_entry, gate_task);              \
+    } while (0)
+
+#define EB_CREATE_GATED_THREAD_ARRAY(gate, channel, pa, count, thread_function, thread_contexts)           \
+    do {                                                                                                   \
+        EB_ALLOC_PTR_ARRAY(pa, count);                                                                     \
+        for (uint32_t i = 0; i < count; i++)                                                               \
+            EB_CREATE_GATED_THREAD(gate, channel, pa[i], thread_function, thread_contexts[i]);             \
+    } while (0)
+
+#ifdef __cplusplus
+}
+#endif
+#endif // EbStageGate_h
@@ -16,10 +16,239 @@
 #define LOG_TAG "SvtMalloc"
 #include "svt_log.h"
 
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
 void svt_print_alloc_fail_impl(const char* file, int line) {
     SVT_FATAL("allocate memory failed, at %s:%d\n", file, line);
 }
 
+/*
+ Memory accounting
+ The tracked allocations are kept in a pointer keyed hash table split in
+ shards, each with its own lock and open addressing with linear probing.
+ The table itself is allocated with the C library and not tracked.
+*/
+#define MEM_ACCOUNT_SHARD_COUNT 64
+#define MEM_ACCOUNT_MIN_CAPACITY 256
+// Marks a removed entry, so the probe sequences crossing it are kept
+#define MEM_ACCOUNT_TOMBSTONE ((void*)(uintptr_t)1)
+
+struct EbMemAccount {
+    // Indexed by SvtAv1MemCategory, the last counter sums all categories
+    volatile uint64_t current[SVT_AV1_MEM_COUNT + 1];
+    volatile uint64_t peak[SVT_AV1_MEM_COUNT + 1];
+    // The creator and each tracked allocation hold a reference
+    volatile int32_t ref_count;
+};
+
+typedef struct MemAccountEntry {
+    void*         ptr;
+    EbMemAccount* account;
+    size_t        size;
+    uint32_t      category;
+} MemAccountEntry;
+
+typedef struct MemAccountShard {
+#ifdef _WIN32
+    SRWLOCK lock;
+#else
+    pthread_mutex_t lock;
+#endif
+    MemAccountEntry* entries;
+    uint32_t         capacity;
+    uint32_t         count; // live entries
+    uint32_t         used; // live entries and tombstones
+} MemAccountShard;
+
+#ifdef _WIN32
+#define MEM_ACCOUNT_SHARD_INIT {SRWLOCK_INIT, NULL, 0, 0, 0}
+#else
+#define MEM_ACCOUNT_SHARD_INIT {PTHREAD_MUTEX_INITIALIZER, NULL, 0, 0, 0}
+#endif
+
+#define MEM_ACCOUNT_SHARD_INIT_4 MEM_ACCOUNT_SHARD_INIT, MEM_ACCOUNT_SHARD_INIT, MEM_ACCOUNT_SHARD_INIT, MEM_ACCOUNT_SHARD_INIT
+#define MEM_ACCOUNT_SHARD_INIT_16 \
+    MEM_ACCOUNT_SHARD_INIT_4, MEM_ACCOUNT_SHARD_INIT_4, MEM_ACCOUNT_SHARD_INIT_4, MEM_ACCOUNT_SHARD_INIT_4
+
+static MemAccountShard g_mem_account_shards[MEM_ACCOUNT_SHARD_COUNT] = {
+    MEM_ACCOUNT_SHARD_INIT_16, MEM_ACCOUNT_SHARD_INIT_16, MEM_ACCOUNT_SHARD_INIT_16, MEM_ACCOUNT_SHARD_INIT_16};
+// Tracked allocations over all shards, lets the free path skip the table when nothing is tracked
+static volatile int32_t g_mem_account_entry_count;
+
+static EB_THREAD_LOCAL EbMemScope g_mem_scope;
+
+static void mem_account_lock(MemAccountShard* shard) {
+#ifdef _WIN32
+    AcquireSRWLockExclusive(&shard->lock);
+#else
+    pthread_mutex_lock(&shard->lock);
+#endif
+}
+
+static void mem_account_unlock(MemAccountShard* shard) {
+#ifdef _WIN32
+    ReleaseSRWLockExclusive(&shard->lock);
+#else
+    pthread_mutex_unlock(&shard->lock);
+#endif
+}
+
+static inline uint64_t mem_account_hash(const void* ptr) {
+    // The low bits of heap pointers are mostly zero
+    return ((uint64_t)(uintptr_t)ptr >> 4) * 0x9E3779B97F4A7C15ull;
+}
+
+static void mem_account_charge(EbMemAccount* account, uint32_t index, uint64_t size) {
+    const uint64_t current = svt_atomic_fetch_add_u64(&account->current[index], size) + size;
+    uint64_t       peak    = svt_atomic_load_u64(&account->peak[index]);
+    while (current > peak && !svt_atomic_cas_u64(&account->peak[index], peak, current))
+        peak = svt_atomic_load_u64(&account->peak[index]);
+}
+
+static void mem_account_unref(EbMemAccount* account) {
+    if (svt_atomic_fetch_add_i32(&account->ref_count, -1) == 1)
+        free(account);
+}
+
+static void mem_account_discharge(const MemAccountEntry* e) {
+    svt_atomic_fetch_add_u64(&e->account->current[e->category], (uint64_t)0 - e->size);
+    svt_atomic_fetch_add_u64(&e->account->current[SVT_AV1_MEM_COUNT], (uint64_t)0 - e->size);
+}
+
+// Returns the slot holding ptr, or the slot to insert it into when absent
+static MemAccountEntry* mem_account_find(MemAccountShard* shard, const void* ptr) {
+    const uint32_t   mask      = shard->capacity - 1;
+    uint32_t         i         = (uint32_t)(mem_account_hash(ptr) >> 32) & mask;
+    MemAccountEntry* tombstone = NULL;
+    for (;; i = (i + 1) & mask) {
+        MemAccountEntry* e = &shard->entries[i];
+        if (e->ptr == ptr)
+            return e;
+        if (e->ptr == NULL)
+            return tombstone ? tombstone : e;
+        if (e->ptr == MEM_ACCOUNT_TOMBSTONE && !tombstone)
+            tombstone = e;
+    }
+}
+
+// Rebuilds the table without tombstones, doubling it when more than half full
+static bool mem_account_rehash(MemAccountShard* shard) {
+    uint32_t capacity = shard->capacity ? shard->capacity : MEM_ACCOUNT_MIN_CAPACITY;
+    if (shard->count + 1 > capacity / 2)
+        capacity *= 2;
+    MemAccountEntry* entries = calloc(capacity, sizeof(*entries));
+    if (!entries)
+        return false;
+    MemAccountEntry* old_entries  = shard->entries;
+    const uint32_t   old_capacity = shard->capacity;
+    shard->entries                = entries;
+    shard->capacity               = capacity;
+    shard->used                   = shard->count;
+    for (uint32_t i = 0; i < old_capacity; i++) {
+        if (old_entries[i].ptr && old_entries[i].ptr != MEM_ACCOUNT_TOMBSTONE)
+            *mem_account_find(shard, old_entries[i].ptr) = old_entries[i];
+    }
+    free(old_entries);
+    return true;
+}
+
+EbMemAccount* svt_mem_account_create(void) {
+    EbMemAccount* account = calloc(1, sizeof(*account));
+    if (account)
+        account->ref_count = 1;
+    return account;
+}
+
+void svt_mem_account_release(EbMemAccount* account) {
+    if (account)
+        mem_account_unref(account);
+}
+
+void svt_mem_account_get_stats(EbMemAccount* account, SvtAv1MemoryStats* stats) {
+    for (uint32_t i = 0; i < SVT_AV1_MEM_COUNT; i++) {
+        stats->category[i].current = svt_atomic_load_u64(&account->current[i]);
+        stats->category[i].peak    = svt_atomic_load_u64(&account->peak[i]);
+    }
+    stats->total.current = svt_atomic_load_u64(&account->current[SVT_AV1_MEM_COUNT]);
+    stats->total.peak    = svt_atomic_load_u64(&account->peak[SVT_AV1_MEM_COUNT]);
+}
+
+EbMemScope svt_mem_get_scope(void) { return g_mem_scope; }
+
+EbMemScope svt_mem_set_scope(EbMemScope scope) {
+    const EbMemScope prev = g_mem_scope;
+    g_mem_scope           = scope;
+    return prev;
+}
+
+SvtAv1MemCategory svt_mem_set_category(SvtAv1MemCategory category) {
+    const SvtAv1MemCategory prev = g_mem_scope.category;
+    g_mem_scope.category         = category;
+    return prev;
+}
+
+void svt_mem_account_add_entry(void* ptr, EbPtrType type, size_t count) {
+    EbMemAccount* account = g_mem_scope.account;
+    // Only the allocations are accounted, the OS objects are counted by the debug tracker
+    if (!account || !ptr || type > EB_A_PTR)
+        return;
+    MemAccountShard* shard = &g_mem_account_shards[mem_account_hash(ptr) % MEM_ACCOUNT_SHARD_COUNT];
+    MemAccountEntry  stale = {0};
+    mem_account_lock(shard);
+    if (shard->used + 1 > shard->capacity / 4 * 3 && !mem_account_rehash(shard)) {
+        mem_account_unlock(shard);
+        return;
+    }
+    MemAccountEntry* e = mem_account_find(shard, ptr);
+    if (e->ptr == ptr)
+        // Released outside of the EB_FREE macros and handed out again
+        stale = *e;
+    else {
+        if (e->ptr == NULL)
+            shard->used++;
+        shard->count++;
+        svt_atomic_fetch_add_i32(&g_mem_account_entry_count, 1);
+    }
+    e->ptr      = ptr;
+    e->account  = account;
+    e->size     = count;
+    e->category = g_mem_scope.category;
+    svt_atomic_fetch_add_i32(&account->ref_count, 1);
+    mem_account_charge(account, e->category, count);
+    mem_account_charge(account, SVT_AV1_MEM_COUNT, count);
+    mem_account_unlock(shard);
+    if (stale.account) {
+        mem_account_discharge(&stale);
+        mem_account_unref(stale.account);
+    }
+}
+
+void svt_mem_account_remove_entry(void* ptr, EbPtrType type) {
+    if (!ptr || type > EB_A_PTR || !svt_atomic_load_i32(&g_mem_account_entry_count))
+        return;
+    MemAccountShard* shard = &g_mem_account_shards[mem_account_hash(ptr) % MEM_ACCOUNT_SHARD_COUNT];
+    MemAccountEntry  e     = {0};
+    mem_account_lock(shard);
+    if (shard->count) {
+        MemAccountEntry* slot = mem_account_find(shard, ptr);
+        if (slot->ptr == ptr) {
+            e         = *slot;
+            slot->ptr = MEM_ACCOUNT_TOMBSTONE;
+            shard->count--;
+            svt_atomic_fetch_add_i32(&g_mem_account_entry_count, -1);
+        }
+    }
+    mem_account_unlock(shard);
+    if (e.account) {
+        mem_account_discharge(&e);
+        mem_account_unref(e.account);
+    }
+}
+
 #ifdef DEBUG_MEMORY_USAGE
 
 static EbHandle g_malloc_mutex;
@@ -27,6 +27,31 @@
 #endif
 void svt_print_alloc_fail_impl(const char* file, int line);
 
+
+/*
+ Memory accounting, enabled in all builds
+ Allocations made while a thread is in the scope of an account are charged to
+ the category of the scope, and discharged when freed from any thread.
+*/
+typedef struct EbMemAccount EbMemAccount;
+
+typedef struct EbMemScope {
+    EbMemAccount*     account;
+    SvtAv1MemCategory category;
+} EbMemScope;
+
+/* Creates an account holding one reference, released by svt_mem_account_release() */
+EbMemAccount*     svt_mem_account_create(void);
+/* Drops the creator reference, the account lives on until its allocations are freed */
+void              svt_mem_account_release(EbMemAccount* account);
+void              svt_mem_account_get_stats(EbMemAccount* account, SvtAv1MemoryStats* stats);
+EbMemScope        svt_mem_get_scope(void);
+/* Sets the scope of the calling thread and returns the previous one */
+EbMemScope        svt_mem_set_scope(EbMemScope scope);
+SvtAv1MemCategory svt_mem_set_category(SvtAv1MemCategory category);
+void              svt_mem_account_add_entry(void* ptr, EbPtrType type, size_t count);
+void              svt_mem_account_remove_entry(void* ptr, EbPtrType type);
+
 #ifdef DEBUG_MEMORY_USAGE
 void svt_print_memory_usage(void);
 void svt_increase_component_count(void);
@@ -40,8 +65,16 @@ void svt_remove_mem_entry(void* ptr, EbPtrType type);
 #define svt_add_mem_entry(a, b, c, d, e) svt_add_mem_entry_impl(a, b, c, d, e)
 #endif
 
-#define EB_ADD_MEM_ENTRY(p, type, count) svt_add_mem_entry(p, type, count, __FILE__, __LINE__)
-#define EB_REMOVE_MEM_ENTRY(p, type) svt_remove_mem_entry(p, type);
+#define EB_ADD_MEM_ENTRY(p, type, count)                       \
+    do {                                                       \
+        svt_add_mem_entry(p, type, count, __FILE__, __LINE__); \
+        svt_mem_account_add_entry(p, type, count);             \
+    } while (0)
+#define EB_REMOVE_MEM_ENTRY(p, type)           \
+    do {                                       \
+        svt_remove_mem_entry(p, type);         \
+        svt_mem_account_remove_entry(p, type); \
+    } while (0)
 
 #else
 #define svt_print_memory_usage() \
@@ -53,12 +86,8 @@ void svt_remove_mem_entry(void* ptr, EbPtrType type);
 #define svt_decrease_component_count() \
     do {                               \
     } while (0)
-#define EB_ADD_MEM_ENTRY(p, type, count) \
-    do {                                 \
-    } while (0)
-#define EB_REMOVE_MEM_ENTRY(p, type) \
-    do {                             \
-    } while (0)
+#define EB_ADD_MEM_ENTRY(p, type, count) svt_mem_account_add_entry(p, type, count)
+#define EB_REMOVE_MEM_ENTRY(p, type) svt_mem_account_remove_entry(p, type)
 
 #endif //DEBUG_MEMORY_USAGE
 
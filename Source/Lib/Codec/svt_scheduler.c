@@ -0,0 +1,222 @@
+/*
+* Copyright (c) 2025, Alliance for Open Media. All rights reserved
+*
+* This source code is subject to the terms of the BSD 2 Clause License and
+* the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+* was not distributed with this source code in the LICENSE file, you can
+* obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+* Media Patent License 1.0 was not distributed with this source code in the
+* PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+*/
+
+#include <stdlib.h>
+
+#include "svt_scheduler.h"
+
+// Channel the calling stage thread belongs to, and whether it currently holds a token
+static EB_THREAD_LOCAL EbSchedulerChannel *current_channel;
+static EB_THREAD_LOCAL bool                token_held;
+
+/*
+    The scheduler lock is taken with the native primitives rather than the
+    svt_* wrappers, since the wrappers call back into the scheduler when
+    blocking.
+*/
+static void scheduler_lock(EbScheduler *scheduler) {
+#ifdef _WIN32
+    EnterCriticalSection(&scheduler->lock);
+#else
+    pthread_mutex_lock(&scheduler->lock);
+#endif
+}
+
+static void scheduler_unlock(EbScheduler *scheduler) {
+#ifdef _WIN32
+    LeaveCriticalSection(&scheduler->lock);
+#else
+    pthread_mutex_unlock(&scheduler->lock);
+#endif
+}
+
+static void scheduler_acquire_token(EbSchedulerChannel *channel) {
+    EbScheduler *scheduler = channel->scheduler;
+    scheduler_lock(scheduler);
+    if (scheduler->waiting_count == 0 && scheduler->active_count < scheduler->core_count) {
+        scheduler->active_count++;
+        channel->active_count++;
+    } else {
+        // Wait for a token to be handed over to this channel
+        scheduler->waiting_count++;
+        channel->waiting_count++;
+        while (channel->grant_count == 0) {
+#ifdef _WIN32
+            SleepConditionVariableCS(&channel->grant_cond, &scheduler->lock, INFINITE);
+#else
+            pthread_cond_wait(&channel->grant_cond, &scheduler->lock);
+#endif
+        }
+        channel->grant_count--;
+    }
+    scheduler_unlock(scheduler);
+    token_held = true;
+}
+
+/*
+    Pick the waiting channel holding the fewest tokens, starting the search
+    after the last channel served so that ties are served round robin.
+*/
+static EbSchedulerChannel *scheduler_pick_channel(EbScheduler *scheduler) {
+    EbSchedulerChannel *start = scheduler->last_granted && scheduler->last_granted->next ? scheduler->last_granted->next
+                                                                                         : scheduler->channel_list;
+    EbSchedulerChannel *best  = NULL;
+    EbSchedulerChannel *it    = start;
+    do {
+        if (it->waiting_count > it->grant_count && (!best || it->active_count < best->active_count))
+            best = it;
+        it = it->next ? it->next : scheduler->channel_list;
+    } while (it != start);
+    return best;
+}
+
+static void scheduler_release_token(EbSchedulerChannel *channel) {
+    EbScheduler *scheduler = channel->scheduler;
+    token_held             = false;
+    scheduler_lock(scheduler);
+    channel->active_count--;
+    EbSchedulerChannel *next = scheduler->waiting_count ? scheduler_pick_channel(scheduler) : NULL;
+    if (next) {
+        // Hand the token over directly, so a thread entering acquire cannot steal it
+        scheduler->waiting_count--;
+        next->waiting_count--;
+        next->grant_count++;
+        next->active_count++;
+        scheduler->last_granted = next;
+#ifdef _WIN32
+        WakeConditionVariable(&next->grant_cond);
+#else
+        pthread_cond_signal(&next->grant_cond);
+#endif
+    } else
+        scheduler->active_count--;
+    scheduler_unlock(scheduler);
+}
+
+static void svt_scheduler_dctor(EbPtr p) {
+    EbScheduler *obj = (EbScheduler *)p;
+#ifdef _WIN32
+    DeleteCriticalSection(&obj->lock);
+#else
+    pthread_mutex_destroy(&obj->lock);
+#endif
+}
+
+/**************************************
+ * svt_scheduler_ctor
+ **************************************/
+EbErrorType svt_scheduler_ctor(EbScheduler *scheduler, uint32_t core_count) {
+    scheduler->core_count = core_count ? core_count : svt_get_num_processors();
+    scheduler->core_count = AOMMAX(scheduler->core_count, 1);
+#ifdef _WIN32
+    InitializeCriticalSection(&scheduler->lock);
+#else
+    if (pthread_mutex_init(&scheduler->lock, NULL))
+        return EB_ErrorInsufficientResources;
+#endif
+    scheduler->dctor = svt_scheduler_dctor;
+    return EB_ErrorNone;
+}
+
+static void svt_scheduler_channel_dctor(EbPtr p) {
+    EbSchedulerChannel *obj       = (EbSchedulerChannel *)p;
+    EbScheduler        *scheduler = obj->scheduler;
+    if (scheduler) {
+        scheduler_lock(scheduler);
+        EbSchedulerChannel **it = &scheduler->channel_list;
+        while (*it && *it != obj) it = &(*it)->next;
+        if (*it)
+            *it = obj->next;
+        if (scheduler->last_granted == obj)
+            scheduler->last_granted = NULL;
+        scheduler->channel_count--;
+        scheduler_unlock(scheduler);
+#ifndef _WIN32
+        pthread_cond_destroy(&obj->grant_cond);
+#endif
+    }
+    EB_FREE_ARRAY(obj->task_array);
+}
+
+/**************************************
+ * svt_scheduler_channel_ctor
+ **************************************/
+EbErrorType svt_scheduler_channel_ctor(EbSchedulerChannel *channel, EbScheduler *scheduler,
+                                       uint32_t task_total_count) {
+    channel->dctor            = svt_scheduler_channel_dctor;
+    channel->task_total_count = task_total_count;
+    EB_CALLOC_ARRAY(channel->task_array, task_total_count);
+#ifdef _WIN32
+    InitializeConditionVariable(&channel->grant_cond);
+#else
+    if (pthread_cond_init(&channel->grant_cond, NULL))
+        return EB_ErrorInsufficientResources;
+#endif
+
+    scheduler_lock(scheduler);
+    channel->scheduler      = scheduler;
+    channel->next           = scheduler->channel_list;
+    scheduler->channel_list = channel;
+    scheduler->channel_count++;
+    scheduler_unlock(scheduler);
+    return EB_ErrorNone;
+}
+
+/**************************************
+ * svt_scheduler_add_task
+ **************************************/
+EbSchedulerTask *svt_scheduler_add_task(EbSchedulerChannel *channel, EbThreadFunction thread_function,
+                                        void *thread_context) {
+    if (channel->task_count >= channel->task_total_count)
+        return NULL;
+    EbSchedulerTask *task = &channel->task_array[channel->task_count++];
+    task->channel         = channel;
+    task->thread_function = thread_function;
+    task->thread_context  = thread_context;
+    return task;
+}
+
+/**************************************
+ * svt_scheduler_thread_entry
+ *   Runs a stage kernel while holding an execution token.
+ **************************************/
+void *svt_scheduler_thread_entry(void *task_ptr) {
+    EbSchedulerTask *task = (EbSchedulerTask *)task_ptr;
+
+    current_channel = task->channel;
+    scheduler_acquire_token(current_channel);
+
+    void *ret = task->thread_function(task->thread_context);
+
+    if (token_held)
+        scheduler_release_token(current_channel);
+    current_channel = NULL;
+    return ret;
+}
+
+/**************************************
+ * svt_scheduler_suspend
+ **************************************/
+EbSchedulerChannel *svt_scheduler_suspend(void) {
+    EbSchedulerChannel *channel = current_channel;
+    if (channel == NULL || !token_held)
+        return NULL;
+    scheduler_release_token(channel);
+    return channel;
+}
+
+/**************************************
+ * svt_scheduler_resume
+ **************************************/
+void svt_scheduler_resume(EbSchedulerChannel *channel) {
+    if (channel)
+        scheduler_acquire_token(channel);
+}
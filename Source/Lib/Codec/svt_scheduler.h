@@ -0,0 +1,130 @@
+/*
+* Copyright (c) 2025, Alliance for Open Media. All rights reserved
+*
+* This source code is subject to the terms of the BSD 2 Clause License and
+* the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+* was not distributed with this source code in the LICENSE file, you can
+* obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+* Media Patent License 1.0 was not distributed with this source code in the
+* PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+*/
+
+#ifndef EbScheduler_h
+#define EbScheduler_h
+
+#include "definitions.h"
+#include "object.h"
+#include "svt_threads.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**************************************
+ * Shared scheduler
+ *
+ * The pipeline kernels are long running loops that block on their input
+ * fifos, so they cannot be split into resumable tasks. Instead, when the
+ * scheduler is enabled every stage thread must hold one of core_count
+ * execution tokens while it runs. A thread hands its token back whenever it
+ * blocks (fifo semaphores, condition variables, contended mutexes), so the
+ * cores are always handed to whichever stages currently have work, and the
+ * number of stage threads that are runnable at once never exceeds the core
+ * count.
+ *
+ * A scheduler can be private to one encoder handle, or shared by several
+ * handles as a process-wide thread pool. Each handle is a channel of the
+ * scheduler; when threads are waiting for a token, a freed token is handed to
+ * the waiting channel currently holding the fewest tokens (round robin on
+ * ties), so busy channels cannot starve the others.
+ **************************************/
+typedef void *(*EbThreadFunction)(void *);
+
+typedef struct EbSchedulerTask {
+    struct EbSchedulerChannel *channel;
+    EbThreadFunction           thread_function;
+    void                      *thread_context;
+} EbSchedulerTask;
+
+typedef struct EbSchedulerChannel {
+    EbDctor             dctor;
+    struct EbScheduler *scheduler;
+    // Tokens held by the threads of this channel
+    uint32_t active_count;
+    // Threads of this channel waiting for a token
+    uint32_t waiting_count;
+    // Tokens handed over to this channel but not yet picked up by its waiting threads
+    uint32_t grant_count;
+#ifdef _WIN32
+    CONDITION_VARIABLE grant_cond;
+#else
+    pthread_cond_t grant_cond;
+#endif
+    struct EbSchedulerChannel *next;
+
+    // Thread entry descriptors, one per stage thread
+    EbSchedulerTask *task_array;
+    uint32_t         task_count;
+    uint32_t         task_total_count;
+} EbSchedulerChannel;
+
+typedef struct EbScheduler {
+    EbDctor dctor;
+    // Number of execution tokens, i.e. stage threads allowed to run at once
+    uint32_t core_count;
+    // Tokens currently held
+    uint32_t active_count;
+    // Threads waiting for a token, over all channels
+    uint32_t waiting_count;
+#ifdef _WIN32
+    CRITICAL_SECTION lock;
+#else
+    pthread_mutex_t lock;
+#endif
+    EbSchedulerChannel *channel_list;
+    EbSchedulerChannel *last_granted;
+    uint32_t            channel_count;
+} EbScheduler;
+
+extern EbErrorType svt_scheduler_ctor(EbScheduler *scheduler, uint32_t core_count);
+
+/* Registers a channel (an encoder handle) running up to task_total_count
+ * stage threads on the scheduler. Deleting the channel unregisters it; all of
+ * its threads must have exited by then. */
+extern EbErrorType svt_scheduler_channel_ctor(EbSchedulerChannel *channel, EbScheduler *scheduler,
+                                              uint32_t task_total_count);
+
+/* Registers a stage thread with the channel, returns the context to pass to
+ * svt_scheduler_thread_entry() or NULL when all task slots are taken. */
+extern EbSchedulerTask *svt_scheduler_add_task(EbSchedulerChannel *channel, EbThreadFunction thread_function,
+                                               void *thread_context);
+extern void *svt_scheduler_thread_entry(void *task_ptr);
+
+/* Gives back the execution token of the calling thread before a blocking call.
+ * Returns the channel to pass to svt_scheduler_resume(), or NULL when the
+ * calling thread is not a scheduled stage thread. */
+extern EbSchedulerChannel *svt_scheduler_suspend(void);
+extern void                svt_scheduler_resume(EbSchedulerChannel *channel);
+
+#define EB_CREATE_SCHEDULED_THREAD(channel, pointer, thread_function, thread_context)                     \
+    do {                                                                                                   \
+        if (channel) {                                                                                     \
+            EbSchedulerTask *task = svt_scheduler_add_task(channel, thread_function, thread_context);      \
+            if (task == NULL)                                                                              \
+                return EB_ErrorInsufficientResources;                                                      \
+            EB_CREATE_THREAD(pointer, svt_scheduler_thread_entry, task);                                   \
+        } else                                                                                             \
+            EB_CREATE_THREAD(pointer, thread_function, thread_context);                                    \
+    } while (0)
+
+#define EB_CREATE_SCHEDULED_THREAD_ARRAY(channel, pa, count, thread_function, thread_contexts)              \
+    do {                                                                                                   \
+        EB_ALLOC_PTR_ARRAY(pa, count);                                                                     \
+        for (uint32_t i = 0; i < count; i++)                                                               \
+            EB_CREATE_SCHEDULED_THREAD(channel, pa[i], thread_function, thread_contexts[i]);               \
+    } while (0)
+
+#ifdef __cplusplus
+}
+#endif
+#endif // EbScheduler_h
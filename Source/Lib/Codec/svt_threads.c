@@ -31,6 +31,7 @@
 #include <stdbool.h>
 #include <stdlib.h>
 #include "svt_threads.h"
+#include "svt_scheduler.h"
 #include "svt_log.h"
 /****************************************
   * Win32 Includes
@@ -43,6 +44,7 @@
 #include <fcntl.h>
 #include <pthread.h>
 #include <semaphore.h>
+#include <time.h>
 #include <unistd.h>
 #endif // _WIN32
 #ifdef __APPLE__
@@ -114,6 +116,33 @@ end:
 }
 #endif
 
+/****************************************
+ * svt_get_num_processors
+ *   Get Number of logical processors
+ ****************************************/
+uint32_t svt_get_num_processors(void) {
+#ifdef _WIN32
+    return GetActiveProcessorCount(ALL_PROCESSOR_GROUPS);
+#else
+    return sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+}
+
+/****************************************
+ * svt_sleep_ms
+ *   Suspend the calling thread for ms milliseconds
+ ****************************************/
+void svt_sleep_ms(uint32_t ms) {
+#ifdef _WIN32
+    Sleep(ms);
+#else
+    struct timespec ts;
+    ts.tv_sec  = ms / 1000;
+    ts.tv_nsec = (long)(ms % 1000) * 1000000;
+    nanosleep(&ts, NULL);
+#endif
+}
+
 /****************************************
  * svt_create_thread
  ****************************************/
@@ -294,9 +323,26 @@ EbErrorType svt_post_semaphore(EbHandle semaphore_handle) {
 /***************************************
  * svt_block_on_semaphore
  ***************************************/
+static bool try_semaphore(EbHandle semaphore_handle) {
+#ifdef _WIN32
+    return WaitForSingleObject((HANDLE)semaphore_handle, 0) == WAIT_OBJECT_0;
+#elif defined(__APPLE__)
+    return dispatch_semaphore_wait((dispatch_semaphore_t)semaphore_handle, DISPATCH_TIME_NOW) == 0;
+#else
+    int ret;
+    do { ret = sem_trywait((sem_t *)semaphore_handle); } while (ret == -1 && errno == EINTR);
+    return ret == 0;
+#endif
+}
+
 EbErrorType svt_block_on_semaphore(EbHandle semaphore_handle) {
     EbErrorType return_error;
 
+    // Scheduled stage threads give their execution token back while they wait
+    if (try_semaphore(semaphore_handle))
+        return EB_ErrorNone;
+    EbSchedulerChannel *scheduler = svt_scheduler_suspend();
+
 #ifdef _WIN32
     return_error = WaitForSingleObject((HANDLE)semaphore_handle, INFINITE) ? EB_ErrorSemaphoreUnresponsive
                                                                            : EB_ErrorNone;
@@ -310,6 +356,7 @@ EbErrorType svt_block_on_semaphore(EbHandle semaphore_handle) {
     return_error = ret ? EB_ErrorSemaphoreUnresponsive : EB_ErrorNone;
 #endif
 
+    svt_scheduler_resume(scheduler);
     return return_error;
 }
 
@@ -376,12 +423,21 @@ EbErrorType svt_release_mutex(EbHandle mutex_handle) {
 EbErrorType svt_block_on_mutex(EbHandle mutex_handle) {
     EbErrorType return_error;
 
+    // A contended lock may be held by a thread waiting for an execution token,
+    // so scheduled stage threads must not keep theirs while waiting for it
 #ifdef _WIN32
+    if (WaitForSingleObject((HANDLE)mutex_handle, 0) == WAIT_OBJECT_0)
+        return EB_ErrorNone;
+    EbSchedulerChannel *scheduler = svt_scheduler_suspend();
     return_error = WaitForSingleObject((HANDLE)mutex_handle, INFINITE) ? EB_ErrorMutexUnresponsive : EB_ErrorNone;
 #else
+    if (pthread_mutex_trylock((pthread_mutex_t *)mutex_handle) == 0)
+        return EB_ErrorNone;
+    EbSchedulerChannel *scheduler = svt_scheduler_suspend();
     return_error = pthread_mutex_lock((pthread_mutex_t *)mutex_handle) ? EB_ErrorMutexUnresponsive : EB_ErrorNone;
 #endif
 
+    svt_scheduler_resume(scheduler);
     return return_error;
 }
 
@@ -457,7 +513,8 @@ EbErrorType svt_set_cond_var(CondVar *cond_var, int32_t newval) {
 */
 
 EbErrorType svt_wait_cond_var(CondVar *cond_var, int32_t input) {
-    EbErrorType return_error;
+    EbErrorType  return_error;
+    EbSchedulerChannel *scheduler = svt_scheduler_suspend();
 
 #ifdef _WIN32
 
@@ -470,5 +527,6 @@ EbErrorType svt_wait_cond_var(CondVar *cond_var, int32_t input) {
     while (cond_var->val == input) return_error = pthread_cond_wait(&cond_var->m_cond, &cond_var->m_mutex);
     return_error = pthread_mutex_unlock(&cond_var->m_mutex);
 #endif
+    svt_scheduler_resume(scheduler);
     return return_error;
 }
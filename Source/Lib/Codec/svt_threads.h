@@ -28,6 +28,9 @@ extern "C" {
 /**************************************
      * Threads
      **************************************/
+extern uint32_t svt_get_num_processors(void);
+extern void     svt_sleep_ms(uint32_t ms);
+
 extern EbHandle svt_create_thread(void *thread_function(void *), void *thread_context);
 
 extern EbErrorType svt_start_thread(EbHandle thread_handle);
@@ -120,6 +123,82 @@ extern EbErrorType svt_destroy_mutex(EbHandle mutex_handle);
 
 void svt_aom_atomic_set_u32(AtomicVarU32 *var, uint32_t in);
 
+#ifdef _MSC_VER
+#define EB_THREAD_LOCAL __declspec(thread)
+#else
+#define EB_THREAD_LOCAL __thread
+#endif
+
+/*
+ Lock-free atomic operations
+ Read-modify-write operations are sequentially consistent, loads have acquire
+ and stores have release semantics.
+*/
+#ifdef _MSC_VER
+#include <intrin.h>
+static INLINE uint32_t svt_atomic_load_u32(volatile uint32_t *ptr) {
+    return (uint32_t)_InterlockedOr((volatile long *)ptr, 0);
+}
+static INLINE void svt_atomic_store_u32(volatile uint32_t *ptr, uint32_t val) {
+    _InterlockedExchange((volatile long *)ptr, (long)val);
+}
+static INLINE bool svt_atomic_cas_u32(volatile uint32_t *ptr, uint32_t expected, uint32_t desired) {
+    return (uint32_t)_InterlockedCompareExchange((volatile long *)ptr, (long)desired, (long)expected) == expected;
+}
+static INLINE int32_t svt_atomic_load_i32(volatile int32_t *ptr) { return _InterlockedOr((volatile long *)ptr, 0); }
+static INLINE int32_t svt_atomic_fetch_add_i32(volatile int32_t *ptr, int32_t val) {
+    return _InterlockedExchangeAdd((volatile long *)ptr, val);
+}
+static INLINE bool svt_atomic_cas_i32(volatile int32_t *ptr, int32_t expected, int32_t desired) {
+    return _InterlockedCompareExchange((volatile long *)ptr, desired, expected) == expected;
+}
+// _InterlockedOr64 and _InterlockedExchangeAdd64 only exist on 64-bit targets, the 64-bit operations are built on
+// _InterlockedCompareExchange64 (cmpxchg8b on x86) so 32-bit builds work
+static INLINE uint64_t svt_atomic_load_u64(volatile uint64_t *ptr) {
+    return (uint64_t)_InterlockedCompareExchange64((volatile __int64 *)ptr, 0, 0);
+}
+static INLINE uint64_t svt_atomic_fetch_add_u64(volatile uint64_t *ptr, uint64_t val) {
+    __int64 old = (__int64)*ptr, prev;
+    while ((prev = _InterlockedCompareExchange64((volatile __int64 *)ptr, (__int64)((uint64_t)old + val), old)) != old)
+        old = prev;
+    return (uint64_t)old;
+}
+static INLINE bool svt_atomic_cas_u64(volatile uint64_t *ptr, uint64_t expected, uint64_t desired) {
+    return (uint64_t)_InterlockedCompareExchange64((volatile __int64 *)ptr, (__int64)desired, (__int64)expected) ==
+        expected;
+}
+#define svt_cpu_relax() YieldProcessor()
+#else
+static INLINE uint32_t svt_atomic_load_u32(volatile uint32_t *ptr) { return __atomic_load_n(ptr, __ATOMIC_ACQUIRE); }
+static INLINE void     svt_atomic_store_u32(volatile uint32_t *ptr, uint32_t val) {
+    __atomic_store_n(ptr, val, __ATOMIC_RELEASE);
+}
+static INLINE bool svt_atomic_cas_u32(volatile uint32_t *ptr, uint32_t expected, uint32_t desired) {
+    return __atomic_compare_exchange_n(ptr, &expected, desired, false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+}
+static INLINE int32_t svt_atomic_load_i32(volatile int32_t *ptr) { return __atomic_load_n(ptr, __ATOMIC_ACQUIRE); }
+static INLINE int32_t svt_atomic_fetch_add_i32(volatile int32_t *ptr, int32_t val) {
+    return __atomic_fetch_add(ptr, val, __ATOMIC_SEQ_CST);
+}
+static INLINE bool svt_atomic_cas_i32(volatile int32_t *ptr, int32_t expected, int32_t desired) {
+    return __atomic_compare_exchange_n(ptr, &expected, desired, false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+}
+static INLINE uint64_t svt_atomic_load_u64(volatile uint64_t *ptr) { return __atomic_load_n(ptr, __ATOMIC_ACQUIRE); }
+static INLINE uint64_t svt_atomic_fetch_add_u64(volatile uint64_t *ptr, uint64_t val) {
+    return __atomic_fetch_add(ptr, val, __ATOMIC_SEQ_CST);
+}
+static INLINE bool svt_atomic_cas_u64(volatile uint64_t *ptr, uint64_t expected, uint64_t desired) {
+    return __atomic_compare_exchange_n(ptr, &expected, desired, false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+}
+#if defined(__x86_64__) || defined(__i386__)
+#define svt_cpu_relax() __builtin_ia32_pause()
+#elif defined(__aarch64__) || defined(__arm__)
+#define svt_cpu_relax() __asm__ __volatile__("yield" ::: "memory")
+#else
+#define svt_cpu_relax() __asm__ __volatile__("" ::: "memory")
+#endif
+#endif
+
 /*
  Condition variable
 */
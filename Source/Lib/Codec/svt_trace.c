@@ -0,0 +1,277 @@
+/*
+* Copyright (c) 2025, Alliance for Open Media. All rights reserved
+*
+* This source code is subject to the terms of the BSD 2 Clause License and
+* the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+* was not distributed with this source code in the LICENSE file, you can
+* obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+* Media Patent License 1.0 was not distributed with this source code in the
+* PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+*/
+//for getenv and fopen on windows
+#if defined(_WIN32) && !defined(_CRT_SECURE_NO_WARNINGS)
+#define _CRT_SECURE_NO_WARNINGS
+#endif
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "svt_trace.h"
+#include "svt_threads.h"
+#include "svt_time.h"
+#define LOG_TAG "SvtTrace"
+#include "svt_log.h"
+
+#define TRACE_CHUNK_EVENTS 4096
+// Up to 1M events per thread, the events past that are dropped
+#define TRACE_MAX_CHUNKS 256
+
+typedef struct TraceEvent {
+    const char *name;
+    uint64_t    start;
+    uint64_t    end;
+    uint64_t    pic;
+    int32_t     seg;
+} TraceEvent;
+
+typedef struct TraceChunk {
+    struct TraceChunk *next;
+    uint32_t           count;
+    TraceEvent         events[TRACE_CHUNK_EVENTS];
+} TraceChunk;
+
+typedef struct TraceBuffer {
+    struct TraceBuffer *next;
+    uint32_t            tid;
+    const char         *thread_name;
+    TraceChunk         *head;
+    TraceChunk         *tail;
+    uint32_t            chunk_count;
+    uint64_t            dropped_count;
+} TraceBuffer;
+
+// Task being processed by a thread. Tasks that are never labeled (e.g. the
+// application thread waiting for packets) are not recorded.
+typedef struct TraceTask {
+    const char *name;
+    uint64_t    start;
+    uint64_t    pic;
+    int32_t     seg;
+} TraceTask;
+
+volatile bool svt_trace_enabled;
+
+static EbHandle     g_trace_mutex;
+static uint32_t     g_trace_ref_count;
+static uint32_t     g_trace_generation;
+static char        *g_trace_file;
+static uint64_t     g_trace_origin;
+static TraceBuffer *g_trace_buffers;
+static uint32_t     g_trace_thread_count;
+
+// Buffer of the calling thread, valid while trace_generation matches the current session
+static EB_THREAD_LOCAL TraceBuffer *trace_buffer;
+static EB_THREAD_LOCAL uint32_t     trace_generation;
+static EB_THREAD_LOCAL TraceTask    trace_task;
+
+static void trace_mutex_cleanup(void) { svt_destroy_mutex(g_trace_mutex); }
+static void create_trace_mutex(void) {
+    g_trace_mutex = svt_create_mutex();
+    atexit(trace_mutex_cleanup);
+}
+
+#ifdef _WIN32
+
+static INIT_ONCE g_trace_once = INIT_ONCE_STATIC_INIT;
+
+static BOOL CALLBACK create_trace_mutex_wrapper(PINIT_ONCE InitOnce, PVOID Parameter, PVOID *lpContext) {
+    (void)InitOnce;
+    (void)Parameter;
+    (void)lpContext;
+    create_trace_mutex();
+    return true;
+}
+
+static EbHandle get_trace_mutex() {
+    InitOnceExecuteOnce(&g_trace_once, create_trace_mutex_wrapper, NULL, NULL);
+    return g_trace_mutex;
+}
+#else
+#include <pthread.h>
+
+static pthread_once_t g_trace_once = PTHREAD_ONCE_INIT;
+
+static EbHandle get_trace_mutex() {
+    pthread_once(&g_trace_once, create_trace_mutex);
+    return g_trace_mutex;
+}
+#endif // _WIN32
+
+uint64_t svt_trace_now(void) { return svt_av1_get_time_ns(); }
+
+/* Returns the buffer of the calling thread, registering it on first use */
+static TraceBuffer *trace_get_buffer(void) {
+    if (trace_buffer && trace_generation == g_trace_generation)
+        return trace_buffer;
+    TraceBuffer *buffer = (TraceBuffer *)calloc(1, sizeof(*buffer));
+    if (!buffer)
+        return NULL;
+    EbHandle m = get_trace_mutex();
+    svt_block_on_mutex(m);
+    buffer->tid      = ++g_trace_thread_count;
+    buffer->next     = g_trace_buffers;
+    g_trace_buffers  = buffer;
+    trace_generation = g_trace_generation;
+    svt_release_mutex(m);
+    trace_buffer = buffer;
+    return buffer;
+}
+
+static void trace_append(TraceBuffer *buffer, const char *name, uint64_t start, uint64_t end, uint64_t pic,
+                         int32_t seg) {
+    TraceChunk *chunk = buffer->tail;
+    if (!chunk || chunk->count == TRACE_CHUNK_EVENTS) {
+        if (buffer->chunk_count == TRACE_MAX_CHUNKS ||
+            (chunk = (TraceChunk *)malloc(sizeof(*chunk))) == NULL) {
+            buffer->dropped_count++;
+            return;
+        }
+        chunk->next  = NULL;
+        chunk->count = 0;
+        if (buffer->tail)
+            buffer->tail->next = chunk;
+        else
+            buffer->head = chunk;
+        buffer->tail = chunk;
+        buffer->chunk_count++;
+    }
+    TraceEvent *event = &chunk->events[chunk->count++];
+    event->name       = name;
+    event->start      = start;
+    event->end        = end;
+    event->pic        = pic;
+    event->seg        = seg;
+}
+
+void svt_trace_task_end(void) {
+    if (!trace_task.name)
+        return;
+    TraceBuffer *buffer = trace_get_buffer();
+    if (buffer) {
+        // Threads are named after the first task they process
+        if (!buffer->thread_name)
+            buffer->thread_name = trace_task.name;
+        trace_append(buffer, trace_task.name, trace_task.start, svt_trace_now(), trace_task.pic, trace_task.seg);
+    }
+    trace_task.name = NULL;
+}
+
+void svt_trace_task_begin(void) {
+    trace_task.name  = NULL;
+    trace_task.start = svt_trace_now();
+}
+
+void svt_trace_task_label(const char *name, uint64_t pic, int32_t seg) {
+    trace_task.name = name;
+    trace_task.pic  = pic;
+    trace_task.seg  = seg;
+}
+
+void svt_trace_span(const char *name, uint64_t start, uint64_t pic, int32_t seg) {
+    TraceBuffer *buffer = trace_get_buffer();
+    if (buffer)
+        trace_append(buffer, name, start, svt_trace_now(), pic, seg);
+}
+
+static void trace_write_event(FILE *f, const TraceBuffer *buffer, const TraceEvent *event, bool *first) {
+    // Events that started before the trace session (threads of an earlier handle) are clamped
+    uint64_t start = event->start > g_trace_origin ? event->start - g_trace_origin : 0;
+    uint64_t end   = event->end > g_trace_origin ? event->end - g_trace_origin : 0;
+    fprintf(f,
+            "%s\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f,\"args\":{",
+            *first ? "" : ",",
+            event->name,
+            buffer->tid,
+            start / 1000.0,
+            (end - start) / 1000.0);
+    if (event->pic != UINT64_MAX)
+        fprintf(f, "\"pic\":%llu%s", (unsigned long long)event->pic, event->seg >= 0 ? "," : "");
+    if (event->seg >= 0)
+        fprintf(f, "\"seg\":%d", event->seg);
+    fprintf(f, "}}");
+    *first = false;
+}
+
+static void trace_dump(void) {
+    FILE *f = fopen(g_trace_file, "w");
+    if (!f)
+        SVT_ERROR("failed to open trace file %s\n", g_trace_file);
+    bool first = true;
+    if (f)
+        fprintf(f, "{\"traceEvents\":[");
+    while (g_trace_buffers) {
+        TraceBuffer *buffer = g_trace_buffers;
+        g_trace_buffers     = buffer->next;
+        if (f) {
+            fprintf(f,
+                    "%s\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"%s\"}}",
+                    first ? "" : ",",
+                    buffer->tid,
+                    buffer->thread_name ? buffer->thread_name : "thread");
+            first = false;
+        }
+        if (buffer->dropped_count)
+            SVT_WARN("trace buffer of thread %u full, %llu events dropped\n",
+                     buffer->tid,
+                     (unsigned long long)buffer->dropped_count);
+        while (buffer->head) {
+            TraceChunk *chunk = buffer->head;
+            buffer->head      = chunk->next;
+            for (uint32_t i = 0; f && i < chunk->count; i++) trace_write_event(f, buffer, &chunk->events[i], &first);
+            free(chunk);
+        }
+        free(buffer);
+    }
+    if (f) {
+        fprintf(f, "\n],\"displayTimeUnit\":\"ms\"}\n");
+        fclose(f);
+    }
+}
+
+/**************************************
+ * svt_trace_init
+ **************************************/
+void svt_trace_init(void) {
+    EbHandle m = get_trace_mutex();
+    svt_block_on_mutex(m);
+    if (g_trace_ref_count++ == 0) {
+        const char *file = getenv("SVT_TRACE_FILE");
+        if (file && *file) {
+            size_t len   = strlen(file) + 1;
+            g_trace_file = (char *)malloc(len);
+            if (g_trace_file) {
+                memcpy(g_trace_file, file, len);
+                g_trace_generation++;
+                g_trace_thread_count = 0;
+                g_trace_origin       = svt_trace_now();
+                svt_trace_enabled    = true;
+            }
+        }
+    }
+    svt_release_mutex(m);
+}
+
+/**************************************
+ * svt_trace_deinit
+ **************************************/
+void svt_trace_deinit(void) {
+    EbHandle m = get_trace_mutex();
+    svt_block_on_mutex(m);
+    if (g_trace_ref_count && --g_trace_ref_count == 0 && g_trace_file) {
+        svt_trace_enabled = false;
+        trace_dump();
+        free(g_trace_file);
+        g_trace_file = NULL;
+    }
+    svt_release_mutex(m);
+}
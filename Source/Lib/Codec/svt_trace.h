@@ -0,0 +1,73 @@
+/*
+* Copyright (c) 2025, Alliance for Open Media. All rights reserved
+*
+* This source code is subject to the terms of the BSD 2 Clause License and
+* the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+* was not distributed with this source code in the LICENSE file, you can
+* obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+* Media Patent License 1.0 was not distributed with this source code in the
+* PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+*/
+
+#ifndef EbTrace_h
+#define EbTrace_h
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**************************************
+ * Pipeline tracing
+ *
+ * When the SVT_TRACE_FILE environment variable is set, every stage thread
+ * records one span per object it processes, from the moment the object is
+ * taken out of its input fifo until the thread comes back to the fifo. The
+ * kernels name the span and tag it with the picture number (and segment when
+ * the task covers a single segment); segment loops inside a task record
+ * nested spans. Each thread appends to its own buffer without locking, and
+ * the buffers are written as a Chrome trace event file (chrome://tracing,
+ * ui.perfetto.dev) when the last encoder handle is deinitialized.
+ **************************************/
+extern volatile bool svt_trace_enabled;
+
+/* Reference counted: the first call reads SVT_TRACE_FILE, the last
+ * svt_trace_deinit() writes the trace. All traced threads must have exited
+ * by then. */
+extern void svt_trace_init(void);
+extern void svt_trace_deinit(void);
+
+/* Monotonic time stamp in ns */
+extern uint64_t svt_trace_now(void);
+
+/* Called by svt_get_full_object() when the calling thread goes back to its
+ * input fifo, and when it leaves with a new object */
+extern void svt_trace_task_end(void);
+extern void svt_trace_task_begin(void);
+
+/* Names the current task of the calling thread */
+extern void svt_trace_task_label(const char *name, uint64_t pic, int32_t seg);
+
+/* Records a span nested in the current task, from start to now */
+extern void svt_trace_span(const char *name, uint64_t start, uint64_t pic, int32_t seg);
+
+#define SVT_TRACE_TASK(name, pic, seg)                            \
+    do {                                                          \
+        if (svt_trace_enabled)                                    \
+            svt_trace_task_label(name, (uint64_t)(pic), seg);     \
+    } while (0)
+
+#define SVT_TRACE_NOW() (svt_trace_enabled ? svt_trace_now() : 0)
+
+#define SVT_TRACE_SPAN(name, start, pic, seg)                     \
+    do {                                                          \
+        if (svt_trace_enabled)                                    \
+            svt_trace_span(name, start, (uint64_t)(pic), seg);    \
+    } while (0)
+
+#ifdef __cplusplus
+}
+#endif
+#endif // EbTrace_h
@@ -11,35 +11,23 @@
 */
 
 #include <stdlib.h>
+#include <string.h>
 
 #include "sys_resource_manager.h"
 #include "definitions.h"
 #include "svt_threads.h"
+#include "svt_time.h"
+#include "svt_trace.h"
 #if SRM_REPORT
 #include "svt_log.h"
 #endif
-static void svt_fifo_dctor(EbPtr p) {
-    EbFifo *obj = (EbFifo *)p;
-    EB_DESTROY_SEMAPHORE(obj->counting_semaphore);
-    EB_DESTROY_MUTEX(obj->lockout_mutex);
-}
+// Number of polls of a MuxingQueue before a waiting process parks on its semaphore
+#define SRM_SPIN_COUNT 256
+
 /**************************************
  * svt_fifo_ctor
  **************************************/
-static EbErrorType svt_fifo_ctor(EbFifo *fifoPtr, uint32_t initial_count, uint32_t max_count,
-                                 EbObjectWrapper *firstWrapperPtr, EbObjectWrapper *lastWrapperPtr,
-                                 EbMuxingQueue *queue_ptr) {
-    fifoPtr->dctor = svt_fifo_dctor;
-    // Create Counting Semaphore
-    EB_CREATE_SEMAPHORE(fifoPtr->counting_semaphore, initial_count, max_count);
-
-    // Create Buffer Pool Mutex
-    EB_CREATE_MUTEX(fifoPtr->lockout_mutex);
-
-    // Initialize Fifo First & Last ptrs
-    fifoPtr->first_ptr = firstWrapperPtr;
-    fifoPtr->last_ptr  = lastWrapperPtr;
-
+static EbErrorType svt_fifo_ctor(EbFifo *fifoPtr, EbMuxingQueue *queue_ptr) {
     // Copy the Muxing Queue ptr this Fifo belongs to
     fifoPtr->queue_ptr = queue_ptr;
 
@@ -47,138 +35,160 @@ static EbErrorType svt_fifo_ctor(EbFifo *fifoPtr, uint32_t initial_count, uint32
 }
 
 /**************************************
- * svt_fifo_push_back
+ * svt_muxing_queue_ring_push
+ *   Lock-free bounded MPMC enqueue. The ring holds at least as many
+ *   slots as objects exist in the SystemResource, so it never fills up.
  **************************************/
-static EbErrorType svt_fifo_push_back(EbFifo *fifoPtr, EbObjectWrapper *wrapper_ptr) {
-    EbErrorType return_error = EB_ErrorNone;
-
-    // If FIFO is empty
-    if (fifoPtr->first_ptr == (EbObjectWrapper *)NULL) {
-        fifoPtr->first_ptr = wrapper_ptr;
-        fifoPtr->last_ptr  = wrapper_ptr;
-    } else {
-        fifoPtr->last_ptr->next_ptr = wrapper_ptr;
-        fifoPtr->last_ptr           = wrapper_ptr;
+static void svt_muxing_queue_ring_push(EbMuxingQueue *queue_ptr, EbObjectWrapper *wrapper_ptr) {
+    EbRingCell *cell;
+    uint32_t    pos = svt_atomic_load_u32(&queue_ptr->enqueue_pos);
+    for (;;) {
+        cell               = &queue_ptr->ring[pos & queue_ptr->ring_mask];
+        const uint32_t seq = svt_atomic_load_u32(&cell->sequence);
+        const int32_t  dif = (int32_t)(seq - pos);
+        if (dif == 0) {
+            if (svt_atomic_cas_u32(&queue_ptr->enqueue_pos, pos, pos + 1))
+                break;
+        } else
+            svt_aom_assert_err(dif > 0, "MuxingQueue ring overflow");
+        pos = svt_atomic_load_u32(&queue_ptr->enqueue_pos);
     }
-
-    fifoPtr->last_ptr->next_ptr = (EbObjectWrapper *)NULL;
-
-    return return_error;
+    cell->wrapper_ptr = wrapper_ptr;
+    svt_atomic_store_u32(&cell->sequence, pos + 1);
 }
 
 /**************************************
- * svt_fifo_pop_front
+ * svt_muxing_queue_ring_pop
+ *   Lock-free bounded MPMC dequeue. The caller must own one unit of
+ *   available_count, so an object is guaranteed to be (or become)
+ *   published in the ring.
  **************************************/
-static EbErrorType svt_fifo_pop_front(EbFifo *fifoPtr, EbObjectWrapper **wrapper_ptr) {
-    EbErrorType return_error = EB_ErrorNone;
-
-    // Set wrapper_ptr to head of BufferPool
-    *wrapper_ptr = fifoPtr->first_ptr;
-
-    // Update tail of BufferPool if the BufferPool is now empty
-    fifoPtr->last_ptr = (fifoPtr->first_ptr == fifoPtr->last_ptr) ? (EbObjectWrapper *)NULL : fifoPtr->last_ptr;
-
-    // Update head of BufferPool
-    fifoPtr->first_ptr = fifoPtr->first_ptr->next_ptr;
-
-    return return_error;
-}
-
-static EbErrorType svt_fifo_shutdown(EbFifo *fifo_ptr) {
-    EbErrorType return_error = EB_ErrorNone;
-
-    // Acquire lockout Mutex
-    svt_block_on_mutex(fifo_ptr->lockout_mutex);
-    fifo_ptr->quit_signal = true;
-    // Release Mutex
-    svt_release_mutex(fifo_ptr->lockout_mutex);
-    //Wake up the waiting process if any
-    svt_post_semaphore(fifo_ptr->counting_semaphore);
-
-    return return_error;
+static EbObjectWrapper *svt_muxing_queue_ring_pop(EbMuxingQueue *queue_ptr) {
+    EbRingCell *cell;
+    uint32_t    pos = svt_atomic_load_u32(&queue_ptr->dequeue_pos);
+    for (;;) {
+        cell               = &queue_ptr->ring[pos & queue_ptr->ring_mask];
+        const uint32_t seq = svt_atomic_load_u32(&cell->sequence);
+        const int32_t  dif = (int32_t)(seq - (pos + 1));
+        if (dif == 0) {
+            if (svt_atomic_cas_u32(&queue_ptr->dequeue_pos, pos, pos + 1))
+                break;
+            pos = svt_atomic_load_u32(&queue_ptr->dequeue_pos);
+        } else if (dif < 0) {
+            // a producer claimed the slot but has not published it yet
+            svt_cpu_relax();
+            pos = svt_atomic_load_u32(&queue_ptr->dequeue_pos);
+        } else
+            pos = svt_atomic_load_u32(&queue_ptr->dequeue_pos);
+    }
+    EbObjectWrapper *wrapper_ptr = cell->wrapper_ptr;
+    svt_atomic_store_u32(&cell->sequence, pos + queue_ptr->ring_mask + 1);
+    return wrapper_ptr;
 }
 
-static void svt_circular_buffer_dctor(EbPtr p) {
-    EbCircularBuffer *obj = (EbCircularBuffer *)p;
-    EB_FREE(obj->array_ptr);
+/**************************************
+ * svt_muxing_queue_try_acquire
+ *   Takes one unit of available_count without blocking.
+ **************************************/
+static bool svt_muxing_queue_try_acquire(EbMuxingQueue *queue_ptr) {
+    int32_t count = svt_atomic_load_i32(&queue_ptr->available_count);
+    while (count > 0) {
+        if (svt_atomic_cas_i32(&queue_ptr->available_count, count, count - 1))
+            return true;
+        count = svt_atomic_load_i32(&queue_ptr->available_count);
+    }
+    return false;
 }
 
 /**************************************
- * svt_circular_buffer_ctor
+ * svt_muxing_queue_signal_idle
+ *   Tells the thread waiting for the queue to drain, if any, that a
+ *   consumer stopped working.
  **************************************/
-static EbErrorType svt_circular_buffer_ctor(EbCircularBuffer *bufferPtr, uint32_t buffer_total_count) {
-    bufferPtr->dctor = svt_circular_buffer_dctor;
-
-    bufferPtr->buffer_total_count = buffer_total_count;
-
-    EB_CALLOC(bufferPtr->array_ptr, bufferPtr->buffer_total_count, sizeof(EbPtr));
-
-    return EB_ErrorNone;
+static void svt_muxing_queue_signal_idle(EbMuxingQueue *queue_ptr) {
+    EbHandle idle_semaphore = queue_ptr->idle_semaphore;
+    if (idle_semaphore)
+        svt_post_semaphore(idle_semaphore);
 }
 
 /**************************************
- * svt_circular_buffer_empty_check
+ * svt_muxing_queue_acquire
+ *   Takes one unit of available_count, spinning for a short while
+ *   before parking the calling thread.
  **************************************/
-static bool svt_circular_buffer_empty_check(EbCircularBuffer *bufferPtr) {
-    return ((bufferPtr->head_index == bufferPtr->tail_index) && (bufferPtr->array_ptr[bufferPtr->head_index] == NULL))
-        ? true
-        : false;
+static void svt_muxing_queue_acquire(EbMuxingQueue *queue_ptr) {
+    for (uint32_t spin = 0; spin < queue_ptr->spin_count; spin++) {
+        if (svt_muxing_queue_try_acquire(queue_ptr))
+            return;
+        svt_cpu_relax();
+    }
+    if (svt_atomic_fetch_add_i32(&queue_ptr->available_count, -1) > 0)
+        return;
+    svt_muxing_queue_signal_idle(queue_ptr);
+    svt_block_on_semaphore(queue_ptr->park_semaphore);
 }
 
 /**************************************
- * svt_circular_buffer_pop_front
+ * svt_muxing_queue_release
+ *   Gives back one unit of available_count, waking a parked thread if any.
  **************************************/
-static EbErrorType svt_circular_buffer_pop_front(EbCircularBuffer *bufferPtr, EbPtr *object_ptr) {
-    EbErrorType return_error = EB_ErrorNone;
-
-    // Copy the head of the buffer into the object_ptr
-    *object_ptr                                 = bufferPtr->array_ptr[bufferPtr->head_index];
-    bufferPtr->array_ptr[bufferPtr->head_index] = NULL;
-
-    // Increment the head & check for rollover
-    bufferPtr->head_index = (bufferPtr->head_index == bufferPtr->buffer_total_count - 1) ? 0
-                                                                                         : bufferPtr->head_index + 1;
-
-    // Decrement the Current Count
-    --bufferPtr->current_count;
-
-    return return_error;
+static void svt_muxing_queue_release(EbMuxingQueue *queue_ptr) {
+    if (svt_atomic_fetch_add_i32(&queue_ptr->available_count, 1) < 0)
+        svt_post_semaphore(queue_ptr->park_semaphore);
 }
 
 /**************************************
- * svt_circular_buffer_push_back
+ * svt_muxing_queue_park_check
+ *   Parks the calling consumer if processes were asked to park.
  **************************************/
-static EbErrorType svt_circular_buffer_push_back(EbCircularBuffer *bufferPtr, EbPtr object_ptr) {
-    EbErrorType return_error = EB_ErrorNone;
-
-    // Copy the pointer into the array
-    bufferPtr->array_ptr[bufferPtr->tail_index] = object_ptr;
-
-    // Increment the tail & check for rollover
-    bufferPtr->tail_index = (bufferPtr->tail_index == bufferPtr->buffer_total_count - 1) ? 0
-                                                                                         : bufferPtr->tail_index + 1;
-
-    // Increment the Current Count
-    ++bufferPtr->current_count;
-
-    return return_error;
+static void svt_muxing_queue_park_check(EbMuxingQueue *queue_ptr) {
+    if (svt_atomic_load_i32(&queue_ptr->park_request) <= 0)
+        return;
+    bool park = false;
+    svt_block_on_mutex(queue_ptr->gate_mutex);
+    if (queue_ptr->park_request > 0 && !svt_atomic_load_u32(&queue_ptr->quit_signal)) {
+        svt_atomic_fetch_add_i32(&queue_ptr->park_request, -1);
+        queue_ptr->parked_count++;
+        park = true;
+    }
+    svt_release_mutex(queue_ptr->gate_mutex);
+    if (park) {
+        svt_muxing_queue_signal_idle(queue_ptr);
+        svt_block_on_semaphore(queue_ptr->gate_semaphore);
+    }
 }
 
 /**************************************
- * svt_circular_buffer_push_front
+ * svt_muxing_queue_set_active_count
+ *   Parks or wakes up consumers so that active_count of them take objects.
  **************************************/
-static EbErrorType svt_circular_buffer_push_front(EbCircularBuffer *bufferPtr, EbPtr object_ptr) {
-    EbErrorType return_error = EB_ErrorNone;
-
-    // Decrement the head_index
-    bufferPtr->head_index = (bufferPtr->head_index == 0) ? bufferPtr->buffer_total_count - 1
-                                                         : bufferPtr->head_index - 1;
+static void svt_muxing_queue_set_active_count(EbMuxingQueue *queue_ptr, uint32_t active_count) {
+    svt_block_on_mutex(queue_ptr->gate_mutex);
+    int32_t delta = (int32_t)active_count -
+        ((int32_t)queue_ptr->process_total_count - queue_ptr->park_request - (int32_t)queue_ptr->parked_count);
+    if (delta < 0)
+        svt_atomic_fetch_add_i32(&queue_ptr->park_request, -delta);
+    else if (delta > 0) {
+        // Cancel the pending park requests first, then wake up parked processes
+        const int32_t cancel = AOMMIN(delta, queue_ptr->park_request);
+        svt_atomic_fetch_add_i32(&queue_ptr->park_request, -cancel);
+        delta -= cancel;
+        for (; delta > 0 && queue_ptr->parked_count; delta--) {
+            queue_ptr->parked_count--;
+            svt_post_semaphore(queue_ptr->gate_semaphore);
+        }
+    }
+    svt_release_mutex(queue_ptr->gate_mutex);
+}
 
-    // Copy the pointer into the array
-    bufferPtr->array_ptr[bufferPtr->head_index] = object_ptr;
+static EbErrorType svt_muxing_queue_shutdown(EbMuxingQueue *queue_ptr) {
+    EbErrorType return_error = EB_ErrorNone;
 
-    // Increment the Current Count
-    ++bufferPtr->current_count;
+    svt_atomic_store_u32(&queue_ptr->quit_signal, 1);
+    // Wake up the parked processes so they see the quit signal
+    svt_muxing_queue_set_active_count(queue_ptr, queue_ptr->process_total_count);
+    //Wake up the waiting processes if any
+    for (uint32_t i = 0; i < queue_ptr->process_total_count; i++) svt_muxing_queue_release(queue_ptr);
 
     return return_error;
 }
@@ -186,8 +196,10 @@ static EbErrorType svt_circular_buffer_push_front(EbCircularBuffer *bufferPtr, E
 void svt_muxing_queue_dctor(EbPtr p) {
     EbMuxingQueue *obj = (EbMuxingQueue *)p;
     EB_DELETE_PTR_ARRAY(obj->process_fifo_ptr_array, obj->process_total_count);
-    EB_DELETE(obj->object_queue);
-    EB_DELETE(obj->process_queue);
+    EB_FREE_ARRAY(obj->ring);
+    EB_DESTROY_SEMAPHORE(obj->park_semaphore);
+    EB_DESTROY_SEMAPHORE(obj->gate_semaphore);
+    EB_DESTROY_MUTEX(obj->gate_mutex);
     EB_DESTROY_MUTEX(obj->lockout_mutex);
 }
 
@@ -197,6 +209,7 @@ void svt_muxing_queue_dctor(EbPtr p) {
 static EbErrorType svt_muxing_queue_ctor(EbMuxingQueue *queue_ptr, uint32_t object_total_count,
                                          uint32_t process_total_count) {
     uint32_t    process_index;
+    uint32_t    ring_size    = 1;
     EbErrorType return_error = EB_ErrorNone;
 
     queue_ptr->dctor               = svt_muxing_queue_dctor;
@@ -204,55 +217,32 @@ static EbErrorType svt_muxing_queue_ctor(EbMuxingQueue *queue_ptr, uint32_t obje
 
     // Lockout Mutex
     EB_CREATE_MUTEX(queue_ptr->lockout_mutex);
+    EB_CREATE_SEMAPHORE(queue_ptr->park_semaphore, 0, process_total_count + object_total_count);
+    EB_CREATE_MUTEX(queue_ptr->gate_mutex);
+    EB_CREATE_SEMAPHORE(queue_ptr->gate_semaphore, 0, process_total_count);
+
+    // Construct the object ring, rounded up to a power of 2
+    while (ring_size < object_total_count) ring_size <<= 1;
+    EB_MALLOC_ARRAY(queue_ptr->ring, ring_size);
+    for (uint32_t i = 0; i < ring_size; i++) {
+        queue_ptr->ring[i].sequence    = i;
+        queue_ptr->ring[i].wrapper_ptr = NULL;
+    }
+    queue_ptr->ring_mask       = ring_size - 1;
+    queue_ptr->enqueue_pos     = 0;
+    queue_ptr->dequeue_pos     = 0;
+    queue_ptr->available_count = 0;
+    queue_ptr->quit_signal     = 0;
+    queue_ptr->park_request    = 0;
+    queue_ptr->parked_count    = 0;
+    // Spinning only pays off when the producer can run at the same time
+    queue_ptr->spin_count = svt_get_num_processors() > 1 ? SRM_SPIN_COUNT : 0;
 
-    // Construct Object Circular Buffer
-    EB_NEW(queue_ptr->object_queue, svt_circular_buffer_ctor, object_total_count);
-    // Construct Process Circular Buffer
-    EB_NEW(queue_ptr->process_queue, svt_circular_buffer_ctor, queue_ptr->process_total_count);
     // Construct the Process Fifos
     EB_ALLOC_PTR_ARRAY(queue_ptr->process_fifo_ptr_array, queue_ptr->process_total_count);
 
     for (process_index = 0; process_index < queue_ptr->process_total_count; ++process_index) {
-        EB_NEW(queue_ptr->process_fifo_ptr_array[process_index],
-               svt_fifo_ctor,
-               0,
-               object_total_count,
-               (EbObjectWrapper *)NULL,
-               (EbObjectWrapper *)NULL,
-               queue_ptr);
-    }
-
-    return return_error;
-}
-
-/**************************************
- * svt_muxing_queue_assignation
- **************************************/
-static EbErrorType svt_muxing_queue_assignation(EbMuxingQueue *queue_ptr) {
-    EbErrorType      return_error = EB_ErrorNone;
-    EbFifo          *process_fifo_ptr;
-    EbObjectWrapper *wrapper_ptr;
-
-    // while loop
-    while ((svt_circular_buffer_empty_check(queue_ptr->object_queue) == false) &&
-           (svt_circular_buffer_empty_check(queue_ptr->process_queue) == false)) {
-        // Get the next process
-        svt_circular_buffer_pop_front(queue_ptr->process_queue, (void **)&process_fifo_ptr);
-
-        // Get the next object
-        svt_circular_buffer_pop_front(queue_ptr->object_queue, (void **)&wrapper_ptr);
-
-        // Block on the Process Fifo's Mutex
-        svt_block_on_mutex(process_fifo_ptr->lockout_mutex);
-
-        // Put the object on the fifo
-        svt_fifo_push_back(process_fifo_ptr, wrapper_ptr);
-
-        // Release the Process Fifo's Mutex
-        svt_release_mutex(process_fifo_ptr->lockout_mutex);
-
-        // Post the semaphore
-        svt_post_semaphore(process_fifo_ptr->counting_semaphore);
+        EB_NEW(queue_ptr->process_fifo_ptr_array[process_index], svt_fifo_ctor, queue_ptr);
     }
 
     return return_error;
@@ -264,22 +254,9 @@ static EbErrorType svt_muxing_queue_assignation(EbMuxingQueue *queue_ptr) {
 static EbErrorType svt_muxing_queue_object_push_back(EbMuxingQueue *queue_ptr, EbObjectWrapper *object_ptr) {
     EbErrorType return_error = EB_ErrorNone;
 
-    svt_circular_buffer_push_back(queue_ptr->object_queue, object_ptr);
-
-    svt_muxing_queue_assignation(queue_ptr);
-
-    return return_error;
-}
-
-/**************************************
-* svt_muxing_queue_object_push_front
-**************************************/
-static EbErrorType svt_muxing_queue_object_push_front(EbMuxingQueue *queue_ptr, EbObjectWrapper *object_ptr) {
-    EbErrorType return_error = EB_ErrorNone;
-
-    svt_circular_buffer_push_front(queue_ptr->object_queue, object_ptr);
+    svt_muxing_queue_ring_push(queue_ptr, object_ptr);
 
-    svt_muxing_queue_assignation(queue_ptr);
+    svt_muxing_queue_release(queue_ptr);
 
     return return_error;
 }
@@ -407,48 +384,93 @@ static void svt_system_resource_dctor(EbPtr p) {
     EbSystemResource *obj = (EbSystemResource *)p;
     EB_DELETE(obj->full_queue);
     EB_DELETE(obj->empty_queue);
+    // Slots of objects not created yet, or destroyed by a shrinking pool, are NULL
     EB_DELETE_PTR_ARRAY(obj->wrapper_ptr_pool, obj->object_total_count);
+    EB_DESTROY_MUTEX(obj->grow_mutex);
+    EB_FREE(obj->object_init_data_ptr);
 }
 
 /*********************************************************************
- * svt_system_resource_ctor
- *   Constructor for EbSystemResource.  Fully constructs all members
- *   of EbSystemResource including the object with the passed
- *   object_ctor function.
- *
- *   resource_ptr
- *     pointer that will contain the SystemResource to be constructed.
- *
- *   object_total_count
- *     Number of objects to be managed by the SystemResource.
- *
- *   object_ctor
- *     Function pointer to the constructor of the object managed by
- *     SystemResource referenced by resource_ptr. No object level
- *     construction is performed if object_ctor is NULL.
- *
- *   object_init_data_ptr
+ * svt_system_resource_grow
+ *   Constructs one more object of a growable SystemResource, unless
+ *   the pool already reached its object_total_count. The new object
+ *   is handed to the caller rather than queued.
+ *********************************************************************/
+static EbObjectWrapper *svt_system_resource_grow(EbSystemResource *resource_ptr) {
+    if (svt_atomic_load_u32(&resource_ptr->created_count) >= resource_ptr->object_total_count)
+        return NULL;
+    EbObjectWrapper *wrapper_ptr = NULL;
+    svt_block_on_mutex(resource_ptr->grow_mutex);
+    if (resource_ptr->created_count < resource_ptr->object_total_count) {
+        uint32_t index = 0;
+        while (resource_ptr->wrapper_ptr_pool[index]) index++;
+        const EbMemScope mem_scope = svt_mem_set_scope(resource_ptr->mem_scope);
+        EB_NO_THROW_NEW(wrapper_ptr,
+                        svt_object_wrapper_ctor,
+                        resource_ptr,
+                        resource_ptr->object_creator,
+                        resource_ptr->object_init_data_ptr,
+                        resource_ptr->object_destroyer);
+        svt_mem_set_scope(mem_scope);
+        if (wrapper_ptr) {
+            resource_ptr->wrapper_ptr_pool[index] = wrapper_ptr;
+            svt_atomic_store_u32(&resource_ptr->created_count, resource_ptr->created_count + 1);
+        }
+    }
+    svt_release_mutex(resource_ptr->grow_mutex);
+    return wrapper_ptr;
+}
 
- *     pointer to data block to be used during the construction of
- *     the object. object_init_data_ptr is passed to object_ctor when
- *     object_ctor is called.
- *   object_destroyer
- *     object destroyer, will call dctor if this is null
+/*********************************************************************
+ * svt_system_resource_recycle
+ *   Returns a released object to the empty queue, or destroys it when a
+ *   shrinking pool has enough free objects. Called under the empty
+ *   queue lockout_mutex.
  *********************************************************************/
-EbErrorType svt_system_resource_ctor(EbSystemResource *resource_ptr, uint32_t object_total_count,
-                                     uint32_t producer_process_total_count, uint32_t consumer_process_total_count,
-                                     EbCreator object_creator, EbPtr object_init_data_ptr, EbDctor object_destroyer) {
+static void svt_system_resource_recycle(EbObjectWrapper *object_ptr) {
+    EbSystemResource *resource_ptr = object_ptr->system_resource_ptr;
+    if (resource_ptr->object_recycler)
+        resource_ptr->object_recycler(object_ptr->object_ptr);
+    if (resource_ptr->shrink) {
+        const uint32_t created    = svt_atomic_load_u32(&resource_ptr->created_count);
+        const int32_t  free_count = svt_atomic_load_i32(&resource_ptr->empty_queue->available_count);
+        if (created > resource_ptr->initial_count && free_count > 0 && (uint32_t)free_count >= created / 2) {
+            svt_block_on_mutex(resource_ptr->grow_mutex);
+            uint32_t index = 0;
+            while (resource_ptr->wrapper_ptr_pool[index] != object_ptr) index++;
+            // The initial objects are kept, other pools may point into them
+            const bool destroy = index >= resource_ptr->initial_count;
+            if (destroy) {
+                resource_ptr->wrapper_ptr_pool[index] = NULL;
+                svt_atomic_store_u32(&resource_ptr->created_count, resource_ptr->created_count - 1);
+            }
+            svt_release_mutex(resource_ptr->grow_mutex);
+            if (destroy) {
+                EB_DELETE(object_ptr);
+                return;
+            }
+        }
+    }
+    svt_muxing_queue_object_push_back(resource_ptr->empty_queue, object_ptr);
+}
+
+static EbErrorType system_resource_init(EbSystemResource *resource_ptr, uint32_t object_total_count,
+                                        uint32_t initial_count, uint32_t producer_process_total_count,
+                                        uint32_t consumer_process_total_count, EbCreator object_creator,
+                                        EbPtr object_init_data_ptr, EbDctor object_destroyer) {
     uint32_t    wrapper_index;
     EbErrorType return_error = EB_ErrorNone;
     resource_ptr->dctor      = svt_system_resource_dctor;
 
     resource_ptr->object_total_count = object_total_count;
+    resource_ptr->initial_count      = initial_count;
+    resource_ptr->created_count      = initial_count;
 
     // Allocate array for wrapper pointers
     EB_ALLOC_PTR_ARRAY(resource_ptr->wrapper_ptr_pool, resource_ptr->object_total_count);
 
     // Initialize each wrapper
-    for (wrapper_index = 0; wrapper_index < resource_ptr->object_total_count; ++wrapper_index) {
+    for (wrapper_index = 0; wrapper_index < resource_ptr->initial_count; ++wrapper_index) {
         EB_NEW(resource_ptr->wrapper_ptr_pool[wrapper_index],
                svt_object_wrapper_ctor,
                resource_ptr,
@@ -467,12 +489,12 @@ EbErrorType svt_system_resource_ctor(EbSystemResource *resource_ptr, uint32_t ob
            resource_ptr->object_total_count,
            producer_process_total_count);
     // Fill the Empty Fifo with every ObjectWrapper
-    for (wrapper_index = 0; wrapper_index < resource_ptr->object_total_count; ++wrapper_index) {
+    for (wrapper_index = 0; wrapper_index < resource_ptr->initial_count; ++wrapper_index) {
         svt_muxing_queue_object_push_back(resource_ptr->empty_queue, resource_ptr->wrapper_ptr_pool[wrapper_index]);
     }
 #if SRM_REPORT
     //at init time, the SRM is full
-    resource_ptr->empty_queue->curr_count = resource_ptr->object_total_count;
+    resource_ptr->empty_queue->curr_count = resource_ptr->initial_count;
     resource_ptr->empty_queue->log        = 0;
 #endif
     // Initialize the Full Queue
@@ -488,6 +510,78 @@ EbErrorType svt_system_resource_ctor(EbSystemResource *resource_ptr, uint32_t ob
     return return_error;
 }
 
+/*********************************************************************
+ * svt_system_resource_ctor
+ *   Constructor for EbSystemResource.  Fully constructs all members
+ *   of EbSystemResource including the object with the passed
+ *   object_ctor function.
+ *
+ *   resource_ptr
+ *     pointer that will contain the SystemResource to be constructed.
+ *
+ *   object_total_count
+ *     Number of objects to be managed by the SystemResource.
+ *
+ *   object_ctor
+ *     Function pointer to the constructor of the object managed by
+ *     SystemResource referenced by resource_ptr. No object level
+ *     construction is performed if object_ctor is NULL.
+ *
+ *   object_init_data_ptr
+
+ *     pointer to data block to be used during the construction of
+ *     the object. object_init_data_ptr is passed to object_ctor when
+ *     object_ctor is called.
+ *   object_destroyer
+ *     object destroyer, will call dctor if this is null
+ *********************************************************************/
+EbErrorType svt_system_resource_ctor(EbSystemResource *resource_ptr, uint32_t object_total_count,
+                                     uint32_t producer_process_total_count, uint32_t consumer_process_total_count,
+                                     EbCreator object_creator, EbPtr object_init_data_ptr, EbDctor object_destroyer) {
+    return system_resource_init(resource_ptr,
+                                object_total_count,
+                                object_total_count,
+                                producer_process_total_count,
+                                consumer_process_total_count,
+                                object_creator,
+                                object_init_data_ptr,
+                                object_destroyer);
+}
+
+/*********************************************************************
+ * svt_system_resource_growable_ctor
+ *********************************************************************/
+EbErrorType svt_system_resource_growable_ctor(EbSystemResource *resource_ptr, uint32_t object_total_count,
+                                              uint32_t initial_count, bool shrink,
+                                              uint32_t producer_process_total_count,
+                                              uint32_t consumer_process_total_count, EbCreator object_creator,
+                                              EbPtr object_init_data_ptr, size_t init_data_size,
+                                              EbDctor object_destroyer) {
+    resource_ptr->dctor = svt_system_resource_dctor;
+    initial_count       = AOMMAX(1, AOMMIN(initial_count, object_total_count));
+    if (initial_count < object_total_count) {
+        // The init data is used again when the pool grows
+        EB_MALLOC(resource_ptr->object_init_data_ptr, init_data_size);
+        memcpy(resource_ptr->object_init_data_ptr, object_init_data_ptr, init_data_size);
+        EB_CREATE_MUTEX(resource_ptr->grow_mutex);
+        resource_ptr->object_creator   = object_creator;
+        resource_ptr->object_destroyer = object_destroyer;
+        resource_ptr->shrink           = shrink;
+        resource_ptr->mem_scope        = svt_mem_get_scope();
+    }
+    EbErrorType return_error = system_resource_init(resource_ptr,
+                                                    object_total_count,
+                                                    initial_count,
+                                                    producer_process_total_count,
+                                                    consumer_process_total_count,
+                                                    object_creator,
+                                                    object_init_data_ptr,
+                                                    object_destroyer);
+    if (return_error == EB_ErrorNone && initial_count < object_total_count)
+        resource_ptr->empty_queue->growable_resource = resource_ptr;
+    return return_error;
+}
+
 EbFifo *svt_system_resource_get_producer_fifo(const EbSystemResource *resource_ptr, uint32_t index) {
     return svt_muxing_queue_get_fifo(resource_ptr->empty_queue, index);
 }
@@ -496,42 +590,126 @@ EbFifo *svt_system_resource_get_consumer_fifo(const EbSystemResource *resource_p
     return svt_muxing_queue_get_fifo(resource_ptr->full_queue, index);
 }
 
+void svt_system_resource_set_consumer_limit(const EbSystemResource *resource_ptr, uint32_t limit) {
+    EbMuxingQueue *queue_ptr = resource_ptr->full_queue;
+    if (!queue_ptr || svt_atomic_load_u32(&queue_ptr->quit_signal))
+        return;
+    svt_muxing_queue_set_active_count(queue_ptr, AOMMAX(1, AOMMIN(limit, queue_ptr->process_total_count)));
+}
+
+void svt_system_resource_set_app_consumer(const EbSystemResource *resource_ptr) {
+    resource_ptr->full_queue->app_consumer = true;
+}
+
+void svt_system_resource_get_consumer_load(const EbSystemResource *resource_ptr, uint32_t *queued, uint32_t *busy) {
+    const EbMuxingQueue *queue_ptr = resource_ptr->full_queue;
+    const int32_t        available = svt_atomic_load_i32((volatile int32_t *)&queue_ptr->available_count);
+    const int32_t        active    = (int32_t)queue_ptr->process_total_count -
+        svt_atomic_load_i32((volatile int32_t *)&queue_ptr->park_request) - (int32_t)queue_ptr->parked_count;
+    // A negative available_count is the number of consumers waiting for an object
+    *queued = available > 0 ? (uint32_t)available : 0;
+    *busy   = (uint32_t)AOMMAX(active + AOMMIN(available, 0), 0);
+}
+
+void svt_system_resource_set_idle_signal(const EbSystemResource *resource_ptr, EbHandle semaphore) {
+    //not fully constructed
+    if (resource_ptr && resource_ptr->full_queue)
+        resource_ptr->full_queue->idle_semaphore = semaphore;
+}
+
+void svt_system_resource_get_stats(const EbSystemResource *resource_ptr, EbSystemResourceStats *stats) {
+    memset(stats, 0, sizeof(*stats));
+    EbMuxingQueue *full_queue = resource_ptr->full_queue;
+    if (full_queue) {
+        svt_system_resource_get_consumer_load(resource_ptr, &stats->queued, &stats->busy);
+        stats->process_count = full_queue->process_total_count;
+        stats->busy_time     = svt_atomic_load_u64(&full_queue->busy_time);
+        stats->task_count    = svt_atomic_load_u64(&full_queue->pop_count);
+    }
+    EbMuxingQueue *empty_queue = resource_ptr->empty_queue;
+    // A negative available_count is the number of producers waiting for an object
+    const int32_t available = svt_atomic_load_i32(&empty_queue->available_count);
+    stats->created          = svt_atomic_load_u32((volatile uint32_t *)&resource_ptr->created_count);
+    stats->in_use           = stats->created - AOMMIN(stats->created, (uint32_t)AOMMAX(available, 0));
+    stats->wait_count       = svt_atomic_load_u64(&empty_queue->wait_count);
+    stats->wait_time        = svt_atomic_load_u64(&empty_queue->wait_time);
+}
+
 EbErrorType svt_shutdown_process(const EbSystemResource *resource_ptr) {
     //not fully constructed
     if (!resource_ptr || !resource_ptr->full_queue)
         return EB_ErrorNone;
 
     //notify all consumers we are shutting down
-    for (unsigned int i = 0; i < resource_ptr->full_queue->process_total_count; i++) {
-        EbFifo *fifo_ptr = svt_system_resource_get_consumer_fifo(resource_ptr, i);
-        svt_fifo_shutdown(fifo_ptr);
-    }
+    svt_muxing_queue_shutdown(resource_ptr->full_queue);
     return EB_ErrorNone;
 }
 
-/*********************************************************************
- * EbSystemResourceReleaseProcess
- *********************************************************************/
-static EbErrorType svt_release_process(EbFifo *process_fifo_ptr) {
-    EbErrorType return_error = EB_ErrorNone;
-
-    svt_block_on_mutex(process_fifo_ptr->queue_ptr->lockout_mutex);
-
-    svt_circular_buffer_push_front(process_fifo_ptr->queue_ptr->process_queue, process_fifo_ptr);
-
-    svt_muxing_queue_assignation(process_fifo_ptr->queue_ptr);
-
-    svt_release_mutex(process_fifo_ptr->queue_ptr->lockout_mutex);
+/**************************************
+ * svt_muxing_queue_reset
+ *   Empties the queue and brings it back to its state after
+ *   construction. The semaphores are re-created, so that wake ups left
+ *   over by the shut down cannot leak into the next run. The run time
+ *   counters are kept.
+ **************************************/
+static EbErrorType svt_muxing_queue_reset(EbMuxingQueue *queue_ptr, uint32_t object_total_count) {
+    for (uint32_t i = 0; i <= queue_ptr->ring_mask; i++) {
+        queue_ptr->ring[i].sequence    = i;
+        queue_ptr->ring[i].wrapper_ptr = NULL;
+    }
+    queue_ptr->enqueue_pos     = 0;
+    queue_ptr->dequeue_pos     = 0;
+    queue_ptr->available_count = 0;
+
+    svt_block_on_mutex(queue_ptr->gate_mutex);
+    EB_DESTROY_SEMAPHORE(queue_ptr->park_semaphore);
+    EB_DESTROY_SEMAPHORE(queue_ptr->gate_semaphore);
+    EB_CREATE_SEMAPHORE(queue_ptr->park_semaphore, 0, queue_ptr->process_total_count + object_total_count);
+    EB_CREATE_SEMAPHORE(queue_ptr->gate_semaphore, 0, queue_ptr->process_total_count);
+    queue_ptr->park_request = 0;
+    queue_ptr->parked_count = 0;
+    svt_atomic_store_u32(&queue_ptr->quit_signal, 0);
+    svt_release_mutex(queue_ptr->gate_mutex);
+#if SRM_REPORT
+    queue_ptr->curr_count = 0;
+#endif
+    if (!queue_ptr->park_semaphore || !queue_ptr->gate_semaphore)
+        return EB_ErrorInsufficientResources;
+    return EB_ErrorNone;
+}
 
-    return return_error;
+EbErrorType svt_system_resource_reset(EbSystemResource *resource_ptr) {
+    EbErrorType return_error;
+    if (resource_ptr->full_queue) {
+        return_error = svt_muxing_queue_reset(resource_ptr->full_queue, resource_ptr->object_total_count);
+        if (return_error != EB_ErrorNone)
+            return return_error;
+    }
+    return_error = svt_muxing_queue_reset(resource_ptr->empty_queue, resource_ptr->object_total_count);
+    if (return_error != EB_ErrorNone)
+        return return_error;
+    // Objects destroyed by a shrinking pool, or not created yet, are NULL
+    for (uint32_t i = 0; i < resource_ptr->object_total_count; i++) {
+        EbObjectWrapper *wrapper_ptr = resource_ptr->wrapper_ptr_pool[i];
+        if (!wrapper_ptr)
+            continue;
+        if (resource_ptr->object_recycler)
+            resource_ptr->object_recycler(wrapper_ptr->object_ptr);
+        wrapper_ptr->live_count     = EB_ObjectWrapperReleasedValue;
+        wrapper_ptr->release_enable = true;
+        svt_muxing_queue_object_push_back(resource_ptr->empty_queue, wrapper_ptr);
+    }
+#if SRM_REPORT
+    resource_ptr->empty_queue->curr_count = resource_ptr->created_count;
+#endif
+    return EB_ErrorNone;
 }
 
 /*********************************************************************
  * EbSystemResourcePostObject
  *   Queues a full EbObjectWrapper to the SystemResource. This
- *   function posts the SystemResource fullFifo counting_semaphore.
- *   This function is write protected by the SystemResource fullFifo
- *   lockout_mutex.
+ *   function wakes up a consumer parked on the SystemResource full
+ *   queue, if any. It does not take any lock.
  *
  *   resource_ptr
  *      pointer to the SystemResource that the EbObjectWrapper is
@@ -543,29 +721,26 @@ static EbErrorType svt_release_process(EbFifo *process_fifo_ptr) {
 EbErrorType svt_post_full_object(EbObjectWrapper *object_ptr) {
     EbErrorType return_error = EB_ErrorNone;
 
-    svt_block_on_mutex(object_ptr->system_resource_ptr->full_queue->lockout_mutex);
-
     svt_muxing_queue_object_push_back(object_ptr->system_resource_ptr->full_queue, object_ptr);
 
-    svt_release_mutex(object_ptr->system_resource_ptr->full_queue->lockout_mutex);
-
     return return_error;
 }
 
 /*********************************************************************
  * EbSystemResourceReleaseObject
- *   Queues an empty EbObjectWrapper to the SystemResource. This
- *   function posts the SystemResource emptyFifo counting_semaphore.
- *   This function is write protected by the SystemResource emptyFifo
- *   lockout_mutex.
+ *   Queues an empty EbObjectWrapper to the SystemResource once its
+ *   live_count drops to zero. The live_count update is write protected
+ *   by the SystemResource empty queue lockout_mutex.
  *
  *   object_ptr
  *      pointer to EbObjectWrapper to be released.
  *********************************************************************/
 EbErrorType svt_release_object(EbObjectWrapper *object_ptr) {
     EbErrorType return_error = EB_ErrorNone;
+    // The object may be destroyed when recycled by a shrinking pool
+    EbMuxingQueue *empty_queue = object_ptr->system_resource_ptr->empty_queue;
 
-    svt_block_on_mutex(object_ptr->system_resource_ptr->empty_queue->lockout_mutex);
+    svt_block_on_mutex(empty_queue->lockout_mutex);
 
     svt_aom_assert_err(object_ptr->live_count != EB_ObjectWrapperReleasedValue,
                        "live_count should not be EB_ObjectWrapperReleasedValue when release");
@@ -577,7 +752,6 @@ EbErrorType svt_release_object(EbObjectWrapper *object_ptr) {
         // Set live_count to EB_ObjectWrapperReleasedValue
         object_ptr->live_count = EB_ObjectWrapperReleasedValue;
 
-        svt_muxing_queue_object_push_front(object_ptr->system_resource_ptr->empty_queue, object_ptr);
 #if SRM_REPORT
         object_ptr->pic_number = 99999999;
         //increment the fullness
@@ -587,17 +761,20 @@ EbErrorType svt_release_object(EbObjectWrapper *object_ptr) {
                     object_ptr->system_resource_ptr->empty_queue->curr_count,
                     object_ptr->system_resource_ptr->object_total_count);
 #endif
+        svt_system_resource_recycle(object_ptr);
     }
 
-    svt_release_mutex(object_ptr->system_resource_ptr->empty_queue->lockout_mutex);
+    svt_release_mutex(empty_queue->lockout_mutex);
 
     return return_error;
 }
 
 EbErrorType svt_release_dual_object(EbObjectWrapper *object_ptr, EbObjectWrapper *sec_object_ptr) {
     EbErrorType return_error = EB_ErrorNone;
+    // The object may be destroyed when recycled by a shrinking pool
+    EbMuxingQueue *empty_queue = object_ptr->system_resource_ptr->empty_queue;
 
-    svt_block_on_mutex(object_ptr->system_resource_ptr->empty_queue->lockout_mutex);
+    svt_block_on_mutex(empty_queue->lockout_mutex);
 
     // Decrement live_count
     object_ptr->live_count = (object_ptr->live_count == 0) ? object_ptr->live_count : object_ptr->live_count - 1;
@@ -609,8 +786,6 @@ EbErrorType svt_release_dual_object(EbObjectWrapper *object_ptr, EbObjectWrapper
         // Set live_count to EB_ObjectWrapperReleasedValue
         object_ptr->live_count = EB_ObjectWrapperReleasedValue;
 
-        svt_muxing_queue_object_push_front(object_ptr->system_resource_ptr->empty_queue, object_ptr);
-
 #if SRM_REPORT
 
         if (object_ptr->system_resource_ptr->empty_queue->log)
@@ -622,9 +797,10 @@ EbErrorType svt_release_dual_object(EbObjectWrapper *object_ptr, EbObjectWrapper
         //  if (object_ptr->system_resource_ptr->empty_queue->log)
         //      SVT_LOG("SRM fullness+: %i/%i\n", object_ptr->system_resource_ptr->empty_queue->curr_count, object_ptr->system_resource_ptr->object_total_count);
 #endif
+        svt_system_resource_recycle(object_ptr);
     }
 
-    svt_release_mutex(object_ptr->system_resource_ptr->empty_queue->lockout_mutex);
+    svt_release_mutex(empty_queue->lockout_mutex);
 
     return return_error;
 }
@@ -646,9 +822,8 @@ EbErrorType dump_srm_content(EbSystemResource *resource_ptr, uint8_t log) {
 /*********************************************************************
  * EbSystemResourceGetEmptyObject
  *   Dequeues an empty EbObjectWrapper from the SystemResource.  This
- *   function blocks on the SystemResource emptyFifo counting_semaphore.
- *   This function is write protected by the SystemResource emptyFifo
- *   lockout_mutex.
+ *   function spins, then blocks, until an empty object is available in
+ *   the SystemResource empty queue.
  *
  *   resource_ptr
  *      pointer to the SystemResource that provides the empty
@@ -659,26 +834,28 @@ EbErrorType dump_srm_content(EbSystemResource *resource_ptr, uint8_t log) {
  *      EbObjectWrapper pointer.
  *********************************************************************/
 EbErrorType svt_get_empty_object(EbFifo *empty_fifo_ptr, EbObjectWrapper **wrapper_dbl_ptr) {
-    EbErrorType return_error = EB_ErrorNone;
-
-    // Queue the Fifo requesting the empty fifo
-    svt_release_process(empty_fifo_ptr);
-
-    // Block on the counting Semaphore until an empty buffer is available
-    svt_block_on_semaphore(empty_fifo_ptr->counting_semaphore);
-
-    // Acquire lockout Mutex
-    svt_block_on_mutex(empty_fifo_ptr->lockout_mutex);
+    EbErrorType    return_error = EB_ErrorNone;
+    EbMuxingQueue *queue_ptr    = empty_fifo_ptr->queue_ptr;
+
+    // Wait until an empty buffer is available, or construct a new one if the pool can grow
+    EbObjectWrapper *grown_ptr = NULL;
+    if (!svt_muxing_queue_try_acquire(queue_ptr) &&
+        !(queue_ptr->growable_resource && (grown_ptr = svt_system_resource_grow(queue_ptr->growable_resource)))) {
+        const uint64_t start = svt_av1_get_time_ns();
+        svt_muxing_queue_acquire(queue_ptr);
+        svt_atomic_fetch_add_u64(&queue_ptr->wait_time, svt_av1_get_time_ns() - start);
+        svt_atomic_fetch_add_u64(&queue_ptr->wait_count, 1);
+    }
 
     // Get the empty object
-    svt_fifo_pop_front(empty_fifo_ptr, wrapper_dbl_ptr);
+    *wrapper_dbl_ptr = grown_ptr ? grown_ptr : svt_muxing_queue_ring_pop(queue_ptr);
 
 #if SRM_REPORT
     //decrement the fullness
-    empty_fifo_ptr->queue_ptr->curr_count--;
-    if (empty_fifo_ptr->queue_ptr->log)
+    queue_ptr->curr_count--;
+    if (queue_ptr->log)
         printf("SRM fullness-: %i/%i\n",
-               empty_fifo_ptr->queue_ptr->curr_count,
+               queue_ptr->curr_count,
                (*wrapper_dbl_ptr)->system_resource_ptr->object_total_count);
 #endif
 
@@ -692,18 +869,18 @@ EbErrorType svt_get_empty_object(EbFifo *empty_fifo_ptr, EbObjectWrapper **wrapp
     // Object release enable
     (*wrapper_dbl_ptr)->release_enable = true;
 
-    // Release Mutex
-    svt_release_mutex(empty_fifo_ptr->lockout_mutex);
-
     return return_error;
 }
 
+// Full queue the calling thread took its current object from, and when
+static EB_THREAD_LOCAL EbMuxingQueue *busy_queue;
+static EB_THREAD_LOCAL uint64_t       busy_start;
+
 /*********************************************************************
  * EbSystemResourceGetFullObject
  *   Dequeues an full EbObjectWrapper from the SystemResource. This
- *   function blocks on the SystemResource fullFifo counting_semaphore.
- *   This function is write protected by the SystemResource fullFifo
- *   lockout_mutex.
+ *   function spins, then blocks, until a full object is available in
+ *   the SystemResource full queue or the queue is shut down.
  *
  *   resource_ptr
  *      pointer to the SystemResource that provides the full
@@ -714,61 +891,46 @@ EbErrorType svt_get_empty_object(EbFifo *empty_fifo_ptr, EbObjectWrapper **wrapp
  *      EbObjectWrapper pointer.
  *********************************************************************/
 EbErrorType svt_get_full_object(EbFifo *full_fifo_ptr, EbObjectWrapper **wrapper_dbl_ptr) {
-    EbErrorType return_error = EB_ErrorNone;
+    EbErrorType    return_error = EB_ErrorNone;
+    EbMuxingQueue *queue_ptr    = full_fifo_ptr->queue_ptr;
 
-    // Queue the Fifo requesting the full fifo
-    svt_release_process(full_fifo_ptr);
+    // The previous object of the calling thread is done
+    if (busy_queue) {
+        svt_atomic_fetch_add_u64(&busy_queue->busy_time, svt_av1_get_time_ns() - busy_start);
+        busy_queue = NULL;
+    }
+    if (svt_trace_enabled)
+        svt_trace_task_end();
 
-    // Block on the counting Semaphore until an empty buffer is available
-    svt_block_on_semaphore(full_fifo_ptr->counting_semaphore);
+    svt_muxing_queue_park_check(queue_ptr);
 
-    // Acquire lockout Mutex
-    svt_block_on_mutex(full_fifo_ptr->lockout_mutex);
+    // Wait until a full buffer is available
+    svt_muxing_queue_acquire(queue_ptr);
 
-    if (!full_fifo_ptr->quit_signal) {
-        svt_fifo_pop_front(full_fifo_ptr, wrapper_dbl_ptr);
+    if (!svt_atomic_load_u32(&queue_ptr->quit_signal)) {
+        *wrapper_dbl_ptr = svt_muxing_queue_ring_pop(queue_ptr);
+        svt_atomic_fetch_add_u64(&queue_ptr->pop_count, 1);
+        if (!queue_ptr->app_consumer) {
+            busy_queue = queue_ptr;
+            busy_start = svt_av1_get_time_ns();
+        }
+        if (svt_trace_enabled)
+            svt_trace_task_begin();
     } else {
         *wrapper_dbl_ptr = NULL;
         return_error     = EB_NoErrorFifoShutdown;
     }
 
-    // Release Mutex
-    svt_release_mutex(full_fifo_ptr->lockout_mutex);
-
     return return_error;
 }
 
-/**************************************
-* svt_fifo_pop_front
-**************************************/
-static bool svt_fifo_peak_front(EbFifo *fifoPtr) {
-    // Set wrapper_ptr to head of BufferPool
-    if (fifoPtr->first_ptr == (EbObjectWrapper *)NULL)
-        return true;
-    else
-        return false;
-}
-
 EbErrorType svt_get_full_object_non_blocking(EbFifo *full_fifo_ptr, EbObjectWrapper **wrapper_dbl_ptr) {
-    EbErrorType return_error = EB_ErrorNone;
-    bool        fifo_empty;
-    // Queue the Fifo requesting the full fifo
-    svt_release_process(full_fifo_ptr);
-
-    // Acquire lockout Mutex
-    svt_block_on_mutex(full_fifo_ptr->lockout_mutex);
+    EbErrorType    return_error = EB_ErrorNone;
+    EbMuxingQueue *queue_ptr    = full_fifo_ptr->queue_ptr;
 
     //if the fifo is shutting down, we will not give any buffer to caller
-    if (!full_fifo_ptr->quit_signal)
-        fifo_empty = svt_fifo_peak_front(full_fifo_ptr);
-    else
-        fifo_empty = true;
-
-    // Release Mutex
-    svt_release_mutex(full_fifo_ptr->lockout_mutex);
-
-    if (fifo_empty == false)
-        svt_get_full_object(full_fifo_ptr, wrapper_dbl_ptr);
+    if (!svt_atomic_load_u32(&queue_ptr->quit_signal) && svt_muxing_queue_try_acquire(queue_ptr))
+        *wrapper_dbl_ptr = svt_muxing_queue_ring_pop(queue_ptr);
     else
         *wrapper_dbl_ptr = (EbObjectWrapper *)NULL;
 
@@ -48,10 +48,6 @@ typedef struct EbObjectWrapper {
     // system_resource_ptr - a pointer to the SystemResourceManager
     //   that the object belongs to.
     struct EbSystemResource *system_resource_ptr;
-
-    // next_ptr - a pointer to a different EbObjectWrapper.  Used
-    //   only in the implemenation of a single-linked Fifo.
-    struct EbObjectWrapper *next_ptr;
 #if SRM_REPORT
     uint64_t pic_number;
 #endif
@@ -59,59 +55,90 @@ typedef struct EbObjectWrapper {
 
 /*********************************************************************
      * Fifo
-     *   Defines a static (i.e. no dynamic memory allocation) single
-     *   linked-list, constant time fifo implmentation. The fifo uses
-     *   the EbObjectWrapper member next_ptr to create the linked-list.
-     *   The Fifo also contains a counting_semaphore for OS thread-blocking
-     *   and dynamic EbObjectWrapper counting.
+     *   Per-process handle on a MuxingQueue. Every process (kernel
+     *   instance) that produces into or consumes from a SystemResource
+     *   owns one EbFifo; all the EbFifos of a MuxingQueue share its
+     *   object ring, so any waiting process picks up the next object.
      *********************************************************************/
 typedef struct EbFifo {
     EbDctor dctor;
-    // counting_semaphore - used for OS thread-blocking & dynamically
-    //   counting the number of EbObjectWrappers currently in the
-    //   EbFifo.
-    EbHandle counting_semaphore;
-
-    // lockout_mutex - used to prevent more than one thread from
-    //   modifying EbFifo simultaneously.
-    EbHandle lockout_mutex;
-
-    // first_ptr - pointer the the head of the Fifo
-    EbObjectWrapper *first_ptr;
-
-    // last_ptr - pointer to the tail of the Fifo
-    EbObjectWrapper *last_ptr;
-
-    // quit_signal - a flag that main thread sets to break out from kernels
-    bool quit_signal;
-
     // queue_ptr - pointer to MuxingQueue that the EbFifo is
     //   associated with.
     struct EbMuxingQueue *queue_ptr;
 } EbFifo;
 
 /*********************************************************************
-     * CircularBuffer
+     * RingCell
+     *   Slot of the MuxingQueue ring. sequence tells producers and
+     *   consumers whether the slot is free or holds a published object
+     *   for the current lap of the ring.
      *********************************************************************/
-typedef struct EbCircularBuffer {
-    EbDctor  dctor;
-    EbPtr   *array_ptr;
-    uint32_t head_index;
-    uint32_t tail_index;
-    uint32_t buffer_total_count;
-    uint32_t current_count;
-} EbCircularBuffer;
+typedef struct EbRingCell {
+    volatile uint32_t sequence;
+    EbObjectWrapper  *wrapper_ptr;
+} EbRingCell;
 
 /*********************************************************************
      * MuxingQueue
+     *   Bounded lock-free multi-producer / multi-consumer ring of
+     *   EbObjectWrappers. available_count counts the objects that can be
+     *   dequeued; it goes negative when processes are parked on
+     *   park_semaphore. Waiting processes spin for a short while before
+     *   parking, so a busy pipeline hands objects over without any
+     *   system call.
      *********************************************************************/
 typedef struct EbMuxingQueue {
-    EbDctor           dctor;
-    EbHandle          lockout_mutex;
-    EbCircularBuffer *object_queue;
-    EbCircularBuffer *process_queue;
-    uint32_t          process_total_count;
-    EbFifo          **process_fifo_ptr_array;
+    EbDctor dctor;
+    // lockout_mutex - protects live_count / release_enable of the
+    //   wrappers released into this queue.
+    EbHandle lockout_mutex;
+
+    EbRingCell *ring;
+    uint32_t    ring_mask;
+    // enqueue / dequeue positions are kept on separate cache lines
+    uint8_t           pad0[64];
+    volatile uint32_t enqueue_pos;
+    uint8_t           pad1[64];
+    volatile uint32_t dequeue_pos;
+    uint8_t           pad2[64];
+    volatile int32_t  available_count;
+    EbHandle          park_semaphore;
+    uint32_t          spin_count;
+
+    // quit_signal - a flag that main thread sets to break out from kernels
+    volatile uint32_t quit_signal;
+
+    uint32_t process_total_count;
+    EbFifo **process_fifo_ptr_array;
+
+    // Consumer parking, used to rebalance threads between stages at run time.
+    // park_request - number of processes asked to park before taking their next object
+    // parked_count - number of processes parked on gate_semaphore
+    // Both are only modified under gate_mutex; park_request is read without it.
+    EbHandle         gate_mutex;
+    EbHandle         gate_semaphore;
+    volatile int32_t park_request;
+    uint32_t         parked_count;
+
+    // Run time counters. On a full queue, the time the consumers spent on the
+    // objects they took (in ns) and the number of objects taken; on an empty
+    // queue, the time the producers were blocked waiting for an empty object
+    // (in ns) and the number of times they were.
+    volatile uint64_t busy_time;
+    volatile uint64_t pop_count;
+    volatile uint64_t wait_time;
+    volatile uint64_t wait_count;
+    // Consumed by application threads, which outlive the queue, so the time
+    // they spend on its objects is not tracked
+    bool app_consumer;
+
+    // Resource creating objects on demand when the queue runs empty, NULL
+    // for full queues and fixed size pools
+    struct EbSystemResource *growable_resource;
+
+    // Semaphore posted each time a consumer runs out of objects and waits,
+    // NULL when nobody waits for the queue to drain
+    EbHandle volatile idle_semaphore;
 #if SRM_REPORT
     uint32_t curr_count; //run time fullness
     uint8_t  log; //if set monitor out the queue size
@@ -142,6 +169,26 @@ typedef struct EbSystemResource {
 
     // The full FIFO contains a queue of completed buffers
     EbMuxingQueue *full_queue;
+
+    // Growable pools start with initial_count objects and create the others
+    // on demand, up to object_total_count. created_count is only modified
+    // under grow_mutex. When shrink is set, released objects are destroyed
+    // while at least half of the created objects are free. The grown objects
+    // are charged to the memory scope the pool was created in.
+    uint32_t          initial_count;
+    volatile uint32_t created_count;
+    bool              shrink;
+    EbHandle          grow_mutex;
+    EbCreator         object_creator;
+    EbPtr             object_init_data_ptr;
+    EbDctor           object_destroyer;
+    EbMemScope        mem_scope;
+
+    // object_recycler - Optional, called on an object when its last live
+    //   reference is released and when the SystemResource is reset, before the
+    //   object returns to the empty queue. Called under the empty queue
+    //   lockout_mutex.
+    EbDctor object_recycler;
 } EbSystemResource;
 
 /*********************************************************************
@@ -222,6 +269,28 @@ extern EbErrorType svt_system_resource_ctor(EbSystemResource *resource_ptr, uint
                                             uint32_t consumer_process_total_count, EbCreator object_ctor,
                                             EbPtr object_init_data_ptr, EbDctor object_destroyer);
 
+/*********************************************************************
+     * svt_system_resource_growable_ctor
+     *   Constructor for a growable EbSystemResource. Only initial_count
+     *   objects are constructed up front; the others are constructed by
+     *   svt_get_empty_object() when the pool runs empty, up to
+     *   object_total_count. initial_count is clipped to
+     *   [1, object_total_count].
+     *
+     *   shrink
+     *     when set, released objects above initial_count are destroyed
+     *     while the pool has more free objects than it needs.
+     *
+     *   object_init_data_ptr / init_data_size
+     *     the init data is copied, so it can live on the caller stack.
+     *********************************************************************/
+extern EbErrorType svt_system_resource_growable_ctor(EbSystemResource *resource_ptr, uint32_t object_total_count,
+                                                     uint32_t initial_count, bool shrink,
+                                                     uint32_t producer_process_total_count,
+                                                     uint32_t consumer_process_total_count, EbCreator object_ctor,
+                                                     EbPtr object_init_data_ptr, size_t init_data_size,
+                                                     EbDctor object_destroyer);
+
 /*********************************************************************
      * svt_system_resource_get_producer_fifo
      *   get producer fifo
@@ -250,9 +319,8 @@ EbFifo *svt_system_resource_get_consumer_fifo(const EbSystemResource *resource_p
      * EbSystemResourceGetEmptyObject
      *   Dequeues an empty EbObjectWrapper from the SystemResource.  The
      *   new EbObjectWrapper will be populated with the contents of the
-     *   wrapperCopyPtr if wrapperCopyPtr is not NULL. This function blocks
-     *   on the SystemResource emptyFifo counting_semaphore. This function
-     *   is write protected by the SystemResource emptyFifo lockout_mutex.
+     *   wrapperCopyPtr if wrapperCopyPtr is not NULL. This function spins,
+     *   then blocks, until the SystemResource empty queue has an object.
      *
      *   resource_ptr
      *      pointer to the SystemResource that provides the empty
@@ -272,9 +340,8 @@ EbErrorType dump_srm_content(EbSystemResource *resource_ptr, uint8_t log);
 /*********************************************************************
      * EbSystemResourcePostObject
      *   Queues a full EbObjectWrapper to the SystemResource. This
-     *   function posts the SystemResource fullFifo counting_semaphore.
-     *   This function is write protected by the SystemResource fullFifo
-     *   lockout_mutex.
+     *   function wakes up a consumer parked on the SystemResource full
+     *   queue, if any. It does not take any lock.
      *
      *   resource_ptr
      *      pointer to the SystemResource that the EbObjectWrapper is
@@ -288,9 +355,8 @@ extern EbErrorType svt_post_full_object(EbObjectWrapper *object_ptr);
 /*********************************************************************
      * EbSystemResourceGetFullObject
      *   Dequeues an full EbObjectWrapper from the SystemResource. This
-     *   function blocks on the SystemResource fullFifo counting_semaphore.
-     *   This function is write protected by the SystemResource fullFifo
-     *   lockout_mutex.
+     *   function spins, then blocks, until the SystemResource full queue
+     *   has an object or is shut down.
      *
      *   resource_ptr
      *      pointer to the SystemResource that provides the full
@@ -306,10 +372,9 @@ extern EbErrorType svt_get_full_object_non_blocking(EbFifo *full_fifo_ptr, EbObj
 
 /*********************************************************************
      * EbSystemResourceReleaseObject
-     *   Queues an empty EbObjectWrapper to the SystemResource. This
-     *   function posts the SystemResource emptyFifo counting_semaphore.
-     *   This function is write protected by the SystemResource emptyFifo
-     *   lockout_mutex.
+     *   Queues an empty EbObjectWrapper to the SystemResource once its
+     *   live_count drops to zero. The live_count update is write protected
+     *   by the SystemResource empty queue lockout_mutex.
      *
      *   object_ptr
      *      pointer to EbObjectWrapper to be released.
@@ -326,6 +391,91 @@ extern EbErrorType svt_release_object(EbObjectWrapper *object_ptr);
      *********************************************************************/
 extern EbErrorType svt_shutdown_process(const EbSystemResource *resource_ptr);
 
+/*********************************************************************
+     * svt_system_resource_reset
+     *   Returns every object of the EbSystemResource to the empty queue,
+     *   empties the full queue and clears its shut down signal, so that
+     *   the SystemResource can be used again after svt_shutdown_process.
+     *   No process may use the SystemResource while it is reset.
+     *
+     *   resource_ptr
+     *      pointer to the SystemResource.
+     *********************************************************************/
+extern EbErrorType svt_system_resource_reset(EbSystemResource *resource_ptr);
+
+/*********************************************************************
+     * svt_system_resource_set_consumer_limit
+     *   Sets how many consumer processes of the SystemResource may take
+     *   objects from its full queue. The other processes park before
+     *   taking their next object, and are woken up when the limit is
+     *   raised again or the SystemResource is shut down.
+     *
+     *   resource_ptr
+     *      pointer to the SystemResource.
+     *
+     *   limit
+     *      number of active consumers, clipped to [1, consumer count].
+     *********************************************************************/
+extern void svt_system_resource_set_consumer_limit(const EbSystemResource *resource_ptr, uint32_t limit);
+
+/*********************************************************************
+     * svt_system_resource_set_app_consumer
+     *   Marks the full queue of the SystemResource as consumed by the
+     *   application rather than by stage threads. busy_time is not
+     *   tracked for such a queue, since the consumer threads keep
+     *   running after the SystemResource is destroyed.
+     *********************************************************************/
+extern void svt_system_resource_set_app_consumer(const EbSystemResource *resource_ptr);
+
+/*********************************************************************
+     * svt_system_resource_get_consumer_load
+     *   Samples the full queue occupancy of the SystemResource.
+     *
+     *   queued
+     *      number of objects waiting for a consumer.
+     *
+     *   busy
+     *      number of active consumers not waiting for an object.
+     *********************************************************************/
+extern void svt_system_resource_get_consumer_load(const EbSystemResource *resource_ptr, uint32_t *queued,
+                                                  uint32_t *busy);
+
+/*********************************************************************
+     * svt_system_resource_set_idle_signal
+     *   Has the consumers of the SystemResource post semaphore each time
+     *   one of them finds the full queue empty and waits, or parks, so a
+     *   thread can wait for a pipeline to drain without polling it.
+     *
+     *   semaphore
+     *      semaphore to post, NULL to stop the signal.
+     *********************************************************************/
+extern void svt_system_resource_set_idle_signal(const EbSystemResource *resource_ptr, EbHandle semaphore);
+
+typedef struct EbSystemResourceStats {
+    // Consumers of the full queue
+    uint32_t process_count;
+    // Objects waiting for a consumer, and consumers not waiting for an object
+    uint32_t queued;
+    uint32_t busy;
+    // Time spent by the consumers on the objects they took, in ns
+    uint64_t busy_time;
+    uint64_t task_count;
+    // Objects constructed so far, and objects taken from the empty queue and not released yet
+    uint32_t created;
+    uint32_t in_use;
+    // Times a producer was blocked on an exhausted empty queue, and for how long in ns
+    uint64_t wait_count;
+    uint64_t wait_time;
+} EbSystemResourceStats;
+
+/*********************************************************************
+     * svt_system_resource_get_stats
+     *   Samples the run time counters of the SystemResource. The
+     *   counters are read without locking, so they are only
+     *   approximately consistent with each other.
+     *********************************************************************/
+extern void svt_system_resource_get_stats(const EbSystemResource *resource_ptr, EbSystemResourceStats *stats);
+
 #define EB_GET_FULL_OBJECT(full_fifo_ptr, wrapper_dbl_ptr)                     \
     do {                                                                       \
         EbErrorType err = svt_get_full_object(full_fifo_ptr, wrapper_dbl_ptr); \
@@ -0,0 +1,333 @@
+/*
+* Copyright (c) 2025, Alliance for Open Media. All rights reserved
+*
+* This source code is subject to the terms of the BSD 2 Clause License and
+* the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+* was not distributed with this source code in the LICENSE file, you can
+* obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+* Media Patent License 1.0 was not distributed with this source code in the
+* PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+*/
+
+#include <string.h>
+
+#include "chunk_encoder.h"
+#include "enc_handle.h"
+#include "svt_log.h"
+#include "svt_threads.h"
+
+/* Moves a packet of the pipeline to the queue of the lane. */
+static void chunk_lane_queue_packet(EbChunkLane *lane, EbBufferHeaderType *packet) {
+    EbChunkEncoder  *encoder = lane->encoder;
+    EbObjectWrapper *wrapper;
+    svt_get_empty_object(lane->packet_producer_fifo, &wrapper);
+    EbBufferHeaderType *queued = (EbBufferHeaderType *)wrapper->object_ptr;
+    // The queued packet takes over the data, so the pipeline packet is released right away
+    *queued          = *packet;
+    packet->p_buffer = NULL;
+    packet->analysis = NULL;
+    svt_av1_enc_release_out_buffer(&packet);
+    // The pipeline numbers the pictures from the start of the chunk
+    for (SvtAv1AnalysisExport *analysis = queued->analysis; analysis; analysis = analysis->next) {
+        analysis->picture_number += lane->first_frame;
+        for (int i = 0; i < SVT_AV1_ANALYSIS_REFS; i++) analysis->ref_picture[i] += lane->first_frame;
+    }
+    svt_post_full_object(wrapper);
+    // The packet is posted before the head is checked, so the application either
+    // finds it when moving to the chunk or is notified here
+    if (encoder->output_notify && lane->chunk_index == svt_atomic_load_u32(&encoder->head_chunk))
+        encoder->output_notify(encoder->output_notify_opaque);
+}
+
+/**************************************
+ * chunk_lane_kernel
+ *   Collects the packets of each chunk given to the lane, then resets the
+ *   pipeline of the lane for the next one.
+ **************************************/
+static void *chunk_lane_kernel(void *input_ptr) {
+    EbChunkLane    *lane    = (EbChunkLane *)input_ptr;
+    EbChunkEncoder *encoder = lane->encoder;
+    for (;;) {
+        svt_block_on_semaphore(lane->start_semaphore);
+        if (encoder->exit)
+            break;
+        bool eos = false;
+        while (!eos) {
+            EbBufferHeaderType *packet = NULL;
+            svt_aom_enc_handle_get_packet(lane->component, &packet, true);
+            if (packet == NULL)
+                break;
+            eos = packet->flags & EB_BUFFERFLAG_EOS;
+            chunk_lane_queue_packet(lane, packet);
+        }
+        if (svt_aom_enc_handle_reset(lane->component) != EB_ErrorNone)
+            SVT_ERROR("chunk lane %u: reset failed\n", (uint32_t)(lane - encoder->lanes));
+        svt_post_semaphore(lane->idle_semaphore);
+    }
+    return NULL;
+}
+
+/* Gives the lane the first pass stats of the frames of its chunk. The input
+ * chunk can end earlier on a forced key frame, the rate control of the lane
+ * then sees a few frames past its end. */
+static void chunk_lane_set_stats(EbChunkLane *lane, uint64_t first_frame) {
+    EbChunkEncoder        *encoder = lane->encoder;
+    const FIRSTPASS_STATS *stats   = (const FIRSTPASS_STATS *)encoder->rc_stats.buf;
+    // An input longer than the first pass reuses the stats of its last frame
+    first_frame    = AOMMIN(first_frame, encoder->rc_stats_frames - 1);
+    uint64_t count = encoder->rc_stats_frames - first_frame;
+    if (encoder->chunk_length)
+        count = AOMMIN(count, encoder->chunk_length);
+
+    FIRSTPASS_STATS *total = &lane->stats[count];
+    svt_av1_twopass_zero_stats(total);
+    for (uint64_t i = 0; i < count; i++) {
+        lane->stats[i] = stats[first_frame + i];
+        lane->stats[i].frame -= (double)first_frame;
+        lane->stats[i].stat_struct.poc -= first_frame;
+        svt_av1_accumulate_stats(total, &lane->stats[i]);
+    }
+
+    // Read by the resource coordination of the lane with its first picture
+    EbEncHandle         *handle   = (EbEncHandle *)lane->component->p_component_private;
+    const SvtAv1FixedBuf rc_stats = {lane->stats, (count + 1) * sizeof(FIRSTPASS_STATS)};
+    handle->stream_config.rc_stats_buffer                             = rc_stats;
+    handle->scs_instance_array[0]->scs->static_config.rc_stats_buffer = rc_stats;
+}
+
+static EbChunkLane *chunk_encoder_input_lane(const EbChunkEncoder *encoder) {
+    return &encoder->lanes[(encoder->chunk_count - 1) % encoder->lane_count];
+}
+
+static void chunk_encoder_start_chunk(EbChunkEncoder *encoder) {
+    const uint32_t chunk_index = encoder->chunk_count;
+    EbChunkLane   *lane        = &encoder->lanes[chunk_index % encoder->lane_count];
+    // Wait for the lane to be done with its previous chunk
+    svt_block_on_semaphore(lane->idle_semaphore);
+    lane->chunk_index = chunk_index;
+    lane->first_frame = encoder->frame_count;
+    if (lane->stats)
+        chunk_lane_set_stats(lane, encoder->frame_count);
+    encoder->chunk_frames = 0;
+    encoder->chunk_open   = true;
+    svt_atomic_store_u32(&encoder->chunk_count, chunk_index + 1);
+    svt_post_semaphore(lane->start_semaphore);
+}
+
+static EbErrorType chunk_encoder_end_chunk(EbChunkEncoder *encoder, EbBufferHeaderType *eos_buffer,
+                                           SvtAv1InputRelease release, void *opaque) {
+    encoder->chunk_open = false;
+    return svt_aom_enc_handle_send_picture(chunk_encoder_input_lane(encoder)->component, eos_buffer, release, opaque);
+}
+
+/**************************************
+ * svt_aom_chunk_encoder_send_picture
+ **************************************/
+EbErrorType svt_aom_chunk_encoder_send_picture(EbChunkEncoder *encoder, EbBufferHeaderType *p_buffer,
+                                               SvtAv1InputRelease release, void *opaque) {
+    if (encoder->eos_received) {
+        SVT_ERROR("picture sent after the end of stream\n");
+        return EB_ErrorBadParameter;
+    }
+    encoder->frame_received = true;
+    if (p_buffer->flags & EB_BUFFERFLAG_EOS) {
+        if (!encoder->chunk_open)
+            chunk_encoder_start_chunk(encoder);
+        // The EOS of this chunk is the one of the stream
+        encoder->last_chunk   = encoder->chunk_count - 1;
+        encoder->eos_received = true;
+        return chunk_encoder_end_chunk(encoder, p_buffer, release, opaque);
+    }
+
+    // A chunk ends before each key frame, forced or placed by the intra period
+    const bool key_frame = p_buffer->pic_type == EB_AV1_KEY_PICTURE && encoder->chunk_frames;
+    if (!encoder->chunk_open || key_frame ||
+        (encoder->chunk_length && encoder->chunk_frames == encoder->chunk_length)) {
+        if (encoder->chunk_open) {
+            EbErrorType return_error = chunk_encoder_end_chunk(
+                encoder, &(EbBufferHeaderType){.flags = EB_BUFFERFLAG_EOS}, NULL, NULL);
+            if (return_error != EB_ErrorNone)
+                return return_error;
+        }
+        chunk_encoder_start_chunk(encoder);
+    }
+    encoder->chunk_frames++;
+    encoder->frame_count++;
+    return svt_aom_enc_handle_send_picture(chunk_encoder_input_lane(encoder)->component, p_buffer, release, opaque);
+}
+
+/**************************************
+ * svt_aom_chunk_encoder_get_packet
+ **************************************/
+EbErrorType svt_aom_chunk_encoder_get_packet(EbChunkEncoder *encoder, EbBufferHeaderType **p_buffer, bool blocking) {
+    *p_buffer = NULL;
+    while (!encoder->eos_sent) {
+        const uint32_t head = encoder->head_chunk;
+        if (head >= svt_atomic_load_u32(&encoder->chunk_count))
+            return EB_NoErrorEmptyQueue;
+        EbChunkLane     *lane    = &encoder->lanes[head % encoder->lane_count];
+        EbObjectWrapper *wrapper = NULL;
+        if (blocking)
+            svt_get_full_object(lane->packet_consumer_fifo, &wrapper);
+        else
+            svt_get_full_object_non_blocking(lane->packet_consumer_fifo, &wrapper);
+        if (wrapper == NULL)
+            return EB_NoErrorEmptyQueue;
+
+        EbBufferHeaderType *packet = (EbBufferHeaderType *)wrapper->object_ptr;
+        packet->wrapper_ptr        = wrapper;
+        if (packet->flags & EB_BUFFERFLAG_EOS) {
+            if (encoder->eos_received && head == encoder->last_chunk)
+                encoder->eos_sent = true;
+            else {
+                // The next chunk continues the stream
+                packet->flags &= ~EB_BUFFERFLAG_EOS;
+                svt_atomic_store_u32(&encoder->head_chunk, head + 1);
+                if (packet->p_buffer == NULL) {
+                    svt_av1_enc_release_out_buffer(&packet);
+                    continue;
+                }
+            }
+        }
+        *p_buffer = packet;
+        return packet->flags & 0xfffffff0 ? EB_ErrorMax : EB_ErrorNone;
+    }
+    return EB_NoErrorEmptyQueue;
+}
+
+/**************************************
+ * svt_aom_chunk_encoder_flush
+ **************************************/
+EbErrorType svt_aom_chunk_encoder_flush(EbChunkEncoder *encoder) {
+    if (encoder->frame_received) {
+        if (!encoder->eos_received)
+            svt_aom_chunk_encoder_send_picture(encoder, &(EbBufferHeaderType){.flags = EB_BUFFERFLAG_EOS}, NULL, NULL);
+        while (!encoder->eos_sent) {
+            EbBufferHeaderType *packet = NULL;
+            svt_aom_chunk_encoder_get_packet(encoder, &packet, true);
+            if (packet)
+                svt_av1_enc_release_out_buffer(&packet);
+        }
+    }
+    // Wait for the lanes to reset their pipeline after their last chunk
+    for (uint32_t i = 0; i < encoder->lane_count; i++) {
+        svt_block_on_semaphore(encoder->lanes[i].idle_semaphore);
+        svt_post_semaphore(encoder->lanes[i].idle_semaphore);
+    }
+    encoder->chunk_count    = 0;
+    encoder->chunk_frames   = 0;
+    encoder->frame_count    = 0;
+    encoder->last_chunk     = 0;
+    encoder->chunk_open     = false;
+    encoder->frame_received = false;
+    encoder->eos_received   = false;
+    encoder->head_chunk     = 0;
+    encoder->eos_sent       = false;
+    return EB_ErrorNone;
+}
+
+static void chunk_encoder_dctor(EbPtr p) {
+    EbChunkEncoder *obj = (EbChunkEncoder *)p;
+    if (obj->lanes == NULL)
+        return;
+    obj->exit = true;
+    for (uint32_t i = 0; i < obj->lane_count; i++) {
+        EbChunkLane *lane = &obj->lanes[i];
+        if (lane->thread) {
+            svt_post_semaphore(lane->start_semaphore);
+            EB_DESTROY_THREAD(lane->thread);
+        }
+        EB_DESTROY_SEMAPHORE(lane->start_semaphore);
+        EB_DESTROY_SEMAPHORE(lane->idle_semaphore);
+        EB_DELETE(lane->packet_pool);
+        EB_FREE_ARRAY(lane->stats);
+        // Lane 0 is the handle owning the chunk encoder
+        if (i && lane->component) {
+            svt_av1_enc_deinit(lane->component);
+            svt_av1_enc_deinit_handle(lane->component);
+        }
+    }
+    EB_FREE_ARRAY(obj->lanes);
+}
+
+/**************************************
+ * svt_aom_chunk_encoder_ctor
+ *   Creates the lanes after the handle itself is initialized, the other
+ *   lanes are handles with the same configuration sharing its scheduler.
+ **************************************/
+EbErrorType svt_aom_chunk_encoder_ctor(EbChunkEncoder *encoder, EbComponentType *svt_enc_component) {
+    EbEncHandle                    *handle  = (EbEncHandle *)svt_enc_component->p_component_private;
+    const EbSvtAv1EncConfiguration *config  = &handle->stream_config;
+    EncodeContext                  *enc_ctx = handle->scs_instance_array[0]->enc_ctx;
+    EbScheduler                    *pool    = handle->thread_pool ? handle->thread_pool : handle->scheduler;
+    encoder->dctor                          = chunk_encoder_dctor;
+
+    if (enc_ctx->packet_writer.write) {
+        SVT_ERROR("The packet writer is not supported with parallel_chunks\n");
+        return EB_ErrorBadParameter;
+    }
+    // Packets are ready for the application once they reach the head chunk
+    encoder->output_notify        = enc_ctx->output_notify;
+    encoder->output_notify_opaque = enc_ctx->output_notify_opaque;
+    enc_ctx->output_notify        = NULL;
+
+    encoder->lane_count   = config->parallel_chunks;
+    encoder->chunk_length = config->intra_period_length >= 0 ? (uint64_t)config->intra_period_length + 1 : 0;
+    uint64_t stats_count  = 0;
+    if (config->pass == ENC_SECOND_PASS && config->rc_stats_buffer.sz > sizeof(FIRSTPASS_STATS)) {
+        encoder->rc_stats        = config->rc_stats_buffer;
+        encoder->rc_stats_frames = config->rc_stats_buffer.sz / sizeof(FIRSTPASS_STATS) - 1;
+        stats_count              = encoder->chunk_length ? AOMMIN(encoder->chunk_length, encoder->rc_stats_frames)
+                                                         : encoder->rc_stats_frames;
+    }
+
+    EB_CALLOC_ARRAY(encoder->lanes, encoder->lane_count);
+    for (uint32_t i = 0; i < encoder->lane_count; i++) {
+        EbChunkLane *lane = &encoder->lanes[i];
+        lane->encoder     = encoder;
+        if (i == 0)
+            lane->component = svt_enc_component;
+        else {
+            EbSvtAv1EncConfiguration lane_config;
+            EbErrorType              return_error = svt_av1_enc_init_handle(&lane->component, &lane_config);
+            if (return_error != EB_ErrorNone)
+                return return_error;
+            // The lanes keep parallel_chunks to split the pools and the threads of one handle
+            lane_config  = *config;
+            return_error = svt_av1_enc_set_parameter(lane->component, &lane_config);
+            ((EbEncHandle *)lane->component->p_component_private)->chunk_lane = true;
+            if (return_error == EB_ErrorNone && pool)
+                return_error = svt_av1_enc_attach_thread_pool(lane->component, (SvtAv1ThreadPool *)pool);
+            if (return_error == EB_ErrorNone)
+                return_error = svt_av1_enc_init(lane->component);
+            if (return_error != EB_ErrorNone)
+                return return_error;
+        }
+
+        const uint8_t packet_init_data = 0;
+        EB_NEW(lane->packet_pool,
+               svt_system_resource_growable_ctor,
+               CHUNK_PACKET_POOL_MAX,
+               CHUNK_PACKET_POOL_INIT,
+               true,
+               1,
+               1,
+               svt_output_buffer_header_creator,
+               (EbPtr)&packet_init_data,
+               sizeof(packet_init_data),
+               svt_output_buffer_header_destroyer);
+        // Read by the application thread like the output packets of a handle
+        svt_system_resource_set_app_consumer(lane->packet_pool);
+        lane->packet_producer_fifo = svt_system_resource_get_producer_fifo(lane->packet_pool, 0);
+        lane->packet_consumer_fifo = svt_system_resource_get_consumer_fifo(lane->packet_pool, 0);
+        if (stats_count)
+            EB_MALLOC_ARRAY(lane->stats, stats_count + 1);
+        EB_CREATE_SEMAPHORE(lane->start_semaphore, 0, 1);
+        EB_CREATE_SEMAPHORE(lane->idle_semaphore, 1, 1);
+        lane->thread = svt_create_thread(chunk_lane_kernel, lane);
+        if (lane->thread == NULL)
+            return EB_ErrorInsufficientResources;
+        EB_ADD_MEM(lane->thread, 1, EB_THREAD);
+    }
+    return EB_ErrorNone;
+}
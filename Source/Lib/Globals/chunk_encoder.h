@@ -0,0 +1,108 @@
+/*
+* Copyright (c) 2025, Alliance for Open Media. All rights reserved
+*
+* This source code is subject to the terms of the BSD 2 Clause License and
+* the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+* was not distributed with this source code in the LICENSE file, you can
+* obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+* Media Patent License 1.0 was not distributed with this source code in the
+* PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+*/
+
+#ifndef EbChunkEncoder_h
+#define EbChunkEncoder_h
+
+#include "EbSvtAv1Enc.h"
+#include "definitions.h"
+#include "object.h"
+#include "sys_resource_manager.h"
+#include "firstpass.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Most packets of a lane waiting for the chunks before it to be output
+#define CHUNK_PACKET_POOL_MAX (1 << 15)
+#define CHUNK_PACKET_POOL_INIT 64
+
+/**************************************
+ * Chunk lane
+ *
+ * One encoder pipeline encoding a chunk at a time as an independent stream.
+ * A lane thread takes the packets of the pipeline as they are produced and
+ * queues them, so the pipeline never waits on the application while its
+ * chunk is not the one being output, then resets the pipeline for the next
+ * chunk.
+ **************************************/
+typedef struct EbChunkLane {
+    struct EbChunkEncoder *encoder;
+    // Handle of the application for lane 0, an internal handle otherwise
+    EbComponentType *component;
+    // Packets of the chunks of the lane, in output order
+    EbSystemResource *packet_pool;
+    EbFifo           *packet_producer_fifo;
+    EbFifo           *packet_consumer_fifo;
+    EbHandle          thread;
+    // Posted when a chunk is given to the lane
+    EbHandle start_semaphore;
+    // Posted when the lane is ready for a new chunk
+    EbHandle idle_semaphore;
+    uint32_t chunk_index;
+    // Number of the first frame of the chunk in the input
+    uint64_t first_frame;
+    // Two-pass stats of the chunk, followed by their total
+    FIRSTPASS_STATS *stats;
+} EbChunkLane;
+
+/**************************************
+ * Chunk encoder
+ *
+ * Splits the input of a handle at its key frames into closed-GOP chunks,
+ * encodes the chunks concurrently on parallel_chunks lanes, assigned round
+ * robin, and outputs their packets chunk after chunk as a single stream.
+ **************************************/
+typedef struct EbChunkEncoder {
+    EbDctor      dctor;
+    EbChunkLane *lanes;
+    uint32_t     lane_count;
+    // Frames per chunk, 0 when only the forced key frames start a chunk
+    uint64_t chunk_length;
+    // Two-pass stats of the whole input, split between the chunks
+    SvtAv1FixedBuf rc_stats;
+    uint64_t       rc_stats_frames;
+
+    // Input side
+    uint32_t chunk_count;
+    uint64_t chunk_frames;
+    uint64_t frame_count;
+    uint32_t last_chunk;
+    bool     chunk_open;
+    bool     frame_received;
+    bool     eos_received;
+
+    // Output side
+    uint32_t head_chunk;
+    bool     eos_sent;
+
+    SvtAv1OutputNotify output_notify;
+    void              *output_notify_opaque;
+    volatile bool      exit;
+} EbChunkEncoder;
+
+extern EbErrorType svt_aom_chunk_encoder_ctor(EbChunkEncoder *encoder, EbComponentType *svt_enc_component);
+
+/* Sends a picture of the input, starting a new chunk when needed. */
+extern EbErrorType svt_aom_chunk_encoder_send_picture(EbChunkEncoder *encoder, EbBufferHeaderType *p_buffer,
+                                                      SvtAv1InputRelease release, void *opaque);
+/* Returns the next packet of the stream, waiting for it when blocking is set. */
+extern EbErrorType svt_aom_chunk_encoder_get_packet(EbChunkEncoder *encoder, EbBufferHeaderType **p_buffer,
+                                                    bool blocking);
+/* Ends the stream, drops the packets not taken yet and waits for every lane
+ * to be ready for a new stream. */
+extern EbErrorType svt_aom_chunk_encoder_flush(EbChunkEncoder *encoder);
+
+#ifdef __cplusplus
+}
+#endif
+#endif // EbChunkEncoder_h
@@ -21,6 +21,8 @@
 
 #include "EbVersion.h"
 #include "svt_threads.h"
+#include "svt_trace.h"
+#include "rtcd_profile.h"
 #include "utility.h"
 #include "enc_handle.h"
 #include "enc_settings.h"
@@ -56,6 +58,7 @@
 #include "rc_results.h"
 #include "definitions.h"
 #include "metadata_handle.h"
+#include "analysis_export.h"
 
 #include "pack_unpack_c.h"
 #include "enc_mode_config.h"
@@ -72,6 +75,9 @@
 #include <pthread.h>
 #include <unistd.h>
 #endif
+#ifdef __linux__
+#include <sys/syscall.h>
+#endif
 
 #include "aom_dsp_rtcd.h"
 #include "common_dsp_rtcd.h"
@@ -173,15 +179,6 @@ static const char *get_asm_level_name_str(EbCpuFlags cpu_flags) {
     return "c";
 }
 
-//Get Number of logical processors
-static uint32_t get_num_processors() {
-#ifdef _WIN32
-    return GetActiveProcessorCount(ALL_PROCESSOR_GROUPS);
-#else
-    return sysconf(_SC_NPROCESSORS_ONLN);
-#endif
-}
-
 static EbErrorType init_thread_management_params() {
 #ifdef _WIN32
     // Initialize svt_aom_group_affinity structure with Current thread info
@@ -248,7 +245,7 @@ void svt_set_thread_management_parameters(EbSvtAv1EncConfiguration* config_ptr)
 
 #ifdef _WIN32
     svt_aom_group_affinity_enabled = 1;
-    const uint32_t num_logical_processors = get_num_processors();
+    const uint32_t num_logical_processors = svt_get_num_processors();
     // For system with a single processor group(no more than 64 logic processors all together)
     // Affinity of the thread can be set to one or more logical processors
     if (num_groups == 1 && config_ptr->pin_threads) {
@@ -286,7 +283,7 @@ void svt_set_thread_management_parameters(EbSvtAv1EncConfiguration* config_ptr)
         }
     }
 #elif defined(__linux__)
-    uint32_t num_logical_processors = get_num_processors();
+    uint32_t num_logical_processors = svt_get_num_processors();
     CPU_ZERO(&svt_aom_group_affinity);
 
     if (num_groups == 1 && config_ptr->pin_threads) {
@@ -329,6 +326,90 @@ void svt_set_thread_management_parameters(EbSvtAv1EncConfiguration* config_ptr)
 #endif
 }
 
+/*
+    Pool placement on NUMA systems. The pools are allocated and zeroed by the
+    thread calling svt_av1_enc_init(), so the pages land on the node of that
+    thread (first touch). While the pools are created, the calling thread is
+    moved onto the cores the stage threads will be pinned to (local policy), or
+    its memory policy is set to interleave over all nodes (interleave policy).
+*/
+typedef struct NumaAllocState {
+#ifdef _WIN32
+    bool           affinity_set;
+    GROUP_AFFINITY prev_affinity;
+#elif defined(__linux__)
+    bool          affinity_set;
+    cpu_set_t     prev_affinity;
+    bool          policy_set;
+    int           prev_mode;
+    unsigned long prev_nodemask[16];
+#else
+    uint8_t unused;
+#endif
+} NumaAllocState;
+
+#if defined(__linux__) && defined(SYS_set_mempolicy) && defined(SYS_get_mempolicy)
+#define NUMA_MPOL_DEFAULT 0
+#define NUMA_MPOL_INTERLEAVE 3
+#define NUMA_MPOL_F_MEMS_ALLOWED (1 << 2)
+#define NUMA_MAX_NODE (16 * 8 * sizeof(unsigned long))
+#endif
+
+static void numa_alloc_begin(const EbSvtAv1EncConfiguration *config_ptr, NumaAllocState *state) {
+    memset(state, 0, sizeof(*state));
+    if (config_ptr->numa_policy == 1) {
+#if defined(__linux__) && defined(NUMA_MPOL_INTERLEAVE)
+        unsigned long allowed[16] = {0};
+        if (syscall(SYS_get_mempolicy, &state->prev_mode, state->prev_nodemask, NUMA_MAX_NODE, NULL, 0) ||
+            syscall(SYS_get_mempolicy, NULL, allowed, NUMA_MAX_NODE, NULL, NUMA_MPOL_F_MEMS_ALLOWED) ||
+            syscall(SYS_set_mempolicy, NUMA_MPOL_INTERLEAVE, allowed, NUMA_MAX_NODE)) {
+            SVT_WARN("numa_policy 1: memory interleaving is not available, using the default placement\n");
+            return;
+        }
+        state->policy_set = true;
+#else
+        SVT_WARN("numa_policy 1: memory interleaving is only supported on Linux\n");
+#endif
+        return;
+    }
+    // Without pinning nor a target socket the threads are not placed, so the calling thread is left alone
+    if (!config_ptr->pin_threads && config_ptr->target_socket == -1)
+        return;
+#ifdef _WIN32
+    if (svt_aom_group_affinity_enabled)
+        state->affinity_set =
+            SetThreadGroupAffinity(GetCurrentThread(), &svt_aom_group_affinity, &state->prev_affinity) != 0;
+#elif defined(__linux__)
+    if (CPU_COUNT(&svt_aom_group_affinity) &&
+        !pthread_getaffinity_np(pthread_self(), sizeof(cpu_set_t), &state->prev_affinity))
+        state->affinity_set =
+            !pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &svt_aom_group_affinity);
+#endif
+}
+
+// Restores the calling thread, once: later calls do nothing
+static void numa_alloc_end(NumaAllocState *state) {
+#ifdef _WIN32
+    if (state->affinity_set)
+        SetThreadGroupAffinity(GetCurrentThread(), &state->prev_affinity, NULL);
+    state->affinity_set = false;
+#elif defined(__linux__)
+    if (state->affinity_set)
+        pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &state->prev_affinity);
+    state->affinity_set = false;
+#if defined(NUMA_MPOL_INTERLEAVE)
+    if (state->policy_set)
+        syscall(SYS_set_mempolicy,
+                state->prev_mode,
+                state->prev_mode == NUMA_MPOL_DEFAULT ? NULL : state->prev_nodemask,
+                NUMA_MAX_NODE);
+    state->policy_set = false;
+#endif
+#else
+    UNUSED(state);
+#endif
+}
+
 void svt_aom_asm_set_convolve_asm_table(void);
 void svt_aom_asm_set_convolve_hbd_asm_table(void);
 void svt_aom_init_intra_dc_predictors_c_internal(void);
@@ -475,10 +556,15 @@ void set_segments_numbers(SequenceControlSet* scs) {
     scs->tf_segment_column_count = me_seg_w;
     scs->tf_segment_row_count = me_seg_h;
 }
+// Share of a lane of the chunk encoder in a count of the handle: the lanes split what is above the
+// minimum each of them needs
+static uint32_t chunk_lane_share(uint32_t count, uint32_t min_count, uint32_t lane_count) {
+    return count > min_count ? min_count + (count - min_count) / lane_count : count;
+}
 static EbErrorType load_default_buffer_configuration_settings(
     SequenceControlSet       *scs) {
     EbErrorType           return_error = EB_ErrorNone;
-    uint32_t core_count = get_num_processors();
+    uint32_t core_count = svt_get_num_processors();
     uint32_t me_seg_h, me_seg_w;
 #if defined(_WIN32) || defined(__linux__)
     if (scs->static_config.target_socket != -1)
@@ -508,6 +594,7 @@ static EbErrorType load_default_buffer_configuration_settings(
             lp = PARALLEL_LEVEL_6;
     }
     scs->lp = lp;
+    scs->core_count = core_count;
     set_segments_numbers(scs);
     me_seg_h = scs->me_segment_row_count_array[0];
     me_seg_w = scs->me_segment_column_count_array[0];
@@ -780,9 +867,62 @@ static EbErrorType load_default_buffer_configuration_settings(
         scs->total_process_init_count += (scs->rest_process_init_count = clamp(10, 1, max_rest_proc));
     }
 
+    if (scs->static_config.scheduler_mode || (scs->static_config.stage_rebalance && lp > PARALLEL_LEVEL_1)) {
+        // The shared scheduler and the stage balancer cap the number of running stage threads
+        // to the core count, so the heavy stages can get enough threads to use every core when
+        // they have backlog without oversubscribing the machine.
+        const uint32_t me_proc = MAX(scs->motion_estimation_process_init_count, (uint32_t)clamp(core_count, 1, max_me_proc));
+        const uint32_t tpl_proc = MAX(scs->tpl_disp_process_init_count, (uint32_t)clamp(core_count, 1, max_tpl_proc));
+        const uint32_t md_proc = MAX(scs->enc_dec_process_init_count, (uint32_t)clamp(core_count, 1, max_md_proc));
+        scs->total_process_init_count += me_proc - scs->motion_estimation_process_init_count;
+        scs->total_process_init_count += tpl_proc - scs->tpl_disp_process_init_count;
+        scs->total_process_init_count += md_proc - scs->enc_dec_process_init_count;
+        scs->motion_estimation_process_init_count = me_proc;
+        scs->tpl_disp_process_init_count = tpl_proc;
+        scs->enc_dec_process_init_count = md_proc;
+    }
+
+    if (scs->static_config.parallel_chunks > 1) {
+        // The lanes encoding the chunks together cost about one handle: each keeps the pictures its chunk
+        // needs in flight and they split the rest of the pictures and the stage threads of the handle
+        const uint32_t lanes = scs->static_config.parallel_chunks;
+        scs->input_buffer_fifo_init_count = chunk_lane_share(scs->input_buffer_fifo_init_count, min_input, lanes);
+        scs->picture_control_set_pool_init_count = chunk_lane_share(scs->picture_control_set_pool_init_count, min_parent, lanes);
+        scs->pa_reference_picture_buffer_init_count = chunk_lane_share(scs->pa_reference_picture_buffer_init_count, min_paref, lanes);
+        scs->output_recon_buffer_fifo_init_count = scs->reference_picture_buffer_init_count =
+            chunk_lane_share(scs->reference_picture_buffer_init_count, min_ref, lanes);
+        scs->me_pool_init_count = chunk_lane_share(scs->me_pool_init_count, min_me, lanes);
+        scs->picture_control_set_pool_init_count_child = scs->enc_dec_pool_init_count =
+            chunk_lane_share(scs->picture_control_set_pool_init_count_child, min_child + superres_count, lanes);
+
+        uint32_t *const process_counts[] = {
+            &scs->picture_analysis_process_init_count,
+            &scs->motion_estimation_process_init_count,
+            &scs->tpl_disp_process_init_count,
+            &scs->mode_decision_configuration_process_init_count,
+            &scs->enc_dec_process_init_count,
+            &scs->entropy_coding_process_init_count,
+            &scs->dlf_process_init_count,
+            &scs->cdef_process_init_count,
+            &scs->rest_process_init_count,
+        };
+        for (uint32_t i = 0; i < sizeof(process_counts) / sizeof(process_counts[0]); i++) {
+            scs->total_process_init_count -= *process_counts[i];
+            *process_counts[i] = chunk_lane_share(*process_counts[i], 1, lanes);
+            scs->total_process_init_count += *process_counts[i];
+        }
+        // As above, at least one enc dec thread per child picture
+        if (scs->enc_dec_process_init_count < scs->picture_control_set_pool_init_count_child) {
+            scs->total_process_init_count += scs->picture_control_set_pool_init_count_child - scs->enc_dec_process_init_count;
+            scs->enc_dec_process_init_count = scs->picture_control_set_pool_init_count_child;
+        }
+    }
+
     scs->total_process_init_count += 6; // single processes count
     if (scs->static_config.pass == 0 || scs->static_config.pass == 2) {
         SVT_INFO("Level of Parallelism: %u\n", lp);
+        if (scs->static_config.scheduler_mode)
+            SVT_INFO("Shared scheduler: %u cores\n", core_count);
         SVT_INFO("Number of PPCS %u\n", scs->picture_control_set_pool_init_count);
 
         /******************************************************************
@@ -927,6 +1067,8 @@ static void lib_svt_encoder_send_error_exit(
 static void svt_enc_handle_stop_threads(EbEncHandle *enc_handle_ptr)
 {
     SequenceControlSet*  control_set_ptr = enc_handle_ptr->scs_instance_array[0]->scs;
+    // Stop parking stage threads before they are joined
+    EB_DELETE(enc_handle_ptr->stage_balancer);
     // Resource Coordination
     EB_DESTROY_THREAD(enc_handle_ptr->resource_coordination_thread_handle);
     EB_DESTROY_THREAD_ARRAY(enc_handle_ptr->picture_analysis_thread_handle_array,control_set_ptr->picture_analysis_process_init_count);
@@ -972,6 +1114,11 @@ static void svt_enc_handle_stop_threads(EbEncHandle *enc_handle_ptr)
 
     // Packetization
     EB_DESTROY_THREAD(enc_handle_ptr->packetization_thread_handle);
+
+    EB_DELETE(enc_handle_ptr->stage_gate);
+    EB_DESTROY_SEMAPHORE(enc_handle_ptr->reset_idle_semaphore);
+    EB_DELETE(enc_handle_ptr->scheduler_channel);
+    EB_DELETE(enc_handle_ptr->scheduler);
 }
 /**********************************
 * Encoder Library Handle Deonstructor
@@ -979,6 +1126,8 @@ static void svt_enc_handle_stop_threads(EbEncHandle *enc_handle_ptr)
 static void svt_enc_handle_dctor(EbPtr p)
 {
     EbEncHandle *enc_handle_ptr = (EbEncHandle *)p;
+    // The lanes are channels of the scheduler of the handle
+    EB_DELETE(enc_handle_ptr->chunk_encoder);
     svt_enc_handle_stop_threads(enc_handle_ptr);
     EB_FREE_PTR_ARRAY(enc_handle_ptr->app_callback_ptr_array, enc_handle_ptr->encode_instance_total_count);
     EB_DELETE_PTR_ARRAY(enc_handle_ptr->scs_pool_ptr_array, enc_handle_ptr->encode_instance_total_count);
@@ -1073,6 +1222,7 @@ static EbErrorType svt_enc_handle_ctor(
     enc_handle_ptr->eos_sent = false;
     enc_handle_ptr->frame_received = false;
     enc_handle_ptr->is_prev_valid = true;
+    enc_handle_ptr->first_picture_sent = false;
     return EB_ErrorNone;
 }
 
@@ -1098,6 +1248,8 @@ void svt_output_buffer_header_destroyer(    EbPtr p);
 
 EbErrorType svt_input_y8b_creator(EbPtr *object_dbl_ptr, EbPtr  object_init_data_ptr);
 void svt_input_y8b_destroyer(EbPtr p);
+static void svt_input_buffer_header_recycler(EbPtr p);
+static void svt_input_y8b_recycler(EbPtr p);
 
 static EbErrorType in_cmd_ctor(
     InputCommand *context_ptr,
@@ -1223,6 +1375,14 @@ static EbErrorType rest_results_creator(
     return EB_ErrorNone;
 }
 
+/*
+* Number of objects to construct at init for a pool of total_count objects,
+* the rest are constructed on demand when pool growth is enabled
+*/
+static uint32_t pool_initial_count(const SequenceControlSet *scs, uint32_t total_count) {
+    return scs->static_config.pool_growth ? 1 : total_count;
+}
+
 static int create_pa_ref_buf_descs(EbEncHandle *enc_handle_ptr, uint32_t instance_index)
 {
         SequenceControlSet* scs = enc_handle_ptr->scs_instance_array[instance_index]->scs;
@@ -1289,12 +1449,15 @@ static int create_pa_ref_buf_descs(EbEncHandle *enc_handle_ptr, uint32_t instanc
         eb_pa_ref_obj_ect_desc_init_data_structure.sixteenth_picture_desc_init_data = sixteenth_pic_buf_desc_init_data;
         // Reference Picture Buffers
         EB_NEW(enc_handle_ptr->pa_reference_picture_pool_ptr_array[instance_index],
-            svt_system_resource_ctor,
+            svt_system_resource_growable_ctor,
             scs->pa_reference_picture_buffer_init_count,
+            pool_initial_count(scs, scs->pa_reference_picture_buffer_init_count),
+            scs->static_config.pool_growth == 2,
             EB_PictureDecisionProcessInitCount,
             0,
             svt_pa_reference_object_creator,
             &(eb_pa_ref_obj_ect_desc_init_data_structure),
+            sizeof(eb_pa_ref_obj_ect_desc_init_data_structure),
             NULL);
         // Set the SequenceControlSet Picture Pool Fifo Ptrs
         enc_handle_ptr->scs_instance_array[instance_index]->enc_ctx->pa_reference_picture_pool_fifo_ptr =
@@ -1336,12 +1499,15 @@ static int create_tpl_ref_buf_descs(EbEncHandle *enc_handle_ptr, uint32_t instan
 
     // Reference Picture Buffers
     EB_NEW(enc_handle_ptr->tpl_reference_picture_pool_ptr_array[instance_index],
-        svt_system_resource_ctor,
+        svt_system_resource_growable_ctor,
         scs->tpl_reference_picture_buffer_init_count,
+        pool_initial_count(scs, scs->tpl_reference_picture_buffer_init_count),
+        scs->static_config.pool_growth == 2,
         EB_PictureDecisionProcessInitCount,
         0,
         svt_tpl_reference_object_creator,
         &(eb_tpl_ref_obj_ect_desc_init_data_structure),
+        sizeof(eb_tpl_ref_obj_ect_desc_init_data_structure),
         NULL);
     // Set the SequenceControlSet Picture Pool Fifo Ptrs
     enc_handle_ptr->scs_instance_array[instance_index]->enc_ctx->tpl_reference_picture_pool_fifo_ptr =
@@ -1391,12 +1557,15 @@ static int create_ref_buf_descs(EbEncHandle *enc_handle_ptr, uint32_t instance_i
     // Reference Picture Buffers
     EB_NEW(
             enc_handle_ptr->reference_picture_pool_ptr_array[instance_index],
-            svt_system_resource_ctor,
+            svt_system_resource_growable_ctor,
             scs->reference_picture_buffer_init_count,//enc_handle_ptr->ref_pic_pool_total_count,
+            pool_initial_count(scs, scs->reference_picture_buffer_init_count),
+            scs->static_config.pool_growth == 2,
             EB_PictureManagerProcessInitCount,
             0,
             svt_reference_object_creator,
             &(eb_ref_obj_ect_desc_init_data_structure),
+            sizeof(eb_ref_obj_ect_desc_init_data_structure),
             NULL);
 
     // Create reference list for Picture Manager
@@ -1430,35 +1599,17 @@ void svt_av1_init_wedge_masks(void);
 /**********************************
 * Initialize Encoder Library
 **********************************/
-EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
-{
-    if(svt_enc_component == NULL)
-        return EB_ErrorBadParameter;
-    EbEncHandle *enc_handle_ptr = (EbEncHandle*)svt_enc_component->p_component_private;
-    EbErrorType return_error = EB_ErrorNone;
-    uint32_t instance_index;
-    uint32_t process_index;
-    EbColorFormat color_format = enc_handle_ptr->scs_instance_array[0]->scs->static_config.encoder_color_format;
-    SequenceControlSet* control_set_ptr;
-
-    svt_aom_setup_common_rtcd_internal(enc_handle_ptr->scs_instance_array[0]->scs->static_config.use_cpu_flags);
-    svt_aom_setup_rtcd_internal(enc_handle_ptr->scs_instance_array[0]->scs->static_config.use_cpu_flags);
-
-    svt_aom_asm_set_convolve_asm_table();
-
-    svt_aom_init_intra_dc_predictors_c_internal();
-
-    svt_aom_asm_set_convolve_hbd_asm_table();
-
-    svt_aom_init_intra_predictors_internal();
-    #ifdef MINIMAL_BUILD
-    svt_aom_blk_geom_mds = svt_aom_malloc(MAX_NUM_BLOCKS_ALLOC * sizeof(svt_aom_blk_geom_mds[0]));
-    #endif
-    svt_aom_build_blk_geom(enc_handle_ptr->scs_instance_array[0]->scs->svt_aom_geom_idx);
+/*
+    Creates the pools, queues, contexts and threads of the pipeline. The constructors return straight out of here on
+    failure, so the caller owns the placement of the calling thread (numa_state) and undoes it on every exit.
+*/
+static EbErrorType enc_init_pipeline(EbEncHandle *enc_handle_ptr, NumaAllocState *numa_state) {
+    EbErrorType         return_error = EB_ErrorNone;
+    uint32_t            instance_index;
+    uint32_t            process_index;
+    EbColorFormat       color_format = enc_handle_ptr->scs_instance_array[0]->scs->static_config.encoder_color_format;
+    SequenceControlSet *control_set_ptr;
 
-    svt_av1_init_me_luts();
-    init_fn_ptr();
-    svt_av1_init_wedge_masks();
     /************************************
      * Sequence Control Set
      ************************************/
@@ -1545,24 +1696,30 @@ EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
 
         EB_NEW(
             enc_handle_ptr->picture_parent_control_set_pool_ptr_array[instance_index],
-            svt_system_resource_ctor,
+            svt_system_resource_growable_ctor,
             enc_handle_ptr->scs_instance_array[instance_index]->scs->picture_control_set_pool_init_count,//enc_handle_ptr->pcs_pool_total_count,
+            pool_initial_count(enc_handle_ptr->scs_instance_array[instance_index]->scs, enc_handle_ptr->scs_instance_array[instance_index]->scs->picture_control_set_pool_init_count),
+            enc_handle_ptr->scs_instance_array[instance_index]->scs->static_config.pool_growth == 2,
             1,
             0,
             svt_aom_picture_parent_control_set_creator,
             &input_data,
+            sizeof(input_data),
             NULL);
 #if SRM_REPORT
         enc_handle_ptr->picture_parent_control_set_pool_ptr_array[0]->empty_queue->log = 0;
 #endif
         EB_NEW(
             enc_handle_ptr->me_pool_ptr_array[instance_index],
-            svt_system_resource_ctor,
+            svt_system_resource_growable_ctor,
             enc_handle_ptr->scs_instance_array[instance_index]->scs->me_pool_init_count,
+            pool_initial_count(enc_handle_ptr->scs_instance_array[instance_index]->scs, enc_handle_ptr->scs_instance_array[instance_index]->scs->me_pool_init_count),
+            enc_handle_ptr->scs_instance_array[instance_index]->scs->static_config.pool_growth == 2,
             1,
             0,
             svt_aom_me_creator,
             &input_data,
+            sizeof(input_data),
             NULL);
 #if SRM_REPORT
         enc_handle_ptr->me_pool_ptr_array[instance_index]->empty_queue->log = 0;
@@ -1617,12 +1774,15 @@ EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
 
             EB_NEW(
                 enc_handle_ptr->enc_dec_pool_ptr_array[instance_index],
-                svt_system_resource_ctor,
+                svt_system_resource_growable_ctor,
                 enc_handle_ptr->scs_instance_array[instance_index]->scs->enc_dec_pool_init_count, //EB_PictureControlSetPoolInitCountChild,
+                pool_initial_count(enc_handle_ptr->scs_instance_array[instance_index]->scs, enc_handle_ptr->scs_instance_array[instance_index]->scs->enc_dec_pool_init_count),
+                enc_handle_ptr->scs_instance_array[instance_index]->scs->static_config.pool_growth == 2,
                 1,
                 0,
                 svt_aom_recon_coef_creator,
                 &input_data,
+                sizeof(input_data),
                 NULL);
         }
 
@@ -1680,18 +1840,22 @@ EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
 
             EB_NEW(
                 enc_handle_ptr->picture_control_set_pool_ptr_array[instance_index],
-                svt_system_resource_ctor,
+                svt_system_resource_growable_ctor,
                 enc_handle_ptr->scs_instance_array[instance_index]->scs->picture_control_set_pool_init_count_child, //EB_PictureControlSetPoolInitCountChild,
+                pool_initial_count(enc_handle_ptr->scs_instance_array[instance_index]->scs, enc_handle_ptr->scs_instance_array[instance_index]->scs->picture_control_set_pool_init_count_child),
+                enc_handle_ptr->scs_instance_array[instance_index]->scs->static_config.pool_growth == 2,
                 1,
                 0,
                 svt_aom_picture_control_set_creator,
                 &input_data,
+                sizeof(input_data),
                 NULL);
         }
 
     /************************************
     * Picture Buffers
     ************************************/
+    svt_mem_set_category(SVT_AV1_MEM_PICTURE_BUFFERS);
 
     // Allocate Resource Arrays
     EB_ALLOC_PTR_ARRAY(enc_handle_ptr->reference_picture_pool_ptr_array, enc_handle_ptr->encode_instance_total_count);
@@ -1721,8 +1885,11 @@ EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
         enc_handle_ptr->scs_instance_array[instance_index]->scs->rest_units_per_tile = pcs->rst_info[0/*Y-plane*/].units_per_tile;
         enc_handle_ptr->scs_instance_array[instance_index]->scs->b64_total_count = pcs->b64_total_count;
         create_ref_buf_descs(enc_handle_ptr, instance_index);
-        if(enc_handle_ptr->scs_instance_array[instance_index]->scs->tpl)
-        create_tpl_ref_buf_descs(enc_handle_ptr, instance_index);
+        if (enc_handle_ptr->scs_instance_array[instance_index]->scs->tpl) {
+            svt_mem_set_category(SVT_AV1_MEM_TPL);
+            create_tpl_ref_buf_descs(enc_handle_ptr, instance_index);
+            svt_mem_set_category(SVT_AV1_MEM_PICTURE_BUFFERS);
+        }
 
         create_pa_ref_buf_descs(enc_handle_ptr, instance_index);
 
@@ -1745,6 +1912,7 @@ EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
     /************************************
     * System Resource Managers & Fifos
     ************************************/
+    svt_mem_set_category(SVT_AV1_MEM_OTHER);
 
     //SRM to link App to Ress-Coordination via Input commands. an Input Command holds 2 picture buffers: y8bit and rest(uv8b + yuv2b)
     EB_NEW(
@@ -1758,6 +1926,7 @@ EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
         NULL);
     enc_handle_ptr->input_cmd_producer_fifo_ptr = svt_system_resource_get_producer_fifo(enc_handle_ptr->input_cmd_resource_ptr, 0);
 
+    svt_mem_set_category(SVT_AV1_MEM_PICTURE_BUFFERS);
     //Picture Buffer SRM to hold (uv8b + yuv2b)
     EB_NEW(
         enc_handle_ptr->input_buffer_resource_ptr,
@@ -1768,6 +1937,7 @@ EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
         svt_input_buffer_header_creator,
         enc_handle_ptr->scs_instance_array[0]->scs,
         svt_input_buffer_header_destroyer);
+    enc_handle_ptr->input_buffer_resource_ptr->object_recycler = svt_input_buffer_header_recycler;
     enc_handle_ptr->input_buffer_producer_fifo_ptr = svt_system_resource_get_producer_fifo(enc_handle_ptr->input_buffer_resource_ptr, 0);
 
     //Picture Buffer SRM to hold y8b to be shared by Pcs->enhanced and Pa_ref
@@ -1784,9 +1954,11 @@ EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
 #if SRM_REPORT
     enc_handle_ptr->input_y8b_buffer_resource_ptr->empty_queue->log = 1;
 #endif
+    enc_handle_ptr->input_y8b_buffer_resource_ptr->object_recycler = svt_input_y8b_recycler;
     enc_handle_ptr->input_y8b_buffer_producer_fifo_ptr = svt_system_resource_get_producer_fifo(enc_handle_ptr->input_y8b_buffer_resource_ptr, 0);
 
     // EbBufferHeaderType Output Stream
+    svt_mem_set_category(SVT_AV1_MEM_BITSTREAM);
     EB_ALLOC_PTR_ARRAY(enc_handle_ptr->output_stream_buffer_resource_ptr_array, enc_handle_ptr->encode_instance_total_count);
 
     for (instance_index = 0; instance_index < enc_handle_ptr->encode_instance_total_count; ++instance_index) {
@@ -1799,8 +1971,10 @@ EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
             svt_output_buffer_header_creator,
             &enc_handle_ptr->scs_instance_array[0]->scs->static_config,
             svt_output_buffer_header_destroyer);
+        svt_system_resource_set_app_consumer(enc_handle_ptr->output_stream_buffer_resource_ptr_array[instance_index]);
     }
     enc_handle_ptr->output_stream_buffer_consumer_fifo_ptr = svt_system_resource_get_consumer_fifo(enc_handle_ptr->output_stream_buffer_resource_ptr_array[0], 0);
+    svt_mem_set_category(SVT_AV1_MEM_PICTURE_BUFFERS);
     if (enc_handle_ptr->scs_instance_array[0]->scs->static_config.recon_enabled) {
         // EbBufferHeaderType Output Recon
         EB_ALLOC_PTR_ARRAY(enc_handle_ptr->output_recon_buffer_resource_ptr_array, enc_handle_ptr->encode_instance_total_count);
@@ -1818,6 +1992,7 @@ EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
         }
         enc_handle_ptr->output_recon_buffer_consumer_fifo_ptr = svt_system_resource_get_consumer_fifo(enc_handle_ptr->output_recon_buffer_resource_ptr_array[0], 0);
     }
+    svt_mem_set_category(SVT_AV1_MEM_OTHER);
 
     // Resource Coordination Results
     {
@@ -2127,6 +2302,7 @@ EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
                 pic_mgr_port_lookup(PIC_MGR_INPUT_PORT_SOP, process_index));
         }
         // TPL dispenser
+        svt_mem_set_category(SVT_AV1_MEM_TPL);
         EB_ALLOC_PTR_ARRAY(enc_handle_ptr->tpl_disp_context_ptr_array, enc_handle_ptr->scs_instance_array[0]->scs->tpl_disp_process_init_count);
 
         for (process_index = 0; process_index < enc_handle_ptr->scs_instance_array[0]->scs->tpl_disp_process_init_count; ++process_index) {
@@ -2138,6 +2314,7 @@ EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
                 tpl_port_lookup(TPL_INPUT_PORT_TPL, process_index)
             );
         }
+        svt_mem_set_category(SVT_AV1_MEM_OTHER);
         // Picture Manager Context
         EB_NEW(
             enc_handle_ptr->picture_manager_context_ptr,
@@ -2152,6 +2329,7 @@ EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
             EB_PictureDecisionProcessInitCount);  // me_port_index
 
         // Mode Decision Configuration Contexts
+        svt_mem_set_category(SVT_AV1_MEM_MD);
         {
             // Mode Decision Configuration Contexts
             EB_ALLOC_PTR_ARRAY(enc_handle_ptr->mode_decision_configuration_context_ptr_array, enc_handle_ptr->scs_instance_array[0]->scs->mode_decision_configuration_process_init_count);
@@ -2175,6 +2353,7 @@ EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
                 process_index,
                 enc_dec_port_lookup(ENCDEC_INPUT_PORT_ENCDEC, process_index));
         }
+        svt_mem_set_category(SVT_AV1_MEM_OTHER);
 
         // Dlf Contexts
         EB_ALLOC_PTR_ARRAY(enc_handle_ptr->dlf_context_ptr_array, enc_handle_ptr->scs_instance_array[0]->scs->dlf_process_init_count);
@@ -2235,76 +2414,145 @@ EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
     /************************************
     * Thread Handles
     ************************************/
-    EbSvtAv1EncConfiguration   *config_ptr = &enc_handle_ptr->scs_instance_array[0]->scs->static_config;
-    if (config_ptr->pin_threads || config_ptr->target_socket != -1)
-        svt_set_thread_management_parameters(config_ptr);
+    numa_alloc_end(numa_state);
 
     control_set_ptr = enc_handle_ptr->scs_instance_array[0]->scs;
+    EbScheduler *scheduler = enc_handle_ptr->thread_pool;
+    if (control_set_ptr->static_config.scheduler_mode && !scheduler) {
+        EB_NEW(enc_handle_ptr->scheduler, svt_scheduler_ctor, control_set_ptr->core_count);
+        scheduler = enc_handle_ptr->scheduler;
+    }
+    if (scheduler)
+        EB_NEW(enc_handle_ptr->scheduler_channel, svt_scheduler_channel_ctor, scheduler, control_set_ptr->total_process_init_count);
+    EB_NEW(enc_handle_ptr->stage_gate, svt_stage_gate_ctor, control_set_ptr->total_process_init_count);
 
     // Resource Coordination
-    EB_CREATE_THREAD(enc_handle_ptr->resource_coordination_thread_handle, svt_aom_resource_coordination_kernel, enc_handle_ptr->resource_coordination_context_ptr);
-    EB_CREATE_THREAD_ARRAY(enc_handle_ptr->picture_analysis_thread_handle_array,control_set_ptr->picture_analysis_process_init_count,
+    EB_CREATE_GATED_THREAD(enc_handle_ptr->stage_gate, enc_handle_ptr->scheduler_channel, enc_handle_ptr->resource_coordination_thread_handle, svt_aom_resource_coordination_kernel, enc_handle_ptr->resource_coordination_context_ptr);
+    EB_CREATE_GATED_THREAD_ARRAY(enc_handle_ptr->stage_gate, enc_handle_ptr->scheduler_channel, enc_handle_ptr->picture_analysis_thread_handle_array,control_set_ptr->picture_analysis_process_init_count,
         svt_aom_picture_analysis_kernel,
         enc_handle_ptr->picture_analysis_context_ptr_array);
 
     // Picture Decision
-    EB_CREATE_THREAD(enc_handle_ptr->picture_decision_thread_handle, svt_aom_picture_decision_kernel, enc_handle_ptr->picture_decision_context_ptr);
+    EB_CREATE_GATED_THREAD(enc_handle_ptr->stage_gate, enc_handle_ptr->scheduler_channel, enc_handle_ptr->picture_decision_thread_handle, svt_aom_picture_decision_kernel, enc_handle_ptr->picture_decision_context_ptr);
 
     // Motion Estimation
-    EB_CREATE_THREAD_ARRAY(enc_handle_ptr->motion_estimation_thread_handle_array, control_set_ptr->motion_estimation_process_init_count,
+    EB_CREATE_GATED_THREAD_ARRAY(enc_handle_ptr->stage_gate, enc_handle_ptr->scheduler_channel, enc_handle_ptr->motion_estimation_thread_handle_array, control_set_ptr->motion_estimation_process_init_count,
         svt_aom_motion_estimation_kernel,
         enc_handle_ptr->motion_estimation_context_ptr_array);
 
         // Initial Rate Control
-        EB_CREATE_THREAD(enc_handle_ptr->initial_rate_control_thread_handle, svt_aom_initial_rate_control_kernel, enc_handle_ptr->initial_rate_control_context_ptr);
+        EB_CREATE_GATED_THREAD(enc_handle_ptr->stage_gate, enc_handle_ptr->scheduler_channel, enc_handle_ptr->initial_rate_control_thread_handle, svt_aom_initial_rate_control_kernel, enc_handle_ptr->initial_rate_control_context_ptr);
 
         // Source Based Oprations
-        EB_CREATE_THREAD_ARRAY(enc_handle_ptr->source_based_operations_thread_handle_array, control_set_ptr->source_based_operations_process_init_count,
+        EB_CREATE_GATED_THREAD_ARRAY(enc_handle_ptr->stage_gate, enc_handle_ptr->scheduler_channel, enc_handle_ptr->source_based_operations_thread_handle_array, control_set_ptr->source_based_operations_process_init_count,
             svt_aom_source_based_operations_kernel,
             enc_handle_ptr->source_based_operations_context_ptr_array);
 
         // TPL dispenser
-        EB_CREATE_THREAD_ARRAY(enc_handle_ptr->tpl_disp_thread_handle_array, control_set_ptr->tpl_disp_process_init_count,
+        EB_CREATE_GATED_THREAD_ARRAY(enc_handle_ptr->stage_gate, enc_handle_ptr->scheduler_channel, enc_handle_ptr->tpl_disp_thread_handle_array, control_set_ptr->tpl_disp_process_init_count,
             svt_aom_tpl_disp_kernel,//TODOOMK
             enc_handle_ptr->tpl_disp_context_ptr_array);
         // Picture Manager
-        EB_CREATE_THREAD(enc_handle_ptr->picture_manager_thread_handle, svt_aom_picture_manager_kernel, enc_handle_ptr->picture_manager_context_ptr);
+        EB_CREATE_GATED_THREAD(enc_handle_ptr->stage_gate, enc_handle_ptr->scheduler_channel, enc_handle_ptr->picture_manager_thread_handle, svt_aom_picture_manager_kernel, enc_handle_ptr->picture_manager_context_ptr);
         // Rate Control
-        EB_CREATE_THREAD(enc_handle_ptr->rate_control_thread_handle, svt_aom_rate_control_kernel, enc_handle_ptr->rate_control_context_ptr);
+        EB_CREATE_GATED_THREAD(enc_handle_ptr->stage_gate, enc_handle_ptr->scheduler_channel, enc_handle_ptr->rate_control_thread_handle, svt_aom_rate_control_kernel, enc_handle_ptr->rate_control_context_ptr);
 
         // Mode Decision Configuration Process
-        EB_CREATE_THREAD_ARRAY(enc_handle_ptr->mode_decision_configuration_thread_handle_array, control_set_ptr->mode_decision_configuration_process_init_count,
+        EB_CREATE_GATED_THREAD_ARRAY(enc_handle_ptr->stage_gate, enc_handle_ptr->scheduler_channel, enc_handle_ptr->mode_decision_configuration_thread_handle_array, control_set_ptr->mode_decision_configuration_process_init_count,
             svt_aom_mode_decision_configuration_kernel,
             enc_handle_ptr->mode_decision_configuration_context_ptr_array);
 
 
         // EncDec Process
-        EB_CREATE_THREAD_ARRAY(enc_handle_ptr->enc_dec_thread_handle_array, control_set_ptr->enc_dec_process_init_count,
+        EB_CREATE_GATED_THREAD_ARRAY(enc_handle_ptr->stage_gate, enc_handle_ptr->scheduler_channel, enc_handle_ptr->enc_dec_thread_handle_array, control_set_ptr->enc_dec_process_init_count,
             svt_aom_mode_decision_kernel,
             enc_handle_ptr->enc_dec_context_ptr_array);
 
         // Dlf Process
-        EB_CREATE_THREAD_ARRAY(enc_handle_ptr->dlf_thread_handle_array, control_set_ptr->dlf_process_init_count,
+        EB_CREATE_GATED_THREAD_ARRAY(enc_handle_ptr->stage_gate, enc_handle_ptr->scheduler_channel, enc_handle_ptr->dlf_thread_handle_array, control_set_ptr->dlf_process_init_count,
             svt_aom_dlf_kernel,
             enc_handle_ptr->dlf_context_ptr_array);
 
         // Cdef Process
-        EB_CREATE_THREAD_ARRAY(enc_handle_ptr->cdef_thread_handle_array, control_set_ptr->cdef_process_init_count,
+        EB_CREATE_GATED_THREAD_ARRAY(enc_handle_ptr->stage_gate, enc_handle_ptr->scheduler_channel, enc_handle_ptr->cdef_thread_handle_array, control_set_ptr->cdef_process_init_count,
             svt_aom_cdef_kernel,
             enc_handle_ptr->cdef_context_ptr_array);
 
         // Rest Process
-        EB_CREATE_THREAD_ARRAY(enc_handle_ptr->rest_thread_handle_array, control_set_ptr->rest_process_init_count,
+        EB_CREATE_GATED_THREAD_ARRAY(enc_handle_ptr->stage_gate, enc_handle_ptr->scheduler_channel, enc_handle_ptr->rest_thread_handle_array, control_set_ptr->rest_process_init_count,
             svt_aom_rest_kernel,
             enc_handle_ptr->rest_context_ptr_array);
 
         // Entropy Coding Process
-        EB_CREATE_THREAD_ARRAY(enc_handle_ptr->entropy_coding_thread_handle_array, control_set_ptr->entropy_coding_process_init_count,
+        EB_CREATE_GATED_THREAD_ARRAY(enc_handle_ptr->stage_gate, enc_handle_ptr->scheduler_channel, enc_handle_ptr->entropy_coding_thread_handle_array, control_set_ptr->entropy_coding_process_init_count,
             svt_aom_entropy_coding_kernel,
             enc_handle_ptr->entropy_coding_context_ptr_array);
 
     // Packetization
-    EB_CREATE_THREAD(enc_handle_ptr->packetization_thread_handle, svt_aom_packetization_kernel, enc_handle_ptr->packetization_context_ptr);
+    EB_CREATE_GATED_THREAD(enc_handle_ptr->stage_gate, enc_handle_ptr->scheduler_channel, enc_handle_ptr->packetization_thread_handle, svt_aom_packetization_kernel, enc_handle_ptr->packetization_context_ptr);
+
+    // Stage balancer, fed by the input queue of each multi-threaded stage
+    if (control_set_ptr->static_config.stage_rebalance) {
+        EB_NEW(enc_handle_ptr->stage_balancer, svt_stage_balancer_ctor, control_set_ptr->core_count);
+        svt_stage_balancer_add_stage(enc_handle_ptr->stage_balancer, enc_handle_ptr->picture_decision_results_resource_ptr, control_set_ptr->motion_estimation_process_init_count);
+        svt_stage_balancer_add_stage(enc_handle_ptr->stage_balancer, enc_handle_ptr->initial_rate_control_results_resource_ptr, control_set_ptr->source_based_operations_process_init_count);
+        svt_stage_balancer_add_stage(enc_handle_ptr->stage_balancer, enc_handle_ptr->tpl_disp_res_srm, control_set_ptr->tpl_disp_process_init_count);
+        svt_stage_balancer_add_stage(enc_handle_ptr->stage_balancer, enc_handle_ptr->rate_control_results_resource_ptr, control_set_ptr->mode_decision_configuration_process_init_count);
+        svt_stage_balancer_add_stage(enc_handle_ptr->stage_balancer, enc_handle_ptr->enc_dec_tasks_resource_ptr, control_set_ptr->enc_dec_process_init_count);
+        svt_stage_balancer_add_stage(enc_handle_ptr->stage_balancer, enc_handle_ptr->enc_dec_results_resource_ptr, control_set_ptr->dlf_process_init_count);
+        svt_stage_balancer_add_stage(enc_handle_ptr->stage_balancer, enc_handle_ptr->dlf_results_resource_ptr, control_set_ptr->cdef_process_init_count);
+        svt_stage_balancer_add_stage(enc_handle_ptr->stage_balancer, enc_handle_ptr->cdef_results_resource_ptr, control_set_ptr->rest_process_init_count);
+        svt_stage_balancer_add_stage(enc_handle_ptr->stage_balancer, enc_handle_ptr->rest_results_resource_ptr, control_set_ptr->entropy_coding_process_init_count);
+        return_error = svt_stage_balancer_start(enc_handle_ptr->stage_balancer);
+    }
+    enc_handle_ptr->stream_config = control_set_ptr->static_config;
+    return return_error;
+}
+
+EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
+{
+    if(svt_enc_component == NULL)
+        return EB_ErrorBadParameter;
+    EbEncHandle *enc_handle_ptr = (EbEncHandle*)svt_enc_component->p_component_private;
+    EbErrorType return_error = EB_ErrorNone;
+    SequenceControlSet* control_set_ptr;
+
+    svt_aom_setup_common_rtcd_internal(enc_handle_ptr->scs_instance_array[0]->scs->static_config.use_cpu_flags);
+    svt_aom_setup_rtcd_internal(enc_handle_ptr->scs_instance_array[0]->scs->static_config.use_cpu_flags);
+
+    svt_aom_asm_set_convolve_asm_table();
+
+    svt_aom_init_intra_dc_predictors_c_internal();
+
+    svt_aom_asm_set_convolve_hbd_asm_table();
+
+    svt_aom_init_intra_predictors_internal();
+    #ifdef MINIMAL_BUILD
+    svt_aom_blk_geom_mds = svt_aom_malloc(MAX_NUM_BLOCKS_ALLOC * sizeof(svt_aom_blk_geom_mds[0]));
+    #endif
+    svt_aom_build_blk_geom(enc_handle_ptr->scs_instance_array[0]->scs->svt_aom_geom_idx);
+
+    svt_av1_init_me_luts();
+    init_fn_ptr();
+    svt_av1_init_wedge_masks();
+
+    EbSvtAv1EncConfiguration   *config_ptr = &enc_handle_ptr->scs_instance_array[0]->scs->static_config;
+    if (config_ptr->pin_threads || config_ptr->target_socket != -1)
+        svt_set_thread_management_parameters(config_ptr);
+    NumaAllocState numa_state;
+    numa_alloc_begin(config_ptr, &numa_state);
+    // Allocations are charged to the handle, per category from here on
+    const EbMemScope mem_scope = svt_mem_set_scope((EbMemScope){enc_handle_ptr->mem_account, SVT_AV1_MEM_PCS});
+    return_error = enc_init_pipeline(enc_handle_ptr, &numa_state);
+    // Single exit of the pipeline creation: a failed constructor returns from enc_init_pipeline() without undoing
+    // the placement of the calling thread nor its memory scope, which must not outlive the handle
+    numa_alloc_end(&numa_state);
+    svt_mem_set_scope(mem_scope);
+    if (return_error != EB_ErrorNone)
+        return return_error;
+    control_set_ptr = enc_handle_ptr->scs_instance_array[0]->scs;
+    if (control_set_ptr->static_config.parallel_chunks > 1 && !enc_handle_ptr->chunk_lane)
+        EB_NEW(enc_handle_ptr->chunk_encoder, svt_aom_chunk_encoder_ctor, svt_enc_component);
 
     svt_print_memory_usage();
 
@@ -2316,7 +2564,7 @@ static EbErrorType enc_drain_queue(EbComponentType *svt_enc_component) {
     do {
         EbBufferHeaderType *receive_buffer = NULL;
         EbErrorType         return_error;
-        switch ((return_error = svt_av1_enc_get_packet(svt_enc_component, &receive_buffer, 1))) {
+        switch ((return_error = svt_aom_enc_handle_get_packet(svt_enc_component, &receive_buffer, true))) {
         case EB_ErrorMax: return EB_ErrorMax;
         case EB_NoErrorEmptyQueue: eos = true; break;
         default: break;
@@ -2330,6 +2578,30 @@ static EbErrorType enc_drain_queue(EbComponentType *svt_enc_component) {
     return EB_ErrorNone;
 }
 
+// Resources whose full queue feeds a stage thread
+#define ENC_STAGE_RESOURCE_COUNT 17
+static void enc_get_stage_resources(const EbEncHandle *handle, EbSystemResource **resources) {
+    uint32_t i     = 0;
+    resources[i++] = handle->input_buffer_resource_ptr;
+    resources[i++] = handle->input_cmd_resource_ptr;
+    resources[i++] = handle->resource_coordination_results_resource_ptr;
+    resources[i++] = handle->picture_analysis_results_resource_ptr;
+    resources[i++] = handle->picture_decision_results_resource_ptr;
+    resources[i++] = handle->motion_estimation_results_resource_ptr;
+    resources[i++] = handle->initial_rate_control_results_resource_ptr;
+    resources[i++] = handle->picture_demux_results_resource_ptr;
+    resources[i++] = handle->tpl_disp_res_srm;
+    resources[i++] = handle->rate_control_tasks_resource_ptr;
+    resources[i++] = handle->rate_control_results_resource_ptr;
+    resources[i++] = handle->enc_dec_tasks_resource_ptr;
+    resources[i++] = handle->enc_dec_results_resource_ptr;
+    resources[i++] = handle->entropy_coding_results_resource_ptr;
+    resources[i++] = handle->dlf_results_resource_ptr;
+    resources[i++] = handle->cdef_results_resource_ptr;
+    resources[i++] = handle->rest_results_resource_ptr;
+    assert(i == ENC_STAGE_RESOURCE_COUNT);
+}
+
 /**********************************
 * DeInitialize Encoder Library
 **********************************/
@@ -2339,10 +2611,17 @@ EB_API EbErrorType svt_av1_enc_deinit(EbComponentType *svt_enc_component) {
 
     EbEncHandle *handle = svt_enc_component->p_component_private;
 
-    if (handle->input_y8b_buffer_producer_fifo_ptr && handle->frame_received) {
+    if (handle->chunk_encoder) {
+        if (handle->chunk_encoder->frame_received && !handle->chunk_encoder->eos_received)
+            SVT_ERROR("deinit called without sending EOS!\n");
+        // The lanes are left reset, so the pipeline of the handle has nothing to drain
+        EbErrorType return_error = svt_aom_chunk_encoder_flush(handle->chunk_encoder);
+        if (return_error != EB_ErrorNone)
+            return return_error;
+    } else if (handle->input_y8b_buffer_producer_fifo_ptr && handle->frame_received) {
         if (!handle->eos_received) {
             SVT_ERROR("deinit called without sending EOS!\n");
-            svt_av1_enc_send_picture(svt_enc_component, &(EbBufferHeaderType){.flags = EB_BUFFERFLAG_EOS});
+            svt_aom_enc_handle_send_picture(svt_enc_component, &(EbBufferHeaderType){.flags = EB_BUFFERFLAG_EOS}, NULL, NULL);
         }
 
         EbErrorType return_error = enc_drain_queue(svt_enc_component);
@@ -2352,27 +2631,183 @@ EB_API EbErrorType svt_av1_enc_deinit(EbComponentType *svt_enc_component) {
     #ifdef MINIMAL_BUILD
     svt_aom_free(svt_aom_blk_geom_mds);
     #endif
-    svt_shutdown_process(handle->input_buffer_resource_ptr);
-    svt_shutdown_process(handle->input_cmd_resource_ptr);
-    svt_shutdown_process(handle->resource_coordination_results_resource_ptr);
-    svt_shutdown_process(handle->picture_analysis_results_resource_ptr);
-    svt_shutdown_process(handle->picture_decision_results_resource_ptr);
-    svt_shutdown_process(handle->motion_estimation_results_resource_ptr);
-    svt_shutdown_process(handle->initial_rate_control_results_resource_ptr);
-    svt_shutdown_process(handle->picture_demux_results_resource_ptr);
-    svt_shutdown_process(handle->tpl_disp_res_srm);
-    svt_shutdown_process(handle->rate_control_tasks_resource_ptr);
-    svt_shutdown_process(handle->rate_control_results_resource_ptr);
-    svt_shutdown_process(handle->enc_dec_tasks_resource_ptr);
-    svt_shutdown_process(handle->enc_dec_results_resource_ptr);
-    svt_shutdown_process(handle->entropy_coding_results_resource_ptr);
-    svt_shutdown_process(handle->dlf_results_resource_ptr);
-    svt_shutdown_process(handle->cdef_results_resource_ptr);
-    svt_shutdown_process(handle->rest_results_resource_ptr);
+    EbSystemResource *stage_resources[ENC_STAGE_RESOURCE_COUNT];
+    enc_get_stage_resources(handle, stage_resources);
+    for (uint32_t i = 0; i < ENC_STAGE_RESOURCE_COUNT; i++) svt_shutdown_process(stage_resources[i]);
 
     return EB_ErrorNone;
 }
 
+/**********************************
+* Stream reset
+**********************************/
+/* No stage holds an object or has one queued, so the stages only wait on their inputs. */
+static bool enc_pipeline_idle(const EbEncHandle *handle) {
+    EbSystemResource *stage_resources[ENC_STAGE_RESOURCE_COUNT];
+    enc_get_stage_resources(handle, stage_resources);
+    for (uint32_t i = 0; i < ENC_STAGE_RESOURCE_COUNT; i++) {
+        uint32_t queued, busy;
+        if (!stage_resources[i] || !stage_resources[i]->full_queue)
+            continue;
+        svt_system_resource_get_consumer_load(stage_resources[i], &queued, &busy);
+        if (queued || busy)
+            return false;
+    }
+    return true;
+}
+
+static EbErrorType enc_reset_resources(EbEncHandle *handle) {
+    // The stage resources, the input pool and the pools of each instance
+    EbSystemResource *resources[ENC_STAGE_RESOURCE_COUNT + 1 + 11 * EB_EncodeInstancesTotalCount];
+    uint32_t          count = ENC_STAGE_RESOURCE_COUNT;
+    enc_get_stage_resources(handle, resources);
+    resources[count++] = handle->input_y8b_buffer_resource_ptr;
+    for (uint32_t instance_index = 0; instance_index < handle->encode_instance_total_count; ++instance_index) {
+        resources[count++] = handle->scs_pool_ptr_array[instance_index];
+        resources[count++] = handle->picture_parent_control_set_pool_ptr_array[instance_index];
+        resources[count++] = handle->me_pool_ptr_array[instance_index];
+        resources[count++] = handle->picture_control_set_pool_ptr_array[instance_index];
+        resources[count++] = handle->enc_dec_pool_ptr_array[instance_index];
+        resources[count++] = handle->reference_picture_pool_ptr_array[instance_index];
+        resources[count++] = handle->pa_reference_picture_pool_ptr_array[instance_index];
+        resources[count++] = handle->tpl_reference_picture_pool_ptr_array[instance_index];
+        resources[count++] = handle->overlay_input_picture_pool_ptr_array ? handle->overlay_input_picture_pool_ptr_array[instance_index] : NULL;
+        resources[count++] = handle->output_stream_buffer_resource_ptr_array[instance_index];
+        resources[count++] = handle->output_recon_buffer_resource_ptr_array ? handle->output_recon_buffer_resource_ptr_array[instance_index] : NULL;
+    }
+    for (uint32_t i = 0; i < count; i++) {
+        if (!resources[i])
+            continue;
+        EbErrorType return_error = svt_system_resource_reset(resources[i]);
+        if (return_error != EB_ErrorNone)
+            return return_error;
+    }
+    return EB_ErrorNone;
+}
+
+// Destroys the private data of a stage context and constructs it again in place
+#define EB_RESET_CONTEXT(context_ptr, ctor, ...)                 \
+    do {                                                         \
+        (context_ptr)->dctor(context_ptr);                       \
+        memset((context_ptr), 0, sizeof(*(context_ptr)));        \
+        EbErrorType err = ctor(context_ptr, __VA_ARGS__);        \
+        if (err != EB_ErrorNone)                                 \
+            return err;                                          \
+    } while (0)
+
+/* Builds the state of the single-threaded stages and of the encode contexts
+ * the same way svt_av1_enc_init() did. */
+static EbErrorType enc_reset_stream_state(EbEncHandle *handle) {
+    for (uint32_t instance_index = 0; instance_index < handle->encode_instance_total_count; ++instance_index) {
+        SequenceControlSet *scs          = handle->scs_instance_array[instance_index]->scs;
+        EncodeContext      *enc_ctx      = handle->scs_instance_array[instance_index]->enc_ctx;
+        EbErrorType         return_error = svt_aom_encode_context_reset(enc_ctx);
+        if (return_error != EB_ErrorNone)
+            return return_error;
+        // Rate and QP updates sent with the pictures of the previous stream are dropped, the
+        // source size follows the resolution changes, which are kept
+        const uint32_t source_width  = scs->static_config.source_width;
+        const uint32_t source_height = scs->static_config.source_height;
+        scs->static_config               = handle->stream_config;
+        scs->static_config.source_width  = source_width;
+        scs->static_config.source_height = source_height;
+        EB_DESTROY_SEMAPHORE(scs->ref_buffer_available_semaphore);
+        EB_CREATE_SEMAPHORE(scs->ref_buffer_available_semaphore,
+            enc_ctx->ref_pic_list_length,
+            enc_ctx->ref_pic_list_length);
+    }
+
+    EB_RESET_CONTEXT(handle->resource_coordination_context_ptr,
+        svt_aom_resource_coordination_context_ctor,
+        handle);
+    EB_RESET_CONTEXT(handle->picture_decision_context_ptr,
+        svt_aom_picture_decision_context_ctor,
+        handle,
+        handle->scs_instance_array[0]->scs->calc_hist);
+    EB_RESET_CONTEXT(handle->initial_rate_control_context_ptr,
+        svt_aom_initial_rate_control_context_ctor,
+        handle);
+    EB_RESET_CONTEXT(handle->picture_manager_context_ptr,
+        svt_aom_picture_manager_context_ctor,
+        handle,
+        rate_control_port_lookup(RATE_CONTROL_INPUT_PORT_INLME, 0));
+    EB_RESET_CONTEXT(handle->rate_control_context_ptr,
+        svt_aom_rate_control_context_ctor,
+        handle,
+        EB_PictureDecisionProcessInitCount);
+    EB_RESET_CONTEXT(handle->packetization_context_ptr,
+        svt_aom_packetization_context_ctor,
+        handle,
+        rate_control_port_lookup(RATE_CONTROL_INPUT_PORT_PACKETIZATION, 0),
+        pic_mgr_port_lookup(PIC_MGR_INPUT_PORT_PACKETIZATION, 0),
+        EB_PictureDecisionProcessInitCount + EB_RateControlProcessInitCount);
+
+    handle->eos_received       = false;
+    handle->eos_sent           = false;
+    handle->frame_received     = false;
+    handle->is_prev_valid      = true;
+    handle->first_picture_sent = false;
+    return EB_ErrorNone;
+}
+
+EbErrorType svt_aom_enc_handle_reset(EbComponentType *svt_enc_component) {
+    EbEncHandle *handle = svt_enc_component->p_component_private;
+    if (!handle->stage_gate)
+        return EB_ErrorBadParameter;
+
+    if (handle->frame_received) {
+        if (!handle->eos_received)
+            svt_aom_enc_handle_send_picture(svt_enc_component, &(EbBufferHeaderType){.flags = EB_BUFFERFLAG_EOS}, NULL, NULL);
+        EbErrorType return_error = enc_drain_queue(svt_enc_component);
+        if (return_error != EB_ErrorNone)
+            return return_error;
+    }
+    // A packet still held by the application would be handed out twice
+    EbSystemResourceStats output_stats;
+    svt_system_resource_get_stats(handle->output_stream_buffer_resource_ptr_array[0], &output_stats);
+    if (output_stats.in_use) {
+        SVT_ERROR("reset called before releasing every output packet\n");
+        return EB_ErrorBadParameter;
+    }
+
+    // Let the stages finish the tail of the previous stream, then stop them. The pipeline can only have drained
+    // once a stage thread ran out of work, and each of them posts the semaphore when it does
+    EbSystemResource *stage_resources[ENC_STAGE_RESOURCE_COUNT];
+    enc_get_stage_resources(handle, stage_resources);
+    // (a count above one would only repeat the check)
+    if (!handle->reset_idle_semaphore)
+        EB_CREATE_SEMAPHORE(handle->reset_idle_semaphore, 0, 1);
+    for (uint32_t i = 0; i < ENC_STAGE_RESOURCE_COUNT; i++)
+        svt_system_resource_set_idle_signal(stage_resources[i], handle->reset_idle_semaphore);
+    while (!enc_pipeline_idle(handle)) svt_block_on_semaphore(handle->reset_idle_semaphore);
+    for (uint32_t i = 0; i < ENC_STAGE_RESOURCE_COUNT; i++)
+        svt_system_resource_set_idle_signal(stage_resources[i], NULL);
+    svt_stage_gate_close(handle->stage_gate);
+    for (uint32_t i = 0; i < ENC_STAGE_RESOURCE_COUNT; i++) svt_shutdown_process(stage_resources[i]);
+    svt_stage_gate_wait_parked(handle->stage_gate);
+
+    const EbMemScope mem_scope    = svt_mem_set_scope((EbMemScope){handle->mem_account, SVT_AV1_MEM_OTHER});
+    EbErrorType      return_error = enc_reset_resources(handle);
+    if (return_error == EB_ErrorNone)
+        return_error = enc_reset_stream_state(handle);
+    svt_mem_set_scope(mem_scope);
+    if (handle->stage_balancer)
+        svt_stage_balancer_reset(handle->stage_balancer);
+    svt_stage_gate_open(handle->stage_gate);
+    return return_error;
+}
+
+EB_API EbErrorType svt_av1_enc_reset(EbComponentType *svt_enc_component) {
+    if (!svt_enc_component || !svt_enc_component->p_component_private)
+        return EB_ErrorBadParameter;
+
+    EbEncHandle *handle = svt_enc_component->p_component_private;
+    // Every lane resets its pipeline after each chunk
+    if (handle->chunk_encoder)
+        return svt_aom_chunk_encoder_flush(handle->chunk_encoder);
+    return svt_aom_enc_handle_reset(svt_enc_component);
+}
+
 static EbErrorType init_svt_av1_encoder_handle(
     EbComponentType * hComponent);
 /**********************************
@@ -2386,6 +2821,8 @@ EB_API EbErrorType svt_av1_enc_init_handle(
     if(p_handle == NULL)
          return EB_ErrorBadParameter;
     svt_log_init();
+    svt_trace_init();
+    svt_rtcd_profile_init();
 
     #if defined(__linux__)
         if(lp_group == NULL) {
@@ -2409,6 +2846,8 @@ EB_API EbErrorType svt_av1_enc_init_handle(
         svt_av1_enc_deinit(*p_handle);
         free(*p_handle);
         *p_handle = NULL;
+        svt_trace_deinit();
+        svt_rtcd_profile_deinit();
         return return_error;
     }
     svt_increase_component_count();
@@ -2424,7 +2863,9 @@ EbErrorType svt_av1_enc_component_de_init(EbComponentType  *svt_enc_component)
 
     if (svt_enc_component->p_component_private) {
         EbEncHandle* handle = (EbEncHandle*)svt_enc_component->p_component_private;
+        EbMemAccount *mem_account = handle->mem_account;
         EB_DELETE(handle);
+        svt_mem_account_release(mem_account);
         svt_enc_component->p_component_private = NULL;
     }
     else
@@ -2440,6 +2881,9 @@ EB_API EbErrorType svt_av1_enc_deinit_handle(
 {
     if (svt_enc_component) {
         EbErrorType return_error = svt_av1_enc_component_de_init(svt_enc_component);
+        // All the stage threads of the handle have exited
+        svt_trace_deinit();
+        svt_rtcd_profile_deinit();
 
         free(svt_enc_component);
 #if  defined(__linux__)
@@ -2451,6 +2895,55 @@ EB_API EbErrorType svt_av1_enc_deinit_handle(
     return EB_ErrorInvalidComponent;
 }
 
+/**********************************
+* svt_av1_enc_thread_pool_create
+**********************************/
+EB_API EbErrorType svt_av1_enc_thread_pool_create(
+    SvtAv1ThreadPool **pool,
+    uint32_t           core_count)
+{
+    if (pool == NULL)
+        return EB_ErrorBadParameter;
+    EbScheduler *scheduler;
+    EB_NEW(scheduler, svt_scheduler_ctor, core_count);
+    *pool = (SvtAv1ThreadPool *)scheduler;
+    return EB_ErrorNone;
+}
+
+/**********************************
+* svt_av1_enc_thread_pool_destroy
+**********************************/
+EB_API EbErrorType svt_av1_enc_thread_pool_destroy(
+    SvtAv1ThreadPool *pool)
+{
+    EbScheduler *scheduler = (EbScheduler *)pool;
+    if (scheduler == NULL)
+        return EB_ErrorBadParameter;
+    if (scheduler->channel_count) {
+        SVT_ERROR("thread pool destroyed while %u encoders are still attached\n", scheduler->channel_count);
+        return EB_ErrorUndefined;
+    }
+    EB_DELETE(scheduler);
+    return EB_ErrorNone;
+}
+
+/**********************************
+* svt_av1_enc_attach_thread_pool
+**********************************/
+EB_API EbErrorType svt_av1_enc_attach_thread_pool(
+    EbComponentType  *svt_enc_component,
+    SvtAv1ThreadPool *pool)
+{
+    if (svt_enc_component == NULL || svt_enc_component->p_component_private == NULL)
+        return EB_ErrorBadParameter;
+    EbEncHandle *enc_handle = (EbEncHandle *)svt_enc_component->p_component_private;
+    // The stage threads are registered with the scheduler when they are created at init
+    if (enc_handle->resource_coordination_thread_handle)
+        return EB_ErrorBadParameter;
+    enc_handle->thread_pool = (EbScheduler *)pool;
+    return EB_ErrorNone;
+}
+
 // Sets the default intra period the closest possible to 1 second without breaking the minigop
 static int32_t compute_default_intra_period(
     SequenceControlSet       *scs){
@@ -4202,6 +4695,25 @@ static void set_param_based_on_input(SequenceControlSet *scs)
 
     scs->max_heirachical_level = scs->static_config.hierarchical_levels;
 }
+/*
+* Fastest preset speed control may step to. The pools are sized for enc_mode, so it only steps to faster presets, up
+* to M10 (M9 for 4k and higher resolutions in Random Access mode) like enc_mode itself.
+*/
+static void set_speed_control_max_preset(SequenceControlSet *scs, EbInputResolution input_resolution) {
+    const EncMode supported_max_preset = scs->static_config.pred_structure == SVT_AV1_PRED_RANDOM_ACCESS &&
+            input_resolution >= INPUT_SIZE_4K_RANGE
+        ? ENC_M9
+        : ENC_M10;
+    EncMode max_preset = supported_max_preset;
+    if (scs->static_config.speed_control_max_preset >= 0) {
+        if (scs->speed_control_flag && scs->static_config.speed_control_max_preset > supported_max_preset)
+            SVT_WARN("Speed control max preset M%d is mapped to M%d, the highest supported preset\n",
+                     scs->static_config.speed_control_max_preset,
+                     supported_max_preset);
+        max_preset = MIN(max_preset, (EncMode)scs->static_config.speed_control_max_preset);
+    }
+    scs->speed_control_max_preset = MAX(max_preset, (EncMode)scs->static_config.enc_mode);
+}
 static void copy_api_from_app(
     SequenceControlSet       *scs,
     EbSvtAv1EncConfiguration   *config_struct){
@@ -4226,7 +4738,6 @@ static void copy_api_from_app(
     scs->pic_based_rate_est = false;
     scs->block_mean_calc_prec        = BLOCK_MEAN_PREC_SUB;
     scs->ten_bit_format = 0;
-    scs->speed_control_flag = 0;
 
     // Padding Offsets
     scs->b64_size = 64;
@@ -4374,6 +4885,14 @@ static void copy_api_from_app(
         }
     }
     scs->max_temporal_layers = scs->static_config.hierarchical_levels;
+    scs->static_config.speed_control = ((EbSvtAv1EncConfiguration*)config_struct)->speed_control;
+    scs->static_config.speed_control_max_preset = ((EbSvtAv1EncConfiguration*)config_struct)->speed_control_max_preset;
+    scs->speed_control_flag = scs->static_config.speed_control;
+    if (scs->speed_control_flag && scs->static_config.pass != ENC_SINGLE_PASS) {
+        scs->speed_control_flag = 0;
+        SVT_WARN("Speed control is only supported in single pass, the preset is fixed\n");
+    }
+    set_speed_control_max_preset(scs, input_resolution);
     scs->static_config.look_ahead_distance = ((EbSvtAv1EncConfiguration*)config_struct)->look_ahead_distance;
     scs->static_config.frame_rate_denominator = ((EbSvtAv1EncConfiguration*)config_struct)->frame_rate_denominator;
     scs->static_config.frame_rate_numerator = ((EbSvtAv1EncConfiguration*)config_struct)->frame_rate_numerator;
@@ -4459,6 +4978,19 @@ static void copy_api_from_app(
     }
     scs->static_config.pin_threads = ((EbSvtAv1EncConfiguration*)config_struct)->pin_threads;
     scs->static_config.target_socket = ((EbSvtAv1EncConfiguration*)config_struct)->target_socket;
+    scs->static_config.scheduler_mode = ((EbSvtAv1EncConfiguration*)config_struct)->scheduler_mode;
+    scs->static_config.numa_policy = ((EbSvtAv1EncConfiguration*)config_struct)->numa_policy;
+    scs->static_config.stage_rebalance = ((EbSvtAv1EncConfiguration*)config_struct)->stage_rebalance;
+    scs->static_config.pool_growth = ((EbSvtAv1EncConfiguration*)config_struct)->pool_growth;
+    scs->static_config.parallel_chunks = ((EbSvtAv1EncConfiguration*)config_struct)->parallel_chunks;
+    if (scs->static_config.parallel_chunks > 1 && scs->static_config.pass == ENC_FIRST_PASS) {
+        scs->static_config.parallel_chunks = 0;
+        SVT_WARN("Parallel chunks are not used in the first pass\n");
+    }
+    // The chunks share the cores of the handle through its scheduler
+    if (scs->static_config.parallel_chunks > 1)
+        scs->static_config.scheduler_mode = 1;
+    scs->static_config.export_analysis = ((EbSvtAv1EncConfiguration*)config_struct)->export_analysis;
     scs->static_config.qp = ((EbSvtAv1EncConfiguration*)config_struct)->qp;
     scs->static_config.recon_enabled = ((EbSvtAv1EncConfiguration*)config_struct)->recon_enabled;
     scs->static_config.enable_tpl_la = ((EbSvtAv1EncConfiguration*)config_struct)->enable_tpl_la;
@@ -4568,14 +5100,10 @@ static void copy_api_from_app(
 
 * Set Parameter
 **********************************/
-EB_API EbErrorType svt_av1_enc_set_parameter(
-    EbComponentType              *svt_enc_component,
+static EbErrorType set_parameter(
+    EbEncHandle                  *enc_handle,
     EbSvtAv1EncConfiguration     *config_struct)
 {
-    if(svt_enc_component == NULL)
-        return EB_ErrorBadParameter;
-
-    EbEncHandle        *enc_handle  = (EbEncHandle*)svt_enc_component->p_component_private;
     uint32_t              instance_index = 0;
     copy_api_from_app(
         enc_handle->scs_instance_array[instance_index]->scs,
@@ -4614,6 +5142,19 @@ EB_API EbErrorType svt_av1_enc_set_parameter(
 
     return return_error;
 }
+EB_API EbErrorType svt_av1_enc_set_parameter(
+    EbComponentType              *svt_enc_component,
+    EbSvtAv1EncConfiguration     *config_struct)
+{
+    if(svt_enc_component == NULL)
+        return EB_ErrorBadParameter;
+
+    EbEncHandle     *enc_handle   = (EbEncHandle*)svt_enc_component->p_component_private;
+    const EbMemScope mem_scope    = svt_mem_set_scope((EbMemScope){enc_handle->mem_account, SVT_AV1_MEM_OTHER});
+    EbErrorType      return_error = set_parameter(enc_handle, config_struct);
+    svt_mem_set_scope(mem_scope);
+    return return_error;
+}
 EB_API EbErrorType svt_av1_enc_stream_header(
     EbComponentType           *svt_enc_component,
     EbBufferHeaderType        **output_stream_ptr)
@@ -4647,6 +5188,8 @@ EB_API EbErrorType svt_av1_enc_stream_header(
     output_stream_buffer->p_app_private = NULL;
     output_stream_buffer->pic_type = EB_AV1_INVALID_PICTURE;
     output_stream_buffer->n_filled_len = 0;
+    memset(&output_stream_buffer->timestamps, 0, sizeof(output_stream_buffer->timestamps));
+    output_stream_buffer->analysis = NULL;
 
     ((OutputBitstreamUnit *)bitstream.output_bitstream_ptr)->buffer_begin_av1 = output_stream_buffer->p_buffer;
 
@@ -4996,6 +5539,30 @@ static EbErrorType copy_frame_buffer(
     return return_error;
 }
 
+static bool motion_hints_valid(const SvtAv1MotionHints *hints) {
+    return (hints->block_size == 8 || hints->block_size == 16 || hints->block_size == 32 ||
+            hints->block_size == 64) &&
+        (hints->trust == SVT_AV1_MV_HINT_SEED || hints->trust == SVT_AV1_MV_HINT_REPLACE_HME) &&
+        hints->cols && hints->rows && hints->mv;
+}
+// Copies the motion hints and their field in a single allocation, freed with the node
+static EbErrorType copy_motion_hints(EbPrivDataNode *dst, const EbPrivDataNode *src) {
+    const SvtAv1MotionHints *src_hints = (const SvtAv1MotionHints *)src->data;
+    // Invalid hints were reported at validation, they are passed without field and ignored
+    const bool   valid   = src->size == sizeof(*src_hints) && src_hints && motion_hints_valid(src_hints);
+    const size_t mv_size = valid ? sizeof(*src_hints->mv) * 2 * src_hints->cols * src_hints->rows : 0;
+    SvtAv1MotionHints *hints;
+    EB_MALLOC(hints, sizeof(*hints) + mv_size);
+    if (valid) {
+        *hints    = *src_hints;
+        hints->mv = (int16_t *)(hints + 1);
+        memcpy(hints->mv, src_hints->mv, mv_size);
+    } else
+        memset(hints, 0, sizeof(*hints));
+    dst->data = hints;
+    dst->size = sizeof(*hints);
+    return EB_ErrorNone;
+}
 static EbErrorType copy_private_data_list(EbBufferHeaderType* dst, EbBufferHeaderType* src) {
     EbErrorType return_error = EB_ErrorNone;
     EbPrivDataNode* p_src_node = (EbPrivDataNode*)src->p_app_private;
@@ -5021,6 +5588,10 @@ static EbErrorType copy_private_data_list(EbBufferHeaderType* dst, EbBufferHeade
         // not copy data from the private data pass through the encoder
         if (p_src_node->node_type == PRIVATE_DATA || p_src_node->node_type == ROI_MAP_EVENT) {
             p_new_node->data = p_src_node->data;
+        } else if (p_src_node->node_type == MV_HINT_EVENT) {
+            return_error = copy_motion_hints(p_new_node, p_src_node);
+            if (return_error != EB_ErrorNone)
+                return return_error;
         } else {
             EB_MALLOC(p_new_node->data, p_src_node->size);
             memcpy(p_new_node->data, p_src_node->data, p_src_node->size);
@@ -5206,12 +5777,74 @@ static void memset_input_buffer(SequenceControlSet* scs, EbBufferHeaderType* dst
         dst->p_app_private = NULL;
 }
 
+/*
+  Frame planes lent by the application with svt_av1_enc_send_picture_zero_copy().
+  The luma 8bit buffer and the chroma buffer of the picture each hold a
+  reference in their wrapper_ptr, which the library input buffers do not use
+  otherwise, and the planes are handed back once both buffers are recycled.
+*/
+typedef struct EbInputLend {
+    SvtAv1InputRelease release;
+    void              *opaque;
+    volatile int32_t   ref_count;
+    // Buffers of the library descriptors replaced by the lent planes
+    EbByte own_buffer_y;
+    EbByte own_buffer_cb;
+    EbByte own_buffer_cr;
+} EbInputLend;
+
+static void input_lend_release(EbInputLend *lend) {
+    if (svt_atomic_fetch_add_i32(&lend->ref_count, -1) == 1) {
+        lend->release(lend->opaque);
+        EB_FREE(lend);
+    }
+}
+
+// The 10bit input is split into 8bit and 2bit planes, and the first pass may downsample it
+static bool input_lend_supported(SequenceControlSet *scs) {
+    return scs->static_config.encoder_bit_depth == EB_EIGHT_BIT && !scs->first_pass_ctrls.ds;
+}
+
+/*
+ Reference the planes of a lent frame from the library buffers, fails when
+ the frame does not follow the input layout
+*/
+static EbErrorType lend_frame_buffer(SequenceControlSet *scs, EbBufferHeaderType *dst, EbBufferHeaderType *dst_y8b,
+                                     EbBufferHeaderType *src, SvtAv1InputRelease release, void *opaque) {
+    EbPictureBufferDesc *input_pic             = (EbPictureBufferDesc*)dst->p_buffer;
+    EbPictureBufferDesc *y8b_input_picture_ptr = (EbPictureBufferDesc*)dst_y8b->p_buffer;
+    EbSvtIOFormat       *input_ptr             = (EbSvtIOFormat*)src->p_buffer;
+
+    if (!input_lend_supported(scs) || input_ptr == NULL || input_ptr->y_stride != y8b_input_picture_ptr->stride_y ||
+        input_ptr->cb_stride != input_pic->stride_cb || input_ptr->cr_stride != input_pic->stride_cr)
+        return EB_ErrorBadParameter;
+
+    EbInputLend *lend;
+    EB_MALLOC(lend, sizeof(*lend));
+    lend->release       = release;
+    lend->opaque        = opaque;
+    lend->ref_count     = 2;
+    lend->own_buffer_y  = y8b_input_picture_ptr->buffer_y;
+    lend->own_buffer_cb = input_pic->buffer_cb;
+    lend->own_buffer_cr = input_pic->buffer_cr;
+
+    // Same offsets as copy_frame_buffer()
+    const uint32_t luma_buffer_offset   = input_pic->stride_y * scs->top_padding + scs->left_padding;
+    const uint32_t chroma_buffer_offset = input_pic->stride_cr * (scs->top_padding >> 1) + (scs->left_padding >> 1);
+    y8b_input_picture_ptr->buffer_y     = input_ptr->luma - luma_buffer_offset;
+    input_pic->buffer_cb                = input_ptr->cb - chroma_buffer_offset;
+    input_pic->buffer_cr                = input_ptr->cr - chroma_buffer_offset;
+    dst_y8b->wrapper_ptr                = lend;
+    dst->wrapper_ptr                    = lend;
+    return EB_ErrorNone;
+}
+
 /*
  Copy the input buffer header content
 from the sample application to the library buffers
 */
 static void copy_input_buffer(SequenceControlSet* scs, EbBufferHeaderType* dst,
-                              EbBufferHeaderType* dst_y8b, EbBufferHeaderType* src, int pass) {
+                              EbBufferHeaderType* dst_y8b, EbBufferHeaderType* src, int pass, bool lent) {
     // Copy the higher level structure
     dst->n_alloc_len  = src->n_alloc_len;
     dst->n_filled_len = src->n_filled_len;
@@ -5231,7 +5864,9 @@ static void copy_input_buffer(SequenceControlSet* scs, EbBufferHeaderType* dst,
         // Bypass copy for the unecessary picture in IPPP pass
         // Copy the picture buffer
         if (src->p_buffer != NULL) {
-            copy_frame_buffer(scs, dst->p_buffer, dst_y8b->p_buffer, src->p_buffer, pass);
+            // Lent planes are already referenced by dst and dst_y8b
+            if (!lent)
+                copy_frame_buffer(scs, dst->p_buffer, dst_y8b->p_buffer, src->p_buffer, pass);
             // Copy the metadata array
             if (svt_aom_copy_metadata_buffer(dst, src->metadata) != EB_ErrorNone)
                 dst->metadata = NULL;
@@ -5345,6 +5980,14 @@ static EbErrorType validate_on_the_fly_settings(EbBufferHeaderType *input_ptr, S
                 return EB_ErrorBadParameter;
             }
         }
+        else if (node->node_type == MV_HINT_EVENT) {
+            const SvtAv1MotionHints *node_data = (const SvtAv1MotionHints *)node->data;
+            if (node->size != sizeof(*node_data) || !node_data || !motion_hints_valid(node_data)) {
+                input_ptr->flags = EB_BUFFERFLAG_EOS;
+                SVT_ERROR("Motion hints require a block size of 8, 16, 32 or 64, a trust level of 1 or 2 and a non-empty field\n");
+                return EB_ErrorBadParameter;
+            }
+        }
         node = node->next;
     }
     return EB_ErrorNone;
@@ -5352,19 +5995,22 @@ static EbErrorType validate_on_the_fly_settings(EbBufferHeaderType *input_ptr, S
 /**********************************
 * Empty This Buffer
 **********************************/
-EB_API EbErrorType svt_av1_enc_send_picture(
+EbErrorType svt_aom_enc_handle_send_picture(
     EbComponentType      *svt_enc_component,
-    EbBufferHeaderType   *p_buffer)
+    EbBufferHeaderType   *p_buffer,
+    SvtAv1InputRelease    release,
+    void                 *opaque)
 {
     EbErrorType     return_val = EB_ErrorNone;
     EbEncHandle          *enc_handle_ptr = (EbEncHandle*)svt_enc_component->p_component_private;
     EbObjectWrapper      *eb_wrapper_ptr;
     EbBufferHeaderType   *app_hdr = p_buffer;
     enc_handle_ptr->frame_received = true;
+    // The input pictures are reallocated here when the resolution changes
+    const EbMemScope mem_scope = svt_mem_set_scope((EbMemScope){enc_handle_ptr->mem_account, SVT_AV1_MEM_PICTURE_BUFFERS});
 
-    static bool is_first_picture_sent = 0;
     // Check if a picture has already been sent and AVIF mode is used
-    if ( enc_handle_ptr->scs_instance_array[0]->scs->static_config.avif && is_first_picture_sent ) {
+    if ( enc_handle_ptr->scs_instance_array[0]->scs->static_config.avif && enc_handle_ptr->first_picture_sent ) {
         p_buffer->flags = EB_BUFFERFLAG_EOS;
         p_buffer->pic_type = EB_AV1_INVALID_PICTURE;
         enc_handle_ptr->eos_received = 1;
@@ -5445,12 +6091,17 @@ EB_API EbErrorType svt_av1_enc_send_picture(
             enc_handle_ptr->is_prev_valid = false;
         }
         else {
+            // Reference the planes of a lent frame, copy them otherwise
+            const bool lent = release && lend_frame_buffer(scs, lib_reg_hdr, lib_y8b_hdr, app_hdr, release, opaque) == EB_ErrorNone;
+            if (lent)
+                release = NULL;
             copy_input_buffer(
                 enc_handle_ptr->scs_instance_array[0]->scs,
                 lib_reg_hdr,
                 lib_y8b_hdr,
                 app_hdr,
-                0);
+                0,
+                lent);
         }
     }
 
@@ -5465,9 +6116,37 @@ EB_API EbErrorType svt_av1_enc_send_picture(
     input_cmd_obj->y8b_wrapper = y8b_wrapper;
     //Send to Lib
     svt_post_full_object(input_cmd_wrp);
-    is_first_picture_sent = 1;
+    enc_handle_ptr->first_picture_sent = true;
+    svt_mem_set_scope(mem_scope);
+    // The frame was copied
+    if (release)
+        release(opaque);
     return return_val;
 }
+
+EB_API EbErrorType svt_av1_enc_send_picture(
+    EbComponentType      *svt_enc_component,
+    EbBufferHeaderType   *p_buffer)
+{
+    EbEncHandle *enc_handle = (EbEncHandle*)svt_enc_component->p_component_private;
+    if (enc_handle->chunk_encoder)
+        return svt_aom_chunk_encoder_send_picture(enc_handle->chunk_encoder, p_buffer, NULL, NULL);
+    return svt_aom_enc_handle_send_picture(svt_enc_component, p_buffer, NULL, NULL);
+}
+
+EB_API EbErrorType svt_av1_enc_send_picture_zero_copy(
+    EbComponentType      *svt_enc_component,
+    EbBufferHeaderType   *p_buffer,
+    SvtAv1InputRelease    release,
+    void                 *opaque)
+{
+    if (release == NULL)
+        return EB_ErrorBadParameter;
+    EbEncHandle *enc_handle = (EbEncHandle*)svt_enc_component->p_component_private;
+    if (enc_handle->chunk_encoder)
+        return svt_aom_chunk_encoder_send_picture(enc_handle->chunk_encoder, p_buffer, release, opaque);
+    return svt_aom_enc_handle_send_picture(svt_enc_component, p_buffer, release, opaque);
+}
 static void copy_output_recon_buffer(
     EbBufferHeaderType   *dst,
     EbBufferHeaderType   *src
@@ -5495,23 +6174,15 @@ static void copy_output_recon_buffer(
     return;
 }
 
-/**********************************
-* svt_av1_enc_get_packet sends out packet
-**********************************/
-EB_API EbErrorType svt_av1_enc_get_packet(
+EbErrorType svt_aom_enc_handle_get_packet(
     EbComponentType      *svt_enc_component,
     EbBufferHeaderType  **p_buffer,
-    unsigned char          pic_send_done)
+    bool                  blocking)
 {
     EbErrorType             return_error = EB_ErrorNone;
     EbEncHandle          *enc_handle = (EbEncHandle*)svt_enc_component->p_component_private;
     EbObjectWrapper      *eb_wrapper_ptr = NULL;
     EbBufferHeaderType    *packet;
-    const EbSvtAv1EncConfiguration* cfg = &enc_handle->scs_instance_array[0]->scs->static_config;
-
-    // check if the user is claiming that the last picture has been sent
-    // without actually signalling it through svt_av1_enc_send_picture()
-    assert(!(!enc_handle->eos_received && pic_send_done));
 
     // if we have already sent out an EOS, then the user should not be calling
     // this function again, as it will just block inside svt_get_full_object()
@@ -5520,7 +6191,7 @@ EB_API EbErrorType svt_av1_enc_get_packet(
         return EB_NoErrorEmptyQueue;
     }
 
-    if (pic_send_done || cfg->pred_structure == SVT_AV1_PRED_LOW_DELAY_B)
+    if (blocking)
         svt_get_full_object(
             enc_handle->output_stream_buffer_consumer_fifo_ptr,
             &eb_wrapper_ptr);
@@ -5547,6 +6218,29 @@ EB_API EbErrorType svt_av1_enc_get_packet(
     return return_error;
 }
 
+/**********************************
+* svt_av1_enc_get_packet sends out packet
+**********************************/
+EB_API EbErrorType svt_av1_enc_get_packet(
+    EbComponentType      *svt_enc_component,
+    EbBufferHeaderType  **p_buffer,
+    unsigned char          pic_send_done)
+{
+    EbEncHandle          *enc_handle = (EbEncHandle*)svt_enc_component->p_component_private;
+    const EbSvtAv1EncConfiguration* cfg = &enc_handle->scs_instance_array[0]->scs->static_config;
+
+    if (enc_handle->chunk_encoder) {
+        assert(!(!enc_handle->chunk_encoder->eos_received && pic_send_done));
+        return svt_aom_chunk_encoder_get_packet(enc_handle->chunk_encoder, p_buffer, pic_send_done);
+    }
+    // check if the user is claiming that the last picture has been sent
+    // without actually signalling it through svt_av1_enc_send_picture()
+    assert(!(!enc_handle->eos_received && pic_send_done));
+
+    return svt_aom_enc_handle_get_packet(
+        svt_enc_component, p_buffer, pic_send_done || cfg->pred_structure == SVT_AV1_PRED_LOW_DELAY_B);
+}
+
 EB_API void svt_av1_enc_release_out_buffer(
     EbBufferHeaderType  **p_buffer)
 {
@@ -5554,12 +6248,52 @@ EB_API void svt_av1_enc_release_out_buffer(
     {
         if((*p_buffer)->p_buffer)
            EB_FREE((*p_buffer)->p_buffer);
+        svt_aom_free_analysis_export(&(*p_buffer)->analysis);
         // Release out put buffer back into the pool
         svt_release_object((EbObjectWrapper  *)(*p_buffer)->wrapper_ptr);
      }
     return;
 }
 
+/**********************************
+* svt_av1_enc_set_packet_writer
+**********************************/
+EB_API EbErrorType svt_av1_enc_set_packet_writer(
+    EbComponentType          *svt_enc_component,
+    const SvtAv1PacketWriter *writer)
+{
+    if (svt_enc_component == NULL || writer == NULL || writer->write == NULL)
+        return EB_ErrorBadParameter;
+    EbEncHandle *enc_handle = (EbEncHandle*)svt_enc_component->p_component_private;
+    if (enc_handle == NULL || enc_handle->input_cmd_resource_ptr) {
+        SVT_ERROR("svt_av1_enc_set_packet_writer must be called before svt_av1_enc_init\n");
+        return EB_ErrorBadParameter;
+    }
+    enc_handle->scs_instance_array[0]->enc_ctx->packet_writer = *writer;
+    return EB_ErrorNone;
+}
+
+/**********************************
+* svt_av1_enc_set_output_notify
+**********************************/
+EB_API EbErrorType svt_av1_enc_set_output_notify(
+    EbComponentType    *svt_enc_component,
+    SvtAv1OutputNotify  notify,
+    void               *opaque)
+{
+    if (svt_enc_component == NULL)
+        return EB_ErrorBadParameter;
+    EbEncHandle *enc_handle = (EbEncHandle*)svt_enc_component->p_component_private;
+    if (enc_handle == NULL || enc_handle->input_cmd_resource_ptr) {
+        SVT_ERROR("svt_av1_enc_set_output_notify must be called before svt_av1_enc_init\n");
+        return EB_ErrorBadParameter;
+    }
+    EncodeContext *enc_ctx        = enc_handle->scs_instance_array[0]->enc_ctx;
+    enc_ctx->output_notify        = notify;
+    enc_ctx->output_notify_opaque = opaque;
+    return EB_ErrorNone;
+}
+
 /**********************************
 * Fill This Buffer
 **********************************/
@@ -5622,6 +6356,9 @@ static void lib_svt_encoder_send_error_exit(
     output_packet->p_buffer   = NULL;
 
     svt_post_full_object(eb_wrapper_ptr);
+    EncodeContext *enc_ctx = enc_handle->scs_instance_array[0]->enc_ctx;
+    if (enc_ctx->output_notify)
+        enc_ctx->output_notify(enc_ctx->output_notify_opaque);
 }
 
 EB_API const char *svt_av1_get_version(void) {
@@ -5673,7 +6410,17 @@ static EbErrorType init_svt_av1_encoder_handle(
     // Set Component Size & Version
     svt_enc_component->size = sizeof(EbComponentType);
 
-    EB_NEW(handle, svt_enc_handle_ctor, svt_enc_component);
+    EbMemAccount *mem_account = svt_mem_account_create();
+    if (!mem_account)
+        return EB_ErrorInsufficientResources;
+    const EbMemScope mem_scope = svt_mem_set_scope((EbMemScope){mem_account, SVT_AV1_MEM_OTHER});
+    EB_NO_THROW_NEW(handle, svt_enc_handle_ctor, svt_enc_component);
+    svt_mem_set_scope(mem_scope);
+    if (!handle) {
+        svt_mem_account_release(mem_account);
+        return EB_ErrorInsufficientResources;
+    }
+    handle->mem_account = mem_account;
     svt_enc_component->p_component_private = handle;
 
     return return_error;
@@ -5809,11 +6556,25 @@ EbErrorType svt_input_y8b_creator(
 
     return EB_ErrorNone;
 }
+/*
+  return the planes a luma 8bit buffer was lent
+*/
+static void svt_input_y8b_recycler(EbPtr p)
+{
+    EbBufferHeaderType *obj  = (EbBufferHeaderType*)p;
+    EbInputLend        *lend = (EbInputLend*)obj->wrapper_ptr;
+    if (lend) {
+        ((EbPictureBufferDesc*)obj->p_buffer)->buffer_y = lend->own_buffer_y;
+        obj->wrapper_ptr = NULL;
+        input_lend_release(lend);
+    }
+}
 /*
   free a luma 8bit buffer descriptor
 */
 void svt_input_y8b_destroyer(EbPtr p)
 {
+    svt_input_y8b_recycler(p);
     EbBufferHeaderType *obj = (EbBufferHeaderType*)p;
     EbPictureBufferDesc* buf = (EbPictureBufferDesc*)obj->p_buffer;
     if (buf) {
@@ -5854,8 +6615,25 @@ EbErrorType svt_input_buffer_header_creator(
     return EB_ErrorNone;
 }
 
+/*
+  return the chroma planes an input buffer was lent
+*/
+static void svt_input_buffer_header_recycler(EbPtr p)
+{
+    EbBufferHeaderType *obj  = (EbBufferHeaderType*)p;
+    EbInputLend        *lend = (EbInputLend*)obj->wrapper_ptr;
+    if (lend) {
+        EbPictureBufferDesc *buf = (EbPictureBufferDesc*)obj->p_buffer;
+        buf->buffer_cb   = lend->own_buffer_cb;
+        buf->buffer_cr   = lend->own_buffer_cr;
+        obj->wrapper_ptr = NULL;
+        input_lend_release(lend);
+    }
+}
+
 void svt_input_buffer_header_destroyer(    EbPtr p)
 {
+    svt_input_buffer_header_recycler(p);
     EbBufferHeaderType *obj = (EbBufferHeaderType*)p;
     EbPictureBufferDesc* buf = (EbPictureBufferDesc*)obj->p_buffer;
     if (buf) {
@@ -5962,6 +6740,93 @@ void svt_output_recon_buffer_header_destroyer(    EbPtr p)
     EB_FREE(obj);
 }
 
+static void get_pipeline_stats(EbEncHandle *enc_handle, SvtAv1PipelineStats *stats) {
+    const EbSystemResource *stage_input[SVT_AV1_STAGE_COUNT] = {
+        [SVT_AV1_STAGE_RESOURCE_COORDINATION]   = enc_handle->input_cmd_resource_ptr,
+        [SVT_AV1_STAGE_PICTURE_ANALYSIS]        = enc_handle->resource_coordination_results_resource_ptr,
+        [SVT_AV1_STAGE_PICTURE_DECISION]        = enc_handle->picture_analysis_results_resource_ptr,
+        [SVT_AV1_STAGE_MOTION_ESTIMATION]       = enc_handle->picture_decision_results_resource_ptr,
+        [SVT_AV1_STAGE_INITIAL_RATE_CONTROL]    = enc_handle->motion_estimation_results_resource_ptr,
+        [SVT_AV1_STAGE_SOURCE_BASED_OPERATIONS] = enc_handle->initial_rate_control_results_resource_ptr,
+        [SVT_AV1_STAGE_TPL]                     = enc_handle->tpl_disp_res_srm,
+        [SVT_AV1_STAGE_PICTURE_MANAGER]         = enc_handle->picture_demux_results_resource_ptr,
+        [SVT_AV1_STAGE_RATE_CONTROL]            = enc_handle->rate_control_tasks_resource_ptr,
+        [SVT_AV1_STAGE_MODE_DECISION_CONFIG]    = enc_handle->rate_control_results_resource_ptr,
+        [SVT_AV1_STAGE_ENC_DEC]                 = enc_handle->enc_dec_tasks_resource_ptr,
+        [SVT_AV1_STAGE_DLF]                     = enc_handle->enc_dec_results_resource_ptr,
+        [SVT_AV1_STAGE_CDEF]                    = enc_handle->dlf_results_resource_ptr,
+        [SVT_AV1_STAGE_RESTORATION]             = enc_handle->cdef_results_resource_ptr,
+        [SVT_AV1_STAGE_ENTROPY_CODING]          = enc_handle->rest_results_resource_ptr,
+        [SVT_AV1_STAGE_PACKETIZATION]           = enc_handle->entropy_coding_results_resource_ptr,
+    };
+    memset(stats, 0, sizeof(*stats));
+    for (int i = 0; i < SVT_AV1_STAGE_COUNT; i++) {
+        if (!stage_input[i])
+            continue;
+        EbSystemResourceStats srm;
+        svt_system_resource_get_stats(stage_input[i], &srm);
+        stats->stage[i].thread_count = srm.process_count;
+        stats->stage[i].queue_depth  = srm.queued;
+        stats->stage[i].busy_threads = srm.busy;
+        stats->stage[i].task_count   = srm.task_count;
+        stats->stage[i].busy_time_us = srm.busy_time / 1000;
+    }
+    // Every input picture holds its input buffer from svt_av1_enc_send_picture() until its packet is out
+    EbSystemResourceStats srm;
+    svt_system_resource_get_stats(enc_handle->input_buffer_resource_ptr, &srm);
+    stats->frames_in_flight = srm.in_use;
+}
+
+static void get_pool_stats(EbEncHandle *enc_handle, SvtAv1PoolStats *stats) {
+    const EbSystemResource *pool[SVT_AV1_POOL_COUNT] = {
+        [SVT_AV1_POOL_INPUT] = enc_handle->input_buffer_resource_ptr,
+    };
+    if (enc_handle->picture_parent_control_set_pool_ptr_array)
+        pool[SVT_AV1_POOL_PARENT_PCS] = enc_handle->picture_parent_control_set_pool_ptr_array[0];
+    if (enc_handle->picture_control_set_pool_ptr_array)
+        pool[SVT_AV1_POOL_PCS] = enc_handle->picture_control_set_pool_ptr_array[0];
+    if (enc_handle->me_pool_ptr_array)
+        pool[SVT_AV1_POOL_ME] = enc_handle->me_pool_ptr_array[0];
+    if (enc_handle->reference_picture_pool_ptr_array)
+        pool[SVT_AV1_POOL_REFERENCE] = enc_handle->reference_picture_pool_ptr_array[0];
+    if (enc_handle->pa_reference_picture_pool_ptr_array)
+        pool[SVT_AV1_POOL_PA_REFERENCE] = enc_handle->pa_reference_picture_pool_ptr_array[0];
+    if (enc_handle->output_stream_buffer_resource_ptr_array)
+        pool[SVT_AV1_POOL_OUTPUT] = enc_handle->output_stream_buffer_resource_ptr_array[0];
+    memset(stats, 0, sizeof(*stats));
+    for (int i = 0; i < SVT_AV1_POOL_COUNT; i++) {
+        if (!pool[i])
+            continue;
+        EbSystemResourceStats srm;
+        svt_system_resource_get_stats(pool[i], &srm);
+        stats->pool[i].total_count     = pool[i]->object_total_count;
+        stats->pool[i].allocated_count = srm.created;
+        stats->pool[i].in_use          = srm.in_use;
+        stats->pool[i].blocked_count   = srm.wait_count;
+        stats->pool[i].blocked_time_us = srm.wait_time / 1000;
+    }
+}
+
+/*
+  layout of the frames lent to the encoder, read from the initial input buffers
+*/
+static EbErrorType get_input_layout(EbEncHandle *enc_handle, SvtAv1InputLayout *layout) {
+    SequenceControlSet *scs = enc_handle->scs_instance_array[0]->scs;
+    if (!input_lend_supported(scs))
+        return EB_ErrorBadParameter;
+    const EbBufferHeaderType  *y8b_hdr   = enc_handle->input_y8b_buffer_resource_ptr->wrapper_ptr_pool[0]->object_ptr;
+    const EbBufferHeaderType  *input_hdr = enc_handle->input_buffer_resource_ptr->wrapper_ptr_pool[0]->object_ptr;
+    const EbPictureBufferDesc *y8b_pic   = (EbPictureBufferDesc*)y8b_hdr->p_buffer;
+    const EbPictureBufferDesc *input_pic = (EbPictureBufferDesc*)input_hdr->p_buffer;
+    layout->luma_stride   = y8b_pic->stride_y;
+    layout->chroma_stride = input_pic->stride_cb;
+    layout->luma_offset   = y8b_pic->stride_y * scs->top_padding + scs->left_padding;
+    layout->chroma_offset = input_pic->stride_cr * (scs->top_padding >> 1) + (scs->left_padding >> 1);
+    layout->luma_size     = y8b_pic->luma_size;
+    layout->chroma_size   = input_pic->chroma_size;
+    return EB_ErrorNone;
+}
+
 /**********************************
 * svt_av1_enc_get_stream_info get stream information from encoder
 **********************************/
@@ -5979,6 +6844,25 @@ EB_API EbErrorType svt_av1_enc_get_stream_info(EbComponentType *    svt_enc_comp
         first_pass_stats->sz = context->stats_out.size * sizeof(FIRSTPASS_STATS);
         return EB_ErrorNone;
     }
+    if (info == NULL)
+        return EB_ErrorBadParameter;
+    if (stream_info_id == SVT_AV1_STREAM_INFO_MEMORY_STATS) {
+        svt_mem_account_get_stats(enc_handle->mem_account, (SvtAv1MemoryStats*)info);
+        return EB_ErrorNone;
+    }
+    // The pools and queues are created by svt_av1_enc_init()
+    if (enc_handle->input_cmd_resource_ptr == NULL)
+        return EB_ErrorBadParameter;
+    if (stream_info_id == SVT_AV1_STREAM_INFO_PIPELINE_STATS) {
+        get_pipeline_stats(enc_handle, (SvtAv1PipelineStats*)info);
+        return EB_ErrorNone;
+    }
+    if (stream_info_id == SVT_AV1_STREAM_INFO_POOL_STATS) {
+        get_pool_stats(enc_handle, (SvtAv1PoolStats*)info);
+        return EB_ErrorNone;
+    }
+    if (stream_info_id == SVT_AV1_STREAM_INFO_INPUT_LAYOUT)
+        return get_input_layout(enc_handle, (SvtAv1InputLayout*)info);
     return EB_ErrorBadParameter;
 }
 // clang-format on
@@ -18,6 +18,10 @@
 #include "sys_resource_manager.h"
 #include "sequence_control_set.h"
 #include "object.h"
+#include "svt_scheduler.h"
+#include "stage_balancer.h"
+#include "stage_gate.h"
+#include "chunk_encoder.h"
 
 struct _EbThreadContext {
     EbDctor dctor;
@@ -76,6 +80,26 @@ struct _EbEncHandle {
 
     EbHandle packetization_thread_handle;
 
+    // Thread pool attached by the application, shared with other handles
+    EbScheduler *thread_pool;
+    // Scheduler owned by the handle when scheduler_mode is set and no pool is attached
+    EbScheduler *scheduler;
+    // Registration of the stage threads with the scheduler in use,
+    // NULL when every stage runs on dedicated threads
+    EbSchedulerChannel *scheduler_channel;
+    // Moves threads between stages at run time, NULL when stage_rebalance is off
+    EbStageBalancer *stage_balancer;
+    // Parks the stage threads between two streams, see svt_av1_enc_reset()
+    EbStageGate *stage_gate;
+    // Posted by the stages running out of work while svt_av1_enc_reset() waits for the pipeline to drain
+    EbHandle reset_idle_semaphore;
+    // Memory allocated for the handle, per category
+    EbMemAccount *mem_account;
+    // Splits the input into chunks encoded concurrently, NULL when parallel_chunks is off
+    EbChunkEncoder *chunk_encoder;
+    // Lane of the chunk encoder of another handle, configured with its parallel_chunks
+    bool chunk_lane;
+
     // Contexts
     EbThreadContext  *resource_coordination_context_ptr;
     EbThreadContext **picture_analysis_context_ptr_array;
@@ -130,6 +154,20 @@ struct _EbEncHandle {
     bool eos_sent; // used to signal we sent the EOS to the app
     bool frame_received; // used to signal we received any frame from the app
     bool is_prev_valid; // whether the previous input is valid or not
+    bool first_picture_sent; // used to signal a picture was sent in AVIF mode
+    // Configuration at the end of init, svt_av1_enc_reset() restores it to undo the on the fly changes
+    EbSvtAv1EncConfiguration stream_config;
 };
 void set_segments_numbers(SequenceControlSet *scs);
+
+EbErrorType svt_output_buffer_header_creator(EbPtr *object_dbl_ptr, EbPtr object_init_data_ptr);
+void        svt_output_buffer_header_destroyer(EbPtr p);
+
+/* Pipeline of the handle itself, the public calls go through the chunk
+ * encoder of the handle when it has one. */
+EbErrorType svt_aom_enc_handle_send_picture(EbComponentType *svt_enc_component, EbBufferHeaderType *p_buffer,
+                                            SvtAv1InputRelease release, void *opaque);
+EbErrorType svt_aom_enc_handle_get_packet(EbComponentType *svt_enc_component, EbBufferHeaderType **p_buffer,
+                                          bool blocking);
+EbErrorType svt_aom_enc_handle_reset(EbComponentType *svt_enc_component);
 #endif // EbEncHandle_h
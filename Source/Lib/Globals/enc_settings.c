@@ -470,6 +470,59 @@ EbErrorType svt_av1_verify_settings(SequenceControlSet *scs) {
         return_error = EB_ErrorBadParameter;
     }
 
+    if (config->scheduler_mode > 1) {
+        SVT_ERROR("Instance %u: Invalid scheduler_mode. scheduler_mode must be [0 - 1]\n", channel_number + 1);
+        return_error = EB_ErrorBadParameter;
+    }
+
+    if (config->numa_policy > 1) {
+        SVT_ERROR("Instance %u: Invalid numa_policy. numa_policy must be [0 - 1]\n", channel_number + 1);
+        return_error = EB_ErrorBadParameter;
+    }
+
+    if (config->stage_rebalance > 1) {
+        SVT_ERROR("Instance %u: Invalid stage_rebalance. stage_rebalance must be [0 - 1]\n", channel_number + 1);
+        return_error = EB_ErrorBadParameter;
+    }
+
+    if (config->pool_growth > 2) {
+        SVT_ERROR("Instance %u: Invalid pool_growth. pool_growth must be [0 - 2]\n", channel_number + 1);
+        return_error = EB_ErrorBadParameter;
+    }
+
+    if (config->speed_control > 1) {
+        SVT_ERROR("Instance %u: Invalid speed_control. speed_control must be [0 - 1]\n", channel_number + 1);
+        return_error = EB_ErrorBadParameter;
+    }
+
+    if (config->speed_control_max_preset < -1 || config->speed_control_max_preset > MAX_ENC_PRESET) {
+        SVT_ERROR("Instance %u: Invalid speed_control_max_preset. speed_control_max_preset must be [-1 - %d]\n",
+                  channel_number + 1,
+                  MAX_ENC_PRESET);
+        return_error = EB_ErrorBadParameter;
+    }
+
+    if (config->parallel_chunks > 16) {
+        SVT_ERROR("Instance %u: Invalid parallel_chunks. parallel_chunks must be [0 - 16]\n", channel_number + 1);
+        return_error = EB_ErrorBadParameter;
+    }
+
+    if (config->parallel_chunks > 1) {
+        if (config->pred_structure != SVT_AV1_PRED_RANDOM_ACCESS) {
+            SVT_ERROR("Instance %u: parallel_chunks is only supported with the random access prediction structure\n",
+                      channel_number + 1);
+            return_error = EB_ErrorBadParameter;
+        }
+        if (config->intra_refresh_type != SVT_AV1_KF_REFRESH) {
+            SVT_ERROR("Instance %u: parallel_chunks requires closed GOPs (intra_refresh_type 2)\n", channel_number + 1);
+            return_error = EB_ErrorBadParameter;
+        }
+        if (config->recon_enabled || config->avif) {
+            SVT_ERROR("Instance %u: parallel_chunks is not supported with recon output or avif\n", channel_number + 1);
+            return_error = EB_ErrorBadParameter;
+        }
+    }
+
     // HBD mode decision
     if (scs->enable_hbd_mode_decision < (int8_t)(-1) || scs->enable_hbd_mode_decision > 2) {
         SVT_ERROR("Instance %u: Invalid HBD mode decision flag [-1 - 2], your input: %d\n",
@@ -951,9 +1004,23 @@ EbErrorType svt_av1_set_default_params(EbSvtAv1EncConfiguration *config_ptr) {
     config_ptr->level_of_parallelism = 0;
     config_ptr->pin_threads          = 0;
     config_ptr->target_socket        = -1;
+    config_ptr->scheduler_mode       = 0;
+    config_ptr->numa_policy          = 0;
+    config_ptr->stage_rebalance      = 0;
+    config_ptr->pool_growth          = 0;
     config_ptr->channel_id           = 0;
     config_ptr->active_channel_count = 1;
 
+    // Speed control
+    config_ptr->speed_control            = 0;
+    config_ptr->speed_control_max_preset = -1;
+
+    // Chunked encoding
+    config_ptr->parallel_chunks = 0;
+
+    // Analysis export
+    config_ptr->export_analysis = false;
+
     // Debug info
     config_ptr->recon_enabled = 0;
 
@@ -1989,6 +2056,12 @@ EB_API EbErrorType svt_av1_enc_parse_parameter(EbSvtAv1EncConfiguration *config_
         {"variance-boost-curve", &config_struct->variance_boost_curve},
         {"fast-decode", &config_struct->fast_decode},
         {"luminance-qp-bias", &config_struct->luminance_qp_bias},
+        {"scheduler-mode", &config_struct->scheduler_mode},
+        {"numa-policy", &config_struct->numa_policy},
+        {"stage-rebalance", &config_struct->stage_rebalance},
+        {"pool-growth", &config_struct->pool_growth},
+        {"speed-control", &config_struct->speed_control},
+        {"parallel-chunks", &config_struct->parallel_chunks},
         {"enable-tf", &config_struct->enable_tf},
         {"tf-strength", &config_struct->tf_strength},
     };
@@ -2063,6 +2136,7 @@ EB_API EbErrorType svt_av1_enc_parse_parameter(EbSvtAv1EncConfiguration *config_
         {"preset", &config_struct->enc_mode},
         {"sharpness", &config_struct->sharpness},
         {"startup-qp-offset", &config_struct->startup_qp_offset},
+        {"speed-control-max-preset", &config_struct->speed_control_max_preset},
     };
     const size_t int8_opts_size = sizeof(int8_opts) / sizeof(int8_opts[0]);
 
@@ -2095,6 +2169,7 @@ EB_API EbErrorType svt_av1_enc_parse_parameter(EbSvtAv1EncConfiguration *config_
         {"enable-variance-boost", &config_struct->enable_variance_boost},
         {"lossless", &config_struct->lossless},
         {"avif", &config_struct->avif},
+        {"export-analysis", &config_struct->export_analysis},
     };
     const size_t bool_opts_size = sizeof(bool_opts) / sizeof(bool_opts[0]);
 
@@ -0,0 +1,521 @@
+/*
+ * Copyright (c) 2025, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at https://www.aomedia.org/license/software-license. If the
+ * Alliance for Open Media Patent License 1.0 was not distributed with this
+ * source code in the PATENTS file, you can obtain it at
+ * https://www.aomedia.org/license/patent-license.
+ */
+
+/******************************************************************************
+ * @file DeblockFrameTest.cc
+ *
+ * @brief Unit test of the frame-level deblocking:
+ * - svt_av1_pick_filter_level (LPF_PICK_FROM_FULL_IMAGE)
+ * - svt_av1_loop_filter_frame
+ * which filter the frame as SB row and SB column jobs shared with helper
+ * threads, against the serial superblock order filter svt_aom_loop_filter_sb
+ * and a serial copy of the filter level search.
+ *
+ ******************************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+#include <thread>
+#include <vector>
+#include "gtest/gtest.h"
+#include "random.h"
+
+extern "C" {
+#include "deblocking_filter.h"
+#include "enc_dec_results.h"
+#include "pcs.h"
+#include "sequence_control_set.h"
+#include "sys_resource_manager.h"
+#include "svt_threads.h"
+}
+
+namespace {
+using svt_av1_test_tool::SVTRandom;
+
+/** setup_test_env is implemented in test/TestEnv.c */
+extern "C" void setup_test_env();
+
+static const uint32_t kWidth = 328;
+static const uint32_t kHeight = 200;
+static const uint32_t kPadding = 96;
+static const uint32_t kHelpers = 3;
+
+static EbErrorType dlf_results_creator(EbPtr *object_dbl_ptr,
+                                       EbPtr object_init_data_ptr) {
+    (void)object_init_data_ptr;
+    *object_dbl_ptr = calloc(1, sizeof(DlfResults));
+    return *object_dbl_ptr ? EB_ErrorNone : EB_ErrorInsufficientResources;
+}
+
+static void dlf_results_destroyer(EbPtr p) {
+    free(p);
+}
+
+static EbPictureBufferDesc *new_pic(uint32_t bit_depth) {
+    EbPictureBufferDescInitData init_data;
+    memset(&init_data, 0, sizeof(init_data));
+    init_data.max_width = kWidth;
+    init_data.max_height = kHeight;
+    init_data.bit_depth = (EbBitDepth)bit_depth;
+    init_data.buffer_enable_mask = PICTURE_BUFFER_DESC_FULL_MASK;
+    init_data.left_padding = kPadding;
+    init_data.right_padding = kPadding;
+    init_data.top_padding = kPadding;
+    init_data.bot_padding = kPadding;
+    init_data.color_format = EB_YUV420;
+    EbPictureBufferDesc *pic =
+        (EbPictureBufferDesc *)calloc(1, sizeof(EbPictureBufferDesc));
+    if (pic && svt_recon_picture_buffer_desc_ctor(pic, &init_data) !=
+                   EB_ErrorNone) {
+        free(pic);
+        return nullptr;
+    }
+    return pic;
+}
+
+static void delete_pic(EbPictureBufferDesc *pic) {
+    if (!pic)
+        return;
+    pic->dctor(pic);
+    free(pic);
+}
+
+/**
+ * The frame is filled with a blocky recon of a textured source, over a mode
+ * info grid of random 16x16 and 8x8 intra and inter blocks with random
+ * transform depths, so that all the filter lengths are used.
+ *
+ * The filter level search and the frame filter run once with the SB row and
+ * SB column jobs taken by the test and kHelpers helper threads, which stand
+ * for the CDEF processes, then once serially: the frame is filtered in
+ * superblock order by svt_aom_loop_filter_sb and the search is a copy of the
+ * library one. The chosen levels and the filtered frame must be identical.
+ */
+class DeblockFrameTest : public ::testing::TestWithParam<uint32_t> {
+  protected:
+    void SetUp() override {
+        setup_test_env();
+        bd_ = GetParam();
+        highbd_ = bd_ > 8;
+        bytes_ = highbd_ ? 2 : 1;
+
+        scs_ = (SequenceControlSet *)calloc(1, sizeof(SequenceControlSet));
+        ppcs_ = (PictureParentControlSet *)calloc(
+            1, sizeof(PictureParentControlSet));
+        pcs_ = (PictureControlSet *)calloc(1, sizeof(PictureControlSet));
+        enc_dec_ = (EncDecSet *)calloc(1, sizeof(EncDecSet));
+        pcs_wrapper_ = (EbObjectWrapper *)calloc(1, sizeof(EbObjectWrapper));
+        ASSERT_TRUE(scs_ && ppcs_ && pcs_ && enc_dec_ && pcs_wrapper_);
+        input_ = new_pic(bd_);
+        recon_ = new_pic(bd_);
+        ASSERT_TRUE(input_ && recon_);
+
+        scs_->seq_header.sb_size = BLOCK_64X64;
+        scs_->sb_size = 64;
+        scs_->super_block_size = 64;
+        scs_->max_input_luma_width = kWidth;
+        scs_->max_input_luma_height = kHeight;
+        scs_->subsampling_x = 1;
+        scs_->subsampling_y = 1;
+        scs_->is_16bit_pipeline = highbd_;
+        scs_->static_config.encoder_bit_depth = bd_;
+        scs_->static_config.encoder_color_format = EB_YUV420;
+        scs_->static_config.tune = 1;
+
+        ppcs_->scs = scs_;
+        ppcs_->aligned_width = kWidth;
+        ppcs_->aligned_height = kHeight;
+        ppcs_->render_width = kWidth;
+        ppcs_->render_height = kHeight;
+        ppcs_->enc_dec_ptr = enc_dec_;
+        ppcs_->frm_hdr.frame_type = KEY_FRAME;
+        ppcs_->frm_hdr.tx_mode = TX_MODE_SELECT;
+        if (highbd_)
+            enc_dec_->recon_pic_16bit = recon_;
+        else
+            enc_dec_->recon_pic = recon_;
+        if (highbd_)
+            pcs_->input_frame16bit = input_;
+        else
+            ppcs_->enhanced_pic = input_;
+
+        struct LoopFilter *lf = &ppcs_->frm_hdr.loop_filter_params;
+        static const int8_t ref_deltas[REF_FRAMES] = {
+            1, 0, 0, 0, -1, 0, -1, -1};
+        lf->mode_ref_delta_enabled = 1;
+        memcpy(lf->ref_deltas, ref_deltas, sizeof(ref_deltas));
+
+        pcs_->ppcs = ppcs_;
+        pcs_->scs = scs_;
+        pcs_->slice_type = I_SLICE;
+        pcs_wrapper_->object_ptr = pcs_;
+        pcs_->dlf_jobs.mutex = svt_create_mutex();
+        pcs_->dlf_jobs.done_semaphore = svt_create_semaphore(0, 1);
+        svt_av1_loop_filter_init(pcs_);
+
+        resource_ =
+            (EbSystemResource *)calloc(1, sizeof(EbSystemResource));
+        ASSERT_NE(resource_, nullptr);
+        ASSERT_EQ(EB_ErrorNone,
+                  svt_system_resource_ctor(resource_,
+                                           kHelpers,
+                                           1,
+                                           kHelpers,
+                                           dlf_results_creator,
+                                           nullptr,
+                                           dlf_results_destroyer));
+        for (uint32_t h = 0; h < kHelpers; h++) {
+            EbFifo *fifo = svt_system_resource_get_consumer_fifo(resource_, h);
+            helpers_.emplace_back([fifo]() {
+                for (;;) {
+                    EbObjectWrapper *wrapper = nullptr;
+                    svt_get_full_object(fifo, &wrapper);
+                    DlfResults *results = (DlfResults *)wrapper->object_ptr;
+                    EbObjectWrapper *pcs_wrapper = results->pcs_wrapper;
+                    if (pcs_wrapper)
+                        svt_av1_loop_filter_run_jobs(
+                            (PictureControlSet *)pcs_wrapper->object_ptr,
+                            results->lf_pass);
+                    svt_release_object(wrapper);
+                    if (!pcs_wrapper)
+                        break;
+                }
+            });
+        }
+        helper_fifo_ = svt_system_resource_get_producer_fifo(resource_, 0);
+    }
+
+    void TearDown() override {
+        if (resource_) {
+            for (size_t h = 0; h < helpers_.size(); h++) {
+                EbObjectWrapper *wrapper = nullptr;
+                svt_get_empty_object(helper_fifo_, &wrapper);
+                ((DlfResults *)wrapper->object_ptr)->pcs_wrapper = nullptr;
+                svt_post_full_object(wrapper);
+            }
+            for (std::thread &t : helpers_) t.join();
+            resource_->dctor(resource_);
+            free(resource_);
+        }
+        if (pcs_) {
+            svt_destroy_mutex(pcs_->dlf_jobs.mutex);
+            svt_destroy_semaphore(pcs_->dlf_jobs.done_semaphore);
+        }
+        delete_pic(input_);
+        delete_pic(recon_);
+        free(pcs_wrapper_);
+        free(enc_dec_);
+        free(pcs_);
+        free(ppcs_);
+        free(scs_);
+    }
+
+    uint8_t *plane_buffer(EbPictureBufferDesc *pic, int plane) {
+        return plane == 0 ? pic->buffer_y
+                          : plane == 1 ? pic->buffer_cb : pic->buffer_cr;
+    }
+
+    size_t plane_bytes(EbPictureBufferDesc *pic, int plane) {
+        return (plane == 0 ? pic->luma_size : pic->chroma_size) * bytes_;
+    }
+
+    void set_sample(EbPictureBufferDesc *pic, int plane, uint32_t x,
+                    uint32_t y, int32_t value) {
+        const uint32_t ss = plane ? 1 : 0;
+        const uint32_t stride = plane == 0 ? pic->stride_y : pic->stride_cb;
+        const size_t pos = ((pic->org_y >> ss) + y) * stride +
+                           (pic->org_x >> ss) + x;
+        value = value < 0 ? 0 : AOMMIN(value, (1 << bd_) - 1);
+        if (highbd_)
+            ((uint16_t *)plane_buffer(pic, plane))[pos] = (uint16_t)value;
+        else
+            plane_buffer(pic, plane)[pos] = (uint8_t)value;
+    }
+
+    void fill_frame(SVTRandom &rnd) {
+        const int32_t scale = 1 << (bd_ - 8);
+        for (int plane = 0; plane < 3; plane++) {
+            const uint32_t ss = plane ? 1 : 0;
+            const uint32_t w = kWidth >> ss, h = kHeight >> ss;
+            std::vector<int32_t> offset(((w + 7) / 8) * ((h + 7) / 8));
+            for (int32_t &o : offset) o = rnd.random() % 17 - 8;
+            for (uint32_t y = 0; y < h; y++) {
+                for (uint32_t x = 0; x < w; x++) {
+                    const int32_t src = 48 + (int32_t)((x * 3 + y * 2) % 160) +
+                                        rnd.random() % 4;
+                    const int32_t rec =
+                        src + offset[(y / 8) * ((w + 7) / 8) + x / 8] +
+                        rnd.random() % 3 - 1;
+                    set_sample(input_, plane, x, y, src * scale);
+                    set_sample(recon_, plane, x, y, rec * scale);
+                }
+            }
+        }
+    }
+
+    void fill_mode_info(SVTRandom &rnd) {
+        const uint32_t mi_cols = ((kWidth + 63) / 64) * 16;
+        const uint32_t mi_rows = ((kHeight + 63) / 64) * 16;
+        mode_info_.assign(mi_cols * mi_rows, ModeInfo());
+        mi_grid_.assign(mi_cols * mi_rows, nullptr);
+        size_t count = 0;
+        for (uint32_t r16 = 0; r16 < mi_rows; r16 += 4) {
+            for (uint32_t c16 = 0; c16 < mi_cols; c16 += 4) {
+                const bool split = rnd.random() & 1;
+                const uint32_t step = split ? 2 : 4;
+                for (uint32_t r = r16; r < r16 + 4; r += step) {
+                    for (uint32_t c = c16; c < c16 + 4; c += step) {
+                        ModeInfo *mi = &mode_info_[count++];
+                        BlockModeInfoEnc *b = &mi->mbmi.block_mi;
+                        const bool inter = rnd.random() & 1;
+                        b->bsize = split ? BLOCK_8X8 : BLOCK_16X16;
+                        b->tx_depth = rnd.random() % (split ? 2 : 3);
+                        b->ref_frame[0] = inter ? LAST_FRAME : INTRA_FRAME;
+                        b->ref_frame[1] = NONE_FRAME;
+                        b->mode = inter
+                                      ? (PredictionMode)(NEARESTMV +
+                                                         rnd.random() % 4)
+                                      : (PredictionMode)(rnd.random() %
+                                                         (PAETH_PRED + 1));
+                        b->skip = inter && (rnd.random() & 1);
+                        for (uint32_t y = r; y < r + step; y++)
+                            for (uint32_t x = c; x < c + step; x++)
+                                mi_grid_[y * mi_cols + x] = mi;
+                    }
+                }
+            }
+        }
+        pcs_->mi_grid_base = mi_grid_.data();
+        pcs_->mi_stride = mi_cols;
+    }
+
+    void save_frame(std::vector<uint8_t> frame[3]) {
+        for (int plane = 0; plane < 3; plane++)
+            frame[plane].assign(
+                plane_buffer(recon_, plane),
+                plane_buffer(recon_, plane) + plane_bytes(recon_, plane));
+    }
+
+    void restore_plane(const std::vector<uint8_t> frame[3], int plane) {
+        memcpy(plane_buffer(recon_, plane),
+               frame[plane].data(),
+               frame[plane].size());
+    }
+
+    void set_levels(const int32_t levels[4]) {
+        struct LoopFilter *lf = &ppcs_->frm_hdr.loop_filter_params;
+        lf->filter_level[0] = levels[0];
+        lf->filter_level[1] = levels[1];
+        lf->filter_level_u = levels[2];
+        lf->filter_level_v = levels[3];
+    }
+
+    void get_levels(int32_t levels[4]) {
+        struct LoopFilter *lf = &ppcs_->frm_hdr.loop_filter_params;
+        levels[0] = lf->filter_level[0];
+        levels[1] = lf->filter_level[1];
+        levels[2] = lf->filter_level_u;
+        levels[3] = lf->filter_level_v;
+    }
+
+    // Filter the planes in superblock order, as the SB based deblocking does
+    void serial_filter_frame(int32_t plane_start, int32_t plane_end) {
+        const uint32_t sb_cols = (kWidth + 63) / 64;
+        const uint32_t sb_rows = (kHeight + 63) / 64;
+        svt_av1_loop_filter_frame_init(&ppcs_->frm_hdr,
+                                       &ppcs_->lf_info,
+                                       plane_start,
+                                       plane_end);
+        for (uint32_t y = 0; y < sb_rows; y++)
+            for (uint32_t x = 0; x < sb_cols; x++)
+                svt_aom_loop_filter_sb(recon_,
+                                       pcs_,
+                                       y * 16,
+                                       x * 16,
+                                       plane_start,
+                                       plane_end,
+                                       x == sb_cols - 1);
+    }
+
+    // Serial copy of try_filter_frame() in deblocking_filter.c
+    int64_t serial_try_filter_frame(const std::vector<uint8_t> unfiltered[3],
+                                    int32_t filt_level, int32_t plane,
+                                    int32_t dir) {
+        struct LoopFilter *lf = &ppcs_->frm_hdr.loop_filter_params;
+        int32_t filter_level[2] = {filt_level, filt_level};
+        if (plane == 0 && dir == 0)
+            filter_level[1] = lf->filter_level[1];
+        if (plane == 0 && dir == 1)
+            filter_level[0] = lf->filter_level[0];
+        switch (plane) {
+        case 0:
+            lf->filter_level[0] = filter_level[0];
+            lf->filter_level[1] = filter_level[1];
+            break;
+        case 1: lf->filter_level_u = filter_level[0]; break;
+        case 2: lf->filter_level_v = filter_level[0]; break;
+        }
+        serial_filter_frame(plane, plane + 1);
+        const int64_t filt_err =
+            picture_sse_calculations(pcs_, recon_, plane);
+        restore_plane(unfiltered, plane);
+        return filt_err;
+    }
+
+    // Serial copy of search_filter_level() in deblocking_filter.c
+    int32_t serial_search_filter_level(const int32_t last_level[4],
+                                       int32_t plane, int32_t dir) {
+        std::vector<uint8_t> unfiltered[3];
+        save_frame(unfiltered);
+        int32_t lvl = plane == 0 ? (dir > 1 ? (last_level[0] + last_level[1] +
+                                               1) >> 1
+                                            : last_level[dir])
+                                 : last_level[plane + 1];
+        int32_t filt_mid = clamp(lvl, 0, MAX_LOOP_FILTER);
+        int32_t filter_step = filt_mid < 16 ? 4 : filt_mid / 4;
+        int32_t filt_direction = 0;
+        int64_t ss_err[MAX_LOOP_FILTER + 1];
+        memset(ss_err, 0xFF, sizeof(ss_err));
+
+        int64_t best_err =
+            serial_try_filter_frame(unfiltered, filt_mid, plane, dir);
+        int32_t filt_best = filt_mid;
+        ss_err[filt_mid] = best_err;
+        while (filter_step > 0) {
+            const int32_t filt_high =
+                AOMMIN(filt_mid + filter_step, MAX_LOOP_FILTER);
+            const int32_t filt_low = AOMMAX(filt_mid - filter_step, 0);
+            int64_t bias = (best_err >> (15 - (filt_mid / 8))) * filter_step;
+            if (ppcs_->frm_hdr.tx_mode != ONLY_4X4)
+                bias >>= 1;
+            if (filt_direction <= 0 && filt_low != filt_mid) {
+                if (ss_err[filt_low] < 0)
+                    ss_err[filt_low] = serial_try_filter_frame(
+                        unfiltered, filt_low, plane, dir);
+                if (ss_err[filt_low] < (best_err + bias)) {
+                    if (ss_err[filt_low] < best_err)
+                        best_err = ss_err[filt_low];
+                    filt_best = filt_low;
+                }
+            }
+            if (filt_direction >= 0 && filt_high != filt_mid) {
+                if (ss_err[filt_high] < 0)
+                    ss_err[filt_high] = serial_try_filter_frame(
+                        unfiltered, filt_high, plane, dir);
+                if (ss_err[filt_high] < (best_err - bias)) {
+                    best_err = ss_err[filt_high];
+                    filt_best = filt_high;
+                }
+            }
+            if (filt_best == filt_mid) {
+                filter_step /= 2;
+                filt_direction = 0;
+            } else {
+                filt_direction = (filt_best < filt_mid) ? -1 : 1;
+                filt_mid = filt_best;
+            }
+        }
+        return filt_best;
+    }
+
+    // The LPF_PICK_FROM_FULL_IMAGE path of svt_av1_pick_filter_level() for
+    // a key frame, with the serial search
+    void serial_pick_filter_level() {
+        struct LoopFilter *lf = &ppcs_->frm_hdr.loop_filter_params;
+        int32_t last_level[4];
+        get_levels(last_level);
+        lf->sharpness_level = 0;
+        lf->filter_level[0] = lf->filter_level[1] =
+            serial_search_filter_level(last_level, 0, 2);
+        if (lf->filter_level[0] == 0 && lf->filter_level[1] == 0) {
+            lf->filter_level_u = 0;
+            lf->filter_level_v = 0;
+        } else {
+            lf->filter_level_u = serial_search_filter_level(last_level, 1, 0);
+            lf->filter_level_v = serial_search_filter_level(last_level, 2, 0);
+        }
+    }
+
+    void run_test(bool with_helpers) {
+        pcs_->dlf_jobs.helper_fifo = with_helpers ? helper_fifo_ : nullptr;
+        pcs_->dlf_jobs.pcs_wrapper = pcs_wrapper_;
+        pcs_->dlf_jobs.helper_max = kHelpers;
+        SVTRandom rnd(0, 0x7fffffff);
+        for (int iter = 0; iter < 4; iter++) {
+            fill_mode_info(rnd);
+            fill_frame(rnd);
+            const int32_t start_levels[4] = {(int32_t)(rnd.random() % 40),
+                                             (int32_t)(rnd.random() % 40),
+                                             (int32_t)(rnd.random() % 20),
+                                             (int32_t)(rnd.random() % 20)};
+            std::vector<uint8_t> unfiltered[3], parallel[3], serial[3];
+            save_frame(unfiltered);
+
+            int32_t parallel_levels[4], serial_levels[4];
+            set_levels(start_levels);
+            ASSERT_EQ(EB_ErrorNone,
+                      svt_av1_pick_filter_level(
+                          input_, pcs_, LPF_PICK_FROM_FULL_IMAGE));
+            get_levels(parallel_levels);
+            svt_av1_loop_filter_frame(recon_, pcs_, 0, 3);
+            save_frame(parallel);
+
+            for (int plane = 0; plane < 3; plane++)
+                restore_plane(unfiltered, plane);
+            set_levels(start_levels);
+            serial_pick_filter_level();
+            get_levels(serial_levels);
+            serial_filter_frame(0, 3);
+            save_frame(serial);
+
+            for (int i = 0; i < 4; i++)
+                EXPECT_EQ(serial_levels[i], parallel_levels[i])
+                    << "filter level " << i << " iteration " << iter;
+            EXPECT_NE(0, serial_levels[0]) << "iteration " << iter;
+            for (int plane = 0; plane < 3; plane++) {
+                EXPECT_TRUE(serial[plane] == parallel[plane])
+                    << "plane " << plane << " iteration " << iter;
+                EXPECT_FALSE(serial[plane] == unfiltered[plane])
+                    << "plane " << plane << " not filtered, iteration "
+                    << iter;
+            }
+        }
+    }
+
+    uint32_t bd_;
+    bool highbd_;
+    uint32_t bytes_;
+    SequenceControlSet *scs_ = nullptr;
+    PictureParentControlSet *ppcs_ = nullptr;
+    PictureControlSet *pcs_ = nullptr;
+    EncDecSet *enc_dec_ = nullptr;
+    EbObjectWrapper *pcs_wrapper_ = nullptr;
+    EbPictureBufferDesc *input_ = nullptr;
+    EbPictureBufferDesc *recon_ = nullptr;
+    EbSystemResource *resource_ = nullptr;
+    EbFifo *helper_fifo_ = nullptr;
+    std::vector<std::thread> helpers_;
+    std::vector<ModeInfo> mode_info_;
+    std::vector<ModeInfo *> mi_grid_;
+};
+
+TEST_P(DeblockFrameTest, MatchSerialWithHelpers) {
+    run_test(true);
+}
+
+TEST_P(DeblockFrameTest, MatchSerialAlone) {
+    run_test(false);
+}
+
+INSTANTIATE_TEST_SUITE_P(Deblock, DeblockFrameTest, ::testing::Values(8, 10));
+
+}  // namespace
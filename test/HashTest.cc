@@ -0,0 +1,541 @@
+/*
+ * Copyright (c) 2025, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at https://www.aomedia.org/license/software-license. If the
+ * Alliance for Open Media Patent License 1.0 was not distributed with this
+ * source code in the PATENTS file, you can obtain it at
+ * https://www.aomedia.org/license/patent-license.
+ */
+
+/******************************************************************************
+ * @file HashTest.cc
+ *
+ * @brief Unit test of the block hashing of IntraBC:
+ * - svt_av1_get_crc32c_value
+ * - svt_av1_generate_block_2x2_hash_row
+ * - svt_av1_generate_block_2x2_hash_value / svt_av1_generate_block_hash_value
+ *   and svt_av1_get_block_hash_value with the C and the run time selected
+ *   kernels
+ *
+ ******************************************************************************/
+
+#include <string.h>
+#include <vector>
+#include "gtest/gtest.h"
+#include "aom_dsp_rtcd.h"
+#include "hash.h"
+#include "hash_motion.h"
+#include "random.h"
+#include "util.h"
+
+namespace {
+
+using svt_av1_test_tool::SVTRandom;
+
+typedef uint32_t (*Crc32cFunc)(const uint8_t *p, size_t length);
+
+TEST(Crc32cTest, CheckValue) {
+    // Check value of the CRC-32C specification
+    const uint8_t check[] = {'1', '2', '3', '4', '5', '6', '7', '8', '9'};
+    EXPECT_EQ(svt_av1_get_crc32c_value_c(check, sizeof(check)), 0xE3069283u);
+    EXPECT_EQ(svt_av1_get_crc32c_value_c(check, 0), 0u);
+}
+
+class Crc32cTest : public ::testing::TestWithParam<Crc32cFunc> {
+  protected:
+    void run_test() {
+        const Crc32cFunc test_impl = GetParam();
+        SVTRandom rnd(8, false);
+        uint8_t data[80];
+        for (int i = 0; i < 1000; i++) {
+            for (size_t j = 0; j < sizeof(data); j++)
+                data[j] = (uint8_t)rnd.random();
+            // Every tail length, from an aligned and an unaligned start
+            for (size_t length = 0; length <= 64; length++) {
+                for (size_t offset = 0; offset < 2; offset++) {
+                    ASSERT_EQ(test_impl(data + offset, length),
+                              svt_av1_get_crc32c_value_c(data + offset, length))
+                        << "length " << length << " offset " << offset;
+                }
+            }
+        }
+    }
+};
+GTEST_ALLOW_UNINSTANTIATED_PARAMETERIZED_TEST(Crc32cTest);
+
+TEST_P(Crc32cTest, MatchTest) {
+    run_test();
+}
+
+#ifdef ARCH_X86_64
+INSTANTIATE_TEST_SUITE_P(SSE4_2, Crc32cTest,
+                         ::testing::Values(svt_av1_get_crc32c_value_sse4_2));
+#endif  // ARCH_X86_64
+
+#if defined(ARCH_AARCH64) && HAVE_ARM_CRC32
+INSTANTIATE_TEST_SUITE_P(ARM_CRC32, Crc32cTest,
+                         ::testing::Values(svt_av1_get_crc32c_value_arm_crc32));
+#endif  // ARCH_AARCH64 && HAVE_ARM_CRC32
+
+typedef void (*Hash2x2RowFunc)(const uint8_t *src, int stride, int width,
+                               CRC_CALCULATOR *crc_calculator, uint32_t *hash1,
+                               uint32_t *hash2, int8_t *row_same,
+                               int8_t *col_same);
+
+// Screen content: few colors, so the same row / column flags are often set
+static void fill_screen_content(uint8_t *buf, int size, SVTRandom *rnd) {
+    const uint8_t colors[3] = {0, 128, 255};
+    int i = 0;
+    while (i < size) {
+        const uint8_t color = colors[rnd->random() % 3];
+        int run = 1 + rnd->random() % 24;
+        for (; run && i < size; run--) buf[i++] = color;
+    }
+}
+
+class BlockHash2x2RowTest : public ::testing::TestWithParam<Hash2x2RowFunc> {
+  protected:
+    static const int kStride = 160;
+    static const int kMaxWidth = kStride - 1;
+
+    void run_test() {
+        const Hash2x2RowFunc test_impl = GetParam();
+        SVTRandom rnd(8, false);
+        CRC_CALCULATOR crc_calculator;
+        svt_av1_crc_calculator_init(&crc_calculator, 24, 0x5D6DCB);
+
+        uint8_t src[2 * kStride];
+        uint32_t hash_ref[2][kMaxWidth], hash_tst[2][kMaxWidth];
+        int8_t same_ref[2][kMaxWidth], same_tst[2][kMaxWidth];
+        for (int i = 0; i < 400; i++) {
+            if (i & 1)
+                fill_screen_content(src, sizeof(src), &rnd);
+            else
+                for (size_t j = 0; j < sizeof(src); j++)
+                    src[j] = (uint8_t)rnd.random();
+            const int width = 1 + i % kMaxWidth;
+            svt_av1_generate_block_2x2_hash_row_c(src,
+                                                  kStride,
+                                                  width,
+                                                  &crc_calculator,
+                                                  hash_ref[0],
+                                                  hash_ref[1],
+                                                  same_ref[0],
+                                                  same_ref[1]);
+            test_impl(src,
+                      kStride,
+                      width,
+                      &crc_calculator,
+                      hash_tst[0],
+                      hash_tst[1],
+                      same_tst[0],
+                      same_tst[1]);
+            for (int x = 0; x < width; x++) {
+                ASSERT_EQ(hash_tst[0][x], hash_ref[0][x]) << "x " << x;
+                ASSERT_EQ(hash_tst[1][x], hash_ref[1][x]) << "x " << x;
+                ASSERT_EQ(same_tst[0][x], same_ref[0][x]) << "x " << x;
+                ASSERT_EQ(same_tst[1][x], same_ref[1][x]) << "x " << x;
+            }
+        }
+    }
+};
+GTEST_ALLOW_UNINSTANTIATED_PARAMETERIZED_TEST(BlockHash2x2RowTest);
+
+TEST_P(BlockHash2x2RowTest, MatchTest) {
+    run_test();
+}
+
+#ifdef ARCH_X86_64
+INSTANTIATE_TEST_SUITE_P(
+    SSE4_2, BlockHash2x2RowTest,
+    ::testing::Values(svt_av1_generate_block_2x2_hash_row_sse4_2));
+#endif  // ARCH_X86_64
+
+#if defined(ARCH_AARCH64) && HAVE_ARM_CRC32
+INSTANTIATE_TEST_SUITE_P(
+    ARM_CRC32, BlockHash2x2RowTest,
+    ::testing::Values(svt_av1_generate_block_2x2_hash_row_arm_crc32));
+#endif  // ARCH_AARCH64 && HAVE_ARM_CRC32
+
+/**
+ * The hash tables of IntraBC and the hash values of the searched blocks,
+ * built with the C kernels and with the kernels selected for the CPU, must be
+ * identical for the search to take the same decisions.
+ */
+class IntraBcHashTest : public ::testing::Test {
+  protected:
+    static const int kWidth = 200;
+    static const int kHeight = 72;
+    static const int kStride = kWidth + 8;
+    static const int kMaxBlockSize = 64;
+
+    struct HashSet {
+        // Hash values and same info of every block size, 4 to kMaxBlockSize
+        std::vector<std::vector<uint32_t>> hash[2];
+        std::vector<std::vector<int8_t>> same;
+        // svt_av1_get_block_hash_value() of every block size at a few places
+        std::vector<uint32_t> block_hash[2];
+    };
+
+    void TearDown() override {
+#if defined(ARCH_X86_64) || defined(ARCH_AARCH64)
+        svt_aom_setup_rtcd_internal(svt_aom_get_cpu_flags_to_use());
+#endif
+    }
+
+    void compute(const Yv12BufferConfig *picture, HashSet *set) {
+        const int size = kStride * kHeight;
+        CRC_CALCULATOR crc_calculator;
+        svt_av1_crc_calculator_init(&crc_calculator, 24, 0x5D6DCB);
+
+        std::vector<uint32_t> hash_values[2][2];
+        std::vector<int8_t> is_same[2][3];
+        uint32_t *block_hash_values[2][2];
+        int8_t *is_block_same[2][3];
+        for (int k = 0; k < 2; k++) {
+            for (int j = 0; j < 2; j++) {
+                hash_values[k][j].assign(size, 0);
+                block_hash_values[k][j] = hash_values[k][j].data();
+            }
+            for (int j = 0; j < 3; j++) {
+                is_same[k][j].assign(size, 0);
+                is_block_same[k][j] = is_same[k][j].data();
+            }
+        }
+
+        svt_av1_generate_block_2x2_hash_value(
+            picture, block_hash_values[0], is_block_same[0], &crc_calculator);
+        int src_idx = 0;
+        for (int size_idx = 4; size_idx <= kMaxBlockSize;
+             size_idx <<= 1, src_idx = !src_idx) {
+            const int dst_idx = !src_idx;
+            svt_av1_generate_block_hash_value(picture,
+                                              size_idx,
+                                              block_hash_values[src_idx],
+                                              block_hash_values[dst_idx],
+                                              is_block_same[src_idx],
+                                              is_block_same[dst_idx],
+                                              &crc_calculator);
+            set->hash[0].push_back(hash_values[dst_idx][0]);
+            set->hash[1].push_back(hash_values[dst_idx][1]);
+            set->same.push_back(is_same[dst_idx][2]);
+        }
+
+        std::vector<uint32_t> buffers(4 * AOM_BUFFER_SIZE_FOR_BLOCK_HASH);
+        IntraBcContext x;
+        memset(&x, 0, sizeof(x));
+        for (int k = 0; k < 2; k++)
+            for (int j = 0; j < 2; j++)
+                x.hash_value_buffer[k][j] =
+                    buffers.data() + (2 * k + j) * AOM_BUFFER_SIZE_FOR_BLOCK_HASH;
+        x.crc_calculator1 = crc_calculator;
+        for (int block_size = 4, level = 0; block_size <= kMaxBlockSize;
+             block_size <<= 1, level++) {
+            for (int y = 0; y + block_size <= kHeight; y += 7) {
+                for (int x_pos = 0; x_pos + block_size <= kWidth; x_pos += 13) {
+                    uint32_t hash_value1, hash_value2;
+                    svt_av1_get_block_hash_value(
+                        picture->y_buffer + y * kStride + x_pos,
+                        kStride,
+                        block_size,
+                        &hash_value1,
+                        &hash_value2,
+                        0,
+                        NULL,
+                        &x);
+                    set->block_hash[0].push_back(hash_value1);
+                    set->block_hash[1].push_back(hash_value2);
+                    // The hash of the searched block is the one of the table
+                    const int pos = y * kWidth + x_pos;
+                    EXPECT_EQ(hash_value1,
+                              (set->hash[0][level][pos] & 0xFFFF) +
+                                  ((uint32_t)level << 16));
+                    EXPECT_EQ(hash_value2, set->hash[1][level][pos]);
+                }
+            }
+        }
+    }
+
+    void run_test() {
+        SVTRandom rnd(8, false);
+        std::vector<uint8_t> buf(kStride * (kHeight + 1));
+        fill_screen_content(buf.data(), (int)buf.size(), &rnd);
+        // Repeat a few areas, as the text and icons of screen content
+        for (int y = 0; y < kHeight; y++)
+            memcpy(&buf[y * kStride + 100], &buf[y * kStride + 20], 40);
+
+        Yv12BufferConfig picture;
+        memset(&picture, 0, sizeof(picture));
+        picture.y_buffer = buf.data();
+        picture.y_stride = kStride;
+        picture.y_crop_width = kWidth;
+        picture.y_crop_height = kHeight;
+
+        HashSet ref, tst;
+        svt_aom_setup_rtcd_internal(0);
+        compute(&picture, &ref);
+#if defined(ARCH_X86_64) || defined(ARCH_AARCH64)
+        svt_aom_setup_rtcd_internal(svt_aom_get_cpu_flags_to_use());
+#endif
+        compute(&picture, &tst);
+
+        for (size_t i = 0; i < ref.same.size(); i++) {
+            EXPECT_EQ(tst.hash[0][i], ref.hash[0][i]) << "block size " << (4 << i);
+            EXPECT_EQ(tst.hash[1][i], ref.hash[1][i]) << "block size " << (4 << i);
+            EXPECT_EQ(tst.same[i], ref.same[i]) << "block size " << (4 << i);
+        }
+        EXPECT_EQ(tst.block_hash[0], ref.block_hash[0]);
+        EXPECT_EQ(tst.block_hash[1], ref.block_hash[1]);
+    }
+};
+
+TEST_F(IntraBcHashTest, MatchTest) {
+    run_test();
+}
+
+/**
+ * The second hash only confirms the candidates of the first one in the IntraBC
+ * hash search. The CRC-32C must keep the candidates of the CRC-24 (0x864CFB)
+ * it replaced: both admit the blocks identical to the searched one, in the
+ * same order, so the search takes the same decisions.
+ */
+class IntraBcHashDecisionTest : public ::testing::Test {
+  protected:
+    static const int kWidth = 256;
+    static const int kHeight = 128;
+    static const int kStride = kWidth + 8;
+    static const int kMaxBlockSize = 64;
+
+    void SetUp() override {
+        // The hash table vectors copy with svt_memcpy()
+#if defined(ARCH_X86_64) || defined(ARCH_AARCH64)
+        svt_aom_setup_common_rtcd_internal(svt_aom_get_cpu_flags_to_use());
+        svt_aom_setup_rtcd_internal(svt_aom_get_cpu_flags_to_use());
+#else
+        svt_aom_setup_common_rtcd_internal(0);
+        svt_aom_setup_rtcd_internal(0);
+#endif
+    }
+
+    // Second hash of the blocks of every size, 2 to kMaxBlockSize, as the
+    // previous versions computed it
+    void old_hash2(const uint8_t *buf,
+                   std::vector<std::vector<uint32_t>> *levels) {
+        CRC_CALCULATOR crc_calculator;
+        svt_av1_crc_calculator_init(&crc_calculator, 24, 0x864CFB);
+
+        std::vector<uint32_t> hash(kWidth * kHeight, 0);
+        for (int y = 0; y + 2 <= kHeight; y++) {
+            for (int x = 0; x + 2 <= kWidth; x++) {
+                const uint8_t *src = buf + y * kStride + x;
+                uint8_t p[4] = {src[0], src[1], src[kStride], src[kStride + 1]};
+                hash[y * kWidth + x] =
+                    svt_av1_get_crc_value(&crc_calculator, p, sizeof(p));
+            }
+        }
+        levels->push_back(hash);
+        for (int block_size = 4; block_size <= kMaxBlockSize; block_size <<= 1) {
+            const std::vector<uint32_t> &src = levels->back();
+            const int half = block_size >> 1;
+            for (int y = 0; y + block_size <= kHeight; y++) {
+                for (int x = 0; x + block_size <= kWidth; x++) {
+                    const int pos = y * kWidth + x;
+                    uint32_t p[4] = {src[pos],
+                                     src[pos + half],
+                                     src[pos + half * kWidth],
+                                     src[pos + half * kWidth + half]};
+                    hash[pos] = svt_av1_get_crc_value(
+                        &crc_calculator, (uint8_t *)p, sizeof(p));
+                }
+            }
+            levels->push_back(hash);
+        }
+    }
+
+    // Candidates of hash_value1, in the search order, confirmed by hash_value2
+    static std::vector<int> search(HashTable *table, uint32_t hash_value1,
+                                   uint32_t hash_value2) {
+        std::vector<int> candidates;
+        const int count = svt_av1_hash_table_count(table, hash_value1);
+        if (!count)
+            return candidates;
+        Iterator iterator = svt_av1_hash_get_first_iterator(table, hash_value1);
+        for (int i = 0; i < count; i++, svt_aom_iterator_increment(&iterator)) {
+            const BlockHash ref = *(BlockHash *)svt_aom_iterator_get(&iterator);
+            if (ref.hash_value2 == hash_value2)
+                candidates.push_back(ref.y * kWidth + ref.x);
+        }
+        return candidates;
+    }
+
+    static bool same_block(const uint8_t *buf, int pos0, int pos1,
+                           int block_size) {
+        const uint8_t *src0 = buf + (pos0 / kWidth) * kStride + pos0 % kWidth;
+        const uint8_t *src1 = buf + (pos1 / kWidth) * kStride + pos1 % kWidth;
+        for (int y = 0; y < block_size; y++)
+            if (memcmp(src0 + y * kStride, src1 + y * kStride, block_size))
+                return false;
+        return true;
+    }
+
+    void run_test() {
+        SVTRandom rnd(8, false);
+        std::vector<uint8_t> buf(kStride * (kHeight + 1));
+        fill_screen_content(buf.data(), (int)buf.size(), &rnd);
+        // Repeat a few areas, aligned or not, as the text and icons of screen
+        // content
+        for (int y = 0; y < 64; y++) {
+            memcpy(&buf[y * kStride + 96], &buf[y * kStride + 16], 72);
+            memcpy(&buf[(y + 64) * kStride + 3], &buf[y * kStride + 16], 72);
+            memcpy(&buf[(y + 61) * kStride + 170], &buf[y * kStride + 16], 72);
+        }
+
+        Yv12BufferConfig picture;
+        memset(&picture, 0, sizeof(picture));
+        picture.y_buffer = buf.data();
+        picture.y_stride = kStride;
+        picture.y_crop_width = kWidth;
+        picture.y_crop_height = kHeight;
+
+        std::vector<std::vector<uint32_t>> old_levels;
+        old_hash2(buf.data(), &old_levels);
+
+        CRC_CALCULATOR crc_calculator;
+        svt_av1_crc_calculator_init(&crc_calculator, 24, 0x5D6DCB);
+        const int size = kWidth * kHeight;
+        std::vector<uint32_t> hash_values[2][2];
+        std::vector<int8_t> is_same[2][3];
+        uint32_t *block_hash_values[2][2];
+        int8_t *is_block_same[2][3];
+        for (int k = 0; k < 2; k++) {
+            for (int j = 0; j < 2; j++) {
+                hash_values[k][j].assign(size, 0);
+                block_hash_values[k][j] = hash_values[k][j].data();
+            }
+            for (int j = 0; j < 3; j++) {
+                is_same[k][j].assign(size, 0);
+                is_block_same[k][j] = is_same[k][j].data();
+            }
+        }
+        svt_av1_generate_block_2x2_hash_value(
+            &picture, block_hash_values[0], is_block_same[0], &crc_calculator);
+
+        int matches = 0, rejected = 0;
+        int src_idx = 0;
+        for (int block_size = 4, level = 0; block_size <= kMaxBlockSize;
+             block_size <<= 1, level++, src_idx = !src_idx) {
+            const int dst_idx = !src_idx;
+            svt_av1_generate_block_hash_value(&picture,
+                                              block_size,
+                                              block_hash_values[src_idx],
+                                              block_hash_values[dst_idx],
+                                              is_block_same[src_idx],
+                                              is_block_same[dst_idx],
+                                              &crc_calculator);
+            uint32_t *new_hash[2] = {block_hash_values[dst_idx][0],
+                                     block_hash_values[dst_idx][1]};
+            uint32_t *old_hash[2] = {block_hash_values[dst_idx][0],
+                                     old_levels[level + 1].data()};
+            HashTable new_table = {}, old_table = {};
+            ASSERT_EQ(svt_aom_rtime_alloc_svt_av1_hash_table_create(&new_table),
+                      EB_ErrorNone);
+            ASSERT_EQ(svt_aom_rtime_alloc_svt_av1_hash_table_create(&old_table),
+                      EB_ErrorNone);
+            ASSERT_EQ(
+                svt_aom_rtime_alloc_svt_av1_add_to_hash_map_by_row_with_precal_data(
+                    &new_table, new_hash, is_block_same[dst_idx][2], kWidth,
+                    kHeight, block_size),
+                EB_ErrorNone);
+            ASSERT_EQ(
+                svt_aom_rtime_alloc_svt_av1_add_to_hash_map_by_row_with_precal_data(
+                    &old_table, old_hash, is_block_same[dst_idx][2], kWidth,
+                    kHeight, block_size),
+                EB_ErrorNone);
+
+            for (int y = 0; y + block_size <= kHeight; y++) {
+                for (int x = 0; x + block_size <= kWidth; x++) {
+                    const int pos = y * kWidth + x;
+                    const uint32_t hash_value1 =
+                        (new_hash[0][pos] & 0xFFFF) + ((uint32_t)level << 16);
+                    const std::vector<int> new_candidates =
+                        search(&new_table, hash_value1, new_hash[1][pos]);
+                    const std::vector<int> old_candidates =
+                        search(&old_table, hash_value1, old_hash[1][pos]);
+                    ASSERT_EQ(old_candidates, new_candidates)
+                        << "block size " << block_size << " x " << x << " y "
+                        << y;
+                    rejected += svt_av1_hash_table_count(&new_table,
+                                                         hash_value1) -
+                        (int)new_candidates.size();
+                    for (const int candidate : new_candidates) {
+                        ASSERT_TRUE(
+                            same_block(buf.data(), pos, candidate, block_size))
+                            << "block size " << block_size << " x " << x
+                            << " y " << y;
+                        matches += candidate != pos;
+                    }
+                }
+            }
+            svt_av1_hash_table_destroy(&new_table);
+            svt_av1_hash_table_destroy(&old_table);
+        }
+        // The repeated areas are found, and the second hash had to reject the
+        // collisions of the first one
+        EXPECT_GT(matches, 0);
+        EXPECT_GT(rejected, 0);
+    }
+};
+
+TEST_F(IntraBcHashDecisionTest, MatchTest) {
+    run_test();
+}
+
+// The hash values of the 16x16 to 64x64 blocks of a 64x64 block, used by the
+// hash based ME, must be the ones of svt_av1_get_block_hash_value()
+TEST(B64BlockHashTest, MatchTest) {
+    const int stride = 64 + 16;
+    SVTRandom rnd(8, false);
+    std::vector<uint8_t> buf(stride * 64);
+    fill_screen_content(buf.data(), (int)buf.size(), &rnd);
+
+    CRC_CALCULATOR crc_calculator;
+    svt_av1_crc_calculator_init(&crc_calculator, 24, 0x5D6DCB);
+    uint32_t hash_value1[3][16], hash_value2[3][16];
+    svt_av1_get_b64_block_hash_values(
+        buf.data(), stride, &crc_calculator, hash_value1, hash_value2);
+
+    std::vector<uint32_t> buffers(4 * AOM_BUFFER_SIZE_FOR_BLOCK_HASH);
+    IntraBcContext x;
+    memset(&x, 0, sizeof(x));
+    for (int k = 0; k < 2; k++)
+        for (int j = 0; j < 2; j++)
+            x.hash_value_buffer[k][j] =
+                buffers.data() + (2 * k + j) * AOM_BUFFER_SIZE_FOR_BLOCK_HASH;
+    x.crc_calculator1 = crc_calculator;
+    for (int level = 0; level < 3; level++) {
+        const int block_size = 16 << level;
+        const int count = 64 / block_size;
+        for (int i = 0; i < count * count; i++) {
+            uint32_t ref_hash1, ref_hash2;
+            svt_av1_get_block_hash_value(
+                buf.data() + (i / count) * block_size * stride +
+                    (i % count) * block_size,
+                stride,
+                block_size,
+                &ref_hash1,
+                &ref_hash2,
+                0,
+                NULL,
+                &x);
+            EXPECT_EQ(hash_value1[level][i], ref_hash1)
+                << "block size " << block_size << " index " << i;
+            EXPECT_EQ(hash_value2[level][i], ref_hash2)
+                << "block size " << block_size << " index " << i;
+        }
+    }
+}
+
+}  // namespace
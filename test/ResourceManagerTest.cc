@@ -0,0 +1,157 @@
+/*
+ * Copyright(c) 2019 Netflix, Inc.
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at https://www.aomedia.org/license/software-license. If the
+ * Alliance for Open Media Patent License 1.0 was not distributed with this
+ * source code in the PATENTS file, you can obtain it at
+ * https://www.aomedia.org/license/patent-license.
+ */
+
+/******************************************************************************
+ * @file ResourceManagerTest.cc
+ *
+ * @brief Unit test of the system resource manager:
+ * - svt_get_empty_object / svt_post_full_object / svt_get_full_object /
+ *   svt_release_object on the lock-free ring of EbMuxingQueue
+ *
+ ******************************************************************************/
+
+#include <stdlib.h>
+#include <thread>
+#include <vector>
+#include "gtest/gtest.h"
+#include "sys_resource_manager.h"
+
+namespace {
+
+// Object value marking the end of the stream for a consumer
+static const uint64_t kStopValue = ~(uint64_t)0;
+
+static EbErrorType value_creator(EbPtr *object_dbl_ptr,
+                                 EbPtr object_init_data_ptr) {
+    (void)object_init_data_ptr;
+    *object_dbl_ptr = calloc(1, sizeof(uint64_t));
+    return *object_dbl_ptr ? EB_ErrorNone : EB_ErrorInsufficientResources;
+}
+
+static void value_destroyer(EbPtr p) {
+    free(p);
+}
+
+/**
+ * Producers post (producer << 32 | sequence) values through a pool smaller
+ * than the number of values, so that every object is taken, posted and
+ * released many times while the other threads race on the ring. Once the
+ * producers are done, one stop value per consumer is posted.
+ *
+ * Every value must be received exactly once, and each consumer must receive
+ * the values of a producer in the order they were posted. The stop values
+ * are posted last, so they must also be the last values received.
+ */
+class MuxingQueueStressTest
+    : public ::testing::TestWithParam<std::tuple<int, int, int>> {
+  protected:
+    void run_test() {
+        const uint32_t producers = std::get<0>(GetParam());
+        const uint32_t consumers = std::get<1>(GetParam());
+        const uint32_t pool_size = std::get<2>(GetParam());
+        const uint32_t count = 20000;
+
+        EbSystemResource *resource =
+            (EbSystemResource *)calloc(1, sizeof(EbSystemResource));
+        ASSERT_NE(resource, nullptr);
+        ASSERT_EQ(EB_ErrorNone,
+                  svt_system_resource_ctor(resource,
+                                           pool_size,
+                                           producers + 1,
+                                           consumers,
+                                           value_creator,
+                                           nullptr,
+                                           value_destroyer));
+
+        std::vector<std::vector<uint64_t>> received(consumers);
+        std::vector<std::thread> threads;
+        for (uint32_t c = 0; c < consumers; c++) {
+            threads.emplace_back([&, c]() {
+                EbFifo *fifo = svt_system_resource_get_consumer_fifo(resource, c);
+                for (;;) {
+                    EbObjectWrapper *wrapper = nullptr;
+                    svt_get_full_object(fifo, &wrapper);
+                    const uint64_t value = *(uint64_t *)wrapper->object_ptr;
+                    received[c].push_back(value);
+                    svt_release_object(wrapper);
+                    if (value == kStopValue)
+                        break;
+                }
+            });
+        }
+        std::vector<std::thread> producer_threads;
+        for (uint32_t p = 0; p < producers; p++) {
+            producer_threads.emplace_back([&, p]() {
+                EbFifo *fifo = svt_system_resource_get_producer_fifo(resource, p);
+                for (uint32_t i = 0; i < count; i++) {
+                    EbObjectWrapper *wrapper = nullptr;
+                    svt_get_empty_object(fifo, &wrapper);
+                    *(uint64_t *)wrapper->object_ptr = ((uint64_t)p << 32) | i;
+                    svt_post_full_object(wrapper);
+                }
+            });
+        }
+        for (std::thread &t : producer_threads) t.join();
+        EbFifo *fifo = svt_system_resource_get_producer_fifo(resource, producers);
+        for (uint32_t c = 0; c < consumers; c++) {
+            EbObjectWrapper *wrapper = nullptr;
+            svt_get_empty_object(fifo, &wrapper);
+            *(uint64_t *)wrapper->object_ptr = kStopValue;
+            svt_post_full_object(wrapper);
+        }
+        for (std::thread &t : threads) t.join();
+
+        std::vector<std::vector<uint8_t>> seen(producers,
+                                               std::vector<uint8_t>(count, 0));
+        for (uint32_t c = 0; c < consumers; c++) {
+            std::vector<int64_t> last(producers, -1);
+            ASSERT_FALSE(received[c].empty());
+            EXPECT_EQ(kStopValue, received[c].back())
+                << "consumer " << c << " did not stop last";
+            for (size_t k = 0; k + 1 < received[c].size(); k++) {
+                const uint64_t value = received[c][k];
+                ASSERT_NE(kStopValue, value)
+                    << "consumer " << c << " got a value after its stop";
+                const uint32_t p = (uint32_t)(value >> 32);
+                const uint32_t i = (uint32_t)value;
+                ASSERT_LT(p, producers);
+                ASSERT_LT(i, count);
+                EXPECT_EQ(0, seen[p][i])
+                    << "value " << i << " of producer " << p << " duplicated";
+                seen[p][i] = 1;
+                EXPECT_GT((int64_t)i, last[p])
+                    << "value " << i << " of producer " << p
+                    << " out of order at consumer " << c;
+                last[p] = i;
+            }
+        }
+        for (uint32_t p = 0; p < producers; p++)
+            for (uint32_t i = 0; i < count; i++)
+                EXPECT_EQ(1, seen[p][i])
+                    << "value " << i << " of producer " << p << " lost";
+
+        resource->dctor(resource);
+        free(resource);
+    }
+};
+
+TEST_P(MuxingQueueStressTest, NoLossNoDuplicateFifo) {
+    run_test();
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    ResourceManager, MuxingQueueStressTest,
+    ::testing::Values(std::make_tuple(1, 1, 1), std::make_tuple(1, 4, 3),
+                      std::make_tuple(4, 1, 5), std::make_tuple(4, 4, 8),
+                      std::make_tuple(8, 3, 64)));
+
+}  // namespace
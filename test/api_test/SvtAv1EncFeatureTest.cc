@@ -0,0 +1,1001 @@
+/*
+ * Copyright(c) 2019 Netflix, Inc.
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at https://www.aomedia.org/license/software-license. If the
+ * Alliance for Open Media Patent License 1.0 was not distributed with this
+ * source code in the PATENTS file, you can obtain it at
+ * https://www.aomedia.org/license/patent-license.
+ */
+
+/******************************************************************************
+ * @file SvtAv1EncFeatureTest.cc
+ *
+ * @brief SVT-AV1 encoder api test, encode short synthetic clips through the
+ * optional encoder features and check their output
+ *
+ ******************************************************************************/
+
+#include <string.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <utility>
+#include <vector>
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+#include "EbSvtAv1Enc.h"
+#include "gtest/gtest.h"
+#include "SvtAv1EncApiTest.h"
+
+using namespace svt_av1_test;
+
+namespace {
+
+static const uint32_t kWidth = 192;
+static const uint32_t kHeight = 128;
+static const int kFrames = 24;
+
+/** Packet returned by the encoder, copied out of the encoder memory */
+typedef struct {
+    std::vector<uint8_t> data;
+    int64_t pts;
+    uint32_t flags;
+    EbAv1PictureType pic_type;
+    EbPictureTimestamps timestamps;
+} Packet;
+
+/** TestEncoder drives a handle through init, the encode of a synthetic clip
+ * and deinit */
+class TestEncoder {
+  public:
+    TestEncoder() : handle_(nullptr), initialized_(false) {
+        memset(&config_, 0, sizeof(config_));
+        EXPECT_EQ(EB_ErrorNone, svt_av1_enc_init_handle(&handle_, &config_))
+            << "svt_av1_enc_init_handle failed";
+        config_.source_width = kWidth;
+        config_.source_height = kHeight;
+        config_.enc_mode = 10;
+        config_.level_of_parallelism = 1;
+    }
+    ~TestEncoder() {
+        if (initialized_) {
+            EXPECT_EQ(EB_ErrorNone, svt_av1_enc_deinit(handle_));
+        }
+        if (handle_) {
+            EXPECT_EQ(EB_ErrorNone, svt_av1_enc_deinit_handle(handle_));
+        }
+    }
+
+    EbComponentType *handle() {
+        return handle_;
+    }
+    EbSvtAv1EncConfiguration &config() {
+        return config_;
+    }
+
+    EbErrorType init() {
+        EbErrorType ret = svt_av1_enc_set_parameter(handle_, &config_);
+        if (ret != EB_ErrorNone)
+            return ret;
+        ret = svt_av1_enc_init(handle_);
+        initialized_ = ret == EB_ErrorNone;
+        return ret;
+    }
+
+    /** Frame n of the clip: a texture moving by (n, n / 2) over a gradient */
+    static void fill_frame(int n, std::vector<uint8_t> &yuv) {
+        const uint32_t luma_size = kWidth * kHeight;
+        yuv.resize(luma_size * 3 / 2);
+        for (uint32_t y = 0; y < kHeight; y++) {
+            for (uint32_t x = 0; x < kWidth; x++) {
+                const uint32_t u = x + n, v = y + n / 2;
+                yuv[y * kWidth + x] =
+                    (uint8_t)(((u * 7) ^ (v * 13)) + ((u * v) >> 6) + y / 2);
+            }
+        }
+        for (uint32_t i = 0; i < luma_size / 2; i++)
+            yuv[luma_size + i] = (uint8_t)(96 + (i % (kWidth / 2)) / 4 + n);
+    }
+
+    /** Sends frame n, with pts n */
+    EbErrorType send(int n, void *app_private = nullptr) {
+        std::vector<uint8_t> yuv;
+        fill_frame(n, yuv);
+        return send_frame(yuv, n, app_private);
+    }
+
+    /** Sends the 4:2:0 frame yuv of the clip size, with pts */
+    EbErrorType send_frame(const std::vector<uint8_t> &yuv, int64_t pts,
+                           void *app_private = nullptr) {
+        EbSvtIOFormat planes;
+        memset(&planes, 0, sizeof(planes));
+        planes.luma = (uint8_t *)yuv.data();
+        planes.cb = planes.luma + kWidth * kHeight;
+        planes.cr = planes.cb + kWidth * kHeight / 4;
+        planes.y_stride = kWidth;
+        planes.cb_stride = planes.cr_stride = kWidth / 2;
+
+        EbBufferHeaderType header;
+        memset(&header, 0, sizeof(header));
+        header.size = sizeof(header);
+        header.p_buffer = (uint8_t *)&planes;
+        header.n_filled_len = (uint32_t)yuv.size();
+        header.p_app_private = app_private;
+        header.pts = pts;
+        header.pic_type = EB_AV1_INVALID_PICTURE;
+        return svt_av1_enc_send_picture(handle_, &header);
+    }
+
+    EbErrorType send_eos() {
+        EbBufferHeaderType header;
+        memset(&header, 0, sizeof(header));
+        header.size = sizeof(header);
+        header.flags = EB_BUFFERFLAG_EOS;
+        header.pic_type = EB_AV1_INVALID_PICTURE;
+        return svt_av1_enc_send_picture(handle_, &header);
+    }
+
+    /** Takes the next packet, returns false when none is queued or on error */
+    bool get_packet(bool done, Packet *packet) {
+        EbBufferHeaderType *out = nullptr;
+        const EbErrorType ret =
+            svt_av1_enc_get_packet(handle_, &out, done ? 1 : 0);
+        if (ret == EB_NoErrorEmptyQueue || out == nullptr)
+            return false;
+        EXPECT_EQ(EB_ErrorNone, ret);
+        packet->data.assign(out->p_buffer, out->p_buffer + out->n_filled_len);
+        packet->pts = out->pts;
+        packet->flags = out->flags;
+        packet->pic_type = out->pic_type;
+        packet->timestamps = out->timestamps;
+        svt_av1_enc_release_out_buffer(&out);
+        return ret == EB_ErrorNone;
+    }
+
+    /** Encodes frames first to first + count - 1 and EOS, returns the
+     * packets up to the EOS one */
+    std::vector<Packet> encode(int count, int first = 0) {
+        std::vector<Packet> packets;
+        Packet packet;
+        for (int n = first; n < first + count; n++) {
+            EXPECT_EQ(EB_ErrorNone, send(n));
+            while (get_packet(false, &packet)) packets.push_back(packet);
+        }
+        EXPECT_EQ(EB_ErrorNone, send_eos());
+        drain(packets);
+        return packets;
+    }
+
+    /** Takes the packets left up to the EOS one */
+    void drain(std::vector<Packet> &packets) {
+        Packet packet;
+        do {
+            if (!get_packet(true, &packet))
+                break;
+            packets.push_back(packet);
+        } while (!(packet.flags & EB_BUFFERFLAG_EOS));
+        EXPECT_TRUE(!packets.empty() &&
+                    (packets.back().flags & EB_BUFFERFLAG_EOS))
+            << "EOS packet not received";
+    }
+
+  private:
+    EbComponentType *handle_;
+    EbSvtAv1EncConfiguration config_;
+    bool initialized_;
+};
+
+/** Bytes of the stream made of the packets */
+static std::vector<uint8_t> stream_of(const std::vector<Packet> &packets) {
+    std::vector<uint8_t> stream;
+    for (const Packet &packet : packets)
+        stream.insert(stream.end(), packet.data.begin(), packet.data.end());
+    return stream;
+}
+
+/** Encodes the clip with the configuration changed by setup, which may also
+ * call the optional setters on the handle before init */
+static std::vector<uint8_t> encode_clip(
+    const std::function<void(TestEncoder &)> &setup, int count = kFrames) {
+    TestEncoder encoder;
+    setup(encoder);
+    EXPECT_EQ(EB_ErrorNone, encoder.init()) << "svt_av1_enc_init failed";
+    return stream_of(encoder.encode(count));
+}
+
+/** @brief The core-token scheduler only changes which threads run, the
+ * stream must be the one of dedicated stage threads
+ */
+TEST(EncFeatureTest, scheduler_mode_is_bit_exact) {
+    const std::vector<uint8_t> ref =
+        encode_clip([](TestEncoder &enc) { enc.config().scheduler_mode = 0; });
+    ASSERT_FALSE(ref.empty());
+    for (uint32_t lp : {1, 4}) {
+        const std::vector<uint8_t> tst =
+            encode_clip([lp](TestEncoder &enc) {
+                enc.config().scheduler_mode = 1;
+                enc.config().level_of_parallelism = lp;
+            });
+        EXPECT_EQ(ref, tst) << "level_of_parallelism " << lp;
+    }
+}
+
+/** @brief scheduler_mode is 0 or 1 */
+TEST(EncFeatureTest, scheduler_mode_invalid) {
+    TestEncoder encoder;
+    encoder.config().scheduler_mode = 2;
+    EXPECT_EQ(EB_ErrorBadParameter,
+              svt_av1_enc_set_parameter(encoder.handle(), &encoder.config()));
+}
+
+/** @brief Handles attached to a shared thread pool encode concurrently, each
+ * producing the stream it produces on its own threads
+ */
+TEST(EncFeatureTest, thread_pool_shared_by_two_handles) {
+    const std::vector<uint8_t> ref[2] = {
+        encode_clip([](TestEncoder &) {}),
+        encode_clip([](TestEncoder &enc) { enc.config().qp = 45; })};
+
+    SvtAv1ThreadPool *pool = nullptr;
+    ASSERT_EQ(EB_ErrorNone, svt_av1_enc_thread_pool_create(&pool, 2));
+    ASSERT_NE(pool, nullptr);
+    std::vector<uint8_t> tst[2];
+    {
+        TestEncoder enc[2];
+        enc[1].config().qp = 45;
+        for (int i = 0; i < 2; i++) {
+            ASSERT_EQ(EB_ErrorNone,
+                      svt_av1_enc_attach_thread_pool(enc[i].handle(), pool));
+            ASSERT_EQ(EB_ErrorNone, enc[i].init());
+        }
+        // Attaching is only possible before init
+        EXPECT_EQ(EB_ErrorBadParameter,
+                  svt_av1_enc_attach_thread_pool(enc[0].handle(), pool));
+
+        std::thread threads[2];
+        for (int i = 0; i < 2; i++)
+            threads[i] = std::thread(
+                [&enc, &tst, i]() { tst[i] = stream_of(enc[i].encode(kFrames)); });
+        for (int i = 0; i < 2; i++) threads[i].join();
+
+        // The handles are still attached
+        EXPECT_NE(EB_ErrorNone, svt_av1_enc_thread_pool_destroy(pool));
+    }
+    EXPECT_EQ(EB_ErrorNone, svt_av1_enc_thread_pool_destroy(pool));
+    for (int i = 0; i < 2; i++) EXPECT_EQ(ref[i], tst[i]) << "handle " << i;
+}
+
+#ifdef __linux__
+/** @brief The pools are placed from the calling thread, which must get its
+ * affinity back once init returns, whatever the NUMA policy
+ */
+TEST(EncFeatureTest, init_keeps_caller_affinity) {
+    cpu_set_t before;
+    ASSERT_EQ(0, pthread_getaffinity_np(pthread_self(), sizeof(before), &before));
+    for (uint8_t numa_policy = 0; numa_policy <= 1; numa_policy++) {
+        for (uint8_t pin_threads = 0; pin_threads <= 1; pin_threads++) {
+            TestEncoder encoder;
+            encoder.config().numa_policy = numa_policy;
+            encoder.config().pin_threads = pin_threads;
+            ASSERT_EQ(EB_ErrorNone, encoder.init());
+            cpu_set_t after;
+            ASSERT_EQ(0,
+                      pthread_getaffinity_np(pthread_self(), sizeof(after), &after));
+            EXPECT_TRUE(CPU_EQUAL(&before, &after))
+                << "numa_policy " << (int)numa_policy << " pin_threads "
+                << (int)pin_threads;
+        }
+    }
+}
+#endif
+
+/** @brief Parking and waking stage threads from the queue occupancy only
+ * changes which threads run, the stream must not change
+ */
+TEST(EncFeatureTest, stage_rebalance_is_bit_exact) {
+    const std::vector<uint8_t> ref = encode_clip([](TestEncoder &enc) {
+        enc.config().level_of_parallelism = 4;
+    });
+    ASSERT_FALSE(ref.empty());
+    const std::vector<uint8_t> tst = encode_clip(
+        [](TestEncoder &enc) {
+            enc.config().level_of_parallelism = 4;
+            enc.config().stage_rebalance = 1;
+        });
+    EXPECT_EQ(ref, tst);
+
+    TestEncoder encoder;
+    encoder.config().stage_rebalance = 2;
+    EXPECT_EQ(EB_ErrorBadParameter,
+              svt_av1_enc_set_parameter(encoder.handle(), &encoder.config()));
+}
+
+/** Samples the pool counters of the handle after each picture sent while it
+ * encodes the clip, returns the stream */
+static std::vector<uint8_t> encode_sampling_pools(
+    TestEncoder &encoder, std::vector<SvtAv1PoolStats> &samples) {
+    std::vector<Packet> packets;
+    Packet packet;
+    SvtAv1PoolStats stats;
+    for (int n = 0; n < kFrames; n++) {
+        EXPECT_EQ(EB_ErrorNone, encoder.send(n));
+        while (encoder.get_packet(false, &packet)) packets.push_back(packet);
+        EXPECT_EQ(EB_ErrorNone,
+                  svt_av1_enc_get_stream_info(encoder.handle(),
+                                              SVT_AV1_STREAM_INFO_POOL_STATS,
+                                              &stats));
+        samples.push_back(stats);
+    }
+    EXPECT_EQ(EB_ErrorNone, encoder.send_eos());
+    encoder.drain(packets);
+    EXPECT_EQ(EB_ErrorNone,
+              svt_av1_enc_get_stream_info(
+                  encoder.handle(), SVT_AV1_STREAM_INFO_POOL_STATS, &stats));
+    samples.push_back(stats);
+    return stream_of(packets);
+}
+
+/** @brief Growable pools start with a single object, grow on demand without
+ * ever going past the size of the fixed pool, and do not change the stream
+ */
+TEST(EncFeatureTest, pool_growth_grows_within_max) {
+    std::vector<SvtAv1PoolStats> fixed;
+    std::vector<uint8_t> ref;
+    {
+        TestEncoder encoder;
+        ASSERT_EQ(EB_ErrorNone, encoder.init());
+        ref = encode_sampling_pools(encoder, fixed);
+    }
+    ASSERT_FALSE(ref.empty());
+    for (const SvtAv1PoolCounters &pool : fixed.back().pool)
+        EXPECT_EQ(pool.total_count, pool.allocated_count);
+
+    for (uint8_t growth = 1; growth <= 2; growth++) {
+        TestEncoder encoder;
+        encoder.config().pool_growth = growth;
+        ASSERT_EQ(EB_ErrorNone, encoder.init());
+        SvtAv1PoolStats initial;
+        ASSERT_EQ(EB_ErrorNone,
+                  svt_av1_enc_get_stream_info(encoder.handle(),
+                                              SVT_AV1_STREAM_INFO_POOL_STATS,
+                                              &initial));
+        std::vector<SvtAv1PoolStats> samples;
+        EXPECT_EQ(ref, encode_sampling_pools(encoder, samples))
+            << "pool_growth " << (int)growth;
+
+        bool grown = false;
+        for (int i = 0; i < SVT_AV1_POOL_COUNT; i++) {
+            const uint32_t total = fixed.back().pool[i].total_count;
+            EXPECT_EQ(total, initial.pool[i].total_count);
+            uint32_t max_allocated = initial.pool[i].allocated_count;
+            for (const SvtAv1PoolStats &stats : samples) {
+                EXPECT_LE(stats.pool[i].allocated_count, total)
+                    << "pool " << i << " grew past its size";
+                EXPECT_LE(stats.pool[i].in_use, stats.pool[i].allocated_count)
+                    << "pool " << i;
+                max_allocated =
+                    std::max(max_allocated, stats.pool[i].allocated_count);
+            }
+            if (initial.pool[i].allocated_count < total) {
+                EXPECT_EQ(1u, initial.pool[i].allocated_count) << "pool " << i;
+                grown |= max_allocated > 1;
+            }
+        }
+        EXPECT_TRUE(grown) << "no pool grew, pool_growth " << (int)growth;
+    }
+}
+
+/** @brief svt_av1_enc_reset starts a new stream on the same handle, which
+ * must be the stream of a fresh handle, whether the previous stream was
+ * drained or cut in the middle
+ */
+TEST(EncFeatureTest, reset_reencodes_same_stream) {
+    TestEncoder encoder;
+    encoder.config().level_of_parallelism = 4;
+    ASSERT_EQ(EB_ErrorNone, encoder.init());
+    const std::vector<uint8_t> ref = stream_of(encoder.encode(kFrames));
+    ASSERT_FALSE(ref.empty());
+
+    ASSERT_EQ(EB_ErrorNone, svt_av1_enc_reset(encoder.handle()));
+    EXPECT_EQ(ref, stream_of(encoder.encode(kFrames))) << "after drained stream";
+
+    // Cut the stream before its EOS, the packets left are dropped by reset
+    ASSERT_EQ(EB_ErrorNone, svt_av1_enc_reset(encoder.handle()));
+    Packet packet;
+    for (int n = 0; n < kFrames / 2; n++) {
+        ASSERT_EQ(EB_ErrorNone, encoder.send(n));
+        while (encoder.get_packet(false, &packet)) {
+        }
+    }
+    ASSERT_EQ(EB_ErrorNone, svt_av1_enc_reset(encoder.handle()));
+    EXPECT_EQ(ref, stream_of(encoder.encode(kFrames))) << "after cut stream";
+}
+
+/** Packet writer keeping a copy of each packet, in memory it hands out or in
+ * encoder memory */
+typedef struct {
+    bool app_memory;
+    std::vector<std::unique_ptr<uint8_t[]>> buffers;
+    uint8_t *last_buffer;
+    std::vector<Packet> packets;
+    int foreign_buffers;
+} PacketSink;
+
+static uint8_t *sink_get_buffer(void *opaque, uint32_t size) {
+    PacketSink *sink = (PacketSink *)opaque;
+    if (!sink->app_memory)
+        return nullptr;
+    sink->buffers.emplace_back(new uint8_t[size]);
+    sink->last_buffer = sink->buffers.back().get();
+    return sink->last_buffer;
+}
+
+static void sink_write(void *opaque, const EbBufferHeaderType *out) {
+    PacketSink *sink = (PacketSink *)opaque;
+    if (sink->app_memory && out->n_filled_len &&
+        out->p_buffer != sink->last_buffer)
+        sink->foreign_buffers++;
+    Packet packet;
+    packet.data.assign(out->p_buffer, out->p_buffer + out->n_filled_len);
+    packet.pts = out->pts;
+    packet.flags = out->flags;
+    packet.pic_type = out->pic_type;
+    packet.timestamps = out->timestamps;
+    sink->packets.push_back(packet);
+}
+
+/** @brief A packet writer gets every packet of the stream, in output order,
+ * in the memory it hands out or in encoder memory, while
+ * svt_av1_enc_get_packet only returns the EOS, without data
+ */
+TEST(EncFeatureTest, packet_writer_gets_every_packet_in_order) {
+    std::vector<Packet> ref;
+    {
+        TestEncoder encoder;
+        ASSERT_EQ(EB_ErrorNone, encoder.init());
+        ref = encoder.encode(kFrames);
+    }
+    ASSERT_FALSE(ref.empty());
+
+    for (bool app_memory : {true, false}) {
+        PacketSink sink;
+        sink.app_memory = app_memory;
+        sink.last_buffer = nullptr;
+        sink.foreign_buffers = 0;
+        SvtAv1PacketWriter writer = {sink_get_buffer, sink_write, &sink};
+        std::vector<Packet> queued;
+        {
+            TestEncoder encoder;
+            ASSERT_EQ(EB_ErrorNone,
+                      svt_av1_enc_set_packet_writer(encoder.handle(), &writer));
+            ASSERT_EQ(EB_ErrorNone, encoder.init());
+            queued = encoder.encode(kFrames);
+        }
+        ASSERT_EQ(1u, queued.size()) << "app_memory " << app_memory;
+        EXPECT_TRUE(queued[0].data.empty());
+        EXPECT_TRUE(queued[0].flags & EB_BUFFERFLAG_EOS);
+
+        ASSERT_EQ(ref.size(), sink.packets.size()) << "app_memory " << app_memory;
+        for (size_t i = 0; i < ref.size(); i++) {
+            EXPECT_EQ(ref[i].pts, sink.packets[i].pts) << "packet " << i;
+            EXPECT_EQ(ref[i].flags, sink.packets[i].flags) << "packet " << i;
+            EXPECT_EQ(ref[i].data, sink.packets[i].data) << "packet " << i;
+        }
+        EXPECT_EQ(0, sink.foreign_buffers) << "app_memory " << app_memory;
+    }
+}
+
+static void count_notify(void *opaque) {
+    ((std::atomic<int> *)opaque)->fetch_add(1);
+}
+
+/** @brief The output notify callback runs once per queued packet, before
+ * the packet can be taken, and does not change the stream
+ */
+TEST(EncFeatureTest, output_notify_once_per_packet) {
+    const std::vector<uint8_t> ref = encode_clip([](TestEncoder &) {});
+    ASSERT_FALSE(ref.empty());
+
+    std::atomic<int> notified(0);
+    TestEncoder encoder;
+    ASSERT_EQ(EB_ErrorNone,
+              svt_av1_enc_set_output_notify(
+                  encoder.handle(), count_notify, &notified));
+    ASSERT_EQ(EB_ErrorNone, encoder.init());
+    std::vector<Packet> packets;
+    Packet packet;
+    for (int n = 0; n < kFrames; n++) {
+        ASSERT_EQ(EB_ErrorNone, encoder.send(n));
+        // Every packet taken was announced first
+        while (encoder.get_packet(false, &packet)) {
+            packets.push_back(packet);
+            EXPECT_LE((int)packets.size(), notified.load());
+        }
+    }
+    ASSERT_EQ(EB_ErrorNone, encoder.send_eos());
+    encoder.drain(packets);
+    EXPECT_EQ((int)packets.size(), notified.load());
+    EXPECT_EQ(ref, stream_of(packets));
+}
+
+/** @brief speed_control only steps to presets faster than enc_mode, and
+ * keeps every picture of the stream, in order
+ */
+TEST(EncFeatureTest, speed_control_keeps_stream_valid) {
+    {
+        TestEncoder encoder;
+        encoder.config().speed_control = 2;
+        EXPECT_EQ(EB_ErrorBadParameter,
+                  svt_av1_enc_set_parameter(encoder.handle(), &encoder.config()));
+    }
+    for (int8_t max_preset : {(int8_t)-2, (int8_t)(MAX_ENC_PRESET + 1)}) {
+        TestEncoder encoder;
+        encoder.config().speed_control = 1;
+        encoder.config().speed_control_max_preset = max_preset;
+        EXPECT_EQ(EB_ErrorBadParameter,
+                  svt_av1_enc_set_parameter(encoder.handle(), &encoder.config()))
+            << "speed_control_max_preset " << (int)max_preset;
+    }
+    {
+        // Above the fastest supported preset, mapped to it
+        TestEncoder encoder;
+        encoder.config().speed_control = 1;
+        encoder.config().speed_control_max_preset = MAX_ENC_PRESET;
+        EXPECT_EQ(EB_ErrorNone, encoder.init());
+    }
+
+    // A frame rate low enough for the speed to be checked every mini-GOP
+    const auto setup = [](TestEncoder &enc) {
+        enc.config().enc_mode = 8;
+        enc.config().frame_rate_numerator = 16;
+        enc.config().frame_rate_denominator = 1;
+    };
+    std::vector<Packet> ref;
+    {
+        TestEncoder encoder;
+        setup(encoder);
+        ASSERT_EQ(EB_ErrorNone, encoder.init());
+        ref = encoder.encode(4 * kFrames);
+    }
+    ASSERT_FALSE(ref.empty());
+
+    // No preset faster than enc_mode allowed, the stream is the fixed one
+    for (int8_t max_preset : {(int8_t)0, (int8_t)8}) {
+        const std::vector<uint8_t> tst = encode_clip(
+            [&setup, max_preset](TestEncoder &enc) {
+                setup(enc);
+                enc.config().speed_control = 1;
+                enc.config().speed_control_max_preset = max_preset;
+            },
+            4 * kFrames);
+        EXPECT_EQ(stream_of(ref), tst)
+            << "speed_control_max_preset " << (int)max_preset;
+    }
+
+    // The presets used depend on the speed of the machine, not the pictures
+    std::vector<Packet> tst;
+    {
+        TestEncoder encoder;
+        setup(encoder);
+        encoder.config().speed_control = 1;
+        ASSERT_EQ(EB_ErrorNone, encoder.init());
+        tst = encoder.encode(4 * kFrames);
+    }
+    ASSERT_EQ(ref.size(), tst.size());
+    for (size_t i = 0; i < ref.size(); i++) {
+        EXPECT_EQ(ref[i].pts, tst[i].pts) << "packet " << i;
+        EXPECT_EQ(ref[i].pic_type, tst[i].pic_type) << "packet " << i;
+        EXPECT_EQ(ref[i].data.empty(), tst[i].data.empty()) << "packet " << i;
+    }
+}
+
+/** Nanoseconds of the clock the encoder stamps the packets with */
+static uint64_t monotonic_ns() {
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+/** @brief Each packet carries the times its picture went through the
+ * stages, in stage order, between the send of the picture and the return of
+ * the packet, and the packets are output in time order
+ */
+TEST(EncFeatureTest, packet_timestamps_follow_the_stages) {
+    TestEncoder encoder;
+    encoder.config().level_of_parallelism = 4;
+    ASSERT_EQ(EB_ErrorNone, encoder.init());
+
+    std::vector<uint64_t> sent(kFrames);
+    std::vector<Packet> packets;
+    std::vector<uint64_t> received;
+    Packet packet;
+    for (int n = 0; n < kFrames; n++) {
+        sent[n] = monotonic_ns();
+        ASSERT_EQ(EB_ErrorNone, encoder.send(n));
+        while (encoder.get_packet(false, &packet)) {
+            packets.push_back(packet);
+            received.push_back(monotonic_ns());
+        }
+    }
+    ASSERT_EQ(EB_ErrorNone, encoder.send_eos());
+    do {
+        if (!encoder.get_packet(true, &packet))
+            break;
+        packets.push_back(packet);
+        received.push_back(monotonic_ns());
+    } while (!(packet.flags & EB_BUFFERFLAG_EOS));
+    ASSERT_FALSE(packets.empty());
+
+    uint64_t prev_output = 0;
+    for (size_t i = 0; i < packets.size(); i++) {
+        const EbPictureTimestamps &t = packets[i].timestamps;
+        // A packet without data, like a lone EOS, holds no picture
+        if (packets[i].data.empty()) {
+            EXPECT_EQ(0u, t.resource_coordination) << "packet " << i;
+            EXPECT_EQ(0u, t.output) << "packet " << i;
+            continue;
+        }
+        ASSERT_GE(packets[i].pts, 0);
+        ASSERT_LT(packets[i].pts, kFrames);
+        const uint64_t stages[] = {sent[packets[i].pts],
+                                   t.resource_coordination,
+                                   t.picture_decision,
+                                   t.enc_dec_start,
+                                   t.enc_dec_end,
+                                   t.packetization,
+                                   t.output,
+                                   received[i]};
+        for (size_t s = 1; s < sizeof(stages) / sizeof(stages[0]); s++) {
+            EXPECT_NE(0u, stages[s]) << "packet " << i << " stage " << s;
+            EXPECT_LE(stages[s - 1], stages[s])
+                << "packet " << i << " stage " << s;
+        }
+        EXPECT_LE(prev_output, t.output) << "packet " << i;
+        prev_output = t.output;
+    }
+}
+
+/** @brief parallel_chunks encodes the closed GOPs of the input on parallel
+ * pipelines, each chunk must be the stream of a handle encoding only its
+ * frames, and the chunks are output in order
+ */
+TEST(EncFeatureTest, parallel_chunks_equal_chunk_encodes) {
+    const int chunk_frames = 16;
+    const int chunk_count = 3;
+    const auto setup = [chunk_frames](TestEncoder &enc) {
+        enc.config().intra_period_length = chunk_frames - 1;
+        enc.config().intra_refresh_type = SVT_AV1_KF_REFRESH;
+    };
+    std::vector<uint8_t> ref;
+    for (int c = 0; c < chunk_count; c++) {
+        TestEncoder encoder;
+        setup(encoder);
+        ASSERT_EQ(EB_ErrorNone, encoder.init());
+        const std::vector<uint8_t> chunk =
+            stream_of(encoder.encode(chunk_frames, c * chunk_frames));
+        ASSERT_FALSE(chunk.empty()) << "chunk " << c;
+        ref.insert(ref.end(), chunk.begin(), chunk.end());
+    }
+
+    for (uint8_t chunks : {2, 3}) {
+        std::vector<Packet> packets;
+        {
+            TestEncoder encoder;
+            setup(encoder);
+            encoder.config().parallel_chunks = chunks;
+            ASSERT_EQ(EB_ErrorNone, encoder.init());
+            packets = encoder.encode(chunk_count * chunk_frames);
+        }
+        EXPECT_EQ(ref, stream_of(packets)) << "parallel_chunks " << (int)chunks;
+        // Each chunk starts with its key frame, right after the previous one
+        int64_t chunk_end = -1;
+        for (size_t i = 0; i < packets.size(); i++) {
+            if (packets[i].pic_type == EB_AV1_KEY_PICTURE) {
+                EXPECT_EQ(chunk_end + 1, packets[i].pts) << "packet " << i;
+                chunk_end = packets[i].pts + chunk_frames - 1;
+            }
+            EXPECT_LE(packets[i].pts, chunk_end) << "packet " << i;
+        }
+    }
+
+    // Chunks need closed GOPs
+    TestEncoder encoder;
+    encoder.config().parallel_chunks = 2;
+    encoder.config().intra_refresh_type = SVT_AV1_FWDKF_REFRESH;
+    EXPECT_EQ(EB_ErrorBadParameter,
+              svt_av1_enc_set_parameter(encoder.handle(), &encoder.config()));
+}
+
+/** Motion hints of a picture of the clip, every block with the vector
+ * (mv_x, mv_y) */
+static SvtAv1MotionHints make_hints(uint8_t trust, int16_t mv_x, int16_t mv_y,
+                                    std::vector<int16_t> &mv) {
+    SvtAv1MotionHints hints;
+    hints.block_size = 16;
+    hints.trust = trust;
+    hints.cols = kWidth / 16;
+    hints.rows = kHeight / 16;
+    mv.resize(2 * hints.cols * hints.rows);
+    for (size_t i = 0; i < mv.size(); i += 2) {
+        mv[i] = mv_x;
+        mv[i + 1] = mv_y;
+    }
+    hints.mv = mv.data();
+    return hints;
+}
+
+/** Encodes the clip with the same hints on every picture */
+static std::vector<Packet> encode_with_hints(const SvtAv1MotionHints &hints) {
+    TestEncoder encoder;
+    EXPECT_EQ(EB_ErrorNone, encoder.init());
+    EbPrivDataNode node;
+    memset(&node, 0, sizeof(node));
+    node.node_type = MV_HINT_EVENT;
+    node.data = (void *)&hints;
+    node.size = sizeof(hints);
+    std::vector<Packet> packets;
+    Packet packet;
+    for (int n = 0; n < kFrames; n++) {
+        EXPECT_EQ(EB_ErrorNone, encoder.send(n, &node));
+        while (encoder.get_packet(false, &packet)) packets.push_back(packet);
+    }
+    EXPECT_EQ(EB_ErrorNone, encoder.send_eos());
+    encoder.drain(packets);
+    return packets;
+}
+
+/** @brief Motion hints are validated when the picture is sent, and valid
+ * ones reach motion estimation without breaking the stream
+ */
+TEST(EncFeatureTest, motion_hints_validated_and_used) {
+    std::vector<Packet> ref;
+    {
+        TestEncoder encoder;
+        ASSERT_EQ(EB_ErrorNone, encoder.init());
+        ref = encoder.encode(kFrames);
+    }
+    ASSERT_FALSE(ref.empty());
+
+    // Like the other per-picture events, invalid hints end the stream
+    std::vector<int16_t> mv;
+    std::vector<std::pair<SvtAv1MotionHints, uint32_t>> invalid;
+    SvtAv1MotionHints hints = make_hints(SVT_AV1_MV_HINT_SEED, 0, 0, mv);
+    invalid.emplace_back(hints, (uint32_t)sizeof(hints) - 1);
+    hints.block_size = 12;
+    invalid.emplace_back(hints, (uint32_t)sizeof(hints));
+    for (uint8_t trust : {0, 3}) {
+        hints = make_hints(trust, 0, 0, mv);
+        invalid.emplace_back(hints, (uint32_t)sizeof(hints));
+    }
+    hints = make_hints(SVT_AV1_MV_HINT_SEED, 0, 0, mv);
+    hints.cols = 0;
+    invalid.emplace_back(hints, (uint32_t)sizeof(hints));
+    hints = make_hints(SVT_AV1_MV_HINT_SEED, 0, 0, mv);
+    hints.mv = nullptr;
+    invalid.emplace_back(hints, (uint32_t)sizeof(hints));
+    for (size_t i = 0; i < invalid.size(); i++) {
+        TestEncoder encoder;
+        ASSERT_EQ(EB_ErrorNone, encoder.init());
+        EbPrivDataNode node;
+        memset(&node, 0, sizeof(node));
+        node.node_type = MV_HINT_EVENT;
+        node.data = &invalid[i].first;
+        node.size = invalid[i].second;
+        ASSERT_EQ(EB_ErrorNone, encoder.send(0));
+        EXPECT_EQ(EB_ErrorBadParameter, encoder.send(1, &node)) << "hints " << i;
+        std::vector<Packet> packets;
+        encoder.drain(packets);
+        for (const Packet &packet : packets)
+            EXPECT_LE(packet.pts, 1) << "hints " << i;
+    }
+
+    // The texture of the clip moves by (1, 1 / 2) pixel per picture
+    for (uint8_t trust : {SVT_AV1_MV_HINT_SEED, SVT_AV1_MV_HINT_REPLACE_HME}) {
+        const std::vector<Packet> tst =
+            encode_with_hints(make_hints(trust, 8, 4, mv));
+        ASSERT_EQ(ref.size(), tst.size()) << "trust " << (int)trust;
+        for (size_t i = 0; i < ref.size(); i++) {
+            EXPECT_EQ(ref[i].pts, tst[i].pts) << "packet " << i;
+            EXPECT_EQ(ref[i].pic_type, tst[i].pic_type) << "packet " << i;
+        }
+    }
+    // Trusted wrong hints steer the search away from the motion
+    const std::vector<Packet> wrong =
+        encode_with_hints(make_hints(SVT_AV1_MV_HINT_REPLACE_HME, -256, 192, mv));
+    EXPECT_NE(stream_of(ref), stream_of(wrong));
+}
+
+/** Checks the analysis export of a coded picture against the clip */
+static void check_analysis(const SvtAv1AnalysisExport *a, bool intra) {
+    EXPECT_EQ(kWidth, a->width);
+    EXPECT_EQ(kHeight, a->height);
+    EXPECT_LE(a->ref_count[0], 4);
+    EXPECT_LE(a->ref_count[1], 3);
+    for (int l = 0; l < a->ref_count[0] + a->ref_count[1]; l++)
+        EXPECT_LT(a->ref_picture[l], a->picture_number + 32);
+
+    ASSERT_TRUE(a->sb_size == 64 || a->sb_size == 128);
+    EXPECT_EQ((kWidth + a->sb_size - 1) / a->sb_size, a->sb_cols);
+    EXPECT_EQ((kHeight + a->sb_size - 1) / a->sb_size, a->sb_rows);
+    ASSERT_NE(nullptr, a->sb_qindex);
+    for (int i = 0; i < a->sb_cols * a->sb_rows; i++)
+        EXPECT_NE(0, a->sb_qindex[i]) << "superblock " << i;
+
+    if (!intra) {
+        EXPECT_EQ(kWidth / 64, a->me_cols);
+        EXPECT_EQ(kHeight / 64, a->me_rows);
+        EXPECT_GT(a->me_ref_count, 0);
+        EXPECT_LE(a->me_ref_count, SVT_AV1_ANALYSIS_REFS);
+        ASSERT_NE(nullptr, a->me_mv);
+        ASSERT_NE(nullptr, a->me_ref_mask);
+        for (int i = 0; i < a->me_cols * a->me_rows * 85; i++)
+            EXPECT_EQ(0, a->me_ref_mask[i] >> a->me_ref_count)
+                << "square block " << i;
+    }
+
+    // The coded blocks tile the picture
+    ASSERT_GT(a->block_count, 0u);
+    ASSERT_NE(nullptr, a->blocks);
+    uint32_t area = 0;
+    for (uint32_t i = 0; i < a->block_count; i++) {
+        const SvtAv1BlockAnalysis &b = a->blocks[i];
+        EXPECT_LE((uint32_t)(b.x + b.width), kWidth) << "block " << i;
+        EXPECT_LE((uint32_t)(b.y + b.height), kHeight) << "block " << i;
+        if (intra) {
+            EXPECT_EQ(0, b.ref_frame[0]) << "block " << i;
+        }
+        area += b.width * b.height;
+    }
+    EXPECT_EQ(kWidth * kHeight, area);
+}
+
+/** @brief export_analysis attaches the analysis of every coded picture to
+ * its packet, without changing the stream
+ */
+TEST(EncFeatureTest, export_analysis_describes_every_picture) {
+    const std::vector<uint8_t> ref = encode_clip([](TestEncoder &) {});
+    ASSERT_FALSE(ref.empty());
+
+    TestEncoder encoder;
+    encoder.config().export_analysis = true;
+    ASSERT_EQ(EB_ErrorNone, encoder.init());
+    std::vector<uint8_t> stream;
+    std::vector<int> coded(kFrames, 0);
+    bool eos = false;
+    for (int n = 0; n <= kFrames && !eos; n++) {
+        if (n < kFrames)
+            ASSERT_EQ(EB_ErrorNone, encoder.send(n));
+        else
+            ASSERT_EQ(EB_ErrorNone, encoder.send_eos());
+        EbBufferHeaderType *out = nullptr;
+        while (!eos &&
+               svt_av1_enc_get_packet(encoder.handle(), &out, n == kFrames) ==
+                   EB_ErrorNone &&
+               out) {
+            stream.insert(stream.end(), out->p_buffer,
+                          out->p_buffer + out->n_filled_len);
+            eos = (out->flags & EB_BUFFERFLAG_EOS) != 0;
+            for (const SvtAv1AnalysisExport *a = out->analysis; a; a = a->next) {
+                ASSERT_LT(a->picture_number, (uint64_t)kFrames);
+                coded[a->picture_number]++;
+                check_analysis(a, out->pic_type == EB_AV1_KEY_PICTURE &&
+                                      a == out->analysis);
+            }
+            svt_av1_enc_release_out_buffer(&out);
+        }
+    }
+    EXPECT_TRUE(eos);
+    EXPECT_EQ(ref, stream);
+    for (int n = 0; n < kFrames; n++)
+        EXPECT_EQ(1, coded[n]) << "picture " << n;
+}
+
+/** Screen content frame n: the 6 noise tiles of 64x64 permuted by n, tile t
+ * at position (t - n) mod 6 of the 3x2 grid. The top left 32x32 block of tile
+ * 5 changes with each frame. */
+static void fill_tile_frame(int n, std::vector<uint8_t> &yuv) {
+    const uint32_t luma_size = kWidth * kHeight;
+    yuv.assign(luma_size * 3 / 2, 128);
+    for (int p = 0; p < 6; p++) {
+        const int t = (p + n) % 6;
+        for (uint32_t y = 0; y < 64; y++) {
+            for (uint32_t x = 0; x < 64; x++) {
+                const bool fresh = t == 5 && x < 32 && y < 32;
+                uint32_t v = ((fresh ? 1000 + n : t) * 4096 + y * 64 + x) *
+                             2654435761u;
+                v ^= v >> 15;
+                yuv[((p / 3) * 64 + y) * kWidth + (p % 3) * 64 + x] =
+                    (uint8_t)(v * 2246822519u >> 24);
+            }
+        }
+    }
+}
+
+/** @brief The hash based motion search of screen content finds the exact
+ * copies out of the search area: the motion estimation vectors of the copied
+ * blocks are their displacement, both when every block of a 64x64 block is a
+ * copy and when only some are, and the searched vectors are replaced
+ */
+TEST(EncFeatureTest, hash_me_finds_block_copies) {
+    TestEncoder encoder;
+    encoder.config().screen_content_mode = 1;
+    encoder.config().enable_tf = 0;
+    encoder.config().export_analysis = true;
+    ASSERT_EQ(EB_ErrorNone, encoder.init());
+    const int frames = 12;
+    int checked = 0, checked_partial = 0;
+    bool eos = false;
+    for (int n = 0; n <= frames && !eos; n++) {
+        std::vector<uint8_t> yuv;
+        fill_tile_frame(n, yuv);
+        if (n < frames)
+            ASSERT_EQ(EB_ErrorNone, encoder.send_frame(yuv, n));
+        else
+            ASSERT_EQ(EB_ErrorNone, encoder.send_eos());
+        EbBufferHeaderType *out = nullptr;
+        while (!eos &&
+               svt_av1_enc_get_packet(encoder.handle(), &out, n == frames) ==
+                   EB_ErrorNone &&
+               out) {
+            eos = (out->flags & EB_BUFFERFLAG_EOS) != 0;
+            for (const SvtAv1AnalysisExport *a = out->analysis; a; a = a->next) {
+                if (!a->me_ref_count)
+                    continue;
+                ASSERT_EQ(3, a->me_cols);
+                ASSERT_EQ(2, a->me_rows);
+                for (int p = 0; p < 6; p++) {
+                    const int t = (int)((p + a->picture_number) % 6);
+                    for (int r = 0; r < a->me_ref_count; r++) {
+                        // Position of the tile in the reference
+                        const uint64_t ref =
+                            a->ref_picture[a->me_ref_frame[r] - 1];
+                        const int q = (int)((t + 6 - ref % 6) % 6);
+                        const int mv_x = (q % 3 - p % 3) * 64;
+                        const int mv_y = (q / 3 - p / 3) * 64;
+                        for (int pu = 0; pu < 85; pu++) {
+                            // Size and position in the 64x64 block
+                            const int size = pu ? pu < 5 ? 32 : pu < 21 ? 16 : 8
+                                                : 64;
+                            const int i = pu ? pu < 5 ? pu - 1
+                                               : pu < 21 ? pu - 5
+                                                         : pu - 21
+                                             : 0;
+                            const int x = i % (64 / size) * size;
+                            const int y = i / (64 / size) * size;
+                            if (t == 5 && x < 32 && y < 32)
+                                continue;
+                            const int b = p * 85 + pu;
+                            if (!((a->me_ref_mask[b] >> r) & 1))
+                                continue;
+                            const int16_t *mv =
+                                a->me_mv + 2 * (b * a->me_ref_count + r);
+                            EXPECT_EQ(mv_x, mv[0])
+                                << "picture " << a->picture_number
+                                << " block " << b << " reference " << ref;
+                            EXPECT_EQ(mv_y, mv[1])
+                                << "picture " << a->picture_number
+                                << " block " << b << " reference " << ref;
+                            checked++;
+                            if (t == 5)
+                                checked_partial++;
+                        }
+                    }
+                }
+            }
+            svt_av1_enc_release_out_buffer(&out);
+        }
+    }
+    EXPECT_TRUE(eos);
+    EXPECT_GT(checked, 0);
+    EXPECT_GT(checked_partial, 0);
+}
+
+}  // namespace
@@ -0,0 +1,905 @@
+/*
+ * Copyright(c) 2025 Alliance for Open Media
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at https://www.aomedia.org/license/software-license. If the
+ * Alliance for Open Media Patent License 1.0 was not distributed with this
+ * source code in the PATENTS file, you can obtain it at
+ * https://www.aomedia.org/license/patent-license.
+ */
+
+/******************************************************************************
+ * @file RtcdBenchmark.cc
+ *
+ * @brief Microbenchmark of the run time dispatched (RTCD) kernels:
+ * - SAD, SADx4d, variance, sub-pixel variance and high bit depth variance
+ * - OBMC SAD, variance and sub-pixel variance
+ * - low and high bit depth intra predictors
+ * - forward (full, N2 and N4) and inverse 2D transforms
+ * - hadamard, SATD, SSE, block error, quantizers, residual, distortion,
+ *   convolution, blending and loop filter kernels
+ *
+ * Every kernel is timed at each ISA level the CPU supports, by restricting the
+ * CPU flags given to the RTCD setup to the ones up to the level. A level that
+ * selects the same function as the level below is not reported. The command
+ * line and the JSON report follow the ones of google-benchmark, so its tools
+ * (e.g. compare.py) can be used on the results.
+ *
+ ******************************************************************************/
+
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "aom_dsp_rtcd.h"
+#include "convolve.h"
+#include "hash.h"
+#include "inter_prediction.h"
+#include "random.h"
+
+using svt_av1_test_tool::SVTRandom;
+
+namespace {
+
+/** Generic function pointer type the RTCD pointers are stored as */
+typedef void (*GenericFn)(void);
+
+/** Buffers shared by all the kernels, large enough for 128x128 blocks with
+ * the borders of the convolution and loop filter kernels */
+static const int kStride = 2 * MAX_SB_SIZE;
+static const int kRows = 2 * MAX_SB_SIZE;
+static const int kBorder = 16;
+static const int kCoeffs = MAX_SB_SQUARE;
+
+struct Buffers {
+    DECLARE_ALIGNED(64, uint8_t, src8[kStride * kRows]);
+    DECLARE_ALIGNED(64, uint8_t, ref8[kStride * kRows]);
+    DECLARE_ALIGNED(64, uint8_t, dst8[kStride * kRows]);
+    DECLARE_ALIGNED(64, uint8_t, mask8[kStride * kRows]);
+    DECLARE_ALIGNED(64, uint16_t, src16[kStride * kRows]);
+    DECLARE_ALIGNED(64, uint16_t, ref16[kStride * kRows]);
+    DECLARE_ALIGNED(64, uint16_t, dst16[kStride * kRows]);
+    DECLARE_ALIGNED(64, int16_t, diff16[kStride * kRows]);
+    DECLARE_ALIGNED(64, int16_t, resid16[kStride * kRows]);
+    DECLARE_ALIGNED(64, int32_t, wsrc[kCoeffs]);
+    DECLARE_ALIGNED(64, int32_t, obmc_mask[kCoeffs]);
+    DECLARE_ALIGNED(64, int32_t, coeff[kCoeffs]);
+    DECLARE_ALIGNED(64, int32_t, dqcoeff[kCoeffs]);
+    DECLARE_ALIGNED(64, int32_t, qcoeff[kCoeffs]);
+    DECLARE_ALIGNED(64, int32_t, out32[kCoeffs]);
+    DECLARE_ALIGNED(64, int16_t, scan[kCoeffs]);
+    DECLARE_ALIGNED(64, uint8_t, above8[4 * MAX_SB_SIZE]);
+    DECLARE_ALIGNED(64, uint8_t, left8[4 * MAX_SB_SIZE]);
+    DECLARE_ALIGNED(64, uint16_t, above16[4 * MAX_SB_SIZE]);
+    DECLARE_ALIGNED(64, uint16_t, left16[4 * MAX_SB_SIZE]);
+    DECLARE_ALIGNED(16, uint8_t, blimit[16]);
+    DECLARE_ALIGNED(16, uint8_t, limit[16]);
+    DECLARE_ALIGNED(16, uint8_t, thresh[16]);
+    int16_t zbin[2], round[2], quant[2], quant_shift[2], dequant[2];
+
+    // Blocks start past the top left border so kernels may read around them
+    uint8_t *src() {
+        return src8 + kBorder * kStride + kBorder;
+    }
+    uint8_t *ref() {
+        return ref8 + kBorder * kStride + kBorder;
+    }
+    uint16_t *src_hbd() {
+        return src16 + kBorder * kStride + kBorder;
+    }
+    uint16_t *ref_hbd() {
+        return ref16 + kBorder * kStride + kBorder;
+    }
+    // Intra predictors read above[-1] and up to twice the block size
+    uint8_t *above() {
+        return above8 + kBorder;
+    }
+    uint8_t *left() {
+        return left8 + kBorder;
+    }
+    uint16_t *above_hbd() {
+        return above16 + kBorder;
+    }
+    uint16_t *left_hbd() {
+        return left16 + kBorder;
+    }
+
+    void init() {
+        SVTRandom rnd8(8, false), rnd10(10, false), rnd_mask(0, 64);
+        SVTRandom rnd_resid(9, true), rnd_coeff(-64, 64);
+        for (int i = 0; i < kStride * kRows; i++) {
+            src8[i] = rnd8.random();
+            ref8[i] = rnd8.random();
+            dst8[i] = rnd8.random();
+            mask8[i] = rnd_mask.random();
+            src16[i] = rnd10.random();
+            ref16[i] = rnd10.random();
+            dst16[i] = rnd10.random();
+            diff16[i] = rnd_resid.random();
+            resid16[i] = rnd_resid.random();
+        }
+        for (int i = 0; i < kCoeffs; i++) {
+            obmc_mask[i] = rnd_mask.random();
+            wsrc[i] = (src8[i] * obmc_mask[i]) << 6;
+            coeff[i] = rnd_coeff.random() * 16;
+            dqcoeff[i] = rnd_coeff.random() * 16;
+            scan[i] = i;
+        }
+        for (int i = 0; i < 4 * MAX_SB_SIZE; i++) {
+            above8[i] = rnd8.random();
+            left8[i] = rnd8.random();
+            above16[i] = rnd10.random();
+            left16[i] = rnd10.random();
+        }
+        memset(blimit, 60, sizeof(blimit));
+        memset(limit, 20, sizeof(limit));
+        memset(thresh, 10, sizeof(thresh));
+        // Quantizer of a mid range qindex
+        zbin[0] = 58, zbin[1] = 67;
+        round[0] = 40, round[1] = 48;
+        quant[0] = 26214, quant[1] = 21845;
+        quant_shift[0] = 16384, quant_shift[1] = 16384;
+        dequant[0] = 100, dequant[1] = 120;
+    }
+};
+
+/** Calls the kernel fn of size w x h once */
+typedef void (*RunFn)(GenericFn fn, Buffers &buf, int w, int h);
+
+/** A registered kernel: the RTCD pointer it is dispatched through and how to
+ * call it */
+struct Kernel {
+    std::string name;
+    GenericFn *slot;
+    RunFn run;
+    int w, h;
+};
+
+// Static, for the alignment of the buffers
+static Buffers buffers;
+volatile uint64_t sink;
+
+/* Adapters, one per kernel signature */
+
+static void run_sad(GenericFn fn, Buffers &b, int, int) {
+    typedef uint32_t (*Fn)(const uint8_t *, int, const uint8_t *, int);
+    sink += ((Fn)fn)(b.src(), kStride, b.ref(), kStride);
+}
+
+static void run_sad_x4d(GenericFn fn, Buffers &b, int, int) {
+    typedef void (*Fn)(const uint8_t *, int, const uint8_t *const[], int,
+                       uint32_t *);
+    const uint8_t *const refs[4] = {
+        b.ref(), b.ref() + 1, b.ref() + kStride, b.ref() + kStride + 1};
+    uint32_t sad[4];
+    ((Fn)fn)(b.src(), kStride, refs, kStride, sad);
+    sink += sad[0] + sad[3];
+}
+
+static void run_variance(GenericFn fn, Buffers &b, int, int) {
+    typedef unsigned int (*Fn)(
+        const uint8_t *, int, const uint8_t *, int, unsigned int *);
+    unsigned int sse;
+    sink += ((Fn)fn)(b.src(), kStride, b.ref(), kStride, &sse);
+}
+
+static void run_highbd_variance(GenericFn fn, Buffers &b, int, int) {
+    typedef unsigned int (*Fn)(
+        const uint8_t *, int, const uint8_t *, int, unsigned int *);
+    unsigned int sse;
+    sink += ((Fn)fn)(CONVERT_TO_BYTEPTR(b.src_hbd()),
+                     kStride,
+                     CONVERT_TO_BYTEPTR(b.ref_hbd()),
+                     kStride,
+                     &sse);
+}
+
+static void run_sub_pixel_variance(GenericFn fn, Buffers &b, int, int) {
+    typedef uint32_t (*Fn)(
+        const uint8_t *, int, int, int, const uint8_t *, int, uint32_t *);
+    uint32_t sse;
+    sink += ((Fn)fn)(b.src(), kStride, 3, 5, b.ref(), kStride, &sse);
+}
+
+static void run_obmc_sad(GenericFn fn, Buffers &b, int, int) {
+    typedef unsigned int (*Fn)(
+        const uint8_t *, int, const int32_t *, const int32_t *);
+    sink += ((Fn)fn)(b.ref(), kStride, b.wsrc, b.obmc_mask);
+}
+
+static void run_obmc_variance(GenericFn fn, Buffers &b, int, int) {
+    typedef unsigned int (*Fn)(const uint8_t *,
+                               int,
+                               const int32_t *,
+                               const int32_t *,
+                               unsigned int *);
+    unsigned int sse;
+    sink += ((Fn)fn)(b.ref(), kStride, b.wsrc, b.obmc_mask, &sse);
+}
+
+static void run_obmc_sub_pixel_variance(GenericFn fn, Buffers &b, int, int) {
+    typedef unsigned int (*Fn)(const uint8_t *,
+                               int,
+                               int,
+                               int,
+                               const int32_t *,
+                               const int32_t *,
+                               unsigned int *);
+    unsigned int sse;
+    sink += ((Fn)fn)(b.ref(), kStride, 3, 5, b.wsrc, b.obmc_mask, &sse);
+}
+
+static void run_intra_pred(GenericFn fn, Buffers &b, int, int) {
+    typedef void (*Fn)(uint8_t *, ptrdiff_t, const uint8_t *, const uint8_t *);
+    ((Fn)fn)(b.dst8, kStride, b.above(), b.left());
+}
+
+static void run_highbd_intra_pred(GenericFn fn, Buffers &b, int, int) {
+    typedef void (*Fn)(
+        uint16_t *, ptrdiff_t, const uint16_t *, const uint16_t *, int32_t);
+    ((Fn)fn)(b.dst16, kStride, b.above_hbd(), b.left_hbd(), 10);
+}
+
+static void run_fwd_txfm(GenericFn fn, Buffers &b, int, int) {
+    typedef void (*Fn)(int16_t *, int32_t *, uint32_t, TxType, uint8_t);
+    ((Fn)fn)(b.diff16, b.out32, kStride, DCT_DCT, 8);
+}
+
+static void run_inv_txfm(GenericFn fn, Buffers &b, int, int) {
+    typedef void (*Fn)(const int32_t *,
+                       uint16_t *,
+                       int32_t,
+                       uint16_t *,
+                       int32_t,
+                       TxType,
+                       int32_t);
+    ((Fn)fn)(b.coeff, b.ref16, kStride, b.dst16, kStride, DCT_DCT, 10);
+}
+
+static void run_hadamard(GenericFn fn, Buffers &b, int, int) {
+    typedef void (*Fn)(const int16_t *, ptrdiff_t, int32_t *);
+    ((Fn)fn)(b.diff16, kStride, b.out32);
+}
+
+static void run_satd(GenericFn fn, Buffers &b, int w, int h) {
+    typedef int (*Fn)(const TranLow *, int);
+    sink += ((Fn)fn)(b.coeff, w * h);
+}
+
+static void run_block_error(GenericFn fn, Buffers &b, int w, int h) {
+    typedef int64_t (*Fn)(const TranLow *, const TranLow *, intptr_t,
+                          int64_t *);
+    int64_t ssz;
+    sink += ((Fn)fn)(b.coeff, b.dqcoeff, w * h, &ssz);
+}
+
+static void run_sse(GenericFn fn, Buffers &b, int w, int h) {
+    typedef int64_t (*Fn)(const uint8_t *, int, const uint8_t *, int, int,
+                          int);
+    sink += ((Fn)fn)(b.src(), kStride, b.ref(), kStride, w, h);
+}
+
+static void run_highbd_sse(GenericFn fn, Buffers &b, int w, int h) {
+    typedef int64_t (*Fn)(const uint8_t *, int, const uint8_t *, int, int,
+                          int);
+    sink += ((Fn)fn)((const uint8_t *)b.src_hbd(),
+                     kStride,
+                     (const uint8_t *)b.ref_hbd(),
+                     kStride,
+                     w,
+                     h);
+}
+
+static void run_subtract_block(GenericFn fn, Buffers &b, int w, int h) {
+    typedef void (*Fn)(int,
+                       int,
+                       int16_t *,
+                       ptrdiff_t,
+                       const uint8_t *,
+                       ptrdiff_t,
+                       const uint8_t *,
+                       ptrdiff_t);
+    ((Fn)fn)(h, w, b.diff16, kStride, b.src(), kStride, b.ref(), kStride);
+}
+
+static void run_residual(GenericFn fn, Buffers &b, int w, int h) {
+    typedef void (*Fn)(uint8_t *,
+                       uint32_t,
+                       uint8_t *,
+                       uint32_t,
+                       int16_t *,
+                       uint32_t,
+                       uint32_t,
+                       uint32_t);
+    ((Fn)fn)(b.src(), kStride, b.ref(), kStride, b.diff16, kStride, w, h);
+}
+
+static void run_spatial_distortion(GenericFn fn, Buffers &b, int w, int h) {
+    typedef uint64_t (*Fn)(uint8_t *,
+                           uint32_t,
+                           uint32_t,
+                           uint8_t *,
+                           int32_t,
+                           uint32_t,
+                           uint32_t,
+                           uint32_t);
+    sink += ((Fn)fn)(b.src8, 0, kStride, b.ref8, 0, kStride, w, h);
+}
+
+static void run_quantize_fp(GenericFn fn, Buffers &b, int w, int h) {
+    typedef void (*Fn)(const TranLow *,
+                       intptr_t,
+                       const int16_t *,
+                       const int16_t *,
+                       const int16_t *,
+                       const int16_t *,
+                       TranLow *,
+                       TranLow *,
+                       const int16_t *,
+                       uint16_t *,
+                       const int16_t *,
+                       const int16_t *);
+    uint16_t eob;
+    ((Fn)fn)(b.coeff,
+             w * h,
+             b.zbin,
+             b.round,
+             b.quant,
+             b.quant_shift,
+             b.qcoeff,
+             b.dqcoeff,
+             b.dequant,
+             &eob,
+             b.scan,
+             b.scan);
+    sink += eob;
+}
+
+static void run_quantize_b(GenericFn fn, Buffers &b, int w, int h) {
+    typedef void (*Fn)(const TranLow *,
+                       intptr_t,
+                       const int16_t *,
+                       const int16_t *,
+                       const int16_t *,
+                       const int16_t *,
+                       TranLow *,
+                       TranLow *,
+                       const int16_t *,
+                       uint16_t *,
+                       const int16_t *,
+                       const int16_t *,
+                       const QmVal *,
+                       const QmVal *,
+                       const int32_t);
+    uint16_t eob;
+    ((Fn)fn)(b.coeff,
+             w * h,
+             b.zbin,
+             b.round,
+             b.quant,
+             b.quant_shift,
+             b.qcoeff,
+             b.dqcoeff,
+             b.dequant,
+             &eob,
+             b.scan,
+             b.scan,
+             NULL,
+             NULL,
+             0);
+    sink += eob;
+}
+
+static void run_ssim_parms(GenericFn fn, Buffers &b, int, int) {
+    typedef void (*Fn)(const uint8_t *,
+                       int,
+                       const uint8_t *,
+                       int,
+                       uint32_t *,
+                       uint32_t *,
+                       uint32_t *,
+                       uint32_t *,
+                       uint32_t *);
+    uint32_t sum_s = 0, sum_r = 0, sum_sq_s = 0, sum_sq_r = 0, sum_sxr = 0;
+    ((Fn)fn)(b.src(),
+             kStride,
+             b.ref(),
+             kStride,
+             &sum_s,
+             &sum_r,
+             &sum_sq_s,
+             &sum_sq_r,
+             &sum_sxr);
+    sink += sum_sxr;
+}
+
+static void run_crc32c(GenericFn fn, Buffers &b, int w, int) {
+    typedef uint32_t (*Fn)(const uint8_t *, size_t);
+    sink += ((Fn)fn)(b.src(), w);
+}
+
+static void run_block_2x2_hash_row(GenericFn fn, Buffers &b, int w, int) {
+    typedef void (*Fn)(const uint8_t *,
+                       int,
+                       int,
+                       CRC_CALCULATOR *,
+                       uint32_t *,
+                       uint32_t *,
+                       int8_t *,
+                       int8_t *);
+    static CRC_CALCULATOR crc_calculator;
+    if (!crc_calculator.bits)
+        svt_av1_crc_calculator_init(&crc_calculator, 24, 0x5D6DCB);
+    ((Fn)fn)(b.src(),
+             kStride,
+             w,
+             &crc_calculator,
+             (uint32_t *)b.out32,
+             (uint32_t *)b.out32 + w,
+             (int8_t *)b.dst8,
+             (int8_t *)b.dst8 + w);
+    sink += b.out32[0];
+}
+
+static void run_convolve_2d_sr(GenericFn fn, Buffers &b, int w, int h) {
+    typedef void (*Fn)(const uint8_t *,
+                       int32_t,
+                       uint8_t *,
+                       int32_t,
+                       int32_t,
+                       int32_t,
+                       InterpFilterParams *,
+                       InterpFilterParams *,
+                       const int32_t,
+                       const int32_t,
+                       ConvolveParams *);
+    InterpFilterParams filter_x =
+        av1_get_interp_filter_params_with_block_size(EIGHTTAP_REGULAR, w);
+    InterpFilterParams filter_y =
+        av1_get_interp_filter_params_with_block_size(EIGHTTAP_REGULAR, h);
+    ConvolveParams conv_params =
+        get_conv_params_no_round(0, 0, 0, NULL, 0, 0, 8);
+    ((Fn)fn)(b.src(),
+             kStride,
+             b.dst8,
+             kStride,
+             w,
+             h,
+             &filter_x,
+             &filter_y,
+             5,
+             7,
+             &conv_params);
+}
+
+static void run_highbd_convolve_2d_sr(GenericFn fn, Buffers &b, int w, int h) {
+    typedef void (*Fn)(const uint16_t *,
+                       int32_t,
+                       uint16_t *,
+                       int32_t,
+                       int32_t,
+                       int32_t,
+                       const InterpFilterParams *,
+                       const InterpFilterParams *,
+                       const int32_t,
+                       const int32_t,
+                       ConvolveParams *,
+                       int32_t);
+    InterpFilterParams filter_x =
+        av1_get_interp_filter_params_with_block_size(EIGHTTAP_REGULAR, w);
+    InterpFilterParams filter_y =
+        av1_get_interp_filter_params_with_block_size(EIGHTTAP_REGULAR, h);
+    ConvolveParams conv_params =
+        get_conv_params_no_round(0, 0, 0, NULL, 0, 0, 10);
+    ((Fn)fn)(b.src_hbd(),
+             kStride,
+             b.dst16,
+             kStride,
+             w,
+             h,
+             &filter_x,
+             &filter_y,
+             5,
+             7,
+             &conv_params,
+             10);
+}
+
+static void run_blend_a64_mask(GenericFn fn, Buffers &b, int w, int h) {
+    typedef void (*Fn)(uint8_t *,
+                       uint32_t,
+                       const uint8_t *,
+                       uint32_t,
+                       const uint8_t *,
+                       uint32_t,
+                       const uint8_t *,
+                       uint32_t,
+                       int,
+                       int,
+                       int,
+                       int);
+    ((Fn)fn)(b.dst8,
+             kStride,
+             b.src(),
+             kStride,
+             b.ref(),
+             kStride,
+             b.mask8,
+             kStride,
+             w,
+             h,
+             0,
+             0);
+}
+
+static void run_wedge_sse(GenericFn fn, Buffers &b, int w, int h) {
+    typedef uint64_t (*Fn)(const int16_t *, const int16_t *, const uint8_t *,
+                           int);
+    sink += ((Fn)fn)(b.resid16, b.diff16, b.mask8, w * h);
+}
+
+static void run_loop_filter(GenericFn fn, Buffers &b, int, int) {
+    typedef void (*Fn)(uint8_t *, int32_t, const uint8_t *, const uint8_t *,
+                       const uint8_t *);
+    ((Fn)fn)(b.dst8 + kBorder * kStride + kBorder,
+             kStride,
+             b.blimit,
+             b.limit,
+             b.thresh);
+}
+
+/* Registry */
+
+// Block sizes of the SAD, variance and OBMC kernels
+#define BLOCK_SIZES(X, f, run) \
+    X(f, run, 4, 4)            \
+    X(f, run, 4, 8)            \
+    X(f, run, 4, 16)           \
+    X(f, run, 8, 4)            \
+    X(f, run, 8, 8)            \
+    X(f, run, 8, 16)           \
+    X(f, run, 8, 32)           \
+    X(f, run, 16, 4)           \
+    X(f, run, 16, 8)           \
+    X(f, run, 16, 16)          \
+    X(f, run, 16, 32)          \
+    X(f, run, 16, 64)          \
+    X(f, run, 32, 8)           \
+    X(f, run, 32, 16)          \
+    X(f, run, 32, 32)          \
+    X(f, run, 32, 64)          \
+    X(f, run, 64, 16)          \
+    X(f, run, 64, 32)          \
+    X(f, run, 64, 64)          \
+    X(f, run, 64, 128)         \
+    X(f, run, 128, 64)         \
+    X(f, run, 128, 128)
+
+// Transform sizes of the intra predictors and the transforms
+#define TX_SIZES(X, f, run) \
+    X(f, run, 4, 4)         \
+    X(f, run, 4, 8)         \
+    X(f, run, 4, 16)        \
+    X(f, run, 8, 4)         \
+    X(f, run, 8, 8)         \
+    X(f, run, 8, 16)        \
+    X(f, run, 8, 32)        \
+    X(f, run, 16, 4)        \
+    X(f, run, 16, 8)        \
+    X(f, run, 16, 16)       \
+    X(f, run, 16, 32)       \
+    X(f, run, 16, 64)       \
+    X(f, run, 32, 8)        \
+    X(f, run, 32, 16)       \
+    X(f, run, 32, 32)       \
+    X(f, run, 32, 64)       \
+    X(f, run, 64, 16)       \
+    X(f, run, 64, 32)       \
+    X(f, run, 64, 64)
+
+// svt_aom_sad16x8, svt_aom_variance16x8, ...
+#define KERNEL_WXH(f, run, w, h) \
+    {#f #w "x" #h, (GenericFn *)&f##w##x##h, run, w, h},
+// svt_aom_sad16x8x4d, svt_av1_fwd_txfm2d_16x8_N2, ...
+#define KERNEL_WXH_SUFFIX(f, run, w, h, suffix) \
+    {#f #w "x" #h #suffix, (GenericFn *)&f##w##x##h##suffix, run, w, h},
+#define KERNEL_WXH_X4D(f, run, w, h) KERNEL_WXH_SUFFIX(f, run, w, h, x4d)
+#define KERNEL_WXH_N2(f, run, w, h) KERNEL_WXH_SUFFIX(f, run, w, h, _N2)
+#define KERNEL_WXH_N4(f, run, w, h) KERNEL_WXH_SUFFIX(f, run, w, h, _N4)
+// Kernels taking their size as arguments, benchmarked on square blocks
+#define KERNEL_SIZED(f, run, w, h) \
+    {#f "/" #w "x" #h, (GenericFn *)&f, run, w, h},
+#define KERNEL(f, run, w, h) {#f, (GenericFn *)&f, run, w, h},
+
+#define SQUARE_SIZES(X, f, run) \
+    X(f, run, 8, 8)             \
+    X(f, run, 16, 16)           \
+    X(f, run, 32, 32)           \
+    X(f, run, 64, 64)
+
+#define INTRA_PREDICTORS(X, prefix, run)     \
+    TX_SIZES(X, prefix##dc_predictor_, run)       \
+    TX_SIZES(X, prefix##dc_top_predictor_, run)   \
+    TX_SIZES(X, prefix##dc_left_predictor_, run)  \
+    TX_SIZES(X, prefix##dc_128_predictor_, run)   \
+    TX_SIZES(X, prefix##v_predictor_, run)        \
+    TX_SIZES(X, prefix##h_predictor_, run)        \
+    TX_SIZES(X, prefix##smooth_predictor_, run)   \
+    TX_SIZES(X, prefix##smooth_v_predictor_, run) \
+    TX_SIZES(X, prefix##smooth_h_predictor_, run) \
+    TX_SIZES(X, prefix##paeth_predictor_, run)
+
+static const Kernel kernels[] = {
+    // clang-format off
+    BLOCK_SIZES(KERNEL_WXH, svt_aom_sad, run_sad)
+    BLOCK_SIZES(KERNEL_WXH_X4D, svt_aom_sad, run_sad_x4d)
+    BLOCK_SIZES(KERNEL_WXH, svt_aom_variance, run_variance)
+    BLOCK_SIZES(KERNEL_WXH, svt_aom_highbd_10_variance, run_highbd_variance)
+    BLOCK_SIZES(KERNEL_WXH, svt_aom_sub_pixel_variance, run_sub_pixel_variance)
+    BLOCK_SIZES(KERNEL_WXH, svt_aom_obmc_sad, run_obmc_sad)
+    BLOCK_SIZES(KERNEL_WXH, svt_aom_obmc_variance, run_obmc_variance)
+    BLOCK_SIZES(KERNEL_WXH, svt_aom_obmc_sub_pixel_variance, run_obmc_sub_pixel_variance)
+    INTRA_PREDICTORS(KERNEL_WXH, svt_aom_, run_intra_pred)
+    INTRA_PREDICTORS(KERNEL_WXH, svt_aom_highbd_, run_highbd_intra_pred)
+    TX_SIZES(KERNEL_WXH, svt_av1_fwd_txfm2d_, run_fwd_txfm)
+    TX_SIZES(KERNEL_WXH_N2, svt_av1_fwd_txfm2d_, run_fwd_txfm)
+    TX_SIZES(KERNEL_WXH_N4, svt_av1_fwd_txfm2d_, run_fwd_txfm)
+    TX_SIZES(KERNEL_WXH, svt_av1_inv_txfm2d_add_, run_inv_txfm)
+    KERNEL(svt_aom_hadamard_8x8, run_hadamard, 8, 8)
+    KERNEL(svt_aom_hadamard_16x16, run_hadamard, 16, 16)
+    KERNEL(svt_aom_hadamard_32x32, run_hadamard, 32, 32)
+    KERNEL(svt_aom_ssim_parms_8x8, run_ssim_parms, 8, 8)
+    KERNEL(svt_aom_lpf_horizontal_8, run_loop_filter, 8, 4)
+    KERNEL(svt_aom_lpf_vertical_14, run_loop_filter, 4, 8)
+    KERNEL(svt_av1_quantize_fp, run_quantize_fp, 16, 16)
+    KERNEL(svt_av1_quantize_fp_32x32, run_quantize_fp, 32, 32)
+    KERNEL(svt_av1_quantize_fp_64x64, run_quantize_fp, 32, 32)
+    KERNEL(svt_aom_quantize_b, run_quantize_b, 16, 16)
+    SQUARE_SIZES(KERNEL_SIZED, svt_aom_satd, run_satd)
+    SQUARE_SIZES(KERNEL_SIZED, svt_av1_block_error, run_block_error)
+    SQUARE_SIZES(KERNEL_SIZED, svt_aom_sse, run_sse)
+    SQUARE_SIZES(KERNEL_SIZED, svt_aom_highbd_sse, run_highbd_sse)
+    SQUARE_SIZES(KERNEL_SIZED, svt_aom_subtract_block, run_subtract_block)
+    SQUARE_SIZES(KERNEL_SIZED, svt_residual_kernel8bit, run_residual)
+    SQUARE_SIZES(KERNEL_SIZED, svt_spatial_full_distortion_kernel, run_spatial_distortion)
+    SQUARE_SIZES(KERNEL_SIZED, svt_av1_convolve_2d_sr, run_convolve_2d_sr)
+    SQUARE_SIZES(KERNEL_SIZED, svt_av1_highbd_convolve_2d_sr, run_highbd_convolve_2d_sr)
+    SQUARE_SIZES(KERNEL_SIZED, svt_aom_blend_a64_mask, run_blend_a64_mask)
+    SQUARE_SIZES(KERNEL_SIZED, svt_av1_wedge_sse_from_residuals, run_wedge_sse)
+    KERNEL_SIZED(svt_av1_get_crc32c_value, run_crc32c, 16, 1)
+    KERNEL_SIZED(svt_av1_generate_block_2x2_hash_row, run_block_2x2_hash_row, 128, 2)
+    // clang-format on
+};
+
+/** ISA levels, each one enabling the CPU flags up to its own */
+struct IsaLevel {
+    const char *name;
+    EbCpuFlags flag;
+};
+
+static const IsaLevel isa_levels[] = {
+    {"c", 0},
+#if defined(ARCH_X86_64)
+    {"sse2", EB_CPU_FLAGS_SSE2},
+    {"sse3", EB_CPU_FLAGS_SSE3},
+    {"ssse3", EB_CPU_FLAGS_SSSE3},
+    {"sse4_1", EB_CPU_FLAGS_SSE4_1},
+    {"sse4_2", EB_CPU_FLAGS_SSE4_2},
+    {"avx", EB_CPU_FLAGS_AVX},
+    {"avx2", EB_CPU_FLAGS_AVX2},
+    {"avx512", EB_CPU_FLAGS_AVX512VL},
+    {"avx512icl", EB_CPU_FLAGS_AVX512ICL},
+#elif defined(ARCH_AARCH64)
+    {"neon", EB_CPU_FLAGS_NEON},
+    {"arm_crc32", EB_CPU_FLAGS_ARM_CRC32},
+    {"neon_dotprod", EB_CPU_FLAGS_NEON_DOTPROD},
+    {"neon_i8mm", EB_CPU_FLAGS_NEON_I8MM},
+    {"sve", EB_CPU_FLAGS_SVE},
+    {"sve2", EB_CPU_FLAGS_SVE2},
+#endif
+};
+
+static EbCpuFlags level_flags(const IsaLevel &level, EbCpuFlags cpu_flags) {
+    return level.flag ? cpu_flags & ((level.flag << 1) - 1) : 0;
+}
+
+static void setup_rtcd(EbCpuFlags flags) {
+    svt_aom_setup_common_rtcd_internal(flags);
+    svt_aom_setup_rtcd_internal(flags);
+}
+
+struct Options {
+    std::string filter;
+    std::string out;
+    std::string format = "console";
+    double min_time = 0.1;
+    bool list = false;
+};
+
+struct Result {
+    std::string name;
+    uint64_t iterations;
+    double real_time;
+    double cpu_time;
+};
+
+/** Times a kernel like google-benchmark does: the iteration count grows until
+ * a run lasts min_time seconds, the last run is reported */
+static Result measure(const std::string &name, const Kernel &kernel,
+                      GenericFn fn, Buffers &buf, double min_time) {
+    uint64_t iterations = 1;
+    for (;;) {
+        const auto start = std::chrono::steady_clock::now();
+        const std::clock_t cpu_start = std::clock();
+        for (uint64_t i = 0; i < iterations; i++)
+            kernel.run(fn, buf, kernel.w, kernel.h);
+        const double cpu =
+            (double)(std::clock() - cpu_start) / CLOCKS_PER_SEC;
+        const double real = std::chrono::duration<double>(
+                                std::chrono::steady_clock::now() - start)
+                                .count();
+        if (real >= min_time || iterations >= (1ull << 40)) {
+            Result result = {name,
+                             iterations,
+                             real * 1e9 / iterations,
+                             cpu * 1e9 / iterations};
+            return result;
+        }
+        double multiplier = real > 0 ? 1.4 * min_time / real : 10;
+        multiplier = multiplier > 10 ? 10 : multiplier < 2 ? 2 : multiplier;
+        iterations = (uint64_t)(iterations * multiplier) + 1;
+    }
+}
+
+static std::string json_escape(const std::string &s) {
+    std::string out;
+    for (char c : s) {
+        if (c == '"' || c == '\\')
+            out += '\\';
+        out += c;
+    }
+    return out;
+}
+
+static void write_json(FILE *f, const std::vector<Result> &results,
+                       const char *executable, EbCpuFlags cpu_flags) {
+    char date[64];
+    const std::time_t now = std::time(NULL);
+    std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+    fprintf(f, "{\n  \"context\": {\n");
+    fprintf(f, "    \"date\": \"%s\",\n", date);
+    fprintf(f, "    \"executable\": \"%s\",\n", json_escape(executable).c_str());
+    fprintf(f, "    \"num_cpus\": %u,\n", std::thread::hardware_concurrency());
+    fprintf(f, "    \"cpu_flags\": \"0x%" PRIx64 "\",\n", (uint64_t)cpu_flags);
+#ifdef NDEBUG
+    fprintf(f, "    \"library_build_type\": \"release\"\n");
+#else
+    fprintf(f, "    \"library_build_type\": \"debug\"\n");
+#endif
+    fprintf(f, "  },\n  \"benchmarks\": [");
+    for (size_t i = 0; i < results.size(); i++) {
+        const Result &r = results[i];
+        fprintf(f, "%s\n    {\n", i ? "," : "");
+        fprintf(f, "      \"name\": \"%s\",\n", json_escape(r.name).c_str());
+        fprintf(f, "      \"run_name\": \"%s\",\n", json_escape(r.name).c_str());
+        fprintf(f, "      \"run_type\": \"iteration\",\n");
+        fprintf(f, "      \"iterations\": %" PRIu64 ",\n", r.iterations);
+        fprintf(f, "      \"real_time\": %.4f,\n", r.real_time);
+        fprintf(f, "      \"cpu_time\": %.4f,\n", r.cpu_time);
+        fprintf(f, "      \"time_unit\": \"ns\"\n    }");
+    }
+    fprintf(f, "\n  ]\n}\n");
+}
+
+static bool parse_flag(const char *arg, const char *flag, std::string &value) {
+    const size_t len = strlen(flag);
+    if (strncmp(arg, flag, len) || arg[len] != '=')
+        return false;
+    value = arg + len + 1;
+    return true;
+}
+
+static int usage(const char *executable) {
+    fprintf(stderr,
+            "usage: %s [--benchmark_filter=<substring>]"
+            " [--benchmark_min_time=<seconds>]\n"
+            "          [--benchmark_format=<console|json>]"
+            " [--benchmark_out=<file>] [--benchmark_list_tests]\n",
+            executable);
+    return 1;
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+    Options opt;
+    for (int i = 1; i < argc; i++) {
+        std::string value;
+        if (parse_flag(argv[i], "--benchmark_filter", value))
+            opt.filter = value;
+        else if (parse_flag(argv[i], "--benchmark_min_time", value))
+            opt.min_time = atof(value.c_str());
+        else if (parse_flag(argv[i], "--benchmark_format", value))
+            opt.format = value;
+        else if (parse_flag(argv[i], "--benchmark_out", value))
+            opt.out = value;
+        else if (!strcmp(argv[i], "--benchmark_list_tests"))
+            opt.list = true;
+        else
+            return usage(argv[0]);
+    }
+    if (opt.min_time <= 0 || (opt.format != "console" && opt.format != "json"))
+        return usage(argv[0]);
+
+#if defined(ARCH_X86_64) || defined(ARCH_AARCH64)
+    const EbCpuFlags cpu_flags = svt_aom_get_cpu_flags_to_use();
+#else
+    const EbCpuFlags cpu_flags = 0;
+#endif
+    Buffers *buf = &buffers;
+    buf->init();
+
+    const bool console = opt.format == "console" && !opt.list;
+    if (console)
+        printf("%-56s %14s %14s %12s\n", "Benchmark", "Time", "CPU", "Iterations");
+
+    // Levels outer, so the RTCD setup runs once per level
+    const size_t kernel_count = sizeof(kernels) / sizeof(kernels[0]);
+    std::vector<GenericFn> last_fn(kernel_count, (GenericFn)NULL);
+    std::vector<std::vector<Result> > per_kernel(kernel_count);
+    for (const IsaLevel &level : isa_levels) {
+        if (level.flag && !(cpu_flags & level.flag))
+            continue;
+        setup_rtcd(level_flags(level, cpu_flags));
+        for (size_t k = 0; k < kernel_count; k++) {
+            const Kernel &kernel = kernels[k];
+            const GenericFn fn = *kernel.slot;
+            if (!fn || fn == last_fn[k])
+                continue;
+            last_fn[k] = fn;
+            const std::string name = kernel.name + "/" + level.name;
+            if (!opt.filter.empty() && name.find(opt.filter) == std::string::npos)
+                continue;
+            if (opt.list) {
+                printf("%s\n", name.c_str());
+                continue;
+            }
+            const Result r = measure(name, kernel, fn, *buf, opt.min_time);
+            if (console)
+                printf("%-56s %11.1f ns %11.1f ns %12" PRIu64 "\n",
+                       r.name.c_str(),
+                       r.real_time,
+                       r.cpu_time,
+                       r.iterations);
+            per_kernel[k].push_back(r);
+        }
+    }
+    setup_rtcd(cpu_flags);
+    if (opt.list)
+        return 0;
+
+    // Report grouped by kernel, the ISA levels of each one in order
+    std::vector<Result> results;
+    for (const std::vector<Result> &kernel_results : per_kernel)
+        results.insert(results.end(), kernel_results.begin(), kernel_results.end());
+    if (opt.format == "json")
+        write_json(stdout, results, argv[0], cpu_flags);
+    if (!opt.out.empty()) {
+        FILE *f = fopen(opt.out.c_str(), "w");
+        if (!f) {
+            fprintf(stderr, "failed to open %s\n", opt.out.c_str());
+            return 1;
+        }
+        write_json(f, results, argv[0], cpu_flags);
+        fclose(f);
+    }
+    return 0;
+}
@@ -265,4 +265,88 @@ TEST_P(SsimHbdTest, MatchTestWithRandomValue) {
 INSTANTIATE_TEST_SUITE_P(SSIM, SsimLbdTest, ::testing::Values(8));
 INSTANTIATE_TEST_SUITE_P(SSIM, SsimHbdTest, ::testing::Values(10));
 
+// svt_aom_ssim_parms_8x8 and svt_aom_highbd_ssim_parms_8x8 accumulate the 8x8
+// sums of the stat report SSIM; the highbd source is split in 8 msb and 2 lsb
+// kept in bits 6 and 7.
+class SsimParmsTest : public ::testing::Test {
+  protected:
+    static const int stride_ = 24;
+
+    void SetUp() override {
+        setup_test_env();
+    }
+
+    void prepare_data(int mode, SVTRandom &rnd8, SVTRandom &rnd10) {
+        for (int i = 0; i < 8 * stride_; ++i) {
+            src_[i] = mode == 0 ? rnd8.random() : mode == 1 ? 0 : 255;
+            src_inc_[i] = mode == 0 ? rnd8.random() : mode == 1 ? 0 : 255;
+            rec_[i] = mode == 0 ? rnd8.random() : mode == 1 ? 0 : 255;
+            rec_hbd_[i] = mode == 0 ? rnd10.random() : mode == 1 ? 0 : 1023;
+        }
+    }
+
+    void run_test(int mode, int run_times) {
+        SVTRandom rnd8(8, false);
+        SVTRandom rnd10(10, false);
+        for (int iter = 0; iter < run_times; ++iter) {
+            uint32_t ref[5], tst[5];
+            prepare_data(mode, rnd8, rnd10);
+            // start from non-zero sums since the kernels accumulate
+            for (int i = 0; i < 5; ++i)
+                ref[i] = tst[i] = iter;
+
+            reset_test_env();
+            svt_aom_ssim_parms_8x8(
+                src_, stride_, rec_, stride_, &ref[0], &ref[1], &ref[2], &ref[3], &ref[4]);
+            setup_test_env();
+            svt_aom_ssim_parms_8x8(
+                src_, stride_, rec_, stride_, &tst[0], &tst[1], &tst[2], &tst[3], &tst[4]);
+            for (int i = 0; i < 5; ++i)
+                ASSERT_EQ(ref[i], tst[i]) << "lbd sum " << i << " mismatch at test(" << iter << ")";
+
+            for (int i = 0; i < 5; ++i)
+                ref[i] = tst[i] = iter;
+            reset_test_env();
+            svt_aom_highbd_ssim_parms_8x8(src_,
+                                          stride_,
+                                          src_inc_,
+                                          stride_,
+                                          rec_hbd_,
+                                          stride_,
+                                          &ref[0],
+                                          &ref[1],
+                                          &ref[2],
+                                          &ref[3],
+                                          &ref[4]);
+            setup_test_env();
+            svt_aom_highbd_ssim_parms_8x8(src_,
+                                          stride_,
+                                          src_inc_,
+                                          stride_,
+                                          rec_hbd_,
+                                          stride_,
+                                          &tst[0],
+                                          &tst[1],
+                                          &tst[2],
+                                          &tst[3],
+                                          &tst[4]);
+            for (int i = 0; i < 5; ++i)
+                ASSERT_EQ(ref[i], tst[i]) << "hbd sum " << i << " mismatch at test(" << iter << ")";
+        }
+    }
+
+    uint8_t src_[8 * stride_];
+    uint8_t src_inc_[8 * stride_];
+    uint8_t rec_[8 * stride_];
+    uint16_t rec_hbd_[8 * stride_];
+};
+
+TEST_F(SsimParmsTest, MatchTestWithExtremeValue) {
+    run_test(1, 1);
+    run_test(2, 1);
+}
+TEST_F(SsimParmsTest, MatchTestWithRandomValue) {
+    run_test(0, test_times);
+}
+
 }  // namespace